@@ -0,0 +1,74 @@
+/*---------------------------------------------------------------------------*\
+    OneFLOW - LargeScale Multiphysics Scientific Simulation Environment
+    Copyright (C) 2017-2023 He Xin and the OneFLOW contributors.
+-------------------------------------------------------------------------------
+License
+    This file is part of OneFLOW.
+
+    OneFLOW is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OneFLOW is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+
+#pragma once
+#include "HXVector.h"
+
+BeginNameSpace( ONEFLOW )
+
+template < typename T, typename U >
+class HXKdNode
+{
+public:
+    U            point[ 3 ];           // the coordinate of the node
+    T            item;                 // any data stored
+    int          axis;                 // the splitting direction of the subtree
+};
+
+//Static kd-tree held in one array. The subtree of the nodes [ ist, ied ) has its root
+//at ( ist + ied ) / 2, the left subtree is [ ist, mid ) and the right one [ mid + 1, ied )
+template < typename T, typename U >
+class HXKdTree
+{
+public:
+    typedef HXKdNode< T, U >     KdNode;
+    typedef HXVector< KdNode >   KdNodeList;
+    typedef HXVector< T >        ItemList;
+public:
+    HXKdTree( int dim = 3 );
+    ~HXKdTree();
+
+    // Build the tree from nPoint points, coor holds the dim coordinates of every point in turn
+    void Build( int nPoint, U * coor, T * items );
+    int  GetNPoint() { return static_cast< int >( nodes.size() ); }
+    KdNode & GetNode( int iNode ) { return nodes[ iNode ]; }
+    // ld carries the items of all the nodes inside region ( pmin, pmax )
+    void FindNodesInRegion( U * pmin, U * pmax, ItemList & ld );
+    // Get the node nearest to point and its squared distance, -1 for an empty tree
+    int  FindNearestNode( U * point, U & dist2 );
+    // Batched queries over nQuery regions or points stored in turn, shared among the threads
+    void FindNodesInRegion( int nQuery, U * pmin, U * pmax, HXVector< ItemList > & ldList );
+    void FindNearestNode( int nQuery, U * point, HXVector< int > & nodeId, HXVector< U > & dist2 );
+protected:
+    void Build( int ist, int ied );
+    bool IsInRegion( KdNode & node, U * pmin, U * pmax );
+    void FindNodesInRegion( int ist, int ied, U * pmin, U * pmax, ItemList & ld );
+    void FindNearestNode( int ist, int ied, U * point, int & iNode, U & dist2 );
+protected:
+    int        dim;
+    KdNodeList nodes;
+};
+
+EndNameSpace
+
+#include "KdTree.hpp"
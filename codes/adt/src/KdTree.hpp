@@ -0,0 +1,233 @@
+/*---------------------------------------------------------------------------*\
+    OneFLOW - LargeScale Multiphysics Scientific Simulation Environment
+    Copyright (C) 2017-2023 He Xin and the OneFLOW contributors.
+-------------------------------------------------------------------------------
+License
+    This file is part of OneFLOW.
+
+    OneFLOW is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OneFLOW is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <limits>
+
+
+BeginNameSpace( ONEFLOW )
+
+template < typename T, typename U >
+class HXKdNodeLess
+{
+public:
+    HXKdNodeLess( int axis ) : axis( axis ) {}
+public:
+    int axis;
+public:
+    bool operator()( const HXKdNode< T, U > & a, const HXKdNode< T, U > & b ) const
+    {
+        return a.point[ axis ] < b.point[ axis ];
+    }
+};
+
+template < typename T, typename U >
+HXKdTree<T,U>::HXKdTree( int dim )
+{
+    this->dim = dim;
+}
+
+template < typename T, typename U >
+HXKdTree<T,U>::~HXKdTree()
+{
+    ;
+}
+
+template < typename T, typename U >
+void HXKdTree<T,U>::Build( int nPoint, U * coor, T * items )
+{
+    nodes.resize( nPoint );
+    for ( int iPoint = 0; iPoint < nPoint; ++ iPoint )
+    {
+        KdNode & node = nodes[ iPoint ];
+        for ( int i = 0; i < 3; ++ i )
+        {
+            node.point[ i ] = ( i < dim ) ? coor[ dim * iPoint + i ] : 0;
+        }
+        node.item = items[ iPoint ];
+        node.axis = 0;
+    }
+
+    this->Build( 0, nPoint );
+}
+
+// Median split along the longest extent of the points
+template < typename T, typename U >
+void HXKdTree<T,U>::Build( int ist, int ied )
+{
+    if ( ied - ist <= 1 ) return;
+
+    U pmin[ 3 ], pmax[ 3 ];
+    for ( int i = 0; i < dim; ++ i )
+    {
+        pmin[ i ] = nodes[ ist ].point[ i ];
+        pmax[ i ] = nodes[ ist ].point[ i ];
+    }
+
+    for ( int iNode = ist + 1; iNode < ied; ++ iNode )
+    {
+        for ( int i = 0; i < dim; ++ i )
+        {
+            pmin[ i ] = std::min( pmin[ i ], nodes[ iNode ].point[ i ] );
+            pmax[ i ] = std::max( pmax[ i ], nodes[ iNode ].point[ i ] );
+        }
+    }
+
+    int axis = 0;
+    for ( int i = 1; i < dim; ++ i )
+    {
+        if ( pmax[ i ] - pmin[ i ] > pmax[ axis ] - pmin[ axis ] ) axis = i;
+    }
+
+    int mid = ( ist + ied ) / 2;
+    std::nth_element( nodes.begin() + ist, nodes.begin() + mid, nodes.begin() + ied, HXKdNodeLess< T, U >( axis ) );
+    nodes[ mid ].axis = axis;
+
+    this->Build( ist, mid );
+    this->Build( mid + 1, ied );
+}
+
+// is the node inside region ( pmin, pmax )?
+template < typename T, typename U >
+bool HXKdTree<T,U>::IsInRegion( KdNode & node, U * pmin, U * pmax )
+{
+    for ( int i = 0; i < dim; ++ i )
+    {
+        if ( node.point[ i ] < pmin[ i ] || node.point[ i ] > pmax[ i ] )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template < typename T, typename U >
+void HXKdTree<T,U>::FindNodesInRegion( U * pmin, U * pmax, ItemList & ld )
+{
+    this->FindNodesInRegion( 0, this->GetNPoint(), pmin, pmax, ld );
+}
+
+template < typename T, typename U >
+void HXKdTree<T,U>::FindNodesInRegion( int ist, int ied, U * pmin, U * pmax, ItemList & ld )
+{
+    if ( ist >= ied ) return;
+
+    int mid = ( ist + ied ) / 2;
+    KdNode & node = nodes[ mid ];
+
+    if ( IsInRegion( node, pmin, pmax ) )
+    {
+        ld.push_back( node.item );
+    }
+
+    int axis = node.axis;
+
+    if ( pmin[ axis ] <= node.point[ axis ] )
+    {
+        this->FindNodesInRegion( ist, mid, pmin, pmax, ld );
+    }
+
+    if ( pmax[ axis ] >= node.point[ axis ] )
+    {
+        this->FindNodesInRegion( mid + 1, ied, pmin, pmax, ld );
+    }
+}
+
+template < typename T, typename U >
+int HXKdTree<T,U>::FindNearestNode( U * point, U & dist2 )
+{
+    int iNode = -1;
+    dist2 = std::numeric_limits< U >::max();
+    this->FindNearestNode( 0, this->GetNPoint(), point, iNode, dist2 );
+    return iNode;
+}
+
+// The near side is searched first, the far side only if the splitting plane is closer than the best node
+template < typename T, typename U >
+void HXKdTree<T,U>::FindNearestNode( int ist, int ied, U * point, int & iNode, U & dist2 )
+{
+    if ( ist >= ied ) return;
+
+    int mid = ( ist + ied ) / 2;
+    KdNode & node = nodes[ mid ];
+
+    U d2 = 0;
+    for ( int i = 0; i < dim; ++ i )
+    {
+        U ds = point[ i ] - node.point[ i ];
+        d2 += ds * ds;
+    }
+
+    if ( d2 < dist2 )
+    {
+        dist2 = d2;
+        iNode = mid;
+    }
+
+    U ds = point[ node.axis ] - node.point[ node.axis ];
+
+    if ( ds <= 0 )
+    {
+        this->FindNearestNode( ist, mid, point, iNode, dist2 );
+        if ( ds * ds < dist2 )
+        {
+            this->FindNearestNode( mid + 1, ied, point, iNode, dist2 );
+        }
+    }
+    else
+    {
+        this->FindNearestNode( mid + 1, ied, point, iNode, dist2 );
+        if ( ds * ds < dist2 )
+        {
+            this->FindNearestNode( ist, mid, point, iNode, dist2 );
+        }
+    }
+}
+
+template < typename T, typename U >
+void HXKdTree<T,U>::FindNodesInRegion( int nQuery, U * pmin, U * pmax, HXVector< ItemList > & ldList )
+{
+    ldList.resize( nQuery );
+
+    #pragma omp parallel for schedule( dynamic, 64 )
+    for ( int iQuery = 0; iQuery < nQuery; ++ iQuery )
+    {
+        ldList[ iQuery ].resize( 0 );
+        this->FindNodesInRegion( 0, this->GetNPoint(), & pmin[ dim * iQuery ], & pmax[ dim * iQuery ], ldList[ iQuery ] );
+    }
+}
+
+template < typename T, typename U >
+void HXKdTree<T,U>::FindNearestNode( int nQuery, U * point, HXVector< int > & nodeId, HXVector< U > & dist2 )
+{
+    nodeId.resize( nQuery );
+    dist2.resize( nQuery );
+
+    #pragma omp parallel for schedule( dynamic, 64 )
+    for ( int iQuery = 0; iQuery < nQuery; ++ iQuery )
+    {
+        nodeId[ iQuery ] = this->FindNearestNode( & point[ dim * iQuery ], dist2[ iQuery ] );
+    }
+}
+
+EndNameSpace
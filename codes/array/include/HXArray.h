@@ -27,6 +27,7 @@ License
 BeginNameSpace( ONEFLOW )
 
 typedef Marray< Real > MRField;
+typedef MarrayRow< Real > MRFieldRow;
 
 typedef Multiarray< Real, 3 > Field3D;
 typedef Multiarray< int, 3 > Int3D;
@@ -22,49 +22,177 @@ License
 #pragma once
 #include "HXType.h"
 #include "HXVector.h"
+#include <new>
 
 BeginNameSpace( ONEFLOW )
 
-template < typename T >
+//EQU_MAJOR stores each equation over all elements (structure of arrays),
+//ELEM_MAJOR stores the nEqu values of one element side by side (array of structures).
+//The layout is a template parameter, so the rows of an EQU_MAJOR array are unit stride at compile time
+enum class MarrayLayout
+{
+    EQU_MAJOR,
+    ELEM_MAJOR
+};
+
+//One equation of a Marray, a view on the shared storage
+template < typename T, MarrayLayout L = MarrayLayout::EQU_MAJOR >
+class MarrayRow
+{
+public:
+    MarrayRow()
+    {
+        this->ptr = 0;
+        this->nElem = 0;
+        this->stride = 1;
+    }
+
+    MarrayRow( T * data, HXSize_t nElem, HXSize_t stride )
+    {
+        this->ptr = data;
+        this->nElem = nElem;
+        this->stride = stride;
+    }
+    MarrayRow( const MarrayRow< T, L > & rhs ) = default;
+protected:
+    T * ptr;
+    HXSize_t nElem;
+    HXSize_t stride;
+public:
+    //Points this view at the storage of rhs, the values are not copied
+    void Bind( const MarrayRow< T, L > & rhs )
+    {
+        this->ptr = rhs.ptr;
+        this->nElem = rhs.nElem;
+        this->stride = rhs.stride;
+    }
+
+    HXSize_t size() const { return nElem; }
+    //A constant for EQU_MAJOR, the stored stride is only read for ELEM_MAJOR
+    HXSize_t Stride() const { return L == MarrayLayout::EQU_MAJOR ? 1 : stride; }
+    T * data() { return ptr; }
+
+    T & operator[]( HXSize_t iElem )
+    {
+        return ptr[ iElem * this->Stride() ];
+    }
+
+    const T & operator[]( HXSize_t iElem ) const
+    {
+        return ptr[ iElem * this->Stride() ];
+    }
+
+    MarrayRow< T, L > & operator = ( const T & value )
+    {
+        for ( HXSize_t iElem = 0; iElem < nElem; ++ iElem )
+        {
+            ( * this )[ iElem ] = value;
+        }
+        return * this;
+    }
+
+    //Assignment copies the values, the view itself is never rebound
+    MarrayRow< T, L > & operator = ( const MarrayRow< T, L > & rhs )
+    {
+        for ( HXSize_t iElem = 0; iElem < nElem; ++ iElem )
+        {
+            ( * this )[ iElem ] = rhs[ iElem ];
+        }
+        return * this;
+    }
+
+    MarrayRow< T, L > & operator = ( const HXVector< T > & rhs )
+    {
+        for ( HXSize_t iElem = 0; iElem < nElem; ++ iElem )
+        {
+            ( * this )[ iElem ] = rhs[ iElem ];
+        }
+        return * this;
+    }
+};
+
+//nEqu fields of nElem values in one aligned allocation
+template < typename T, MarrayLayout L = MarrayLayout::EQU_MAJOR >
 class Marray
 {
+public:
+    static const HXSize_t ALIGNMENT = 64;
 public:
     Marray()
     {
+        this->buffer = 0;
+        this->nEqu = 0;
+        this->nElem = 0;
     }
 
     Marray( HXSize_t nEqu, int numberOfCells )
     {
-        data.resize( nEqu );
-        for ( HXSize_t iEqu = 0; iEqu < nEqu; ++ iEqu )
+        this->nEqu = nEqu;
+        this->nElem = numberOfCells > 0 ? numberOfCells : 0;
+
+        HXSize_t nSize = this->nEqu * this->nElem;
+        this->buffer = static_cast< T * >( ::operator new( ( nSize > 0 ? nSize : 1 ) * sizeof( T ), std::align_val_t( ALIGNMENT ) ) );
+        for ( HXSize_t i = 0; i < nSize; ++ i )
         {
-            data[ iEqu ].resize( numberOfCells );
+            new ( this->buffer + i ) T();
         }
     }
+
     ~Marray()
     {
+        if ( ! this->buffer ) return;
+        HXSize_t nSize = this->nEqu * this->nElem;
+        for ( HXSize_t i = 0; i < nSize; ++ i )
+        {
+            this->buffer[ i ].~T();
+        }
+        ::operator delete( this->buffer, std::align_val_t( ALIGNMENT ) );
     }
+
+    Marray( const Marray< T, L > & rhs ) = delete;
+    Marray< T, L > & operator = ( const Marray< T, L > & rhs ) = delete;
 protected:
-    HXVector< HXVector< T > > data;
+    T * buffer;
+    HXSize_t nEqu;
+    HXSize_t nElem;
 public:
-    HXSize_t GetNEqu() { return data.size(); }
+    HXSize_t GetNEqu() { return nEqu; }
+    HXSize_t GetNElem() { return nElem; }
+    MarrayLayout GetLayout() { return L; }
+
+    //The whole storage, nEqu * nElem values
+    T * Data() { return buffer; }
+    HXSize_t Size() { return nEqu * nElem; }
 
-    HXVector< T > & operator[]( int iEqu )
+    MarrayRow< T, L > operator[]( int iEqu )
     {
-        return data[ iEqu ];
+        if ( L == MarrayLayout::EQU_MAJOR )
+        {
+            return MarrayRow< T, L >( buffer + iEqu * nElem, nElem, 1 );
+        }
+        return MarrayRow< T, L >( buffer + iEqu, nElem, nEqu );
+    }
+
+    T & operator()( int iEqu, int iElem )
+    {
+        if ( L == MarrayLayout::EQU_MAJOR )
+        {
+            return buffer[ iEqu * nElem + iElem ];
+        }
+        return buffer[ iElem * nEqu + iEqu ];
     }
 
-    HXVector< T > & AsOneD()
+    MarrayRow< T, L > AsOneD()
     {
-        return data[ 0 ];
+        return ( * this )[ 0 ];
     }
 
-    Marray< T > & operator = ( const T & value )
+    Marray< T, L > & operator = ( const T & value )
     {
-        HXSize_t nEqu = this->GetNEqu();
-        for ( HXSize_t iEqu = 0; iEqu < nEqu; ++ iEqu )
+        HXSize_t nSize = this->Size();
+        for ( HXSize_t i = 0; i < nSize; ++ i )
         {
-            data[ iEqu ] = value;
+            buffer[ i ] = value;
         }
         return * this;
     }
@@ -1,73 +1,301 @@
-
 #include "util.h"
 #include <cmath>
 #include <vector>
+#include <algorithm>
 #include "stdlib.h"
 #include "solution.h"
 #include "systemSolver.h"
 //#include<crtdbg.h>
 
 /** ************************************************************************
- * Update the current approximation to the solution to the linear
- * system. This assumes that the update is created using a GMRES
- * routine, and the upper Hessenberg matrix has been transformed to an
- * upper diagonal matrix already. Note that it changes the values of
- * the values in the coefficients vector, s, which means that the s
- * vector cannot be reused after this without being re-initialized.
+ * The storage of the GMRES routine: for every right-hand side its upper
+ * Hessenberg matrix, Givens rotations, the right-hand side of its small
+ * least squares problem and its Krylov basis, and the vectors of the
+ * outer system. It is kept from one call to the next and only
+ * reallocated when the size of the system, the number of right-hand
+ * sides or the dimension of the Krylov subspace changes. The basis grows
+ * as needed.
+ ************************************************************************ */
+template <class Approximation, class Double >
+class GMRESWorkspace
+{
+public:
+	GMRESWorkspace()
+	{
+		N = 0;
+		C = 0;
+		K = 0;
+		H = 0;
+		s = 0;
+		w = 0;
+		x = 0;
+		b = 0;
+		residual = 0;
+	}
+
+	~GMRESWorkspace()
+	{
+		release();
+	}
+
+	/**
+		 Method to make the workspace fit a system.
+
+		 @param n The number of rows.
+		 @param c The number of right-hand sides, Rank.COLNUMBER.
+		 @param k The dimension of the Krylov subspace of every right-hand side.
+		 @return N/A
+	 */
+	void resize(int n, int c, int k)
+	{
+		if (n == N && c == C && k == K) return;
+		release();
+		N = n;
+		C = c;
+		K = k;
+		H = ArrayUtils<Double>::twotensor((k + 1) * c, k);
+		s = ArrayUtils<Double>::twotensor(k + 1, c);
+		gc.resize(k * c);
+		gs.resize(k * c);
+		coef.resize(k + 1);
+		bnorm.resize(c);
+		active.resize(c);
+		dimension.resize(c);
+		pin.resize(c);
+		pmid.resize(c);
+		pout.resize(c);
+		V.assign(k + 1, 0);
+		w = new Approximation(n);
+		x = new Approximation(n);
+		b = new Approximation(n);
+		residual = new Approximation(n);
+	}
+
+	/**
+		 Method to get a vector of the basis. The vectors i of all the
+		 right-hand sides are the columns of one block, allocated when GMRES
+		 first gets that far, the solves of a well conditioned system stay
+		 small.
+
+		 @param i The number of the vector.
+		 @param col The right-hand side.
+		 @return The entries of the vector.
+	 */
+	double* vector(int i, int col)
+	{
+		if (!V[i]) V[i] = new Approximation(N);
+		return(V[i]->column(col));
+	}
+
+	/**
+		 Method to get the upper Hessenberg matrix of a right-hand side.
+
+		 @param col The right-hand side.
+		 @return The rows of the matrix.
+	 */
+	Double** hessenberg(int col)
+	{
+		return(H + col * (K + 1));
+	}
+
+public:
+	int N;            //< The number of rows.
+	int C;            //< The number of right-hand sides.
+	int K;            //< The dimension of the Krylov subspaces.
+	Double** H;       //< The upper Hessenberg matrices one below the other, reduced to upper triangular.
+	Double** s;       //< The coefficients of the residuals in the bases, rotated with H, one column each.
+	std::vector<Double> gc;    //< Cosines of the Givens rotations, K for every right-hand side.
+	std::vector<Double> gs;    //< Sines of the Givens rotations.
+	std::vector<Double> coef;  //< Projections of a new vector on its basis.
+	std::vector<Double> bnorm; //< The norm of M^-1 b of every column.
+	std::vector<int> active;    //< The right-hand sides still iterating.
+	std::vector<int> dimension; //< The number of vectors of the basis of every right-hand side in use.
+	std::vector<const double*> pin;  //< The vectors multiplied together.
+	std::vector<double*> pmid;       //< Their products with the operator.
+	std::vector<double*> pout;       //< The products with the preconditioner, the new vectors.
+	std::vector<Approximation*> V;  //< The bases of the Krylov subspaces.
+	Approximation* w;               //< Scratch vectors for the products with the operator.
+	Approximation* x;               //< The approximation of the outer system.
+	Approximation* b;               //< The right-hand side of the outer system.
+	Approximation* residual;        //< The preconditioned residual of the outer system.
+
+private:
+	void release()
+	{
+		ArrayUtils<Double>::deltwotensor(H);
+		ArrayUtils<Double>::deltwotensor(s);
+		H = s = 0;
+		for (std::size_t i = 0; i < V.size(); i++)
+		{
+			delete V[i];
+		}
+		V.clear();
+		delete w;
+		delete x;
+		delete b;
+		delete residual;
+		w = x = b = residual = 0;
+		N = C = K = 0;
+	}
+};
+
+/** ************************************************************************
+ * Orthogonalise a vector against the first vectors of the basis of its
+ * right-hand side with modified Gram-Schmidt. A second pass is made when
+ * the first one cancels most of the vector, so that the basis stays
+ * orthogonal to working precision also close to a breakdown.
+ *
+ * @return The norm of the vector after the orthogonalisation.
+ ************************************************************************ */
+template <class Approximation, class Double >
+Double Orthogonalize
+(GMRESWorkspace<Approximation, Double>* work,  //<! The bases.
+	int col,            //<! The right-hand side.
+	int nv,             //<! The number of vectors of the basis to orthogonalise against.
+	double* v,          //<! The vector, changed in place.
+	Double* h,          //<! The projections on the basis, nv of them.
+	Double& norm0)      //<! The norm of the vector before the orthogonalisation.
+{
+	int n = work->N;
+	Double norm = 0.0;
+	#pragma omp simd reduction(+:norm)
+	for (int k = 0; k < n; k++)
+	{
+		norm += v[k] * v[k];
+	}
+	norm = sqrt(norm);
+	norm0 = norm;
+	for (int i = 0; i < nv; i++)
+	{
+		h[i] = 0.0;
+	}
+	for (int pass = 0; pass < 2 && nv > 0; pass++)
+	{
+		for (int i = 0; i < nv; i++)
+		{
+			const double* q = work->vector(i, col);
+			Double d = 0.0;
+			#pragma omp simd reduction(+:d)
+			for (int k = 0; k < n; k++)
+			{
+				d += q[k] * v[k];
+			}
+			#pragma omp simd
+			for (int k = 0; k < n; k++)
+			{
+				v[k] -= d * q[k];
+			}
+			h[i] += d;
+		}
+		Double before = norm;
+		norm = 0.0;
+		#pragma omp simd reduction(+:norm)
+		for (int k = 0; k < n; k++)
+		{
+			norm += v[k] * v[k];
+		}
+		norm = sqrt(norm);
+		if (norm > 0.7 * before) break;
+	}
+	return(norm);
+}
+
+/** ************************************************************************
+ * Find the Givens rotation that zeroes b against a, and apply it.
+ *
+ * @return N/A
+ ************************************************************************ */
+template <class Double >
+void GivensRotation(Double& a, Double& b, Double& c, Double& s)
+{
+	if (b == 0.0)
+	{
+		c = 1.0;
+		s = 0.0;
+		return;
+	}
+	if (fabs(b) > fabs(a))
+	{
+		// The off diagonal entry has a larger magnitude.
+		Double tmp = a / b;
+		s = 1.0 / sqrt(1.0 + tmp * tmp);
+		c = tmp * s;
+	}
+	else
+	{
+		Double tmp = b / a;
+		c = 1.0 / sqrt(1.0 + tmp * tmp);
+		s = tmp * c;
+	}
+	a = c * a + s * b;
+	b = 0.0;
+}
+
+/** ************************************************************************
+ * Update the approximation of one right-hand side. This assumes that its
+ * upper Hessenberg matrix has been transformed to an upper triangular
+ * matrix already. Note that it changes the values in the coefficients,
+ * s, which means that s cannot be reused after this without being
+ * re-initialized.
  *
  * @return N/A
  ************************************************************************ */
 template <class Approximation, class Double >
 void Update
-(Double** H,         //<! The upper diagonal matrix constructed in the GMRES routine.
+(Double** H,         //<! The upper triangular matrix of the right-hand side.
 	Approximation* x,   //<! The current approximation to the linear system.
-	Double** s,          //<! The vector e_1 that has been multiplied by the Givens rotations.
-	std::vector<Approximation>* v,  //<! The orthogonal basis vectors for the Krylov subspace.
-	int dimension)      //<! The number of vectors in the basis for the Krylov subspace.
+	Double** s,         //<! The rotated coefficients of the residuals.
+	GMRESWorkspace<Approximation, Double>* work,  //<! The bases of the Krylov subspaces.
+	int col,            //<! The right-hand side.
+	int dimension)      //<! The number of vectors of the basis used.
 {
-	// Solve for the coefficients, i.e. solve for c in
-	// H*c=s, but we do it in place.
-	// The calculation is made separately here
-	int lupe;
-	int i;
-	for (i = 0; i < Rank.COLNUMBER; i++)
+	int n = work->N;
+	// Solve for the coefficients, i.e. solve for y in H*y=s, in place.
+	for (int lupe = dimension - 1; lupe >= 0; lupe--)
 	{
-		for (lupe = Rank.COLNUMBER * dimension + Rank.COLNUMBER - 1; lupe >= 0; lupe--)
+		Double sum = s[lupe][col];
+		for (int innerLupe = lupe + 1; innerLupe < dimension; innerLupe++)
 		{
-			s[lupe][i] = s[lupe][i] / H[lupe][lupe];
-			for (int innerLupe = lupe - 1; innerLupe >= 0; innerLupe--)
-			{
-				// Subtract off the parts from the upper diagonal of the
-				// matrix.
-				s[innerLupe][i] -= s[lupe][i] * H[innerLupe][lupe];
-			}
+			sum -= H[lupe][innerLupe] * s[innerLupe][col];
 		}
+		s[lupe][col] = (H[lupe][lupe] == 0.0) ? 0.0 : sum / H[lupe][lupe];
 	}
 	// Finally update the approximation.
-	typename std::vector<Approximation>::iterator ptr = v->begin();
-	for (int xcol = 0; xcol < Rank.COLNUMBER; xcol++)
+	double* xc = x->column(col);
+	for (int m = 0; m < dimension; m++)
 	{
-		for (int lupe = Rank.RANKNUMBER - 1; lupe >= 0; lupe--)
+		const double* q = work->vector(m, col);
+		Double y = s[m][col];
+		#pragma omp simd
+		for (int row = 0; row < n; row++)
 		{
-			for (int m = dimension; m >= 0; m--)
-			{
-				for (int i = Rank.COLNUMBER - 1; i >= 0; i--)
-				{
-					(*x)(lupe, xcol) += (*(ptr + m))(lupe, i) * s[Rank.COLNUMBER * m + i][xcol];
-				}
-			}
+			xc[row] += y * q[row];
 		}
 	}
 }
 
 
 /** ************************************************************************
- * Implementation of the restarted GMRES algorithm. Follows the
- * algorithm given in the book Templates for the Solution of Linear
- * Systems: Building Blocks for Iterative Methods, 2nd Edition.
+ * Implementation of the restarted GMRES algorithm for several right-hand
+ * sides at once. Every right-hand side has its own Krylov subspace, they
+ * are built in step: the products of the newest vectors of all the
+ * right-hand sides still iterating are formed together, in one pass over
+ * the matrix and the preconditioner. A shared block Krylov subspace would
+ * orthogonalise every vector against the C times larger basis of all the
+ * columns, which costs more than it saves when the right-hand sides are
+ * not related, as for the three velocity components.
+ *
+ * A right-hand side stops when its residual estimate satisfies the
+ * tolerance, relative to its M^-1 b, or when its Krylov subspace is
+ * exhausted. One that already satisfies it, a zero one for example,
+ * does not iterate at all. The convergence is confirmed with the true
+ * residual at the end of the cycle.
+ *
+ * All the storage comes from the workspace, so that an iteration does
+ * not allocate memory.
  *
- * @return The number of iterations required. Returns zero if it did
- *         not converge.
+ * @return The number of products with the operator. Returns zero if it
+ *         did not converge.
  ************************************************************************ */
 template<class Operation, class Approximation, class Preconditioner, class Double>
 int GMRES
@@ -76,315 +304,141 @@ int GMRES
 	Approximation* rhs,       //!< the right hand side of the equation to solve.
 	Approximation* residual,
 	Preconditioner* precond,  //!< The preconditioner used for the linear system.
-	int krylovDimension,      //!< The number of vectors to generate in the Krylov subspace.
+	int krylovDimension,      //!< The number of vectors to generate in the Krylov subspace of every right-hand side.
 	int numberRestarts,       //!< Number of times to repeat the GMRES iterations.
-	Double tolerance          //!< How small the residual should be to terminate the GMRES iterations.
+	Double tolerance,         //!< How small the residual should be to terminate the GMRES iterations.
+	GMRESWorkspace<Approximation, Double>* work  //!< The storage, sized by the caller.
 )
 {
+	// A new vector whose norm drops below this fraction of its norm
+	// before the orthogonalisation is in the span of the basis, the
+	// Krylov subspace is exhausted.
+	const Double breakdown = 1.0E-12;
+	int C = work->C;
+	int n = work->N;
+	int K = work->K;
+	Double** s = work->s;
+	Double* h = &work->coef[0];
+	Double* bnorm = &work->bnorm[0];
+	int* active = &work->active[0];
+	int* dimension = &work->dimension[0];
+	const double** pin = &work->pin[0];
+	double** pmid = &work->pmid[0];
+	double** pout = &work->pout[0];
+	Approximation* w = work->w;
 
-	// Allocate the space for the givens rotations, and the upper
-	// Hessenburg matrix.
-	Double** H = ArrayUtils<Double>::twotensor((krylovDimension + 1) * Rank.COLNUMBER, krylovDimension * Rank.COLNUMBER);
-	/*cout << H[1][9] << std::endl;*/
-	// The Givens rotations include the sine and cosine term. The
-	// cosine term is in column zero, and the sine term is in column
-	// one.
-	Double** givens = ArrayUtils<Double>::twotensor(Rank.COLNUMBER * (krylovDimension + 1), krylovDimension * Rank.COLNUMBER);
-
-	Double** s = ArrayUtils<Double>::twotensor((krylovDimension + 1) * Rank.COLNUMBER, Rank.COLNUMBER);
-	Double** S = ArrayUtils<Double>::twotensor(Rank.COLNUMBER, Rank.COLNUMBER);  //To take the last three rows of the S matrix
-	Double** R = ArrayUtils<Double>::twotensor(Rank.COLNUMBER, Rank.COLNUMBER);
-	// Determine the residual and allocate the space for the Krylov
-	// subspace.
-	std::vector<Approximation> V(krylovDimension + 1,
-		Approximation(solution->getN()));
-	(*residual) = precond->solve2((*rhs) - (*linearization) * (*solution));
-
-	//First column vector of residuals
-	Double normr1;
-	double temp = 0.0;
-	for (int ia = 0; ia < Rank.RANKNUMBER; ia++)
+	// Left preconditioning: the residuals are those of M^-1 A x = M^-1 b,
+	// so the tolerance of every column is relative to its M^-1 b
+	precond->apply(*rhs, *w);
+	for (int col = 0; col < C; col++)
 	{
-		temp += (*residual)(ia, 0) * (*residual)(ia, 0);
+		bnorm[col] = w->normColumn(col);
+		if (bnorm[col] < 1.0E-5)
+			bnorm[col] = 1.0;
 	}
-	normr1 = sqrt(temp);
-	Double normRHS = rhs->norm();
-	Double rho = residual->norm();
-	Rank.residual = rho;
-
-	// variable for keeping track of how many restarts had to be used.
-	int totalRestarts = 0;
 
-	if (normRHS < 1.0E-5)
-		normRHS = 1.0;
-
-	// Go through the requisite number of restarts.
-	int iteration = 1;
-	while ((numberRestarts-- >= 0) && (rho > tolerance * normRHS))
+	int products = 0;
+	for (int cycle = 0; ; cycle++)
 	{
+		// Determine the residual, M^-1 (b - A x).
+		linearization->multiply(*solution, *w);
+		w->difference(*rhs, *w);
+		precond->apply(*w, *residual);
+		Rank.residual = residual->norm();
 
-		// The first vector in the Krylov subspace is the normalized residual.
-		// The first QR decomposition, and get the vector V[0], V[1], V[2]
-		for (int ib = 0; ib < Rank.RANKNUMBER; ib++)
-		{
-			(V[0])(ib, 0) = (*residual)(ib, 0) * (1.0 / normr1);    //Unites the first column of the first V vector, v1
-		}
-
-		R[0][0] = normr1;
-		for (int ic = 1; ic < Rank.COLNUMBER; ic++)
+		// The first vector of every basis is the normalised residual.
+		int nActive = 0;
+		for (int col = 0; col < C; col++)
 		{
-			for (int j = 0; j < ic; j++)
-			{
-				R[j][ic] = 0.0;
-				for (int k = 0; k < Rank.RANKNUMBER; k++)
-				{
-					R[j][ic] += (V[0])(k, j) * (*residual)(k, ic);
-				}
-				for (int m = 0; m < Rank.RANKNUMBER; m++)
-				{
-					(V[0])(m, ic) += (V[0])(m, j) * R[j][ic];
-				}
-			}
-			for (int n = 0; n < Rank.RANKNUMBER; n++)
+			Double rnorm = residual->normColumn(col);
+			dimension[col] = 0;
+			if (rnorm <= tolerance * bnorm[col]) continue;
+			double* v = work->vector(0, col);
+			const double* r = residual->column(col);
+			for (int k = 0; k < n; k++)
 			{
-				(V[0])(n, ic) = (*residual)(n, ic) - (V[0])(n, ic);
-				R[ic][ic] += V[0](n, ic) * V[0](n, ic);
+				v[k] = r[k] / rnorm;
 			}
-			R[ic][ic] = sqrt(R[ic][ic]);
-			for (int n = 0; n < Rank.RANKNUMBER; n++)
+			for (int i = 0; i <= K; i++)
 			{
-				V[0](n, ic) = V[0](n, ic) * (1 / R[ic][ic]);
+				s[i][col] = 0.0;
 			}
+			s[0][col] = rnorm;
+			active[nActive++] = col;
 		}
+		if (nActive == 0) return(products > 0 ? products : 1);
+		if (cycle > numberRestarts) return(0);
 
-
-
-		// Need to zero out the s vector in case of restarts
-		// initialize the s vector used to estimate the residual.
-		for (int lupe = 0; lupe <= krylovDimension * Rank.COLNUMBER + Rank.COLNUMBER - 1; lupe++)
-			for (int innerlupe = 0; innerlupe < Rank.COLNUMBER; innerlupe++)
-			{
-				if (lupe > innerlupe)
-					s[lupe][innerlupe] = 0.0;
-				else
-					s[lupe][innerlupe] = R[lupe][innerlupe];
-			}
-
-
-		// Go through and generate the pre-determined number of vectors
-		// for the Krylov subspace.
-		for (iteration = 0; iteration < krylovDimension; ++iteration)
+		// Go through and generate the vectors of the Krylov subspaces, until
+		// every right-hand side is converged or its subspace is exhausted.
+		for (int j = 0; j < K && nActive > 0; j++)
 		{
-			// Get the next entry in the vectors that form the basis for
-			// the Krylov subspace.
-			V[iteration + 1] = precond->solve2((*linearization) * V[iteration]);
-			// Perform the modified Gram-Schmidt method to orthogonalize
-			// the new vector.
-			int row;
-			typename std::vector<Approximation>::iterator ptr = V.begin();
-			for (int id = 0; id < Rank.COLNUMBER; id++)
+			for (int a = 0; a < nActive; a++)
 			{
-				for (row = 0; row <= Rank.COLNUMBER * iteration + Rank.COLNUMBER - 1; row++)
-				{
-					for (int n = 0; n < Rank.RANKNUMBER; n++)
-					{
-						int mod = 0;
-						int quo = 0;
-						mod = row % Rank.COLNUMBER;
-						quo = row / Rank.COLNUMBER;
-						H[row][Rank.COLNUMBER * iteration + id] += (V[iteration + 1])(n, id) * (*(ptr + quo))(n, mod);
-					}
-				}
-				//subtract H[row][iteration]*V[row] from the current vector
-				for (int row = 0; row <= iteration; row++)
-				{
-					for (int n = 0; n < Rank.RANKNUMBER; n++)
-					{
-						double tem = 0.0;
-						for (int j = 0; j < Rank.COLNUMBER; j++)
-						{
-							tem += (*(ptr + row))(n, j) * H[Rank.COLNUMBER * row + j][Rank.COLNUMBER * iteration + id];
-						}
-						(V[iteration + 1])(n, id) = (V[iteration + 1])(n, id) - tem;
-					}
-				}
+				pin[a] = work->vector(j, active[a]);
+				pmid[a] = w->column(a);
+				pout[a] = work->vector(j + 1, active[a]);
 			}
+			linearization->multiply(nActive, pin, pmid);
+			precond->apply(nActive, pmid, pout);
+			products += nActive;
 
-			// The unitization process of QR decomposition to get h [iteration + 1] [iteration], v [iteration + 1]
-			std::vector<Approximation> TV(1, Approximation(solution->getN()));   //Temporary variable
-			TV[0] = V[iteration + 1];
-			Double normr2;
-			double t = 0.0;
-			for (int lupe = 0; lupe < Rank.RANKNUMBER; lupe++)
-			{
-				t += (V[iteration + 1])(lupe, 0) * (V[iteration + 1])(lupe, 0);
-			}
-			normr2 = sqrt(t);
-			for (row = 0; row < Rank.RANKNUMBER; row++)
+			int nStill = 0;
+			for (int a = 0; a < nActive; a++)
 			{
-				(V[iteration + 1])(row, 0) = (V[iteration + 1])(row, 0) * (1.0 / normr2);
-			}
-			H[Rank.COLNUMBER * (iteration + 1)][Rank.COLNUMBER * iteration] = normr2;
-			for (int p = 1; p < Rank.COLNUMBER; p++)
-			{
-				for (int q = 0; q < p; q++)
-				{
-					for (int k = 0; k < Rank.RANKNUMBER; k++)
-					{
-						H[Rank.COLNUMBER * (iteration + 1) + q][Rank.COLNUMBER * iteration + p] += (V[iteration + 1])(k, q) * (TV[0])(k, p);
-					}
-					for (int m = 0; m < Rank.RANKNUMBER; m++)
-					{
-						(V[iteration + 1])(m, p) = 0.0;
-						(V[iteration + 1])(m, p) += (V[iteration + 1])(m, q) * H[Rank.COLNUMBER * (iteration + 1) + q][Rank.COLNUMBER * iteration + p];
-					}
-				}
-				for (int n = 0; n < Rank.RANKNUMBER; n++)
+				int col = active[a];
+				Double** H = work->hessenberg(col);
+				Double* gc = &work->gc[col * K];
+				Double* gs = &work->gs[col * K];
+				double* v = pout[a];
+				Double norm0;
+				Double norm = Orthogonalize(work, col, j + 1, v, h, norm0);
+				for (int i = 0; i <= j; i++)
 				{
-					(V[iteration + 1])(n, p) = (TV[0])(n, p) - (V[iteration + 1])(n, p);
-					H[Rank.COLNUMBER * (iteration + 1) + p][Rank.COLNUMBER * iteration + p] += V[iteration + 1](n, p) * V[iteration + 1](n, p);
+					H[i][j] = h[i];
 				}
-				H[Rank.COLNUMBER * (iteration + 1) + p][Rank.COLNUMBER * iteration + p] = sqrt(H[Rank.COLNUMBER * (iteration + 1) + p][Rank.COLNUMBER * iteration + p]);
-				for (int n = 0; n < Rank.RANKNUMBER; n++)
+				bool exhausted = !(norm > breakdown * norm0);
+				if (exhausted)
 				{
-					(V[iteration + 1])(n, p) = (V[iteration + 1])(n, p) * (1 / H[Rank.COLNUMBER * (iteration + 1) + p][Rank.COLNUMBER * iteration + p]);
+					H[j + 1][j] = 0.0;
 				}
-			}
-			std::vector<Approximation>(TV).swap(TV);
-
-			// Apply the Givens Rotations to insure that H is
-			// an upper diagonal matrix. First apply previous
-			// rotations to the current matrix.
-			// the first Givens Rotations
-			double tmp = 0.0;
-			int col;
-			for (int lupe = 0; lupe < Rank.COLNUMBER; lupe++)
-			{
-				for (col = Rank.COLNUMBER * iteration; col < Rank.COLNUMBER * (iteration + 1); col++)
+				else
 				{
-					for (row = 0; row < col; row++)
-					{
-						int tp = row + Rank.COLNUMBER - 1 - lupe;
-						int mp = Rank.COLNUMBER - lupe - 1;
-						tmp = givens[tp][2 * (tp - mp)] * H[tp][col]
-							+ givens[tp][2 * (tp - mp) + 1] * H[tp + 1][col];
-						H[tp + 1][col] = -givens[tp][2 * (tp - mp) + 1] * H[tp][col]
-							+ givens[tp][2 * (tp - mp)] * H[tp + 1][col];
-						H[tp][col] = tmp;
-					}
-					// Figure out the next Givens rotation.
-					if (H[col + Rank.COLNUMBER - lupe][col] == 0.0)
-					{
-						// It is already lower diagonal. Just leave it be....
-						givens[col + Rank.COLNUMBER - 1 - lupe][col * 2] = 1.0;
-						givens[col + Rank.COLNUMBER - 1 - lupe][1 + col * 2] = 0.0;
-					}
-					else if (fabs(H[col + Rank.COLNUMBER - lupe][col]) > fabs(H[col + Rank.COLNUMBER - 1 - lupe][col]))
-					{
-						// The off diagonal entry has a larger
-						// magnitude. Use the ratio of the
-						// diagonal entry over the off diagonal.
-						tmp = H[col + Rank.COLNUMBER - 1 - lupe][col] / H[col + Rank.COLNUMBER - lupe][col];
-						givens[col + Rank.COLNUMBER - 1 - lupe][1 + col * 2] = 1.0 / sqrt(1.0 + tmp * tmp);
-						givens[col + Rank.COLNUMBER - 1 - lupe][col * 2] = tmp * givens[col + Rank.COLNUMBER - 1 - lupe][1 + col * 2];
-					}
-					else
+					for (int k = 0; k < n; k++)
 					{
-						// The off diagonal entry has a smaller
-						// magnitude. Use the ratio of the off
-						// diagonal entry to the diagonal entry.
-						tmp = H[col + Rank.COLNUMBER - lupe][col] / H[col + Rank.COLNUMBER - 1 - lupe][col];
-						givens[col + Rank.COLNUMBER - 1 - lupe][col * 2] = 1.0 / sqrt(1.0 + tmp * tmp);
-						givens[col + Rank.COLNUMBER - 1 - lupe][1 + col * 2] = tmp * givens[col + Rank.COLNUMBER - 1 - lupe][col * 2];
-					}
-					// Apply the new Givens rotation on the
-					// new entry in the uppper Hessenberg matrix.
-					tmp = givens[col + Rank.COLNUMBER - 1 - lupe][col * 2] * H[col + Rank.COLNUMBER - 1 - lupe][col] +
-						givens[col + Rank.COLNUMBER - 1 - lupe][1 + col * 2] * H[col + Rank.COLNUMBER - lupe][col];
-					H[col + Rank.COLNUMBER - lupe][col] = -givens[col + Rank.COLNUMBER - 1 - lupe][1 + col * 2] * H[col + Rank.COLNUMBER - 1 - lupe][col] +
-						givens[col + Rank.COLNUMBER - 1 - lupe][col * 2] * H[col + Rank.COLNUMBER - lupe][col];
-					H[col + Rank.COLNUMBER - 1 - lupe][col] = tmp;
-					if (H[col + Rank.COLNUMBER - lupe][col] < 1e-10)
-						H[col + Rank.COLNUMBER - lupe][col] = 0;
-
-					// Finally apply the new Givens rotation on the s
-					// vector
-					for (int z = 0; z < Rank.COLNUMBER; z++)
-					{
-						tmp = givens[col + Rank.COLNUMBER - 1 - lupe][col * 2] * s[col + Rank.COLNUMBER - 1 - lupe][z] + givens[col + Rank.COLNUMBER - 1 - lupe][1 + col * 2] * s[col + Rank.COLNUMBER - lupe][z];
-						s[col + Rank.COLNUMBER - lupe][z] = -givens[col + Rank.COLNUMBER - 1 - lupe][1 + col * 2] * s[col + Rank.COLNUMBER - 1 - lupe][z] + givens[col + Rank.COLNUMBER - 1 - lupe][col * 2] * s[col + Rank.COLNUMBER - lupe][z];
-						s[col + Rank.COLNUMBER - 1 - lupe][z] = tmp;
+						v[k] /= norm;
 					}
+					H[j + 1][j] = norm;
 				}
-			}
-			//The last three lines of the s vector group are stored in the s vector group so that the norm can be calculated later
-			int lupe, innerlupe;
-			for (lupe = 0; lupe < Rank.COLNUMBER; lupe++)
-			{
-				for (innerlupe = 0; innerlupe < Rank.COLNUMBER; innerlupe++)
+
+				// Apply the rotations of the previous columns, then zero the
+				// entry below the diagonal, the same rotation going to the
+				// coefficients.
+				for (int i = 0; i < j; i++)
 				{
-					S[lupe][innerlupe] = s[Rank.COLNUMBER * (iteration + 1) + lupe][innerlupe];
+					Double tmp = gc[i] * H[i][j] + gs[i] * H[i + 1][j];
+					H[i + 1][j] = -gs[i] * H[i][j] + gc[i] * H[i + 1][j];
+					H[i][j] = tmp;
 				}
-			}
+				GivensRotation(H[j][j], H[j + 1][j], gc[j], gs[j]);
+				Double tmp = gc[j] * s[j][col] + gs[j] * s[j + 1][col];
+				s[j + 1][col] = -gs[j] * s[j][col] + gc[j] * s[j + 1][col];
+				s[j][col] = tmp;
+				dimension[col] = j + 1;
 
-			/*int row;*/
-			int im;
-			int in;
-			rho = 0.0;
-			for (im = Rank.COLNUMBER - 1; im >= 0; im--)
-				for (in = Rank.COLNUMBER - 1; in >= 0; in--)
+				// The residual estimate is the last rotated coefficient.
+				if (!exhausted && fabs(s[j + 1][col]) > tolerance * bnorm[col])
 				{
-					rho += S[im][in] * S[im][in];
+					active[nStill++] = col;
 				}
-			rho = sqrt(rho);
-
-			//std::cout << "iteration:" << iteration << "residual:" << rho << std::endl;
-			/*ofstream file2("residual.txt", std::ios::app);
-			file2 << "residual:" << rho << std::endl;
-			file2.close();*/
-
-			//std::cout << tolerance * normRHS << std::endl;
-			if (rho < tolerance * normRHS)   //Is this method effective in bgmres
-			{
-				// We are close enough! Update the approximation.
-				Update(H, solution, s, &V, iteration);
-				(*residual) = precond->solve2((*linearization) * (*solution) - (*rhs));      
-				Rank.residual = residual->norm();
-				ArrayUtils<double>::deltwotensor(givens);
-				ArrayUtils<double>::deltwotensor(H);
-				ArrayUtils<double>::deltwotensor(s);
-				ArrayUtils<double>::deltwotensor(S);
-				ArrayUtils<double>::deltwotensor(R);
-				std::vector<Approximation>().swap(V);
-				//delete [] V;
-				//tolerance = rho/normRHS;
-				return(iteration + totalRestarts * krylovDimension);
 			}
+			nActive = nStill;
+		}
 
-		} // for(iteration)
-
-		// We have exceeded the number of iterations. Update the
-		// approximation and start over.
-		totalRestarts += 1;
-		Update(H, solution, s, &V, iteration - 1);
-		(*residual) = precond->solve2((*linearization) * (*solution) - (*rhs));      //The third precond
-		Rank.residual = residual->norm();
-
-		//std::cout << "totalRestarts:" << totalRestarts << std::endl;
-	} // while(numberRestarts,rho)
-
-
-	ArrayUtils<double>::deltwotensor(givens);
-	ArrayUtils<double>::deltwotensor(H);
-	ArrayUtils<double>::deltwotensor(s);
-	ArrayUtils<double>::deltwotensor(S);
-	ArrayUtils<double>::deltwotensor(R);
-	std::vector<Approximation>().swap(V);
-	//delete [] V;
-	//tolerance = rho/normRHS;
-
-	if (rho < tolerance * normRHS)
-		return(0);
-
-	return(0);
+		// Update the approximations and check them against the true residual.
+		for (int col = 0; col < C; col++)
+		{
+			if (dimension[col] > 0) Update(work->hessenberg(col), solution, s, work, col, dimension[col]);
+		}
+	}
 }
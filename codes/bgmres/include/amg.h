@@ -0,0 +1,93 @@
+#ifndef AMGCLASS
+#define AMGCLASS
+#include <vector>
+#include <map>
+
+//Smoothers of the multigrid cycle, selected with amgsmoother
+const int AMG_GAUSS_SEIDEL = 0;
+const int AMG_CHEBYSHEV    = 1;
+
+/**
+	 One level of the multigrid hierarchy: the CSR matrix of the level, the
+	 prolongation P to it from the next coarser level and the restriction
+	 R = P^T, the aggregate of every row and the work vectors of the cycle.
+ */
+class AmgLevel
+{
+public:
+	int n;                         //< Number of rows of the level.
+	int nc;                        //< Number of aggregates, the rows of the next level.
+	std::vector<int> ia, ja;
+	std::vector<double> a;
+	std::vector<double> dinv;      //< Inverse of the diagonal, 0 for a zero diagonal.
+	double rho;                    //< Upper bound of the spectral radius of D^-1 A.
+	std::vector<int> aggregate;    //< Aggregate of every row.
+	std::vector<int> pia, pja, ria, rja;
+	std::vector<double> pa, ra;
+	std::vector<double> x, b, r, d; //< Work vectors of the cycle.
+};
+
+/**
+	 Smoothed aggregation algebraic multigrid for the CSR systems of the
+	 incompressible solver, used standalone or as a preconditioner.
+
+	 The aggregates follow the strong couplings of the matrix. The tentative
+	 piecewise constant prolongation is smoothed with one damped Jacobi step,
+	 and the coarse matrices are the Galerkin products R A P. The coarsest
+	 level is solved with a dense LU factorisation.
+
+	 When setup sees the sparsity pattern of the previous call again, it keeps
+	 the aggregates of all levels and only recomputes the values.
+ */
+class Amg
+{
+public:
+	Amg();
+	~Amg();
+
+	void setup(int n, int *ia, int *ja, double *a);
+	void cycle(const double *b, double *x);                              //< One V-cycle from x = 0.
+	int  solve(double *b, double *x, double tol, int maxIt, double &residual);
+
+	int getLevels() const
+	{
+		return(levels.size());
+	}
+
+protected:
+	bool samePattern(int n, int *ia, int *ja);
+	void calcDiagonal(AmgLevel &level);
+	void calcAggregates(AmgLevel &level);
+	void calcProlongation(AmgLevel &level);
+	void calcCoarseMatrix(AmgLevel &fine, AmgLevel &coarse);
+	void factorCoarse();
+	void solveCoarse(double *b, double *x);
+	void cycle(int iLevel);
+	void smooth(AmgLevel &level, bool forward);
+	void smoothChebyshev(AmgLevel &level);
+	void residual(AmgLevel &level);
+
+private:
+	std::vector<AmgLevel> levels;
+	std::vector<int> fineIA, fineJA;     //< Pattern of the last setup.
+	std::vector<double> lu;              //< Dense LU of the coarsest matrix.
+	std::vector<int> pivot;
+	int smoother;
+	int sweeps;
+};
+
+/**
+	 The hierarchies are kept from one call to the next, one per system and
+	 grid, so that the aggregation can be reused while the pattern does not
+	 change and grids of different sizes never share a hierarchy. Grids are
+	 never rebuilt or freed, so the hierarchies are kept for the whole run.
+ */
+class AmgFactory
+{
+public:
+	static std::map<std::pair<int, const void *>, Amg *> data;
+public:
+	static Amg *getAmg(int system, const void *grid);
+};
+
+#endif
@@ -16,6 +16,9 @@ public:
 	// Basic algebraic operators associated with the linearization of the operator.
 	double& operator()(int row);     //< The value of the linearization for the operator at a given row and column.
 	Solution operator*(class Solution vector);  //< The linearized operator acting on a given Solution.
+	void multiply(const Solution& vector, Solution& result);  //< result = A vector, without temporaries.
+	void multiply(const double* x, double* y);                //< y = A x for a single vector.
+	void multiply(int nv, const double* const* x, double* const* y);  //< y[c] = A x[c] for nv vectors, one pass over A.
 
 	/**
 		 Method to get the number of elements that are in the approximation.
@@ -46,11 +49,8 @@ public:
 		return(A[row]);
 	}
 
-protected:
-	/*void produceA(double* deriv, int* derivrow, int* derivcol);*/
-	void coeMatrix(double* deriv, int* derivrow, int* derivcol);
-
 public:
+	// The matrix is that of Rank, it is not copied.
 	int N;        //< The number of grid points in the approximation.
 	int L;        //< The rank of the matrix
 	double *A;    //< The linear operator matrix
@@ -2,8 +2,18 @@
 #define PRECONDITIONERCLASS
 #include "systemSolver.h"
 #include "UCom.h"
+#include <vector>
 class Solution;
 class UCom;
+class Amg;
+
+//Preconditioner types, selected with iprecond
+const int PRECOND_NONE   = 0;
+const int PRECOND_JACOBI = 1;
+const int PRECOND_BJACOBI = 2;
+const int PRECOND_ILU0   = 3;
+const int PRECOND_ILUT   = 4;
+const int PRECOND_AMG    = 5;
 
 class Preconditioner
 {
@@ -17,6 +27,11 @@ public:
 	Solution solve2(const Solution &vector);																					 //< system associated with
 																						 //< the preconditioner.
 
+	void setup(int type);                      //< Builds the preconditioner from Rank.TempA/TempIA/TempJA
+	void apply(const Solution &r, Solution &z); //< z = M^-1 r
+	void apply(const double *r, double *z);     //< z = M^-1 r for a single vector
+	void apply(int nv, const double *const *r, double *const *z); //< z[c] = M^-1 r[c] for nv vectors
+
 	
 	/**
 		 Method to set the number of elements to use for the length of the approximation.
@@ -40,25 +55,40 @@ public:
 	}
 
 	/**
-		 Method to get the value of the preconditioner's vector for a
-		 given row.
+		 Method to get the type of the preconditioner.
 
-		 @param row Row in the vector you want to access.
-		 @return The value of the vector for the given row.
+		 @return One of the PRECOND_ constants.
 	 */
-	double getValue(int row,int col) const
+	int getType() const
 	{
-		return(vector[row][col]);
+		return(type);
 	}
 
 
 protected:
-
+	void sortRows(std::vector<int> &ia, std::vector<int> &ja, std::vector<double> &a, int nBlocks);
+	void factorILU0(std::vector<int> &ia, std::vector<int> &ja, std::vector<double> &a);
+	void factorILUT(std::vector<int> &ia, std::vector<int> &ja, std::vector<double> &a, int fill, double drop);
+	void calcLevels();
+	void solveLU(const double *r, double *z);
+	void solveLU(int nv, const double *const *r, double *const *z);
 
 private:
 
 	int N;           //< The number of grid points associated with the approximation.
-	double **vector; //< The vector that has the reciprocol of the diagonal entries of the operator.
+	int type;        //< One of the PRECOND_ constants.
+
+	// The factors, L with unit diagonal and U without its diagonal, both as CSR
+	// with increasing column numbers, and the inverse of the diagonal of U.
+	std::vector<int> lIA, lJA, uIA, uJA;
+	std::vector<double> lA, uA;
+	std::vector<double> dinv;
+
+	// Level scheduling: the rows of level k of the forward (backward) sweep are
+	// lRows[lLevel[k]..lLevel[k+1]), they only depend on rows of earlier levels.
+	std::vector<int> lLevel, lRows, uLevel, uRows;
+
+	Amg *amg;        //< The multigrid hierarchy of PRECOND_AMG, kept by AmgFactory.
 };
 
 
@@ -13,9 +13,12 @@ public:
 	~Solution();                             //< Destructor for the class
 
 	// Now define the operators associated with the class.
-	double& operator()(int row, int col);                   //< The parenthesis operator for access to data elements
-	Solution operator=(const Solution& vector);    //< Assignment operator for copying another Solution
-	Solution operator=(const double& value);       //< Assignment operator for assigning a single value to all elements.
+	double& operator()(int row, int col)                    //< The parenthesis operator for access to data elements
+	{
+		return(solution[col][row]);
+	}
+	Solution& operator=(const Solution& vector);   //< Assignment operator for copying another Solution
+	Solution& operator=(const double& value);      //< Assignment operator for assigning a single value to all elements.
 	Solution operator+(const Solution& vector);    //< Operator for adding two Solution objects
 	Solution operator-(const Solution& vector);    //< Operator for subtracting two Solution objects.
 	Solution operator*(const double& value);       //< Operator for scalar multiplication.
@@ -38,6 +41,31 @@ public:
 
 	/** Definition of the axpy procedure. */
 	void axpy(Solution* vector,double multiplier);
+
+	// In-place kernels on single columns, used by GMRES so that an
+	// iteration does not allocate or copy whole vectors.
+	double dot(int col, const Solution& vector, int vcol) const;            //< Dot product of two columns.
+	double normColumn(int col) const;                                       //< The l2 norm of a column.
+	void   scale(int col, double value);                                    //< column *= value
+	void   axpy(int col, double multiplier, const Solution& vector, int vcol); //< column += multiplier*vector(:,vcol)
+	double subtractFrom(int col, const Solution& vector, int vcol);         //< column = vector(:,vcol) - column, returns its squared norm
+	void   difference(const Solution& v1, const Solution& v2);             //< this = v1 - v2 in every column
+
+	/**
+	   Method to get the storage of a column, the entries are contiguous.
+
+	   @param col The column.
+	   @return A pointer to the first entry of the column.
+	*/
+	inline double* column(int col)
+	{
+		return(solution[col]);
+	}
+
+	inline const double* column(int col) const
+	{
+		return(solution[col]);
+	}
 	//static double getcol(const Solution& vector);
 
 	/** ************************************************************************
@@ -51,7 +79,7 @@ public:
 	 * ************************************************************************ */
 	void setEntry(double value,int row, int col)
 	{
-		solution[row][col] = value;
+		solution[col][row] = value;
 	}
 
 
@@ -85,7 +113,7 @@ public:
 	*/
 	inline double getEntry(int row, int col) const
 	{
-		return(solution[row][col]);
+		return(solution[col][row]);
 	}
 
 protected:
@@ -97,7 +125,7 @@ private:
 	// Define the size of the vector and the vector that will contain
 	// the information.
 	int N;                      //< The number of grid points.
-	double **solution ;    //< The vector that contains the approximation.
+	double **solution ;    //< The vector that contains the approximation, stored by column.
 
 };
 
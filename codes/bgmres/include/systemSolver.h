@@ -1,6 +1,22 @@
 #pragma once
+#include <map>
+#include <vector>
 
 class UINsInvterm;
+class Solution;
+class Poisson;
+class Preconditioner;
+template <class Approximation, class Double> class GMRESWorkspace;
+
+//The systems of the incompressible solver, set in SolveMRhs::system
+const int SYSTEM_MOMENTUM = 0;
+const int SYSTEM_PRESSURE = 1;
+
+//Solvers of the pressure-correction equation, selected with ipsolver
+const int PSOLVER_BGMRES = 0;
+const int PSOLVER_AMG = 1;
+const int PSOLVER_BGMRES_AMG = 2;
+
 class SolveMRhs 
 {
 public:
@@ -8,10 +24,14 @@ public:
 	~SolveMRhs();
 public:
 	void Init();
+	void Init(int* ia, int* ja);
 	int RANKNUMBER;
 	int NUMBER;
 	int COLNUMBER;
+	int system;       //< One of the SYSTEM_ constants
+	const void* grid; //< The grid the system is assembled on, with system the key of the cached AMG hierarchies
 	double residual;
+	std::vector<double> residuals;  //< The residual of every column, set by BGMRES and AMG
 	double* TempA;    //< The linear operator matrix
 	int* TempIA;      //< The row number of the matrix
 	int* TempJA;      //< The column number of the matrix
@@ -21,6 +41,18 @@ public:
 
 public:
 	void BGMRES();
+	void AMG();
+
+private:
+	// Sizes of the arrays allocated by Init, and whether TempIA and TempJA
+	// are owned or belong to the pattern passed to Init(ia, ja)
+	int nRowAlloc, nnzAlloc, nColAlloc;
+	bool ownPattern;
+
+	// Kept from one solve to the next, see BGMRES
+	std::map<int, GMRESWorkspace<Solution, double>*> spaces;
+	Poisson* A;
+	Preconditioner* pre;
 };
 extern SolveMRhs Rank;
 extern SolveMRhs bgx;
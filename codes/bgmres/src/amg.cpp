@@ -0,0 +1,642 @@
+#include "amg.h"
+#include "Ctrl.h"
+#include <cmath>
+#include <algorithm>
+
+//Strength of connection threshold of the aggregation
+static const double AMG_STRENGTH = 0.08;
+//The coarsening stops below this number of rows or at this number of levels
+static const int AMG_COARSE_SIZE = 400;
+static const int AMG_MAX_LEVELS = 20;
+
+std::map<std::pair<int, const void *>, Amg *> AmgFactory::data;
+
+/** ************************************************************************
+ * Sparse product C = A B of two CSR matrices, B with nColB columns, using
+ * a marker array over the columns of C.
+ * ************************************************************************ */
+static void multiplyCSR(int nRowA, const std::vector<int> &aia, const std::vector<int> &aja, const std::vector<double> &aa,
+	int nColB, const std::vector<int> &bia, const std::vector<int> &bja, const std::vector<double> &ba,
+	std::vector<int> &cia, std::vector<int> &cja, std::vector<double> &ca)
+{
+	std::vector<int> marker(nColB, -1);
+	cia.assign(nRowA + 1, 0);
+	cja.clear();
+	ca.clear();
+	for (int i = 0; i < nRowA; i++)
+	{
+		int rowStart = cja.size();
+		for (int p = aia[i]; p < aia[i + 1]; p++)
+		{
+			int k = aja[p];
+			double aik = aa[p];
+			for (int q = bia[k]; q < bia[k + 1]; q++)
+			{
+				int j = bja[q];
+				if (marker[j] < rowStart)
+				{
+					marker[j] = cja.size();
+					cja.push_back(j);
+					ca.push_back(aik * ba[q]);
+				}
+				else
+				{
+					ca[marker[j]] += aik * ba[q];
+				}
+			}
+		}
+		cia[i + 1] = cja.size();
+	}
+}
+
+/** ************************************************************************
+ * Transpose of a CSR matrix with nRow rows and nCol columns.
+ * ************************************************************************ */
+static void transposeCSR(int nRow, int nCol, const std::vector<int> &ia, const std::vector<int> &ja, const std::vector<double> &a,
+	std::vector<int> &tia, std::vector<int> &tja, std::vector<double> &ta)
+{
+	tia.assign(nCol + 1, 0);
+	for (int p = 0; p < ia[nRow]; p++)
+	{
+		tia[ja[p] + 1]++;
+	}
+	for (int j = 0; j < nCol; j++)
+	{
+		tia[j + 1] += tia[j];
+	}
+	tja.resize(ia[nRow]);
+	ta.resize(ia[nRow]);
+	std::vector<int> next(tia.begin(), tia.end() - 1);
+	for (int i = 0; i < nRow; i++)
+	{
+		for (int p = ia[i]; p < ia[i + 1]; p++)
+		{
+			int q = next[ja[p]]++;
+			tja[q] = i;
+			ta[q] = a[p];
+		}
+	}
+}
+
+/** ************************************************************************
+ * Base constructor for the Amg class.
+ * ************************************************************************ */
+Amg::Amg()
+{
+	smoother = AMG_GAUSS_SEIDEL;
+	sweeps = 1;
+}
+
+/** ************************************************************************
+ * Destructor for the Amg class.
+ * ************************************************************************ */
+Amg::~Amg()
+{
+	;
+}
+
+/** ************************************************************************
+ * Build the hierarchy of the matrix (ia, ja, a) with n rows. The columns of
+ * a row may come in any order. When the pattern is that of the previous
+ * call the aggregates are kept and only the values are recomputed.
+ *
+ * @param n  The number of rows.
+ * @param ia The row pointers.
+ * @param ja The column numbers.
+ * @param a  The values.
+ * @return N/A
+ * ************************************************************************ */
+void Amg::setup(int n, int *ia, int *ja, double *a)
+{
+	smoother = ONEFLOW::ctrl.amgsmoother;
+	sweeps = (smoother == AMG_CHEBYSHEV) ? 3 : 1;
+
+	bool reuse = samePattern(n, ia, ja);
+	if (!reuse)
+	{
+		levels.clear();
+		levels.resize(1);
+		fineIA.assign(ia, ia + n + 1);
+		fineJA.assign(ja, ja + ia[n]);
+	}
+
+	AmgLevel &fine = levels[0];
+	fine.n = n;
+	fine.ia.assign(ia, ia + n + 1);
+	fine.ja.assign(ja, ja + ia[n]);
+	fine.a.assign(a, a + ia[n]);
+
+	for (int iLevel = 0; ; iLevel++)
+	{
+		calcDiagonal(levels[iLevel]);
+		bool last = reuse ? (iLevel + 1 == getLevels()) :
+			(levels[iLevel].n <= AMG_COARSE_SIZE || iLevel + 1 == AMG_MAX_LEVELS);
+		if (!reuse && !last)
+		{
+			calcAggregates(levels[iLevel]);
+			// Stop when the aggregation no longer reduces the size
+			last = (levels[iLevel].nc * 10 > levels[iLevel].n * 9 || levels[iLevel].nc == 0);
+		}
+		if (last) break;
+
+		calcProlongation(levels[iLevel]);
+		if (!reuse) levels.resize(iLevel + 2);
+		calcCoarseMatrix(levels[iLevel], levels[iLevel + 1]);
+	}
+
+	for (int iLevel = 0; iLevel < getLevels(); iLevel++)
+	{
+		AmgLevel &level = levels[iLevel];
+		level.x.resize(level.n);
+		level.b.resize(level.n);
+		level.r.resize(level.n);
+		level.d.resize(level.n);
+	}
+	factorCoarse();
+}
+
+/** ************************************************************************
+ * Check whether (n, ia, ja) is the pattern of the last setup.
+ * ************************************************************************ */
+bool Amg::samePattern(int n, int *ia, int *ja)
+{
+	if (levels.empty() || fineIA.size() != static_cast<std::size_t>(n + 1) || fineIA[n] != ia[n]) return false;
+	return std::equal(fineIA.begin(), fineIA.end(), ia) && std::equal(fineJA.begin(), fineJA.end(), ja);
+}
+
+/** ************************************************************************
+ * Inverse of the diagonal and the Gershgorin bound of the spectral radius
+ * of D^-1 A. A few steps of the power method from a smooth vector give too
+ * low an estimate, which makes the Chebyshev smoother diverge.
+ * ************************************************************************ */
+void Amg::calcDiagonal(AmgLevel &level)
+{
+	int n = level.n;
+	level.dinv.assign(n, 0.0);
+	for (int i = 0; i < n; i++)
+	{
+		for (int p = level.ia[i]; p < level.ia[i + 1]; p++)
+		{
+			if (level.ja[p] == i && fabs(level.a[p]) > 1.0E-30) level.dinv[i] = 1.0 / level.a[p];
+		}
+	}
+
+	double rho = 0.0;
+	for (int i = 0; i < n; i++)
+	{
+		double s = 0.0;
+		for (int p = level.ia[i]; p < level.ia[i + 1]; p++)
+		{
+			s += fabs(level.a[p]);
+		}
+		rho = std::max(rho, s * fabs(level.dinv[i]));
+	}
+	if (rho == 0.0) rho = 1.0;
+	level.rho = rho;
+}
+
+/** ************************************************************************
+ * Greedy aggregation on the strong couplings |a_ij| >= theta
+ * sqrt(|a_ii a_jj|). The first pass takes every row whose strong
+ * neighbours are all free as the root of a new aggregate, the second adds
+ * the rows left over to the aggregate of a strong neighbour, the third
+ * groups whatever remains with its free strong neighbours.
+ * ************************************************************************ */
+void Amg::calcAggregates(AmgLevel &level)
+{
+	int n = level.n;
+	std::vector<double> diag(n, 0.0);
+	for (int i = 0; i < n; i++)
+	{
+		if (level.dinv[i] != 0.0) diag[i] = fabs(1.0 / level.dinv[i]);
+	}
+
+	std::vector<char> strong(level.ia[n], 0);
+	for (int i = 0; i < n; i++)
+	{
+		for (int p = level.ia[i]; p < level.ia[i + 1]; p++)
+		{
+			int j = level.ja[p];
+			if (j == i) continue;
+			strong[p] = (fabs(level.a[p]) >= AMG_STRENGTH * sqrt(diag[i] * diag[j]) && level.a[p] != 0.0);
+		}
+	}
+
+	std::vector<int> &aggregate = level.aggregate;
+	aggregate.assign(n, -1);
+	int nc = 0;
+
+	for (int i = 0; i < n; i++)
+	{
+		if (aggregate[i] != -1) continue;
+		bool free = true;
+		bool hasStrong = false;
+		for (int p = level.ia[i]; p < level.ia[i + 1]; p++)
+		{
+			if (!strong[p]) continue;
+			hasStrong = true;
+			if (aggregate[level.ja[p]] != -1)
+			{
+				free = false;
+				break;
+			}
+		}
+		if (!free || !hasStrong) continue;
+		aggregate[i] = nc;
+		for (int p = level.ia[i]; p < level.ia[i + 1]; p++)
+		{
+			if (strong[p]) aggregate[level.ja[p]] = nc;
+		}
+		nc++;
+	}
+
+	std::vector<int> first(aggregate);
+	for (int i = 0; i < n; i++)
+	{
+		if (aggregate[i] != -1) continue;
+		double best = 0.0;
+		for (int p = level.ia[i]; p < level.ia[i + 1]; p++)
+		{
+			int j = level.ja[p];
+			if (strong[p] && first[j] != -1 && fabs(level.a[p]) > best)
+			{
+				best = fabs(level.a[p]);
+				aggregate[i] = first[j];
+			}
+		}
+	}
+
+	for (int i = 0; i < n; i++)
+	{
+		if (aggregate[i] != -1) continue;
+		aggregate[i] = nc;
+		for (int p = level.ia[i]; p < level.ia[i + 1]; p++)
+		{
+			if (strong[p] && aggregate[level.ja[p]] == -1) aggregate[level.ja[p]] = nc;
+		}
+		nc++;
+	}
+	level.nc = nc;
+}
+
+/** ************************************************************************
+ * Smoothed prolongation P = (I - omega D^-1 A) P_tent with omega =
+ * 4 / (3 rho), P_tent the piecewise constant interpolation from the
+ * aggregates, and the restriction R = P^T.
+ * ************************************************************************ */
+void Amg::calcProlongation(AmgLevel &level)
+{
+	int n = level.n;
+	double omega = 4.0 / (3.0 * level.rho);
+	std::vector<int> marker(level.nc, -1);
+	level.pia.assign(n + 1, 0);
+	level.pja.clear();
+	level.pa.clear();
+	for (int i = 0; i < n; i++)
+	{
+		int rowStart = level.pja.size();
+		marker[level.aggregate[i]] = rowStart;
+		level.pja.push_back(level.aggregate[i]);
+		level.pa.push_back(1.0);
+		for (int p = level.ia[i]; p < level.ia[i + 1]; p++)
+		{
+			int c = level.aggregate[level.ja[p]];
+			double v = -omega * level.dinv[i] * level.a[p];
+			if (marker[c] < rowStart)
+			{
+				marker[c] = level.pja.size();
+				level.pja.push_back(c);
+				level.pa.push_back(v);
+			}
+			else
+			{
+				level.pa[marker[c]] += v;
+			}
+		}
+		level.pia[i + 1] = level.pja.size();
+	}
+	transposeCSR(n, level.nc, level.pia, level.pja, level.pa, level.ria, level.rja, level.ra);
+}
+
+/** ************************************************************************
+ * Galerkin coarse matrix R A P of the next level.
+ * ************************************************************************ */
+void Amg::calcCoarseMatrix(AmgLevel &fine, AmgLevel &coarse)
+{
+	std::vector<int> apia, apja;
+	std::vector<double> apa;
+	multiplyCSR(fine.n, fine.ia, fine.ja, fine.a, fine.nc, fine.pia, fine.pja, fine.pa, apia, apja, apa);
+	multiplyCSR(fine.nc, fine.ria, fine.rja, fine.ra, fine.nc, apia, apja, apa, coarse.ia, coarse.ja, coarse.a);
+	coarse.n = fine.nc;
+}
+
+/** ************************************************************************
+ * Dense LU factorisation with partial pivoting of the coarsest matrix. The
+ * pressure-correction equation may be singular, a vanishing pivot is left
+ * in place and its unknown set to zero by solveCoarse.
+ * ************************************************************************ */
+void Amg::factorCoarse()
+{
+	AmgLevel &level = levels.back();
+	int n = level.n;
+	lu.assign(n * n, 0.0);
+	pivot.resize(n);
+	double scale = 0.0;
+	for (int i = 0; i < n; i++)
+	{
+		for (int p = level.ia[i]; p < level.ia[i + 1]; p++)
+		{
+			lu[i * n + level.ja[p]] += level.a[p];
+			scale = std::max(scale, fabs(level.a[p]));
+		}
+	}
+	double small = 1.0E-12 * scale;
+
+	for (int k = 0; k < n; k++)
+	{
+		int m = k;
+		for (int i = k + 1; i < n; i++)
+		{
+			if (fabs(lu[i * n + k]) > fabs(lu[m * n + k])) m = i;
+		}
+		pivot[k] = m;
+		if (m != k)
+		{
+			for (int j = 0; j < n; j++)
+			{
+				std::swap(lu[k * n + j], lu[m * n + j]);
+			}
+		}
+		double pkk = lu[k * n + k];
+		if (fabs(pkk) <= small)
+		{
+			lu[k * n + k] = 0.0;
+			continue;
+		}
+		for (int i = k + 1; i < n; i++)
+		{
+			double lik = lu[i * n + k] / pkk;
+			lu[i * n + k] = lik;
+			if (lik == 0.0) continue;
+			for (int j = k + 1; j < n; j++)
+			{
+				lu[i * n + j] -= lik * lu[k * n + j];
+			}
+		}
+	}
+}
+
+/** ************************************************************************
+ * Solve with the dense LU factors of the coarsest matrix.
+ * ************************************************************************ */
+void Amg::solveCoarse(double *b, double *x)
+{
+	int n = levels.back().n;
+	for (int i = 0; i < n; i++)
+	{
+		x[i] = b[i];
+	}
+	for (int k = 0; k < n; k++)
+	{
+		std::swap(x[k], x[pivot[k]]);
+		if (lu[k * n + k] == 0.0) continue;
+		for (int i = k + 1; i < n; i++)
+		{
+			x[i] -= lu[i * n + k] * x[k];
+		}
+	}
+	for (int i = n - 1; i >= 0; i--)
+	{
+		if (lu[i * n + i] == 0.0)
+		{
+			x[i] = 0.0;
+			continue;
+		}
+		double s = x[i];
+		for (int j = i + 1; j < n; j++)
+		{
+			s -= lu[i * n + j] * x[j];
+		}
+		x[i] = s / lu[i * n + i];
+	}
+}
+
+/** ************************************************************************
+ * r = b - A x on one level.
+ * ************************************************************************ */
+void Amg::residual(AmgLevel &level)
+{
+	int n = level.n;
+	#pragma omp parallel for if( n > 1024 )
+	for (int i = 0; i < n; i++)
+	{
+		double s = level.b[i];
+		for (int p = level.ia[i]; p < level.ia[i + 1]; p++)
+		{
+			s -= level.a[p] * level.x[level.ja[p]];
+		}
+		level.r[i] = s;
+	}
+}
+
+/** ************************************************************************
+ * Gauss-Seidel sweeps on level.x, forward before the coarse correction
+ * and backward after it so that the cycle stays symmetric.
+ * ************************************************************************ */
+void Amg::smooth(AmgLevel &level, bool forward)
+{
+	if (smoother == AMG_CHEBYSHEV)
+	{
+		smoothChebyshev(level);
+		return;
+	}
+
+	int n = level.n;
+	for (int sweep = 0; sweep < sweeps; sweep++)
+	{
+		for (int k = 0; k < n; k++)
+		{
+			int i = forward ? k : n - 1 - k;
+			double s = level.b[i];
+			double d = 0.0;
+			for (int p = level.ia[i]; p < level.ia[i + 1]; p++)
+			{
+				int j = level.ja[p];
+				if (j == i)
+				{
+					d = level.a[p];
+				}
+				else
+				{
+					s -= level.a[p] * level.x[j];
+				}
+			}
+			if (d != 0.0) level.x[i] = s / d;
+		}
+	}
+}
+
+/** ************************************************************************
+ * Chebyshev polynomial of D^-1 A of degree sweeps on level.x, damping the
+ * eigenvalues in [rho / 30, rho]. Every step is a matrix-vector product,
+ * so unlike Gauss-Seidel it runs in parallel. The interval assumes a real
+ * spectrum, as that of the symmetric pressure-correction matrix.
+ * ************************************************************************ */
+void Amg::smoothChebyshev(AmgLevel &level)
+{
+	int n = level.n;
+	double upper = 1.1 * level.rho;
+	double lower = upper / 30.0;
+	double theta = 0.5 * (upper + lower);
+	double delta = 0.5 * (upper - lower);
+	double sigma = theta / delta;
+	double rho = 1.0 / sigma;
+
+	residual(level);
+	#pragma omp parallel for if( n > 1024 )
+	for (int i = 0; i < n; i++)
+	{
+		level.d[i] = level.dinv[i] * level.r[i] / theta;
+	}
+	for (int k = 1; k < sweeps; k++)
+	{
+		#pragma omp parallel for if( n > 1024 )
+		for (int i = 0; i < n; i++)
+		{
+			level.x[i] += level.d[i];
+		}
+		residual(level);
+		double rhoNew = 1.0 / (2.0 * sigma - rho);
+		#pragma omp parallel for if( n > 1024 )
+		for (int i = 0; i < n; i++)
+		{
+			level.d[i] = rhoNew * rho * level.d[i] + 2.0 * rhoNew / delta * level.dinv[i] * level.r[i];
+		}
+		rho = rhoNew;
+	}
+	#pragma omp parallel for if( n > 1024 )
+	for (int i = 0; i < n; i++)
+	{
+		level.x[i] += level.d[i];
+	}
+}
+
+/** ************************************************************************
+ * V-cycle on level iLevel for the right-hand side in levels[iLevel].b,
+ * starting from a zero approximation.
+ * ************************************************************************ */
+void Amg::cycle(int iLevel)
+{
+	AmgLevel &level = levels[iLevel];
+	if (iLevel + 1 == getLevels())
+	{
+		solveCoarse(&level.b[0], &level.x[0]);
+		return;
+	}
+	AmgLevel &coarse = levels[iLevel + 1];
+
+	std::fill(level.x.begin(), level.x.end(), 0.0);
+	smooth(level, true);
+	residual(level);
+
+	#pragma omp parallel for if( coarse.n > 1024 )
+	for (int i = 0; i < coarse.n; i++)
+	{
+		double s = 0.0;
+		for (int p = level.ria[i]; p < level.ria[i + 1]; p++)
+		{
+			s += level.ra[p] * level.r[level.rja[p]];
+		}
+		coarse.b[i] = s;
+	}
+
+	cycle(iLevel + 1);
+
+	#pragma omp parallel for if( level.n > 1024 )
+	for (int i = 0; i < level.n; i++)
+	{
+		double s = 0.0;
+		for (int p = level.pia[i]; p < level.pia[i + 1]; p++)
+		{
+			s += level.pa[p] * coarse.x[level.pja[p]];
+		}
+		level.x[i] += s;
+	}
+	smooth(level, false);
+}
+
+/** ************************************************************************
+ * One V-cycle x = M^-1 b, as used by the preconditioner.
+ *
+ * @param b The right-hand side.
+ * @param x The result.
+ * @return N/A
+ * ************************************************************************ */
+void Amg::cycle(const double *b, double *x)
+{
+	AmgLevel &fine = levels[0];
+	std::copy(b, b + fine.n, fine.b.begin());
+	cycle(0);
+	std::copy(fine.x.begin(), fine.x.end(), x);
+}
+
+/** ************************************************************************
+ * Solve A x = b with V-cycles until the residual falls below tol times
+ * that of the initial approximation x.
+ *
+ * @param b        The right-hand side.
+ * @param x        The initial approximation and the result.
+ * @param tol      The relative tolerance.
+ * @param maxIt    The maximum number of cycles.
+ * @param residual The 2-norm of b - A x on return.
+ * @return The number of cycles used.
+ * ************************************************************************ */
+int Amg::solve(double *b, double *x, double tol, int maxIt, double &residual)
+{
+	AmgLevel &fine = levels[0];
+	int n = fine.n;
+	std::vector<double> r(n), e(n);
+	double norm0 = 0.0;
+	int it = 0;
+	for (;; it++)
+	{
+		double norm = 0.0;
+		for (int i = 0; i < n; i++)
+		{
+			double s = b[i];
+			for (int p = fine.ia[i]; p < fine.ia[i + 1]; p++)
+			{
+				s -= fine.a[p] * x[fine.ja[p]];
+			}
+			r[i] = s;
+			norm += s * s;
+		}
+		residual = sqrt(norm);
+		if (it == 0) norm0 = residual;
+		if (residual <= tol * norm0 || residual < 1.0E-300 || it == maxIt) break;
+
+		cycle(&r[0], &e[0]);
+		for (int i = 0; i < n; i++)
+		{
+			x[i] += e[i];
+		}
+	}
+	return(it);
+}
+
+/** ************************************************************************
+ * The hierarchy kept for a system on a grid, created on first use.
+ *
+ * @param system The system, one of the SYSTEM_ constants of SolveMRhs.
+ * @param grid The grid the system is assembled on, only used as a key.
+ * @return The hierarchy.
+ * ************************************************************************ */
+Amg *AmgFactory::getAmg(int system, const void *grid)
+{
+	std::pair<int, const void *> key(system, grid);
+	std::map<std::pair<int, const void *>, Amg *>::iterator iter = data.find(key);
+	if (iter != data.end()) return(iter->second);
+	Amg *amg = new Amg();
+	data[key] = amg;
+	return(amg);
+}
@@ -17,10 +17,9 @@ Poisson::Poisson(int number, int ranknumber)
 {
     N  = number;
 	L  = ranknumber;
-	A  = ArrayUtils<double>::onetensor(number);
-	IA = ArrayUtils<int>::onetensor(number);
-	JA = ArrayUtils<int>::onetensor(number);
-	coeMatrix(A,IA,JA);
+	A  = Rank.TempA;
+	IA = Rank.TempIA;
+	JA = Rank.TempJA;
 }
 
 
@@ -28,16 +27,14 @@ Poisson::Poisson(const Poisson& oldCopy)
 {
     N  = oldCopy.getN();
 	L  = oldCopy.getL();
-	A  = ArrayUtils<double>::onetensor(N);
-	IA = ArrayUtils<int>::onetensor(N);
-	JA = ArrayUtils<int>::onetensor(N);
+	A  = oldCopy.A;
+	IA = oldCopy.IA;
+	JA = oldCopy.JA;
 }
 
 Poisson::~Poisson()
 {
-	ArrayUtils<double>::delonetensor(A);
-	ArrayUtils<int>::delonetensor(IA);
-	ArrayUtils<int>::delonetensor(JA);
+	;
 }
 
 double& Poisson::operator()(int row)
@@ -50,42 +47,88 @@ double& Poisson::operator()(int row)
 */
 Solution Poisson::operator*(class Solution vector)
 {
-	
-	int i, j;
-	int a, b;
-	double data;
-	double** tmp = ArrayUtils<double>::twotensor(Rank.RANKNUMBER, Rank.COLNUMBER);
 	Solution result;
-	// the first and last row just return the same values, so 
-	// there is no need to define the results from that row.
-	
-	for( i = 1; i <= Rank.RANKNUMBER; i++)               
+	multiply(vector, result);
+	return(result);
+}
+
+/**
+ * CSR product result = A vector of every column, straight from the
+ * arrays of Rank.
+*/
+void Poisson::multiply(const Solution& vector, Solution& result)
+{
+	std::vector<const double*> x(Rank.COLNUMBER);
+	std::vector<double*> y(Rank.COLNUMBER);
+	for (int j = 0; j < Rank.COLNUMBER; j++)
+	{
+		x[j] = vector.column(j);
+		y[j] = result.column(j);
+	}
+	multiply(Rank.COLNUMBER, &x[0], &y[0]);
+}
+
+/**
+ * CSR product y[c] = A x[c] of NC vectors, the matrix is streamed once
+ * for all of them. The rows are shared out over the threads.
+*/
+template <int NC>
+static void MultiplyBlock(int L, const double* A, const int* IA, const int* JA, const double* const* x, double* const* y)
+{
+	#pragma omp parallel for if( L > 1024 )
+	for (int i = 0; i < L; i++)
 	{
-		for(j = 0; j < Rank.COLNUMBER; j++)
-	    {
-			for(int col = IA[i-1]; col < IA[i]; col++)
+		double data[NC];
+		for (int c = 0; c < NC; c++)
+		{
+			data[c] = 0.0;
+		}
+		for (int col = IA[i]; col < IA[i + 1]; col++)
+		{
+			double a = A[col];
+			int k = JA[col];
+			for (int c = 0; c < NC; c++)
 			{
-				b = JA[col];
-				data = A[col];
-				tmp[i-1][j] += data * vector(b,j);
-				result.setEntry(tmp[i-1][j],i-1,j);
-				/*cout << tmp[a-1][j] << std::endl;*/
+				data[c] += a * x[c][k];
 			}
 		}
+		for (int c = 0; c < NC; c++)
+		{
+			y[c][i] = data[c];
+		}
 	}
-	ArrayUtils<double>::deltwotensor(tmp);
-	return(result);
 }
 
-void Poisson::coeMatrix(double* deriv,int* derivrow,int* derivcol)
+/**
+ * CSR product y[c] = A x[c] of nv vectors, the matrix is streamed once
+ * for up to four of them.
+*/
+void Poisson::multiply(int nv, const double* const* x, double* const* y)
 {
-	for(int m = 0; m <= Rank.RANKNUMBER; ++m)                 
+	for (int c0 = 0; c0 < nv; c0 += 4)
 	{
-			derivrow[m] = Rank.TempIA[m];
+		int nc = nv - c0 < 4 ? nv - c0 : 4;
+		if (nc == 4) MultiplyBlock<4>(L, A, IA, JA, x + c0, y + c0);
+		else if (nc == 3) MultiplyBlock<3>(L, A, IA, JA, x + c0, y + c0);
+		else if (nc == 2) MultiplyBlock<2>(L, A, IA, JA, x + c0, y + c0);
+		else multiply(x[c0], y[c0]);
 	}
-	for (int k = 0; k < Rank.NUMBER; ++k)
+}
+
+/**
+ * CSR product y = A x of a single vector. The rows are shared out over
+ * the threads.
+*/
+void Poisson::multiply(const double* x, double* y)
+{
+	#pragma omp parallel for if( L > 1024 )
+	for (int i = 0; i < L; i++)
 	{
-		derivcol[k] = Rank.TempJA[k];
-		deriv[k] = Rank.TempA[k];
+		double data = 0.0;
+		for (int col = IA[i]; col < IA[i + 1]; col++)
+		{
+			data += A[col] * x[JA[col]];
+		}
+		y[i] = data;
 	}
 }
@@ -3,7 +3,11 @@
 #include "solution.h"
 #include "util.h"
 #include "UCom.h"
+#include "Ctrl.h"
+#include "amg.h"
 #include <cmath>
+#include <set>
+#include <algorithm>
 
 /** ************************************************************************
  * Base constructor  for the Preconditioner class. 
@@ -14,6 +18,8 @@
 Preconditioner::Preconditioner(int number)
 {
 	setN(number);
+	type = PRECOND_NONE;
+	amg = 0;
 }
 
 /** ************************************************************************
@@ -24,6 +30,8 @@ Preconditioner::Preconditioner(int number)
 Preconditioner::Preconditioner(const Preconditioner& oldCopy)
 {
 	setN(oldCopy.getN());
+	type = PRECOND_NONE;
+	amg = 0;
 }
 
 /** ************************************************************************
@@ -36,75 +44,562 @@ Preconditioner::~Preconditioner()
 }
 
 /** ************************************************************************
- * The method to solve the system of equations associated with the
- * preconditioner.
- * 
- * Returns the value Solution class that is the solution to the
- * preconditioned system.  For the moment we just assume that the
- * preconditioner is the identity matrix. (This needs to be changed!)
+ * Build the preconditioner of the matrix held in Rank.TempA, Rank.TempIA
+ * and Rank.TempJA.
  *
- * @param vector The Solution or right hand side of the system.
- * @return A Solution class member that is the solution to the
- *         preconditioned system.
+ * The rows of that matrix list the neighbours in face order and the
+ * diagonal last, so they are sorted by column first. Jacobi keeps the
+ * inverse of the diagonal only. ILU(0) keeps the pattern of the matrix,
+ * block-Jacobi does the same on the diagonal blocks of
+ * ONEFLOW::ctrl.precondblock rows each, and ILUT(p, tau) drops the entries
+ * below tau times the norm of the row and keeps the p largest of the rest
+ * in each of the L and U parts of a row. AMG applies one V-cycle of the
+ * hierarchy that AmgFactory keeps for Rank.system on Rank.grid.
+ *
+ * @param type One of the PRECOND_ constants.
+ * @return N/A
  * ************************************************************************ */
-Solution Preconditioner::solve(const Solution &current)
+void Preconditioner::setup(int type)
+{
+	this->type = type;
+	if (type == PRECOND_NONE) return;
+
+	if (type == PRECOND_AMG)
+	{
+		amg = AmgFactory::getAmg(Rank.system, Rank.grid);
+		amg->setup(N, Rank.TempIA, Rank.TempJA, Rank.TempA);
+		return;
+	}
+
+	std::vector<int> ia, ja;
+	std::vector<double> a;
+	int nBlocks = 1;
+	if (type == PRECOND_BJACOBI)
+	{
+		int blockSize = ONEFLOW::ctrl.precondblock > 0 ? ONEFLOW::ctrl.precondblock : N;
+		nBlocks = (N + blockSize - 1) / blockSize;
+	}
+	sortRows(ia, ja, a, nBlocks);
+
+	if (type == PRECOND_JACOBI)
+	{
+		dinv.resize(N);
+		for (int i = 0; i < N; i++)
+		{
+			double d = 0.0;
+			for (int p = ia[i]; p < ia[i + 1]; p++)
+			{
+				if (ja[p] == i) d = a[p];
+			}
+			dinv[i] = (fabs(d) > 1.0E-30) ? 1.0 / d : 1.0;
+		}
+		return;
+	}
+
+	if (type == PRECOND_ILUT)
+	{
+		factorILUT(ia, ja, a, ONEFLOW::ctrl.ilutfill, ONEFLOW::ctrl.ilutdrop);
+	}
+	else
+	{
+		factorILU0(ia, ja, a);
+	}
+	calcLevels();
+}
+
+/** ************************************************************************
+ * Copy the matrix of Rank into ia, ja, a with the columns of every row in
+ * increasing order. With nBlocks > 1 the entries coupling different row
+ * blocks are left out.
+ * ************************************************************************ */
+void Preconditioner::sortRows(std::vector<int> &ia, std::vector<int> &ja, std::vector<double> &a, int nBlocks)
+{
+	int blockSize = (N + nBlocks - 1) / nBlocks;
+	std::vector< std::pair<int, double> > row;
+	ia.resize(N + 1);
+	ia[0] = 0;
+	ja.reserve(Rank.TempIA[N]);
+	a.reserve(Rank.TempIA[N]);
+	for (int i = 0; i < N; i++)
+	{
+		row.clear();
+		for (int p = Rank.TempIA[i]; p < Rank.TempIA[i + 1]; p++)
+		{
+			int j = Rank.TempJA[p];
+			if (j / blockSize != i / blockSize) continue;
+			row.push_back(std::make_pair(j, Rank.TempA[p]));
+		}
+		std::sort(row.begin(), row.end());
+		for (std::size_t p = 0; p < row.size(); p++)
+		{
+			ja.push_back(row[p].first);
+			a.push_back(row[p].second);
+		}
+		ia[i + 1] = ja.size();
+	}
+}
+
+/** ************************************************************************
+ * Incomplete LU factorisation without fill, row by row (IKJ order), on the
+ * sorted matrix. The result is split into L, U and the inverse diagonal.
+ * ************************************************************************ */
+void Preconditioner::factorILU0(std::vector<int> &ia, std::vector<int> &ja, std::vector<double> &a)
 {
-	Solution multiplied(current);
-	int cId, iFace, lc, rc, offdiag, offdiag2;
-	int innerlupe;
-	int fId, fn1, n1, n2;
-	int fn2 = 0;
-	for (cId = 0; cId < getN(); cId++)
+	std::vector<int> diag(N, -1);
+	std::vector<int> iw(N, -1);
+
+	for (int i = 0; i < N; i++)
+	{
+		for (int p = ia[i]; p < ia[i + 1]; p++)
+		{
+			iw[ja[p]] = p;
+			if (ja[p] == i) diag[i] = p;
+		}
+
+		for (int p = ia[i]; p < ia[i + 1] && ja[p] < i; p++)
+		{
+			int k = ja[p];
+			if (diag[k] == -1) continue;
+			a[p] /= a[diag[k]];
+			for (int q = diag[k] + 1; q < ia[k + 1]; q++)
+			{
+				int w = iw[ja[q]];
+				if (w != -1) a[w] -= a[p] * a[q];
+			}
+		}
+
+		for (int p = ia[i]; p < ia[i + 1]; p++)
+		{
+			iw[ja[p]] = -1;
+		}
+
+		// A zero pivot would stop the factorisation, keep the row as it is
+		if (diag[i] != -1 && fabs(a[diag[i]]) < 1.0E-30) a[diag[i]] = 1.0E-30;
+	}
+
+	lIA.assign(1, 0);
+	uIA.assign(1, 0);
+	lJA.clear(); lA.clear();
+	uJA.clear(); uA.clear();
+	dinv.resize(N);
+	for (int i = 0; i < N; i++)
 	{
-		for (innerlupe = 0; innerlupe < Rank.COLNUMBER; innerlupe++)
+		dinv[i] = 1.0;
+		for (int p = ia[i]; p < ia[i + 1]; p++)
 		{
-			multiplied(cId, innerlupe) = current.getEntry(cId, innerlupe);
+			if (ja[p] < i)
+			{
+				lJA.push_back(ja[p]);
+				lA.push_back(a[p]);
+			}
+			else if (ja[p] > i)
+			{
+				uJA.push_back(ja[p]);
+				uA.push_back(a[p]);
+			}
+			else
+			{
+				dinv[i] = 1.0 / a[p];
+			}
 		}
+		lIA.push_back(lJA.size());
+		uIA.push_back(uJA.size());
 	}
+}
+
+static bool largerMagnitude(const std::pair<int, double> &x, const std::pair<int, double> &y)
+{
+	return fabs(x.second) > fabs(y.second);
+}
+
+/** ************************************************************************
+ * Threshold incomplete LU factorisation ILUT(fill, drop), row by row.
+ *
+ * Row i is expanded into a dense work row and eliminated with the U rows
+ * of the columns k < i in increasing order, fill-in included. Multipliers
+ * and entries below drop times the 2-norm of row i are dropped, then the
+ * fill largest entries of the L part and of the U part are kept. The
+ * diagonal is always kept.
+ * ************************************************************************ */
+void Preconditioner::factorILUT(std::vector<int> &ia, std::vector<int> &ja, std::vector<double> &a, int fill, double drop)
+{
+	std::vector<double> w(N, 0.0);
+	std::vector<char> used(N, 0);
+	std::vector<int> upper, touched;
+	std::vector<double> udiag(N, 1.0);
+	std::set<int> lower;
+	std::vector< std::pair<int, double> > lrow, urow;
+
+	lIA.assign(1, 0);
+	uIA.assign(1, 0);
+	lJA.clear(); lA.clear();
+	uJA.clear(); uA.clear();
+	dinv.resize(N);
 
-	for (cId = 0; cId < getN(); cId++)
+	for (int i = 0; i < N; i++)
 	{
-		for (innerlupe = 0; innerlupe < Rank.COLNUMBER; innerlupe++)
+		double norm = 0.0;
+		upper.clear();
+		touched.clear();
+		lower.clear();
+		lrow.clear();
+		urow.clear();
+
+		for (int p = ia[i]; p < ia[i + 1]; p++)
+		{
+			int j = ja[p];
+			w[j] = a[p];
+			used[j] = 1;
+			touched.push_back(j);
+			norm += a[p] * a[p];
+			if (j < i) lower.insert(j);
+			else if (j > i) upper.push_back(j);
+		}
+		if (!used[i])
 		{
-			fn1 = (*ONEFLOW::ug.c2f)[cId].size();
-			n1 = Rank.TempIA[cId];
-			for (iFace = 0; iFace < fn1; iFace++)
+			w[i] = 0.0;
+			used[i] = 1;
+			touched.push_back(i);
+		}
+		double tau = drop * sqrt(norm);
+
+		while (!lower.empty())
+		{
+			int k = *lower.begin();
+			lower.erase(lower.begin());
+
+			double lik = w[k] / udiag[k];
+			w[k] = 0.0;
+			if (fabs(lik) < tau) continue;
+			lrow.push_back(std::make_pair(k, lik));
+
+			for (int q = uIA[k]; q < uIA[k + 1]; q++)
 			{
-				//fId = (*ONEFLOW::ug.c2f)[cId][iFace];
-				//lc = (*ONEFLOW::ug.lcf)[fId];                                                                     // Face left unit
-				//rc = (*ONEFLOW::ug.rcf)[fId];                                                                     // Face right unit
-				offdiag = Rank.TempJA[n1 + iFace];
-				if (offdiag > cId && fn2 > 1.0E-16)
+				int j = uJA[q];
+				if (!used[j])
 				{
-					fn2 = (*ONEFLOW::ug.c2f)[offdiag].size();
-					n2 = Rank.TempIA[offdiag];
-					for (iFace = 0; iFace < fn2; iFace++)
-					{
-						offdiag2 = Rank.TempJA[n2 + iFace];
-						if (offdiag2 == cId)
-						{
-							multiplied(offdiag, innerlupe) += Rank.TempA[n2 + iFace] * multiplied(offdiag2, innerlupe) / Rank.TempA[n2 + fn2];
-						}
-					}
+					used[j] = 1;
+					touched.push_back(j);
+					w[j] = 0.0;
+					if (j < i) lower.insert(j);
+					else if (j > i) upper.push_back(j);
 				}
+				w[j] -= lik * uA[q];
 			}
 		}
+
+		for (std::size_t p = 0; p < upper.size(); p++)
+		{
+			int j = upper[p];
+			if (fabs(w[j]) >= tau) urow.push_back(std::make_pair(j, w[j]));
+		}
+
+		if (static_cast<std::size_t>(fill) < lrow.size())
+		{
+			std::nth_element(lrow.begin(), lrow.begin() + fill, lrow.end(), largerMagnitude);
+			lrow.resize(fill);
+		}
+		if (static_cast<std::size_t>(fill) < urow.size())
+		{
+			std::nth_element(urow.begin(), urow.begin() + fill, urow.end(), largerMagnitude);
+			urow.resize(fill);
+		}
+		std::sort(lrow.begin(), lrow.end());
+		std::sort(urow.begin(), urow.end());
+
+		double d = w[i];
+		if (fabs(d) < 1.0E-30) d = (tau > 0.0) ? tau : 1.0E-30;
+		udiag[i] = d;
+		dinv[i] = 1.0 / d;
+
+		for (std::size_t p = 0; p < lrow.size(); p++)
+		{
+			lJA.push_back(lrow[p].first);
+			lA.push_back(lrow[p].second);
+		}
+		for (std::size_t p = 0; p < urow.size(); p++)
+		{
+			uJA.push_back(urow[p].first);
+			uA.push_back(urow[p].second);
+		}
+		lIA.push_back(lJA.size());
+		uIA.push_back(uJA.size());
+
+		// Clear the work row
+		for (std::size_t p = 0; p < touched.size(); p++)
+		{
+			w[touched[p]] = 0.0;
+			used[touched[p]] = 0;
+		}
 	}
-	return(multiplied);
 }
 
+/** ************************************************************************
+ * Sort the rows into levels for the triangular solves: a row of the
+ * forward sweep sits one level above the highest of the rows it reads
+ * through L, a row of the backward sweep one level above the highest of
+ * the rows it reads through U. The rows of one level are independent.
+ * ************************************************************************ */
+static void bucketLevels(std::vector<int> &level, int nLevels, std::vector<int> &start, std::vector<int> &rows)
+{
+	int n = level.size();
+	start.assign(nLevels + 1, 0);
+	for (int i = 0; i < n; i++)
+	{
+		start[level[i] + 1]++;
+	}
+	for (int k = 0; k < nLevels; k++)
+	{
+		start[k + 1] += start[k];
+	}
+	std::vector<int> pos(start.begin(), start.end() - 1);
+	rows.resize(n);
+	for (int i = 0; i < n; i++)
+	{
+		rows[pos[level[i]]++] = i;
+	}
+}
 
-Solution Preconditioner::solve2(const Solution& current)
+void Preconditioner::calcLevels()
 {
-	Solution multiplied(current);
-	int cId;
-	int innerlupe;
-	for (cId = 0; cId < getN(); cId++)
+	std::vector<int> level(N, 0);
+	int nLevels = 0;
+	for (int i = 0; i < N; i++)
 	{
-		for (innerlupe = 0; innerlupe < Rank.COLNUMBER; innerlupe++)
+		for (int p = lIA[i]; p < lIA[i + 1]; p++)
 		{
-			multiplied(cId, innerlupe) = current.getEntry(cId, innerlupe);
+			level[i] = std::max(level[i], level[lJA[p]] + 1);
 		}
+		nLevels = std::max(nLevels, level[i] + 1);
 	}
+	bucketLevels(level, nLevels, lLevel, lRows);
+
+	nLevels = 0;
+	for (int i = N - 1; i >= 0; i--)
+	{
+		level[i] = 0;
+		for (int p = uIA[i]; p < uIA[i + 1]; p++)
+		{
+			level[i] = std::max(level[i], level[uJA[p]] + 1);
+		}
+		nLevels = std::max(nLevels, level[i] + 1);
+	}
+	bucketLevels(level, nLevels, uLevel, uRows);
+}
+
+/** ************************************************************************
+ * z = U^-1 L^-1 r, level by level. Large levels are shared out over the
+ * threads.
+ * ************************************************************************ */
+void Preconditioner::solveLU(const double *r, double *z)
+{
+	int nLevels = lLevel.size() - 1;
+	for (int k = 0; k < nLevels; k++)
+	{
+		int ist = lLevel[k];
+		int ied = lLevel[k + 1];
+		#pragma omp parallel for if( ied - ist > 1024 )
+		for (int t = ist; t < ied; t++)
+		{
+			int i = lRows[t];
+			double s = r[i];
+			for (int p = lIA[i]; p < lIA[i + 1]; p++)
+			{
+				s -= lA[p] * z[lJA[p]];
+			}
+			z[i] = s;
+		}
+	}
+
+	nLevels = uLevel.size() - 1;
+	for (int k = 0; k < nLevels; k++)
+	{
+		int ist = uLevel[k];
+		int ied = uLevel[k + 1];
+		#pragma omp parallel for if( ied - ist > 1024 )
+		for (int t = ist; t < ied; t++)
+		{
+			int i = uRows[t];
+			double s = z[i];
+			for (int p = uIA[i]; p < uIA[i + 1]; p++)
+			{
+				s -= uA[p] * z[uJA[p]];
+			}
+			z[i] = s * dinv[i];
+		}
+	}
+}
+
+/** ************************************************************************
+ * z = U^-1 L^-1 r of up to four vectors, level by level, the factors are
+ * streamed once for all of them.
+ * ************************************************************************ */
+void Preconditioner::solveLU(int nv, const double *const *r, double *const *z)
+{
+	int nLevels = lLevel.size() - 1;
+	for (int k = 0; k < nLevels; k++)
+	{
+		int ist = lLevel[k];
+		int ied = lLevel[k + 1];
+		#pragma omp parallel for if( ied - ist > 1024 )
+		for (int t = ist; t < ied; t++)
+		{
+			int i = lRows[t];
+			double s[4];
+			for (int c = 0; c < nv; c++)
+			{
+				s[c] = r[c][i];
+			}
+			for (int p = lIA[i]; p < lIA[i + 1]; p++)
+			{
+				double a = lA[p];
+				int j = lJA[p];
+				for (int c = 0; c < nv; c++)
+				{
+					s[c] -= a * z[c][j];
+				}
+			}
+			for (int c = 0; c < nv; c++)
+			{
+				z[c][i] = s[c];
+			}
+		}
+	}
+
+	nLevels = uLevel.size() - 1;
+	for (int k = 0; k < nLevels; k++)
+	{
+		int ist = uLevel[k];
+		int ied = uLevel[k + 1];
+		#pragma omp parallel for if( ied - ist > 1024 )
+		for (int t = ist; t < ied; t++)
+		{
+			int i = uRows[t];
+			double s[4];
+			for (int c = 0; c < nv; c++)
+			{
+				s[c] = z[c][i];
+			}
+			for (int p = uIA[i]; p < uIA[i + 1]; p++)
+			{
+				double a = uA[p];
+				int j = uJA[p];
+				for (int c = 0; c < nv; c++)
+				{
+					s[c] -= a * z[c][j];
+				}
+			}
+			for (int c = 0; c < nv; c++)
+			{
+				z[c][i] = s[c] * dinv[i];
+			}
+		}
+	}
+}
+
+/** ************************************************************************
+ * Apply the preconditioner to every column of r.
+ *
+ * @param r The vector to precondition.
+ * @param z The result, z = M^-1 r.
+ * @return N/A
+ * ************************************************************************ */
+void Preconditioner::apply(const Solution &r, Solution &z)
+{
+	std::vector<const double *> rc(Rank.COLNUMBER);
+	std::vector<double *> zc(Rank.COLNUMBER);
+	for (int col = 0; col < Rank.COLNUMBER; col++)
+	{
+		rc[col] = r.column(col);
+		zc[col] = z.column(col);
+	}
+	apply(Rank.COLNUMBER, &rc[0], &zc[0]);
+}
+
+/** ************************************************************************
+ * Apply the preconditioner to nv vectors. The ILU factors are streamed
+ * once for up to four of them, the other preconditioners go vector by
+ * vector.
+ *
+ * @param nv The number of vectors.
+ * @param r The vectors to precondition.
+ * @param z The results, z[c] = M^-1 r[c].
+ * @return N/A
+ * ************************************************************************ */
+void Preconditioner::apply(int nv, const double *const *r, double *const *z)
+{
+	for (int c0 = 0; c0 < nv; c0 += 4)
+	{
+		int nc = nv - c0 < 4 ? nv - c0 : 4;
+		if (nc > 1 && type != PRECOND_NONE && type != PRECOND_JACOBI && type != PRECOND_AMG)
+		{
+			solveLU(nc, r + c0, z + c0);
+			continue;
+		}
+		for (int c = c0; c < c0 + nc; c++)
+		{
+			apply(r[c], z[c]);
+		}
+	}
+}
+
+/** ************************************************************************
+ * Apply the preconditioner to a single vector.
+ *
+ * @param r The vector to precondition.
+ * @param z The result, z = M^-1 r.
+ * @return N/A
+ * ************************************************************************ */
+void Preconditioner::apply(const double *r, double *z)
+{
+	if (type == PRECOND_NONE)
+	{
+		for (int i = 0; i < N; i++)
+		{
+			z[i] = r[i];
+		}
+	}
+	else if (type == PRECOND_JACOBI)
+	{
+		for (int i = 0; i < N; i++)
+		{
+			z[i] = dinv[i] * r[i];
+		}
+	}
+	else if (type == PRECOND_AMG)
+	{
+		amg->cycle(r, z);
+	}
+	else
+	{
+		solveLU(r, z);
+	}
+}
+
+/** ************************************************************************
+ * The method to solve the system of equations associated with the
+ * preconditioner.
+ * 
+ * Returns the value Solution class that is the solution to the
+ * preconditioned system, M^-1 vector, with the preconditioner chosen in
+ * setup. Without a call to setup the preconditioner is the identity.
+ *
+ * @param vector The Solution or right hand side of the system.
+ * @return A Solution class member that is the solution to the
+ *         preconditioned system.
+ * ************************************************************************ */
+Solution Preconditioner::solve(const Solution &current)
+{
+	Solution multiplied(current.getN());
+	apply(current, multiplied);
 	return(multiplied);
 }
+
+
+/** ************************************************************************
+ * Same as solve, kept for the callers of the original interface.
+ * ************************************************************************ */
+Solution Preconditioner::solve2(const Solution& current)
+{
+	return(solve(current));
+}
@@ -15,7 +15,7 @@ Solution::Solution(int size)
 	// Set the size of the vector, allocate the space, and zero out the
 	// approximation.
 	setN(size);
-	solution = ArrayUtils<double>::twotensor(size,Rank.COLNUMBER);  // allocate the space. 
+	solution = ArrayUtils<double>::twotensor(Rank.COLNUMBER,size);  // allocate the space, column by column.
 
 }
 
@@ -31,7 +31,7 @@ Solution::Solution(const Solution& oldCopy)
 	// copy the values over.
 	int size = oldCopy.getN();
 	setN(size);
-	solution = ArrayUtils<double>::twotensor(size,Rank.COLNUMBER);
+	solution = ArrayUtils<double>::twotensor(Rank.COLNUMBER,size);
 	for(size = size-1;size>=0;size--)
 	{
 		for(int col=Rank.COLNUMBER-1;col>=0;col--)
@@ -52,29 +52,16 @@ Solution::~Solution()
 	solution = NULL;
 }
 
-/** ************************************************************************
- * The parenthesis operator for the Solution class.
- * 
- * Returns the value of the approximation for the indicated row.
- *
- * @param row The row number to use.
- * @return a double precision value, solution[row]
- * ************************************************************************ */
-double& Solution::operator()(int row,int col)
-{
-	return(solution[row][col]);
-}
-
 /** ************************************************************************
  * The equals operator for the Solution class.
  * 
- * Returns a new Solution object that is identical to the Solution
- * object passed to it.
+ * Copies the entries of the Solution object passed to it and returns a
+ * reference to this object.
  *
  * @param vector The Solution argument to copy
  * @return An object from the Solution class.
  * ************************************************************************ */
-Solution Solution::operator=(const Solution& vector)
+Solution& Solution::operator=(const Solution& vector)
 {
 	int row;
 	int col;
@@ -93,14 +80,14 @@ Solution Solution::operator=(const Solution& vector)
 /** ************************************************************************
  * The equals operator for the Solution class.
  * 
- * Returns a new Solution object in which every entry in the vector is
- * the same as the double precision number passed to it.
+ * Sets every entry in the vector to the double precision number passed
+ * to it and returns a reference to this object.
  *
  * @overload
  * @param value The value to copy into the vector.
  * @return An object from the Solution class.
  * ************************************************************************ */
-Solution Solution::operator=(const double& value)
+Solution& Solution::operator=(const double& value)
 {
 	int row;
 	int col;
@@ -131,7 +118,7 @@ Solution Solution::operator+(const Solution& vector)
 	int col;
 	
 	for(row=N-1;row>=0;row--)
-		for(col=N-1;col>=0;col--)
+		for(col=Rank.COLNUMBER-1;col>=0;col--)
 			{
 				result.setEntry(this->getEntry(row,col)+vector.getEntry(row,col),row,col);
 			}
@@ -230,7 +217,7 @@ Solution Solution::operator*=(const double& value)
 	int row;
 	int col;
 	for(row=N-1;row>=0;row--)
-		for(col=N-1;col>=0;col--)
+		for(col=Rank.COLNUMBER-1;col>=0;col--)
 			{
 				this->setEntry(this->getEntry(row,col)*value,row,col);
 			}
@@ -253,7 +240,7 @@ Solution Solution::operator-=(const Solution& vector)
 	int row;
 	int col;
 	for(row=N-1;row>=0;row--)
-		for(col=N-1;col>=0;col--)
+		for(col=Rank.COLNUMBER-1;col>=0;col--)
 			{
 				this->setEntry(this->getEntry(row,col)-vector.getEntry(row,col),row,col);
 			}
@@ -276,7 +263,7 @@ Solution Solution::operator+=(const Solution& vector)
 	int row;
 	int col;
 	for(row=N-1;row>=0;row--)
-		for(col=N-1;col>=0;col--)
+		for(col=Rank.COLNUMBER-1;col>=0;col--)
 			{
 				this->setEntry(this->getEntry(row,col)+vector.getEntry(row,col),row,col);
 			}
@@ -318,7 +305,7 @@ double Solution::dot(const Solution& v1,const Solution& v2)
 	int col;
 	//std::cout << "dot product" << std::endl;
 	for(row=N-1;row>=0;row--)
-		for(col=N-1;col>=0;col--)
+		for(col=Rank.COLNUMBER-1;col>=0;col--)
 			{
 				dotProduct += v1.getEntry(row,col)*v2.getEntry(row,col);
 			}
@@ -343,7 +330,7 @@ double Solution::dot(Solution* v1,Solution* v2)
 	int row;
 	int col;
 	for(row=N-1;row>=0;row--)
-		for(col=N-1;col>=0;col--)
+		for(col=Rank.COLNUMBER-1;col>=0;col--)
 			{
 				dotProduct += v1->getEntry(row,col)*v2->getEntry(row,col);
 			}
@@ -365,7 +352,7 @@ double Solution::norm(const Solution& v1)
 	int row;
 	int col;
 	for(row=N-1;row>=0;row--)
-		for(col=N-1;col>=0;col--)
+		for(col=Rank.COLNUMBER-1;col>=0;col--)
 			{
 				norm += v1.getEntry(row,col)*v1.getEntry(row,col);
 			}
@@ -435,7 +422,7 @@ double Solution::Multiplied(const Solution& v1,const Solution& v2)
 	int col;
 	//std::cout << "dot product" << std::endl;
 	for(row=N-1;row>=0;row--)
-		for(col=N-1;col>=0;col--)
+		for(col=Rank.COLNUMBER-1;col>=0;col--)
 			{
 				dotProduct += v1.getEntry(row,col)*v2.getEntry(row,col);
 			}
@@ -458,10 +445,126 @@ void Solution::axpy(Solution* vector,
 	int row;
 	int col;
 	for(row=N-1;row>=0;row--)
-		for(col=N-1;col>=0;col--)
+		for(col=Rank.COLNUMBER-1;col>=0;col--)
 			{
 				setEntry(getEntry(row,col)+multiplier*vector->getEntry(row,col),
 						 row,col);
 			}
 }
 
+/** ************************************************************************
+ * The dot product of a column of this object and a column of another.
+ *
+ * @param col    The column of this object.
+ * @param vector The other Solution object.
+ * @param vcol   The column of the other object.
+ * @return The dot product.
+ * ************************************************************************ */
+double Solution::dot(int col, const Solution& vector, int vcol) const
+{
+	const double* x = solution[col];
+	const double* y = vector.column(vcol);
+	double dotProduct = 0.0;
+	for(int row=0;row<N;row++)
+		{
+			dotProduct += x[row]*y[row];
+		}
+	return(dotProduct);
+}
+
+/** ************************************************************************
+ * The l2 norm of a column.
+ *
+ * @param col The column.
+ * @return The norm of the column.
+ * ************************************************************************ */
+double Solution::normColumn(int col) const
+{
+	const double* x = solution[col];
+	double norm = 0.0;
+	for(int row=0;row<N;row++)
+		{
+			norm += x[row]*x[row];
+		}
+	return(sqrt(norm));
+}
+
+/** ************************************************************************
+ * Multiply a column by a scalar in place.
+ *
+ * @param col   The column.
+ * @param value The scalar.
+ * @return N/A
+ * ************************************************************************ */
+void Solution::scale(int col, double value)
+{
+	double* x = solution[col];
+	for(int row=0;row<N;row++)
+		{
+			x[row] = x[row]*value;
+		}
+}
+
+/** ************************************************************************
+ * Add a multiple of a column of another Solution object to a column of
+ * this object in place.
+ *
+ * @param col        The column of this object.
+ * @param multiplier The scalar multiple.
+ * @param vector     The other Solution object.
+ * @param vcol       The column of the other object.
+ * @return N/A
+ * ************************************************************************ */
+void Solution::axpy(int col, double multiplier, const Solution& vector, int vcol)
+{
+	double* x = solution[col];
+	const double* y = vector.column(vcol);
+	for(int row=0;row<N;row++)
+		{
+			x[row] += multiplier*y[row];
+		}
+}
+
+/** ************************************************************************
+ * Replace a column by a column of another object minus itself, and find
+ * the squared norm of the result in the same pass.
+ *
+ * @param col    The column of this object.
+ * @param vector The other Solution object.
+ * @param vcol   The column of the other object.
+ * @return The squared l2 norm of the new column.
+ * ************************************************************************ */
+double Solution::subtractFrom(int col, const Solution& vector, int vcol)
+{
+	double* x = solution[col];
+	const double* y = vector.column(vcol);
+	double normSquare = 0.0;
+	for(int row=0;row<N;row++)
+		{
+			x[row] = y[row]-x[row];
+			normSquare += x[row]*x[row];
+		}
+	return(normSquare);
+}
+
+/** ************************************************************************
+ * Set this object to the difference of two Solution objects, without
+ * the temporary of operator-.
+ *
+ * @param v1 The Solution object to subtract from.
+ * @param v2 The Solution object to subtract.
+ * @return N/A
+ * ************************************************************************ */
+void Solution::difference(const Solution& v1, const Solution& v2)
+{
+	for(int col=0;col<Rank.COLNUMBER;col++)
+		{
+			double* x = solution[col];
+			const double* y1 = v1.column(col);
+			const double* y2 = v2.column(col);
+			for(int row=0;row<N;row++)
+				{
+					x[row] = y1[row]-y2[row];
+				}
+		}
+}
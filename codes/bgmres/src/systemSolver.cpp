@@ -9,17 +9,37 @@
 #include <stdlib.h>
 #include "systemSolver.h"
 #include "UCom.h"
+#include "Ctrl.h"
+#include "amg.h"
 #include <UINsInvterm.h>
 
 SolveMRhs bgx;
 SolveMRhs::SolveMRhs()
 {
-	;
+	system = SYSTEM_MOMENTUM;
+	grid = 0;
+	TempA = 0;
+	TempIA = 0;
+	TempJA = 0;
+	TempB = 0;
+	TempX = 0;
+	nRowAlloc = 0;
+	nnzAlloc = 0;
+	nColAlloc = 0;
+	ownPattern = true;
+	A = 0;
+	pre = 0;
 }
 
 SolveMRhs::~SolveMRhs()
 {
-	;
+	std::map<int, GMRESWorkspace<Solution, double>*>::iterator iter;
+	for (iter = spaces.begin(); iter != spaces.end(); ++iter)
+	{
+		delete iter->second;
+	}
+	delete A;
+	delete pre;
 }
 
 SolveMRhs Rank;
@@ -30,65 +50,138 @@ void SolveMRhs::Init()
 	TempJA = ArrayUtils<int>::onetensor(Rank.NUMBER);
 	TempB = ArrayUtils<double>::twotensor(Rank.RANKNUMBER,Rank.COLNUMBER);
 	TempX = ArrayUtils<double>::twotensor(Rank.RANKNUMBER,Rank.COLNUMBER);
+	nRowAlloc = Rank.RANKNUMBER;
+	nnzAlloc = Rank.NUMBER;
+	nColAlloc = Rank.COLNUMBER;
+	ownPattern = true;
+}
+
+/** ************************************************************************
+ * Set up the system on a sparsity pattern kept by the caller, the rows
+ * ia and columns ja are used in place. The values, right-hand sides and
+ * solutions are kept from the previous call and only reallocated when
+ * the number of rows or entries changes or there are more right-hand
+ * sides than allocated, so a caller that solves on the same grid again
+ * only writes TempA and TempB.
+ *
+ * @param ia The row pointers, Rank.RANKNUMBER + 1 of them.
+ * @param ja The column numbers, Rank.NUMBER of them.
+ * @return N/A
+ * ************************************************************************ */
+void SolveMRhs::Init(int* ia, int* ja)
+{
+	bool fits = TempA && !ownPattern && nRowAlloc == Rank.RANKNUMBER &&
+		nnzAlloc == Rank.NUMBER && nColAlloc >= Rank.COLNUMBER;
+	if (!fits)
+	{
+		Deallocate();
+		TempA = ArrayUtils<double>::onetensor(Rank.NUMBER);
+		TempB = ArrayUtils<double>::twotensor(Rank.RANKNUMBER, Rank.COLNUMBER);
+		TempX = ArrayUtils<double>::twotensor(Rank.RANKNUMBER, Rank.COLNUMBER);
+		nRowAlloc = Rank.RANKNUMBER;
+		nnzAlloc = Rank.NUMBER;
+		nColAlloc = Rank.COLNUMBER;
+		ownPattern = false;
+	}
+	TempIA = ia;
+	TempJA = ja;
 }
 void SolveMRhs::Deallocate()
 {
 	ArrayUtils<double>::delonetensor(TempA);
-	ArrayUtils<int>::delonetensor(TempIA);
-	ArrayUtils<int>::delonetensor(TempJA);
+	if (ownPattern)
+	{
+		ArrayUtils<int>::delonetensor(TempIA);
+		ArrayUtils<int>::delonetensor(TempJA);
+	}
 	ArrayUtils<double>::deltwotensor(TempB);
 	ArrayUtils<double>::deltwotensor(TempX);
+	TempA = 0;
+	TempIA = 0;
+	TempJA = 0;
+	TempB = 0;
+	TempX = 0;
+	nRowAlloc = 0;
+	nnzAlloc = 0;
+	nColAlloc = 0;
+	ownPattern = true;
 }
 void SolveMRhs::BGMRES()
 {
+	int precond = ONEFLOW::ctrl.iprecond;
+	if (Rank.system == SYSTEM_PRESSURE)
+	{
+		if (ONEFLOW::ctrl.ipsolver == PSOLVER_AMG)
+		{
+			AMG();
+			return;
+		}
+		if (ONEFLOW::ctrl.ipsolver == PSOLVER_BGMRES_AMG) precond = PRECOND_AMG;
+	}
+
 	clock_t start, finish;
 	double time;
 	start = clock();
-	Poisson* A = new Poisson;   // The operator to invert.
-	Solution* x = new Solution(Rank.RANKNUMBER);  // The approximation to calculate.
-	Solution* b = new Solution(Rank.RANKNUMBER);  // The forcing function for the r.h.s.
-	Solution* residual = new Solution(Rank.RANKNUMBER);
-	Preconditioner* pre =
-		new Preconditioner(Rank.RANKNUMBER);      // The preconditioner for the system.
 	int restart = 0;                    // Number of restarts to allow
 	int maxIt = 500;                      // Dimension of the Krylov subspace
 	double tol = 1.0E-8;                 // How close to make the approximation.
 
+	// The operator and the preconditioner are only created on the first
+	// solve, and there is one workspace for every number of right-hand
+	// sides, resized when the system does not fit. The operator works on
+	// the arrays of Rank in place.
+	if (!A)
+	{
+		A = new Poisson;
+		pre = new Preconditioner(Rank.RANKNUMBER);
+	}
+	GMRESWorkspace<Solution, double>*& space = spaces[Rank.COLNUMBER];
+	if (!space) space = new GMRESWorkspace<Solution, double>();
+	space->resize(Rank.RANKNUMBER, Rank.COLNUMBER, maxIt);
+	A->N = Rank.NUMBER;
+	A->L = Rank.RANKNUMBER;
+	A->A = Rank.TempA;
+	A->IA = Rank.TempIA;
+	A->JA = Rank.TempJA;
+	pre->setN(Rank.RANKNUMBER);
+	pre->setup(precond);
+	Solution* x = space->x;                // The approximation to calculate.
+	Solution* b = space->b;                // The forcing function for the r.h.s.
+	Solution* residual = space->residual;
+
 	/**
 	   produce the right-hand sides
 	*/
 	int i, j;
-	for (i = 0; i < Rank.RANKNUMBER; i++)
+	for (j = 0; j < Rank.COLNUMBER; j++)
 	{
-		for (j = 0; j < Rank.COLNUMBER; j++)
+		double* bc = b->column(j);
+		double* xc = x->column(j);
+		for (i = 0; i < Rank.RANKNUMBER; i++)
 		{
-			{
-				(*b)(i, j) = Rank.TempB[i][j];
-			}
+			bc[i] = Rank.TempB[i][j];
+			xc[i] = 0.0;
 		}
 	}
 	// Find an approximation to the system!
-	int result = GMRES(A, x, b, residual, pre, maxIt, restart, tol);
+	int result = GMRES(A, x, b, residual, pre, maxIt, restart, tol, space);
 
 	// Output the solution
+	Rank.residuals.resize(Rank.COLNUMBER);
 	for (int lupe = 0; lupe < Rank.COLNUMBER; lupe++)
 	{
+		const double* xc = x->column(lupe);
 		for (int innerlupe = 0; innerlupe < Rank.RANKNUMBER; innerlupe++)
 		{
-			Rank.TempX[innerlupe][lupe] = (*x)(innerlupe, lupe);
+			Rank.TempX[innerlupe][lupe] = xc[innerlupe];
 		}
+		Rank.residuals[lupe] = residual->normColumn(lupe);
 	}
 
 	//std::cout << "Iterations: " << result << " residual: " << tol << std::endl;
 	finish = clock();
 	time = (double)(finish - start);    //Calculate run time
 
-	delete A;
-	delete x;
-	delete b;
-	delete residual;
-	delete pre;
-
 
 #define SOLUTION
 #ifdef SOLUTION
@@ -108,3 +201,36 @@ void SolveMRhs::BGMRES()
 	
 #endif
 }
+
+/** ************************************************************************
+ * Solve the system of Rank with V-cycles of the aggregation multigrid
+ * alone, column by column from a zero approximation, to the same relative
+ * tolerance as BGMRES. Rank.residuals holds the 2-norm of b - A x of every
+ * column and Rank.residual that of the last one.
+ * ************************************************************************ */
+void SolveMRhs::AMG()
+{
+	int maxIt = 100;
+	double tol = 1.0E-8;
+	int n = Rank.RANKNUMBER;
+
+	Amg *amg = AmgFactory::getAmg(Rank.system, Rank.grid);
+	amg->setup(n, Rank.TempIA, Rank.TempJA, Rank.TempA);
+
+	std::vector<double> b(n), x(n);
+	Rank.residuals.resize(Rank.COLNUMBER);
+	for (int col = 0; col < Rank.COLNUMBER; col++)
+	{
+		for (int i = 0; i < n; i++)
+		{
+			b[i] = Rank.TempB[i][col];
+			x[i] = 0.0;
+		}
+		amg->solve(&b[0], &x[0], tol, maxIt, Rank.residual);
+		Rank.residuals[col] = Rank.residual;
+		for (int i = 0; i < n; i++)
+		{
+			Rank.TempX[i][col] = x[i];
+		}
+	}
+}
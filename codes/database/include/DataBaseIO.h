@@ -109,6 +109,18 @@ void HXWrite( DataBook * dataBook, std::vector< std::vector< T > > & field2D );
 template < typename T >
 void HXWrite( DataBook * dataBook, HXVector< HXVector< T > > & field2D );
 
+template < typename TIO, typename T, MarrayLayout L >
+void HXRead( TIO * tio, MarrayRow< T, L > field );
+
+template < typename TIO, typename T, MarrayLayout L >
+void HXWrite( TIO * tio, MarrayRow< T, L > field );
+
+template < typename T, MarrayLayout L >
+void HXRead( std::fstream * file, MarrayRow< T, L > field );
+
+template < typename T, MarrayLayout L >
+void HXWrite( std::fstream * file, MarrayRow< T, L > field );
+
 template < typename T >
 void HXAppend( DataBook * dataBook, T & value );
 
@@ -326,6 +338,66 @@ void HXWrite( DataBook * dataBook, HXVector< HXVector< T > > & field2D )
     HXWriteVector2D( dataBook, field2D );
 }
 
+template < typename TIO, typename T, MarrayLayout L >
+void HXRead( TIO * tio, MarrayRow< T, L > field )
+{
+    if ( field.Stride() == 1 )
+    {
+        HXRead( tio, field.data(), static_cast< int >( field.size() ) );
+        return;
+    }
+
+    for ( HXSize_t iElem = 0; iElem < field.size(); ++ iElem )
+    {
+        HXRead( tio, field[ iElem ] );
+    }
+}
+
+template < typename TIO, typename T, MarrayLayout L >
+void HXWrite( TIO * tio, MarrayRow< T, L > field )
+{
+    if ( field.Stride() == 1 )
+    {
+        HXWrite( tio, field.data(), static_cast< int >( field.size() ) );
+        return;
+    }
+
+    for ( HXSize_t iElem = 0; iElem < field.size(); ++ iElem )
+    {
+        HXWrite( tio, field[ iElem ] );
+    }
+}
+
+template < typename T, MarrayLayout L >
+void HXRead( std::fstream * file, MarrayRow< T, L > field )
+{
+    if ( field.Stride() == 1 )
+    {
+        HXRead( file, field.data(), static_cast< int >( field.size() ) );
+        return;
+    }
+
+    for ( HXSize_t iElem = 0; iElem < field.size(); ++ iElem )
+    {
+        HXRead( file, field[ iElem ] );
+    }
+}
+
+template < typename T, MarrayLayout L >
+void HXWrite( std::fstream * file, MarrayRow< T, L > field )
+{
+    if ( field.Stride() == 1 )
+    {
+        HXWrite( file, field.data(), static_cast< int >( field.size() ) );
+        return;
+    }
+
+    for ( HXSize_t iElem = 0; iElem < field.size(); ++ iElem )
+    {
+        HXWrite( file, field[ iElem ] );
+    }
+}
+
 template < typename T >
 void HXAppend( DataBook * dataBook, T & value )
 {
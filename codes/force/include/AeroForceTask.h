@@ -22,6 +22,8 @@ License
 
 #pragma once
 #include "Task.h"
+#include "Force.h"
+#include "MonitorReduce.h"
 
 BeginNameSpace( ONEFLOW )
 
@@ -34,11 +36,26 @@ public:
     void Run() override;
     void Init();
     void CalcForce();
-    void Dump();
 public:
     std::string fileName;
 };
 
+//Forces of one iteration, written when their global sums arrive
+class AeroForceReport : public MonitorClient
+{
+public:
+    AeroForceReport();
+    ~AeroForceReport() override;
+public:
+    std::string fileName;
+    int outerSteps, innerSteps;
+    Real currTime;
+    AeroForceInfo info;
+public:
+    void Finish( Real * sum ) override;
+    void Dump();
+};
+
 class UnsGrid;
 void CalcAeroForce( int idump_pres );
 int GetNSolidCell( UnsGrid * grid );
@@ -95,9 +95,9 @@ public:
     ~AeroForceInfo();
 public:
     void Init();
-    void CollectForce();
-    void Sum( Force * force );
-    void Sum( Real * var );
+    //The forces summed over the processors: total, mom and pres as x, y, z, then power
+    void Pack( RealField & values );
+    void Unpack( Real * values );
     void CalcCoef();
 public:
     AeroForce totalForce;
@@ -79,8 +79,16 @@ void AerodynamicForceTask::Run()
         this->CalcForce();
     }
 
-    aeroForceInfo.CollectForce();
-    this->Dump();
+    AeroForceReport * report = new AeroForceReport();
+    report->fileName = this->fileName;
+    report->outerSteps = Iteration::outerSteps;
+    report->innerSteps = Iteration::innerSteps;
+    report->currTime = ctrl.currTime;
+    report->info = aeroForceInfo;
+
+    RealField local;
+    aeroForceInfo.Pack( local );
+    MonitorReduce::Add( report, & local[ 0 ], local.size() );
 }
 
 void AerodynamicForceTask::Init()
@@ -90,12 +98,28 @@ void AerodynamicForceTask::Init()
     this->fileName = GetDataValue< std::string >( "aeroFile" );
 }
 
-void AerodynamicForceTask::Dump()
+AeroForceReport::AeroForceReport()
 {
+    ;
+}
+
+AeroForceReport::~AeroForceReport()
+{
+    ;
+}
+
+void AeroForceReport::Finish( Real * sum )
+{
+    this->info.Unpack( sum );
+
     if ( Parallel::pid != Parallel::serverid ) return;
 
-    aeroForceInfo.CalcCoef();
+    this->info.CalcCoef();
+    this->Dump();
+}
 
+void AeroForceReport::Dump()
+{
     std::ostringstream oss;
 
     int wordWidth = 16;
@@ -132,22 +156,22 @@ void AerodynamicForceTask::Dump()
         }
     }
 
-    oss << Iteration::outerSteps << "    ";
-    oss << Iteration::innerSteps << "    ";
-    oss << std::setprecision( 6 ) << ctrl.currTime << "    ";
+    oss << this->outerSteps << "    ";
+    oss << this->innerSteps << "    ";
+    oss << std::setprecision( 6 ) << this->currTime << "    ";
     oss << std::setprecision( 4 );
-    oss << aeroForceInfo.cl << "    ";
-    oss << aeroForceInfo.cd << "    ";
-    oss << aeroForceInfo.cd_pres << "    ";
-    oss << aeroForceInfo.cd_vis << "    ";
-    oss << aeroForceInfo.cdl << "    ";
-    oss << aeroForceInfo.pres_center << "    ";
-    oss << aeroForceInfo.cf.x << "    ";
-    oss << aeroForceInfo.cf.y << "    ";
-    oss << aeroForceInfo.cf.z << "    ";
-    oss << aeroForceInfo.cmom.x << "    ";
-    oss << aeroForceInfo.cmom.y << "    ";
-    oss << aeroForceInfo.cmom.z << "    ";
+    oss << this->info.cl << "    ";
+    oss << this->info.cd << "    ";
+    oss << this->info.cd_pres << "    ";
+    oss << this->info.cd_vis << "    ";
+    oss << this->info.cdl << "    ";
+    oss << this->info.pres_center << "    ";
+    oss << this->info.cf.x << "    ";
+    oss << this->info.cf.y << "    ";
+    oss << this->info.cf.z << "    ";
+    oss << this->info.cmom.x << "    ";
+    oss << this->info.cmom.y << "    ";
+    oss << this->info.cmom.z << "    ";
     oss << std::endl;
 
     file << oss.str();
@@ -222,15 +246,15 @@ void CalcAeroForce(int idump_pres)
 	int startStrategy = ONEFLOW::GetDataValue< int >("startStrategy");
 	if ( startStrategy == 2 )
 	{
-		RealField & dpdx = (*bcdqdx)[IIDX::IIP];
-		RealField & dpdy = (*bcdqdy)[IIDX::IIP];
-		RealField & dpdz = (*bcdqdz)[IIDX::IIP];
+		MRFieldRow dpdx = (*bcdqdx)[IIDX::IIP];
+		MRFieldRow dpdy = (*bcdqdy)[IIDX::IIP];
+		MRFieldRow dpdz = (*bcdqdz)[IIDX::IIP];
 	}
 	else
 	{
-		RealField & dpdx = (*bcdqdx)[IDX::IP];
-		RealField & dpdy = (*bcdqdy)[IDX::IP];
-		RealField & dpdz = (*bcdqdz)[IDX::IP];
+		MRFieldRow dpdx = (*bcdqdx)[IDX::IP];
+		MRFieldRow dpdy = (*bcdqdy)[IDX::IP];
+		MRFieldRow dpdz = (*bcdqdz)[IDX::IP];
 	}
 
 	stress.rey = GetDataValue< Real >("reynolds");
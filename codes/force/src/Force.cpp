@@ -223,32 +223,33 @@ void AeroForceInfo::Init()
     totalForce.Init();
 }
 
-void AeroForceInfo::CollectForce()
+void AeroForceInfo::Pack( RealField & values )
 {
-    this->Sum( & totalForce.total );
-    this->Sum( & totalForce.mom );
-    this->Sum( & totalForce.pres );
-    this->Sum( & totalForce.power );
+    values.resize( 10 );
+    values[ 0 ] = totalForce.total.x;
+    values[ 1 ] = totalForce.total.y;
+    values[ 2 ] = totalForce.total.z;
+    values[ 3 ] = totalForce.mom.x;
+    values[ 4 ] = totalForce.mom.y;
+    values[ 5 ] = totalForce.mom.z;
+    values[ 6 ] = totalForce.pres.x;
+    values[ 7 ] = totalForce.pres.y;
+    values[ 8 ] = totalForce.pres.z;
+    values[ 9 ] = totalForce.power;
 }
 
-void AeroForceInfo::Sum( Force * force )
+void AeroForceInfo::Unpack( Real * values )
 {
-    Force tf = 0.0;
-
-    HXReduceReal( & force->x, & tf.x, 1, PL_SUM );
-    HXReduceReal( & force->y, & tf.y, 1, PL_SUM );
-    HXReduceReal( & force->z, & tf.z, 1, PL_SUM );
-
-    * force = tf;
-}
-
-void AeroForceInfo::Sum( Real * var )
-{
-    Real sumVar = 0.0;
-
-    HXReduceReal( var, & sumVar, 1, PL_SUM );
-
-    * var = sumVar;
+    totalForce.total.x = values[ 0 ];
+    totalForce.total.y = values[ 1 ];
+    totalForce.total.z = values[ 2 ];
+    totalForce.mom.x   = values[ 3 ];
+    totalForce.mom.y   = values[ 4 ];
+    totalForce.mom.z   = values[ 5 ];
+    totalForce.pres.x  = values[ 6 ];
+    totalForce.pres.y  = values[ 7 ];
+    totalForce.pres.z  = values[ 8 ];
+    totalForce.power   = values[ 9 ];
 }
 
 void AeroForceInfo::CalcCoef()
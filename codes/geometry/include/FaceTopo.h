@@ -57,6 +57,10 @@ public:
 public:
     LinkField facesNew;
     IntField lCellsNew, rCellsNew;
+public:
+    //haloFlag marks the cells that read interface ghost data, directly or through a gradient
+    IntField haloFlag;
+    IntField innerFaces, haloFaces;
 public:
     HXSize_t GetNFaces() { return fTypes.size();  }
     HXSize_t CalcTotalFaceNodes();
@@ -75,6 +79,7 @@ public:
     bool GetSId( int iFace, int iPosition, int & sId );
     bool GetTId( int iFace, int iPosition, int & tId );
     void CalcC2C( LinkField & c2c );
+    void CalcHaloPartition();
 };
 
 EndNameSpace
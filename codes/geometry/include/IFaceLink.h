@@ -74,6 +74,7 @@ public:
 };
 
 void GetFaceCoorList( IntField & faceNode, RealField & xList, RealField & yList, RealField & zList, NodeMesh * nodeMesh );
+//Numbers the first nPoint points of the lists, which are left as they are, pointId is resized to nPoint
 void GetCoorIdList( IFaceLink * iFaceLink, RealField & xList, RealField & yList, RealField & zList, int nPoint, IntField & pointId );
 
 EndNameSpace
@@ -24,6 +24,7 @@ License
 #pragma once
 #include "HXDefine.h"
 #include "AdtTree.h"
+#include "KdTree.h"
 #include "GridDef.h"
 
 BeginNameSpace( ONEFLOW )
@@ -32,6 +33,7 @@ class Grid;
 
 typedef HXAdtTree< int, Real > AdtTree;
 typedef HXAdtNode< int, Real > AdtNode;
+typedef HXKdTree< int, Real > KdTree;
 
 class PointSearch
 {
@@ -41,6 +43,11 @@ public:
 protected:
     int id;
     AdtTree * coorTree;
+    //The points up to the last batch in kd-trees of decreasing size, tree i holds the ids from
+    //treeStart[ i ] to the start of the next tree or nTreePoint, coorTree the points added one by one since
+    HXVector< KdTree * > kdTrees;
+    IntField treeStart;
+    int nTreePoint;
     Real tolerance;
     RealField xCoor, yCoor, zCoor;
 public:
@@ -52,11 +59,15 @@ public:
     int GetNPoint() { return static_cast<int> (xCoor.size()); }
     int FindPoint( Real xm, Real ym, Real zm );
     int AddPoint( Real xm, Real ym, Real zm );
+    //Same ids as AddPoint called for each of the first nPoint points in turn, pointId is resized to nPoint
+    void AddPoints( int nPoint, RealField & xList, RealField & yList, RealField & zList, IntField & pointId );
     void GetPoint( int id, Real & xm, Real & ym, Real & zm );
     Real GetTol() { return tolerance; }
 protected:
     int AddPoint( RealField & coordinate );
     int FindPoint( RealField & coordinate );
+    void FindPointsInRegion( Real * pmin, Real * pmax, IntField & idList );
+    void AddTree();
 public:
     void GetFaceCoorList( IntField & nodeId, RealField &xList, RealField &yList, RealField &zList );
 };
@@ -45,6 +45,12 @@ public:
     FaceTopo * faceTopo;
     FaceMesh * faceMesh;
     CellMesh * cellMesh;
+public:
+    //Agglomeration maps to the grid of the next multigrid level.
+    //f2cCell holds the coarse cell of every cell, ghost cells included, f2cFace the coarse face
+    //of every face, or -1 for a face inside a coarse cell.
+    IntField f2cCell;
+    IntField f2cFace;
 public:
     void Decode( DataBook * databook ) override;
     void Encode( DataBook * databook ) override;
@@ -29,8 +29,11 @@ BeginNameSpace( ONEFLOW )
 
 DEFINE_DATA_CLASS( FillWallStructTask  );
 DEFINE_DATA_CLASS( FillWallStruct  );
+DEFINE_DATA_CLASS( CalcWallDistTask );
 DEFINE_DATA_CLASS( CalcWallDist );
 
+//Every processor keeps the wall faces of its own zones only,
+//the wall boxes of all the processors are known everywhere
 class CFillWallStructTaskImp : public Task
 {
 public:
@@ -39,7 +42,19 @@ public:
 public:
     void Run() override;
     void Create();
-    void FillWall();
+    void GatherWallBox();
+};
+
+//Searches the local wall faces of every zone first, then asks the processors
+//whose wall box is closer than the distance found so far
+class CCalcWallDistTaskImp : public Task
+{
+public:
+    CCalcWallDistTaskImp();
+    ~CCalcWallDistTaskImp() override;
+public:
+    void Run() override;
+    void SearchRemoteWall();
 };
 
 class WallStructure
@@ -51,10 +66,40 @@ public:
 public:
     PointField fc;
     PointLink  fv;
+    //Wall box ( xmin, ymin, zmin, xmax, ymax, zmax ) of every processor
+    RealField pbox;
+};
+
+//Bounding volume hierarchy over the wall faces of a WallStructure.
+//Node iNode covers the faces face[ first[ iNode ] ... first[ iNode ] + count[ iNode ] - 1 ];
+//an inner node has the children left[ iNode ] and left[ iNode ] + 1, a leaf has left[ iNode ] = -1.
+class WallFaceTree
+{
+public:
+    WallFaceTree();
+    ~WallFaceTree();
+public:
+    static int leafSize;
+public:
+    WallStructure * wall;
+    RealField xmin, ymin, zmin;
+    RealField xmax, ymax, zmax;
+    IntField left;
+    IntField first, count;
+    IntField face;
+public:
+    void Build( WallStructure * wall );
+    //Lowers dist2 and sets iWFace if a wall face is closer than sqrt( dist2 ) to node,
+    //stack is the work array of the calling thread
+    void Search( WallStructure::PointType & node, Real & dist2, int & iWFace, IntField & stack );
+protected:
+    void Split( int iNode, RealField & xc, RealField & yc, RealField & zc, RealField & box );
+    Real CalcBoxDist2( int iNode, WallStructure::PointType & node );
 };
 
 void SetWallTask();
 void FreeWallStruct();
 Real CalcPoint2FaceDist( WallStructure::PointType node, WallStructure::PointField & fvList );
+Real CalcPoint2BoxDist( WallStructure::PointType & node, Real * box );
 
 EndNameSpace
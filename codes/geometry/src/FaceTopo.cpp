@@ -395,4 +395,56 @@ void FaceTopo::CalcC2C( LinkField & c2c )
     }
 }
 
+void FaceTopo::CalcHaloPartition()
+{
+    if ( this->haloFlag.size() != 0 ) return;
+
+    int nCells = this->grid->nCells;
+    int nBFaces = this->GetNBFaces();
+    int nFaces = this->GetNFaces();
+
+    this->haloFlag.resize( nCells + nBFaces, 0 );
+
+    // Interface ghost cells and the cells next to them
+    for ( int iFace = 0; iFace < nBFaces; ++ iFace )
+    {
+        int bcType = this->bcManager->bcRecord->bcType[ iFace ];
+        if ( BC::IsInterfaceBc( bcType ) || bcType == BC::PERIODIC )
+        {
+            int lc  = this->lCells[ iFace ];
+            int rc  = this->rCells[ iFace ];
+            this->haloFlag[ lc ] = 1;
+            this->haloFlag[ rc ] = 1;
+        }
+    }
+
+    // Boundary ghost cells copy the gradient of their owner cell
+    for ( int iFace = 0; iFace < nBFaces; ++ iFace )
+    {
+        int lc  = this->lCells[ iFace ];
+        int rc  = this->rCells[ iFace ];
+        if ( this->haloFlag[ lc ] == 1 )
+        {
+            this->haloFlag[ rc ] = 1;
+        }
+    }
+
+    this->innerFaces.resize( 0 );
+    this->haloFaces.resize( 0 );
+
+    for ( int iFace = 0; iFace < nFaces; ++ iFace )
+    {
+        int lc  = this->lCells[ iFace ];
+        int rc  = this->rCells[ iFace ];
+        if ( this->haloFlag[ lc ] == 1 || this->haloFlag[ rc ] == 1 )
+        {
+            this->haloFaces.push_back( iFace );
+        }
+        else
+        {
+            this->innerFaces.push_back( iFace );
+        }
+    }
+}
+
 EndNameSpace
@@ -238,14 +238,7 @@ void GetFaceCoorList( IntField & faceNode, RealField & xList, RealField & yList,
 
 void GetCoorIdList( IFaceLink * iFaceLink, RealField & xList, RealField & yList, RealField & zList, int nPoint, IntField & pointId )
 {
-    for ( int iNode = 0; iNode < nPoint; ++ iNode )
-    {
-        Real xm = xList[ iNode ];
-        Real ym = yList[ iNode ];
-        Real zm = zList[ iNode ];
-
-        pointId[ iNode ] = iFaceLink->point_search->AddPoint( xm, ym, zm );
-    }
+    iFaceLink->point_search->AddPoints( nPoint, xList, yList, zList, pointId );
 }
 
 EndNameSpace
@@ -29,6 +29,8 @@ License
 #include "ZoneState.h"
 #include "DataStorage.h"
 #include "Parallel.h"
+#include "InterfaceExchange.h"
+#include "InterHalo.h"
 #include "SolverDef.h"
 #include "LogFile.h"
 #include <algorithm>
@@ -259,6 +261,10 @@ void InterFaceTopo::InitInterfaceTopo()
     {
         this->InitInterfaceTopoTest();
     }
+
+    //The exchange schedule and the halo plans are derived from the topology and must be rebuilt
+    interfaceExchange.Reset();
+    HaloFactory::Reset();
 }
 
 void InterFaceTopo::InitInterfaceTopoImp()
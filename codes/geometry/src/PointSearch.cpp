@@ -33,11 +33,16 @@ BeginNameSpace( ONEFLOW )
 PointSearch::PointSearch()
 {
     this->coorTree = 0;
+    this->nTreePoint = 0;
 }
 
 PointSearch::~PointSearch()
 {
     delete this->coorTree;
+    for ( HXSize_t iTree = 0; iTree < this->kdTrees.size(); ++ iTree )
+    {
+        delete this->kdTrees[ iTree ];
+    }
 }
 
 void PointSearch::Initialize( RealField & pmin, RealField & pmax, Real toleranceIn )
@@ -75,10 +80,10 @@ int PointSearch::AddPoint( RealField & coor )
     maxWindow[ 1 ] = coor[ 1 ] + tolerance;
     maxWindow[ 2 ] = coor[ 2 ] + tolerance;
 
-    AdtTree::AdtNodeList nodeList;
-    this->coorTree->FindNodesInRegion( minWindow, maxWindow, nodeList );
+    IntField idList;
+    this->FindPointsInRegion( minWindow, maxWindow, idList );
 
-    if ( nodeList.size() == 0 )
+    if ( idList.size() == 0 )
     {
         int count = this->xCoor.size();
         AdtNode * node = new AdtNode( 3, & coor[ 0 ], count );
@@ -93,19 +98,162 @@ int PointSearch::AddPoint( RealField & coor )
     }
     else
     {
-        if ( nodeList.size() > 1 )
+        if ( idList.size() > 1 )
         {
-            std::cout << "FATAL ERROR : nodeList.size() = " << nodeList.size() << std::endl;
+            std::cout << "FATAL ERROR : nodeList.size() = " << idList.size() << std::endl;
             Stop("");
         }
-        AdtNode * node =  nodeList[ 0 ];
 
-        this->id = node->GetData();
+        this->id = idList[ 0 ];
 
         return this->id;
     }
 }
 
+void PointSearch::AddPoints( int nPoint, RealField & xList, RealField & yList, RealField & zList, IntField & pointId )
+{
+    pointId.resize( nPoint );
+
+    if ( nPoint == 0 ) return;
+
+    RealField coor( 3 * nPoint ), pmin( 3 * nPoint ), pmax( 3 * nPoint );
+    IntField batchId( nPoint );
+    for ( int iPoint = 0; iPoint < nPoint; ++ iPoint )
+    {
+        coor[ 3 * iPoint     ] = xList[ iPoint ];
+        coor[ 3 * iPoint + 1 ] = yList[ iPoint ];
+        coor[ 3 * iPoint + 2 ] = zList[ iPoint ];
+        for ( int m = 0; m < 3; ++ m )
+        {
+            pmin[ 3 * iPoint + m ] = coor[ 3 * iPoint + m ] - this->tolerance;
+            pmax[ 3 * iPoint + m ] = coor[ 3 * iPoint + m ] + this->tolerance;
+        }
+        batchId[ iPoint ] = iPoint;
+    }
+
+    //The windows are searched among the old points and among the batch itself by all the threads
+    HXVector< IntField > oldList( nPoint ), newList;
+    int nTree = this->kdTrees.size();
+
+    #pragma omp parallel for schedule( dynamic, 64 )
+    for ( int iPoint = 0; iPoint < nPoint; ++ iPoint )
+    {
+        for ( int iTree = 0; iTree < nTree; ++ iTree )
+        {
+            this->kdTrees[ iTree ]->FindNodesInRegion( & pmin[ 3 * iPoint ], & pmax[ 3 * iPoint ], oldList[ iPoint ] );
+        }
+    }
+
+    KdTree batchTree( 3 );
+    batchTree.Build( nPoint, & coor[ 0 ], & batchId[ 0 ] );
+    batchTree.FindNodesInRegion( nPoint, & pmin[ 0 ], & pmax[ 0 ], newList );
+
+    //A point only sees the batch points before it which have been added
+    IntField newFlag( nPoint, 0 );
+    IntField idList;
+    for ( int iPoint = 0; iPoint < nPoint; ++ iPoint )
+    {
+        idList = oldList[ iPoint ];
+
+        AdtTree::AdtNodeList nodeList;
+        this->coorTree->FindNodesInRegion( & pmin[ 3 * iPoint ], & pmax[ 3 * iPoint ], nodeList );
+        for ( HXSize_t i = 0; i < nodeList.size(); ++ i )
+        {
+            idList.push_back( nodeList[ i ]->GetData() );
+        }
+
+        for ( HXSize_t i = 0; i < newList[ iPoint ].size(); ++ i )
+        {
+            int jPoint = newList[ iPoint ][ i ];
+            if ( jPoint < iPoint && newFlag[ jPoint ] )
+            {
+                idList.push_back( pointId[ jPoint ] );
+            }
+        }
+
+        if ( idList.size() == 0 )
+        {
+            pointId[ iPoint ] = this->xCoor.size();
+            newFlag[ iPoint ] = 1;
+
+            xCoor.push_back( xList[ iPoint ] );
+            yCoor.push_back( yList[ iPoint ] );
+            zCoor.push_back( zList[ iPoint ] );
+        }
+        else
+        {
+            if ( idList.size() > 1 )
+            {
+                std::cout << "FATAL ERROR : nodeList.size() = " << idList.size() << std::endl;
+                Stop("");
+            }
+            pointId[ iPoint ] = idList[ 0 ];
+        }
+    }
+
+    this->AddTree();
+}
+
+//Puts the points added since the last tree into a new kd-tree and starts the tree of single points over.
+//The new tree takes in the trees before it that are not larger, so a point is rebuilt O( log n ) times
+//over all the batches instead of once per batch
+void PointSearch::AddTree()
+{
+    int nTotal = this->xCoor.size();
+    int start = this->nTreePoint;
+    if ( nTotal == start ) return;
+
+    while ( ! this->kdTrees.empty() )
+    {
+        int iLast = this->kdTrees.size() - 1;
+        int lastStart = this->treeStart[ iLast ];
+        if ( start - lastStart > nTotal - start ) break;
+
+        delete this->kdTrees[ iLast ];
+        this->kdTrees.pop_back();
+        this->treeStart.pop_back();
+        start = lastStart;
+    }
+
+    int nPoint = nTotal - start;
+    RealField coor( 3 * nPoint );
+    IntField pointId( nPoint );
+    for ( int iPoint = 0; iPoint < nPoint; ++ iPoint )
+    {
+        int jPoint = start + iPoint;
+        coor[ 3 * iPoint     ] = this->xCoor[ jPoint ];
+        coor[ 3 * iPoint + 1 ] = this->yCoor[ jPoint ];
+        coor[ 3 * iPoint + 2 ] = this->zCoor[ jPoint ];
+        pointId[ iPoint ] = jPoint;
+    }
+
+    KdTree * kdTree = new KdTree( 3 );
+    kdTree->Build( nPoint, & coor[ 0 ], & pointId[ 0 ] );
+    this->kdTrees.push_back( kdTree );
+    this->treeStart.push_back( start );
+    this->nTreePoint = nTotal;
+
+    AdtTree * adtTree = new AdtTree( 3, this->coorTree->GetMin(), this->coorTree->GetMax() );
+    delete this->coorTree;
+    this->coorTree = adtTree;
+}
+
+void PointSearch::FindPointsInRegion( Real * pmin, Real * pmax, IntField & idList )
+{
+    for ( HXSize_t iTree = 0; iTree < this->kdTrees.size(); ++ iTree )
+    {
+        this->kdTrees[ iTree ]->FindNodesInRegion( pmin, pmax, idList );
+    }
+
+    AdtTree::AdtNodeList nodeList;
+    this->coorTree->FindNodesInRegion( pmin, pmax, nodeList );
+
+    for ( HXSize_t i = 0; i < nodeList.size(); ++ i )
+    {
+        idList.push_back( nodeList[ i ]->GetData() );
+    }
+}
+
 void PointSearch::GetPoint( int id, Real & xm, Real & ym, Real & zm )
 {
     xm = this->xCoor[ id ];
@@ -133,8 +281,6 @@ int PointSearch::FindPoint( Real xm, Real ym, Real zm )
 
 int PointSearch::FindPoint( RealField & coordinate )
 {
-    AdtTree::AdtNodeList nodeList;
-
     Real minWindow[ 3 ];
     Real maxWindow[ 3 ];
 
@@ -146,32 +292,31 @@ int PointSearch::FindPoint( RealField & coordinate )
     maxWindow[ 1 ] = coordinate[ 1 ] + this->tolerance;
     maxWindow[ 2 ] = coordinate[ 2 ] + this->tolerance;
 
-    nodeList.resize( 0 );
-    this->coorTree->FindNodesInRegion( minWindow, maxWindow, nodeList );
+    IntField idList;
+    this->FindPointsInRegion( minWindow, maxWindow, idList );
 
-    if ( nodeList.size() == 0 )
+    if ( idList.size() == 0 )
     {
         return INVALID_INDEX;
     }
     else
     {
-        if ( nodeList.size() > 1 )
+        if ( idList.size() > 1 )
         {
-            int numberOfSize = nodeList.size();
-            std::cout << " impossible nodeList.size() = " << nodeList.size() << std::endl;
+            int numberOfSize = idList.size();
+            std::cout << " impossible nodeList.size() = " << idList.size() << std::endl;
             
             int kkk = 1;
             Stop( "" );
         }
-        AdtNode * node = nodeList[ 0 ];
-        this->id = node->GetData();
+        this->id = idList[ 0 ];
         return this->id;
     }
 }
 
 void PointSearch::GetFaceCoorList( IntField & nodeId, RealField &xList, RealField &yList, RealField &zList )
 {
-    for ( int i = 0; i < nodeId.size(); ++ i )
+    for ( HXSize_t i = 0; i < nodeId.size(); ++ i )
     {
         int ip = nodeId[ i ];
         xList.push_back( this->xCoor[ ip ] );
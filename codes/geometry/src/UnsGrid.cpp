@@ -365,10 +365,10 @@ void UnsGrid::GenerateLgMapping( IFaceLink * iFaceLink )
     int nBFaces = bcRecord->GetNBFace();
 
     RealField xList, yList, zList;
-    IntField gINode;
-
-    int lCount  = 0;
+    RealField xAll, yAll, zAll;
+    IntField gINode, gINodeAll;
 
+    //The nodes of all the interface faces are numbered in one batch
     for ( int iBFace = 0; iBFace < nBFaces; ++ iBFace )
     {
         if ( ! BC::IsInterfaceBc( bcRecord->bcType[ iBFace ] ) )
@@ -378,15 +378,33 @@ void UnsGrid::GenerateLgMapping( IFaceLink * iFaceLink )
         IntField & faceNode = this->faceTopo->faces[ iBFace ];
         int nNodes = faceNode.size();
 
-        gINode.resize( nNodes );
         xList.resize( nNodes );
         yList.resize( nNodes );
         zList.resize( nNodes );
 
         ONEFLOW::GetFaceCoorList( faceNode, xList, yList, zList, this->nodeMesh );
-        ONEFLOW::GetCoorIdList( iFaceLink, xList, yList, zList, nNodes, gINode );
+        xAll.insert( xAll.end(), xList.begin(), xList.end() );
+        yAll.insert( yAll.end(), yList.begin(), yList.end() );
+        zAll.insert( zAll.end(), zList.begin(), zList.end() );
+    }
+
+    ONEFLOW::GetCoorIdList( iFaceLink, xAll, yAll, zAll, xAll.size(), gINodeAll );
+
+    int lCount  = 0;
+    int iCount = 0;
+
+    for ( int iBFace = 0; iBFace < nBFaces; ++ iBFace )
+    {
+        if ( ! BC::IsInterfaceBc( bcRecord->bcType[ iBFace ] ) )
+        {
+            continue;
+        }
+        int nNodes = this->faceTopo->faces[ iBFace ].size();
+
+        gINode.assign( gINodeAll.begin() + iCount, gINodeAll.begin() + iCount + nNodes );
         iFaceLink->CreateLink( gINode, this->id, lCount );
 
+        iCount += nNodes;
         ++ lCount;
     }
 
@@ -33,6 +33,7 @@ License
 #include "UnsGrid.h"
 #include "FaceTopo.h"
 #include "CellMesh.h"
+#include "CellTopo.h"
 #include "FaceMesh.h"
 #include "NodeMesh.h"
 #include "BcRecord.h"
@@ -48,21 +49,31 @@ License
 #include "GteTriangle.h"
 #include "GteDistPointTriangleExact.h"
 #include "HXMath.h"
+#include "Constant.h"
 #include "LogFile.h"
+#include <algorithm>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 BeginNameSpace( ONEFLOW )
 
 WallStructure * wallstruct = 0;
+WallFaceTree * walltree = 0;
 
 void FreeWallStruct()
 {
     delete wallstruct;
+    delete walltree;
+    wallstruct = 0;
+    walltree = 0;
 }
 
 void SetWallTask()
 {
     REGISTER_DATA_CLASS( FillWallStructTask  );
     REGISTER_DATA_CLASS( FillWallStruct  );
+    REGISTER_DATA_CLASS( CalcWallDistTask );
     REGISTER_DATA_CLASS( CalcWallDist );
 }
 
@@ -72,6 +83,12 @@ void FillWallStructTask( StringField & data )
     TaskState::task = task;
 }
 
+void CalcWallDistTask( StringField & data )
+{
+    CCalcWallDistTaskImp * task = new CCalcWallDistTaskImp();
+    TaskState::task = task;
+}
+
 void FillWallStruct( StringField & data )
 {
     UnsGrid * grid = Zone::GetUnsGrid();
@@ -88,17 +105,13 @@ void FillWallStruct( StringField & data )
     RealField & y = grid->nodeMesh->yN;
     RealField & z = grid->nodeMesh->zN;
 
-    ActionState::dataBook->MoveToBegin();
-
-    HXWrite( ActionState::dataBook, nWallFace );
-
     if ( nWallFace  <= 0 )
     {
         return;
     }
 
-    WallStructure::PointField fc;
-    WallStructure::PointLink  fv;
+    WallStructure::PointField & fc = wallstruct->fc;
+    WallStructure::PointLink  & fv = wallstruct->fv;
 
     for ( int iFace = 0; iFace < nBFaces; ++ iFace )
     {
@@ -128,18 +141,13 @@ void FillWallStruct( StringField & data )
             fc.push_back( centerPoint );
         }
     }
-
-    HXWrite( ActionState::dataBook, fv );
-    HXWrite( ActionState::dataBook, fc );
 }
 
+//Squared distance of every cell center to the local wall faces,
+//CCalcWallDistTaskImp lowers it by the remote ones and takes the root
 void CalcWallDist( StringField & data )
 {
     UnsGrid * grid = Zone::GetUnsGrid();
-    int nBFaces = grid->faceTopo->bcManager->bcRecord->GetNBFace();
-    BcRecord * bcRecord = grid->faceTopo->bcManager->bcRecord;
-
-    int nWallFace = bcRecord->CalcNumWallFace();
 
     RealField & dist = grid->cellMesh->dist;
 
@@ -153,47 +161,83 @@ void CalcWallDist( StringField & data )
 
     std::cout << "zone " << grid->id << std::endl;
 
-    WallStructure::PointField & fc = wallstruct->fc;
-    WallStructure::PointLink  & fv = wallstruct->fv;
+    WallStructure::PointLink & fv = wallstruct->fv;
 
     int nWFace = wallstruct->fc.size();
 
-    for ( int cId = 0; cId < nCells; ++ cId )
-    {
-        if ( cId % 10000 == 0 )
-        {
-            std::cout << " pid = " << Parallel::pid << " Zone = " << grid->id;
-            std::cout << " cid = " << cId << " " << "nCells = " << nCells;
-            std::cout << " nWFace = " << nWFace << std::endl;
-        }
+    if ( nWFace == 0 ) return;
 
-        Real xc = xcc[ cId ];
-        Real yc = ycc[ cId ];
-        Real zc = zcc[ cId ];
+    ONEFLOW::CalcC2f( grid );
+    LinkField & c2f = grid->cellMesh->cellTopo->c2f;
+    IntField & lCells = grid->faceTopo->lCells;
+    IntField & rCells = grid->faceTopo->rCells;
 
-        WallStructure::PointType ccp( xc, yc, zc );
+    //Nearest wall face of every cell, it bounds the search of the next cells
+    IntField nearest( nCells, -1 );
 
-        for ( int iWFace = 0; iWFace < nWFace; ++ iWFace )
-        {
-            WallStructure::PointField  & fvList = fv[ iWFace ];
+    int nThreads = 1;
+#ifdef _OPENMP
+    nThreads = omp_get_max_threads();
+#endif
+
+    //Every thread sweeps its own range of cells and only warm starts from cells of that range
+    #pragma omp parallel num_threads( nThreads )
+    {
+        int iThread = 0;
+#ifdef _OPENMP
+        iThread = omp_get_thread_num();
+#endif
+        int ist = static_cast< int >( static_cast< HXLongLong_t >( nCells ) * iThread / nThreads );
+        int ied = static_cast< int >( static_cast< HXLongLong_t >( nCells ) * ( iThread + 1 ) / nThreads );
 
-            Real wdst = CalcPoint2FaceDist( ccp, fvList );
+        IntField stack;
 
-            if ( wdst < 1.0e-30 )
+        for ( int cId = ist; cId < ied; ++ cId )
+        {
+            if ( iThread == 0 && cId % 10000 == 0 )
             {
+                std::cout << " pid = " << Parallel::pid << " Zone = " << grid->id;
+                std::cout << " cid = " << cId << " " << "nCells = " << nCells;
+                std::cout << " nWFace = " << nWFace << std::endl;
             }
 
-            if ( dist[ cId ] > wdst )
+            Real xc = xcc[ cId ];
+            Real yc = ycc[ cId ];
+            Real zc = zcc[ cId ];
+
+            WallStructure::PointType ccp( xc, yc, zc );
+
+            Real dist2 = LARGE;
+            int iWFace = -1;
+
+            //Warm start from the nearest faces of the cells already done around this one
+            int nFaces = c2f[ cId ].size();
+            for ( int iFace = 0; iFace <= nFaces; ++ iFace )
             {
-                dist[ cId ] = wdst;
+                int nc = cId - 1;
+                if ( iFace < nFaces )
+                {
+                    int fId = c2f[ cId ][ iFace ];
+                    nc = ( lCells[ fId ] == cId ) ? rCells[ fId ] : lCells[ fId ];
+                }
+                if ( nc < ist || nc >= cId ) continue;
+
+                int jWFace = nearest[ nc ];
+                if ( jWFace == iWFace ) continue;
+
+                Real wdst = CalcPoint2FaceDist( ccp, fv[ jWFace ] );
+                if ( wdst < dist2 )
+                {
+                    dist2 = wdst;
+                    iWFace = jWFace;
+                }
             }
-        }        
-    }
 
+            walltree->Search( ccp, dist2, iWFace, stack );
 
-    for ( int cId = 0; cId < nCells; ++ cId )
-    {
-        dist[ cId ] = sqrt( dist[ cId ] );
+            nearest[ cId ] = iWFace;
+            dist[ cId ] = dist2;
+        }
     }
 }
 
@@ -213,46 +257,405 @@ void CFillWallStructTaskImp::Run()
     ActionState::dataBook = this->dataBook;
     this->Create();
 
+    for ( int zId = 0; zId < ZoneState::nZones; ++ zId )
+    {
+        if ( ! ZoneState::IsValidZone( zId ) ) continue;
+
+        ZoneState::zid = zId;
+
+        this->action();
+    }
+
+    walltree = new WallFaceTree();
+    walltree->Build( wallstruct );
+
+    this->GatherWallBox();
+}
+
+void CFillWallStructTaskImp::Create()
+{
+    wallstruct = new WallStructure();
+}
+
+void CFillWallStructTaskImp::GatherWallBox()
+{
+    int nProc = Parallel::GetNProc();
+    RealField pbox( 6 * nProc, 0.0 );
+
+    Real * box = & pbox[ 6 * Parallel::pid ];
+    box[ 0 ] = walltree->xmin[ 0 ];
+    box[ 1 ] = walltree->ymin[ 0 ];
+    box[ 2 ] = walltree->zmin[ 0 ];
+    box[ 3 ] = walltree->xmax[ 0 ];
+    box[ 4 ] = walltree->ymax[ 0 ];
+    box[ 5 ] = walltree->zmax[ 0 ];
+
+    wallstruct->pbox = pbox;
+
+    if ( nProc <= 1 ) return;
+
+    HXReduceReal( & pbox[ 0 ], & wallstruct->pbox[ 0 ], 6 * nProc, PL_SUM );
+}
+
+CCalcWallDistTaskImp::CCalcWallDistTaskImp()
+{
+    ;
+}
+
+CCalcWallDistTaskImp::~CCalcWallDistTaskImp()
+{
+    ;
+}
+
+void CCalcWallDistTaskImp::Run()
+{
+    ActionState::dataBook = this->dataBook;
+
+    for ( int zId = 0; zId < ZoneState::nZones; ++ zId )
+    {
+        if ( ! ZoneState::IsValidZone( zId ) ) continue;
+
+        ZoneState::zid = zId;
+
+        this->action();
+    }
+
+    this->SearchRemoteWall();
+
+    for ( int zId = 0; zId < ZoneState::nZones; ++ zId )
+    {
+        if ( ! ZoneState::IsValidZone( zId ) ) continue;
+
+        ZoneState::zid = zId;
+
+        UnsGrid * grid = Zone::GetUnsGrid();
+        RealField & dist = grid->cellMesh->dist;
+        int nCells = grid->nCells;
+
+        for ( int cId = 0; cId < nCells; ++ cId )
+        {
+            dist[ cId ] = sqrt( dist[ cId ] );
+        }
+    }
+}
+
+//The remote processors search their own faces bounded by the local distance,
+//so the minimum is the same as the one over all the wall faces
+void CCalcWallDistTaskImp::SearchRemoteWall()
+{
+    int nProc = Parallel::GetNProc();
+    if ( nProc <= 1 ) return;
+
+    int pid = Parallel::pid;
+    RealField & pbox = wallstruct->pbox;
+
+    //Same tolerance as the box test of WallFaceTree::Search
+    const Real factor = 1.0 + 1.0e-10;
+
+    //Queries ( x, y, z, dist2 ) to every processor and the cells they come from
+    HXVector< RealField > sendData( nProc );
+    HXVector< IntField > sendZone( nProc );
+    HXVector< IntField > sendCell( nProc );
 
     for ( int zId = 0; zId < ZoneState::nZones; ++ zId )
     {
+        if ( ! ZoneState::IsValidZone( zId ) ) continue;
+
         ZoneState::zid = zId;
 
-        if ( Parallel::pid == ZoneState::pid[ zId ] )
+        UnsGrid * grid = Zone::GetUnsGrid();
+        RealField & dist = grid->cellMesh->dist;
+        RealField & xcc = grid->cellMesh->xcc;
+        RealField & ycc = grid->cellMesh->ycc;
+        RealField & zcc = grid->cellMesh->zcc;
+        int nCells = grid->nCells;
+
+        for ( int cId = 0; cId < nCells; ++ cId )
+        {
+            WallStructure::PointType ccp( xcc[ cId ], ycc[ cId ], zcc[ cId ] );
+
+            for ( int ip = 0; ip < nProc; ++ ip )
+            {
+                if ( ip == pid ) continue;
+
+                Real * box = & pbox[ 6 * ip ];
+                if ( box[ 0 ] > box[ 3 ] ) continue;
+                if ( CalcPoint2BoxDist( ccp, box ) > dist[ cId ] * factor ) continue;
+
+                sendData[ ip ].push_back( ccp.x );
+                sendData[ ip ].push_back( ccp.y );
+                sendData[ ip ].push_back( ccp.z );
+                sendData[ ip ].push_back( dist[ cId ] );
+                sendZone[ ip ].push_back( zId );
+                sendCell[ ip ].push_back( cId );
+            }
+        }
+    }
+
+    //Only the counts between each pair of processors are exchanged, and only
+    //the processors with queries to or from this one get messages
+    IntField nSendQuery( nProc, 0 );
+    IntField nRecvQuery( nProc, 0 );
+    for ( int ip = 0; ip < nProc; ++ ip )
+    {
+        nSendQuery[ ip ] = sendCell[ ip ].size();
+    }
+    HXAllToAllInt( & nSendQuery[ 0 ], & nRecvQuery[ 0 ], 1 );
+
+    HXVector< RealField > recvData( nProc );
+    for ( int ip = 0; ip < nProc; ++ ip )
+    {
+        recvData[ ip ].resize( 4 * nRecvQuery[ ip ] );
+    }
+
+    int queryTag = 0;
+    int replyTag = 1;
+
+    HXVector< PL_HXRequest > requests( 2 * nProc );
+    int nRequest = 0;
+    for ( int ip = 0; ip < nProc; ++ ip )
+    {
+        int nRecv = recvData[ ip ].size();
+        int nSend = sendData[ ip ].size();
+        if ( nRecv > 0 ) HXIRecvChar( & recvData[ ip ][ 0 ], nRecv * sizeof( Real ), ip, queryTag, & requests[ nRequest ++ ] );
+        if ( nSend > 0 ) HXISendChar( & sendData[ ip ][ 0 ], nSend * sizeof( Real ), ip, queryTag, & requests[ nRequest ++ ] );
+    }
+    if ( nRequest > 0 ) HXWait( nRequest, & requests[ 0 ] );
+
+    //Answer the queries with the local wall faces
+    HXVector< RealField > replyData( nProc );
+    for ( int ip = 0; ip < nProc; ++ ip )
+    {
+        RealField & query = recvData[ ip ];
+        RealField & reply = replyData[ ip ];
+        int nRecv = query.size() / 4;
+        reply.resize( nRecv );
+
+        #pragma omp parallel
         {
-            this->action();
+            IntField stack;
+
+            #pragma omp for schedule( dynamic, 64 )
+            for ( int i = 0; i < nRecv; ++ i )
+            {
+                WallStructure::PointType node( query[ 4 * i ], query[ 4 * i + 1 ], query[ 4 * i + 2 ] );
+                Real dist2 = query[ 4 * i + 3 ];
+                int iWFace = -1;
+                walltree->Search( node, dist2, iWFace, stack );
+                reply[ i ] = dist2;
+            }
         }
+    }
 
-        HXBcast( ActionState::dataBook, ZoneState::pid[ zId ] );
-        
-        FillWall();
+    HXVector< RealField > answerData( nProc );
+    nRequest = 0;
+    for ( int ip = 0; ip < nProc; ++ ip )
+    {
+        int nRecv = sendCell[ ip ].size();
+        int nSend = replyData[ ip ].size();
+        answerData[ ip ].resize( nRecv );
+        if ( nRecv > 0 ) HXIRecvChar( & answerData[ ip ][ 0 ], nRecv * sizeof( Real ), ip, replyTag, & requests[ nRequest ++ ] );
+        if ( nSend > 0 ) HXISendChar( & replyData[ ip ][ 0 ], nSend * sizeof( Real ), ip, replyTag, & requests[ nRequest ++ ] );
+    }
+    if ( nRequest > 0 ) HXWait( nRequest, & requests[ 0 ] );
+
+    for ( int ip = 0; ip < nProc; ++ ip )
+    {
+        int nAnswer = answerData[ ip ].size();
+        for ( int i = 0; i < nAnswer; ++ i )
+        {
+            ZoneState::zid = sendZone[ ip ][ i ];
+            UnsGrid * grid = Zone::GetUnsGrid();
+            RealField & dist = grid->cellMesh->dist;
+            int cId = sendCell[ ip ][ i ];
+            dist[ cId ] = MIN( dist[ cId ], answerData[ ip ][ i ] );
+        }
     }
 }
 
-void CFillWallStructTaskImp::Create()
+int WallFaceTree::leafSize = 4;
+
+class WallFaceLess
 {
-    wallstruct = new WallStructure();
+public:
+    WallFaceLess( RealField & center ) : center( center ) {}
+public:
+    RealField & center;
+public:
+    bool operator()( int a, int b ) const { return center[ a ] < center[ b ]; }
+};
+
+WallFaceTree::WallFaceTree()
+{
+    this->wall = 0;
+}
+
+WallFaceTree::~WallFaceTree()
+{
+    ;
+}
+
+void WallFaceTree::Build( WallStructure * wall )
+{
+    this->wall = wall;
+    int nWFace = wall->fv.size();
+
+    //Bounding box of every wall face
+    RealField box( 6 * nWFace );
+    RealField xc( nWFace ), yc( nWFace ), zc( nWFace );
+    for ( int iWFace = 0; iWFace < nWFace; ++ iWFace )
+    {
+        WallStructure::PointField & fvList = wall->fv[ iWFace ];
+        Real * b = & box[ 6 * iWFace ];
+        b[ 0 ] = b[ 1 ] = b[ 2 ] =   LARGE;
+        b[ 3 ] = b[ 4 ] = b[ 5 ] = - LARGE;
+        for ( HXSize_t iv = 0; iv < fvList.size(); ++ iv )
+        {
+            b[ 0 ] = MIN( b[ 0 ], fvList[ iv ].x );
+            b[ 1 ] = MIN( b[ 1 ], fvList[ iv ].y );
+            b[ 2 ] = MIN( b[ 2 ], fvList[ iv ].z );
+            b[ 3 ] = MAX( b[ 3 ], fvList[ iv ].x );
+            b[ 4 ] = MAX( b[ 4 ], fvList[ iv ].y );
+            b[ 5 ] = MAX( b[ 5 ], fvList[ iv ].z );
+        }
+        xc[ iWFace ] = half * ( b[ 0 ] + b[ 3 ] );
+        yc[ iWFace ] = half * ( b[ 1 ] + b[ 4 ] );
+        zc[ iWFace ] = half * ( b[ 2 ] + b[ 5 ] );
+    }
+
+    this->face.resize( nWFace );
+    for ( int iWFace = 0; iWFace < nWFace; ++ iWFace )
+    {
+        this->face[ iWFace ] = iWFace;
+    }
+
+    this->first.push_back( 0 );
+    this->count.push_back( nWFace );
+
+    //Children are appended behind their parent, so one pass splits the whole tree
+    for ( int iNode = 0; iNode < static_cast< int >( this->first.size() ); ++ iNode )
+    {
+        this->Split( iNode, xc, yc, zc, box );
+    }
+}
+
+void WallFaceTree::Split( int iNode, RealField & xc, RealField & yc, RealField & zc, RealField & box )
+{
+    int ist = this->first[ iNode ];
+    int ied = ist + this->count[ iNode ];
+
+    Real bmin[ 3 ] = {   LARGE,   LARGE,   LARGE };
+    Real bmax[ 3 ] = { - LARGE, - LARGE, - LARGE };
+    Real cmin[ 3 ] = {   LARGE,   LARGE,   LARGE };
+    Real cmax[ 3 ] = { - LARGE, - LARGE, - LARGE };
+    for ( int i = ist; i < ied; ++ i )
+    {
+        int iWFace = this->face[ i ];
+        Real * b = & box[ 6 * iWFace ];
+        Real c[ 3 ] = { xc[ iWFace ], yc[ iWFace ], zc[ iWFace ] };
+        for ( int m = 0; m < 3; ++ m )
+        {
+            bmin[ m ] = MIN( bmin[ m ], b[ m ] );
+            bmax[ m ] = MAX( bmax[ m ], b[ m + 3 ] );
+            cmin[ m ] = MIN( cmin[ m ], c[ m ] );
+            cmax[ m ] = MAX( cmax[ m ], c[ m ] );
+        }
+    }
+
+    this->xmin.push_back( bmin[ 0 ] );
+    this->ymin.push_back( bmin[ 1 ] );
+    this->zmin.push_back( bmin[ 2 ] );
+    this->xmax.push_back( bmax[ 0 ] );
+    this->ymax.push_back( bmax[ 1 ] );
+    this->zmax.push_back( bmax[ 2 ] );
+    this->left.push_back( -1 );
+
+    if ( ied - ist <= WallFaceTree::leafSize ) return;
+
+    //Median split along the longest extent of the face centers
+    int axis = 0;
+    for ( int m = 1; m < 3; ++ m )
+    {
+        if ( cmax[ m ] - cmin[ m ] > cmax[ axis ] - cmin[ axis ] ) axis = m;
+    }
+    RealField & center = ( axis == 0 ) ? xc : ( ( axis == 1 ) ? yc : zc );
+
+    int mid = ( ist + ied ) / 2;
+    std::nth_element( this->face.begin() + ist, this->face.begin() + mid, this->face.begin() + ied, WallFaceLess( center ) );
+
+    this->left[ iNode ] = this->first.size();
+    this->first.push_back( ist );
+    this->count.push_back( mid - ist );
+    this->first.push_back( mid );
+    this->count.push_back( ied - mid );
 }
 
-void CFillWallStructTaskImp::FillWall()
+Real WallFaceTree::CalcBoxDist2( int iNode, WallStructure::PointType & node )
 {
-    ActionState::dataBook->MoveToBegin();
-    int nSolidCell;
-    HXRead( ActionState::dataBook, nSolidCell );
+    Real dx = MAX( MAX( this->xmin[ iNode ] - node.x, node.x - this->xmax[ iNode ] ), 0.0 );
+    Real dy = MAX( MAX( this->ymin[ iNode ] - node.y, node.y - this->ymax[ iNode ] ), 0.0 );
+    Real dz = MAX( MAX( this->zmin[ iNode ] - node.z, node.z - this->zmax[ iNode ] ), 0.0 );
+    return dx * dx + dy * dy + dz * dz;
+}
 
-    WallStructure::PointField fcTmp;
-    WallStructure::PointLink  fvTmp;
+Real CalcPoint2BoxDist( WallStructure::PointType & node, Real * box )
+{
+    Real dx = MAX( MAX( box[ 0 ] - node.x, node.x - box[ 3 ] ), 0.0 );
+    Real dy = MAX( MAX( box[ 1 ] - node.y, node.y - box[ 4 ] ), 0.0 );
+    Real dz = MAX( MAX( box[ 2 ] - node.z, node.z - box[ 5 ] ), 0.0 );
+    return dx * dx + dy * dy + dz * dz;
+}
 
-    fvTmp.resize( nSolidCell );
-    HXRead( ActionState::dataBook, fvTmp );
+void WallFaceTree::Search( WallStructure::PointType & node, Real & dist2, int & iWFace, IntField & stack )
+{
+    if ( this->first.size() == 0 || this->count[ 0 ] == 0 ) return;
 
-    fcTmp.resize( nSolidCell );
-    HXRead( ActionState::dataBook, fcTmp );
+    //The box test is loosened by a relative tolerance so that round-off can never
+    //prune the face the brute-force search would find
+    const Real factor = 1.0 + 1.0e-10;
 
-    for ( int cId = 0; cId < nSolidCell; ++ cId )
+    stack.resize( 0 );
+    stack.push_back( 0 );
+
+    while ( stack.size() > 0 )
     {
-        wallstruct->fc.push_back( fcTmp[ cId ] );
-        wallstruct->fv.push_back( fvTmp[ cId ] );
+        int iNode = stack.back();
+        stack.pop_back();
+
+        if ( this->CalcBoxDist2( iNode, node ) > dist2 * factor ) continue;
+
+        int iLeft = this->left[ iNode ];
+        if ( iLeft < 0 )
+        {
+            int ist = this->first[ iNode ];
+            int ied = ist + this->count[ iNode ];
+            for ( int i = ist; i < ied; ++ i )
+            {
+                int jWFace = this->face[ i ];
+                Real wdst = CalcPoint2FaceDist( node, this->wall->fv[ jWFace ] );
+                if ( wdst < dist2 )
+                {
+                    dist2 = wdst;
+                    iWFace = jWFace;
+                }
+            }
+            continue;
+        }
+
+        //Push the farther child first, so the nearer one is searched first
+        int iRight = iLeft + 1;
+        Real dl = this->CalcBoxDist2( iLeft, node );
+        Real dr = this->CalcBoxDist2( iRight, node );
+        if ( dl <= dr )
+        {
+            stack.push_back( iRight );
+            stack.push_back( iLeft );
+        }
+        else
+        {
+            stack.push_back( iLeft );
+            stack.push_back( iRight );
+        }
     }
 }
 
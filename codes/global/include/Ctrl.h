@@ -55,6 +55,22 @@ public:
     int iexitflag;
     int ilim;
     Real vencat_coef;
+    int icommsplit;
+    int iparallelio;
+    int iasyncdump;
+    int ilusgsthread;
+    int iassemblethread;
+    int ifacethread;
+    int iinvbatch;
+    int igrad;
+    int iprecond;
+    int precondblock;
+    int ilutfill;
+    Real ilutdrop;
+    int ipsolver;
+    int amgsmoother;
+    int imomblock;
+    int iprofile;
     int nrokplus;
     int ivischeme;
     std::string heatfluxFile;
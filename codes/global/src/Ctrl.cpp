@@ -83,6 +83,22 @@ void Ctrl::Init()
     currTime = 0.0;
     ilim = GetDataValue< int >( "ilim" );
     vencat_coef = GetDataValue< Real >( "vencat_coef" );
+    icommsplit = GetDataValue< int >( "icommsplit" );
+    iparallelio = GetDataValue< int >( "iparallelio" );
+    iasyncdump = GetDataValue< int >( "iasyncdump" );
+    ilusgsthread = GetDataValue< int >( "ilusgsthread" );
+    iassemblethread = GetDataValue< int >( "iassemblethread" );
+    ifacethread = GetDataValue< int >( "ifacethread" );
+    iinvbatch = GetDataValue< int >( "iinvbatch" );
+    igrad = GetDataValue< int >( "igrad" );
+    iprecond = GetDataValue< int >( "iprecond" );
+    precondblock = GetDataValue< int >( "precondblock" );
+    ilutfill = GetDataValue< int >( "ilutfill" );
+    ilutdrop = GetDataValue< Real >( "ilutdrop" );
+    ipsolver = GetDataValue< int >( "ipsolver" );
+    amgsmoother = GetDataValue< int >( "amgsmoother" );
+    imomblock = GetDataValue< int >( "imomblock" );
+    iprofile = GetDataValue< int >( "iprofile" );
 
     nrokplus = 0;
 }
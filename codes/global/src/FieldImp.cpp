@@ -34,6 +34,8 @@ License
 #include "InterFace.h"
 #include "FaceTopo.h"
 #include "UNsCom.h"
+#include "InterHalo.h"
+#include "SolverState.h"
 
 BeginNameSpace( ONEFLOW )
 
@@ -86,44 +88,24 @@ void IFieldProperty::AllocateInterfaceField( int nIFaces, DataStorage * dataStor
 
 void IFieldProperty::UploadInterfaceValue()
 {
-    Grid * gridIn = Zone::GetGrid();
-
-    if ( ONEFLOW::IsUnsGrid( gridIn->type ) )
-    {
-        UnsGrid * grid = ONEFLOW::UnsGridCast( gridIn );
-
-        for ( std::map< std::string, int >::iterator iter = this->data.begin(); iter != this->data.end(); ++ iter )
-        {
-            int nEqu = iter->second;
+    Grid * grid = Zone::GetGrid();
 
-            if ( ZoneState::zid == 0 && iter->first == "gama" )
-            {
-                int kkk = 1;
-            }
+    if ( ! ONEFLOW::IsUnsGrid( grid->type ) ) return;
+    if ( ! ONEFLOW::IsValid( grid->interFace ) ) return;
 
-            MRField * targetField = ONEFLOW::GetFieldPointer< MRField >( grid, iter->first );
-            ONEFLOW::UploadInterfaceValue( grid, targetField, iter->first,  nEqu );
-        }
-    }
+    HaloPlan * haloPlan = HaloFactory::GetHaloPlan( grid, SolverState::tid );
+    haloPlan->Upload();
 }
 
 void IFieldProperty::DownloadInterfaceValue()
 {
-    Grid * gridIn = Zone::GetGrid();
-
-    if ( ONEFLOW::IsUnsGrid( gridIn->type ) )
-    {
-        UnsGrid * grid = ONEFLOW::UnsGridCast( gridIn );
-
-        for ( std::map< std::string, int >::iterator iter = this->data.begin(); iter != this->data.end(); ++ iter )
-        {
-            int nEqu = iter->second;
+    Grid * grid = Zone::GetGrid();
 
-            MRField * targetField = ONEFLOW::GetFieldPointer< MRField >( grid, iter->first );
+    if ( ! ONEFLOW::IsUnsGrid( grid->type ) ) return;
+    if ( ! ONEFLOW::IsValid( grid->interFace ) ) return;
 
-            ONEFLOW::DownloadInterfaceValue( grid, targetField, iter->first,  nEqu );
-        }
-    }
+    HaloPlan * haloPlan = HaloFactory::GetHaloPlan( grid, SolverState::tid );
+    haloPlan->Download();
 }
 
 void IFieldProperty::UploadOversetInterfaceValue()
@@ -430,27 +412,13 @@ void UploadInterfaceValue( UnsGrid * grid, MRField * field2D, const std::string
     InterFace * interFace = grid->interFace;
     if ( ! ONEFLOW::IsValid( interFace ) ) return;
 
-    int nIFaces = interFace->nIFaces;
-
     if ( field2D == 0 ) return;
 
-    for ( int ghostId = MAX_GHOST_LEVELS - 1; ghostId >= 0; -- ghostId )
-    {
-        DataStorage * dataSend = interFace->dataSend[ ghostId ];
-
-        MRField * fieldStorage = ONEFLOW::GetFieldPointer< MRField >( dataSend, name );
+    HaloPlan * haloPlan = HaloFactory::GetHaloPlan( grid, SolverState::tid );
+    HaloField * haloField = haloPlan->GetHaloField( name );
+    if ( haloField == 0 ) return;
 
-        for ( int iFace = 0; iFace < nIFaces; ++ iFace )
-        {
-            int iCell;
-            grid->faceTopo->GetSId( iFace, ghostId + 1, iCell );
-
-            for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
-            {
-                ( * fieldStorage )[ iEqu ][ iFace ] = ( * field2D )[ iEqu ][ iCell ];
-            }
-        }
-    }
+    haloPlan->Upload( haloField, field2D, nEqu );
 }
 
 void DownloadInterfaceValue( UnsGrid * grid, MRField * field2D, const std::string & name, int nEqu )
@@ -460,24 +428,11 @@ void DownloadInterfaceValue( UnsGrid * grid, MRField * field2D, const std::strin
 
     if ( field2D == 0 ) return;
 
-    for ( int ghostId = MAX_GHOST_LEVELS - 1; ghostId >= 0; -- ghostId )
-    {
-        DataStorage * dataRecv = interFace->dataRecv[ ghostId ];
-
-        MRField * fieldStorage = ONEFLOW::GetFieldPointer< MRField >( dataRecv, name );
-
-        int nIFaces = interFace->nIFaces;
-        for ( int iFace = 0; iFace < nIFaces; ++ iFace )
-        {
-            int iCell;
-            grid->faceTopo->GetTId( iFace, ghostId + 1, iCell );
+    HaloPlan * haloPlan = HaloFactory::GetHaloPlan( grid, SolverState::tid );
+    HaloField * haloField = haloPlan->GetHaloField( name );
+    if ( haloField == 0 ) return;
 
-            for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
-            {
-                ( * field2D )[ iEqu ][ iCell ] = ( * fieldStorage )[ iEqu ][ iFace ];
-            }
-        }
-    }
+    haloPlan->Download( haloField, field2D, nEqu );
 }
 
 void DownloadInterfaceValue_TEST( UnsGrid * grid, MRField * field2D, const std::string & name, int nEqu )
@@ -29,6 +29,7 @@ License
 #include "CmxTask.h"
 #include "Multigrid.h"
 #include "BcData.h"
+#include "Profiler.h"
 #include <iostream>
 
 
@@ -42,12 +43,14 @@ void FieldSimu()
     SolverMap::CreateSolvers();
     InitializeSolver();
     MultigridSolve();
+    Profiler::Dump();
 }
 
 void InitFlowSimuGlobal()
 {
     vis_model.Init();
     ctrl.Init();
+    Profiler::Init( ctrl.iprofile );
     Iteration::Init();
     usd.InitBasic();
 }
@@ -22,6 +22,8 @@ License
 
 #include "Grad.h"
 #include "UGrad.h"
+#include "GradWeight.h"
+#include "Ctrl.h"
 #include "UCom.h"
 #include "FieldImp.h"
 #include "FaceTopo.h"
@@ -34,6 +36,7 @@ License
 #include "Iteration.h"
 #include "DataBase.h"
 #include "StrUtil.h"
+#include "Profiler.h"
 #include <iostream>
 #include <iomanip>
 
@@ -52,9 +55,16 @@ Grad::~Grad()
 
 void Grad::CalcGrad()
 {
-    for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
+    static int profileId = Profiler::GetId( "gradient", PROFILE_KERNEL );
+    ProfileScope profileScope( profileId );
+
+    if ( ctrl.igrad == GRAD_WLSQ )
+    {
+        ONEFLOW::CalcGradLsq( q, dqdx, dqdy, dqdz, nEqu );
+    }
+    else
     {
-        ONEFLOW::CalcGradGGCellWeight( ( * q )[ iEqu ], ( * dqdx )[ iEqu ], ( * dqdy )[ iEqu ], ( * dqdz )[ iEqu ] );
+        ONEFLOW::CalcGradGGCellWeight( q, dqdx, dqdy, dqdz, nEqu );
     }
 
     if ( Iteration::outerSteps == -31 )
@@ -87,6 +97,23 @@ void Grad::CalcGrad()
     this->SwapBcGrad();
 }
 
+void Grad::CalcGradHalo()
+{
+    static int profileId = Profiler::GetId( "gradient", PROFILE_KERNEL );
+    ProfileScope profileScope( profileId );
+
+    if ( ctrl.igrad == GRAD_WLSQ )
+    {
+        ONEFLOW::CalcGradLsqHalo( q, dqdx, dqdy, dqdz, nEqu );
+    }
+    else
+    {
+        ONEFLOW::CalcGradGGCellWeightHalo( q, dqdx, dqdy, dqdz, nEqu );
+    }
+
+    this->SwapBcGrad();
+}
+
 void Grad::CalcGradDebug()
 {
     for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
@@ -0,0 +1,117 @@
+/*---------------------------------------------------------------------------*\
+    OneFLOW - LargeScale Multiphysics Scientific Simulation Environment
+    Copyright (C) 2017-2023 He Xin and the OneFLOW contributors.
+-------------------------------------------------------------------------------
+License
+    This file is part of OneFLOW.
+
+    OneFLOW is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OneFLOW is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+
+#pragma once
+#include "HXDefine.h"
+#include "HXArray.h"
+#include <map>
+
+BeginNameSpace( ONEFLOW )
+
+class UnsGrid;
+class FaceMesh;
+class UGeom;
+class GCom;
+
+//Faces solved by one LU-SGS sweep, stored cell by cell in CSR form.
+//Entry i of cell cId lies in [ start[ cId ], start[ cId + 1 ] ), in the c2f order of the cell.
+//The face normal is already oriented from cId to its neighbor cell.
+class LusgsSweepList
+{
+public:
+    LusgsSweepList();
+    ~LusgsSweepList();
+public:
+    IntField start;
+    IntField face;
+    IntField nei;
+    IntField swap;
+    RealField xfn, yfn, zfn, vfn, farea;
+public:
+    void Add( FaceMesh * faceMesh, int fId, int rc, bool swapflag );
+    void SetGeometry( int i, UGeom & ug, GCom & gcom );
+};
+
+//Wavefronts of one sweep direction.
+//Level iLevel holds the tasks [ start[ iLevel ], start[ iLevel + 1 ] ), task iTask the cells
+//[ taskStart[ iTask ], taskStart[ iTask + 1 ] ) in sweep order. The tasks of one level are
+//independent of each other; the cells of one task are swept one after the other.
+class LusgsSchedule
+{
+public:
+    LusgsSchedule();
+    ~LusgsSchedule();
+public:
+    IntField start;
+    IntField taskStart;
+    IntField cells;
+public:
+    int GetNLevels() { return static_cast< int >( start.size() ) - 1; }
+    void Init( IntField & order, IntField & level, IntField & task, int nLevels );
+};
+
+//LU-SGS sweep plan of one unstructured grid.
+//It is built once and shared by every solver sweeping the grid.
+//Cells are swept in cell order. When ctrl.ilusgsthread == 2 they are cut into blocks of
+//consecutive cells, the blocks are coloured, and cells are swept colour by colour.
+//A neighbor before the cell in the sweep order is a lower neighbor.
+class LusgsPlan
+{
+public:
+    LusgsPlan();
+    ~LusgsPlan();
+public:
+    static int blockSize;
+public:
+    int nCells;
+    int nColors;
+    IntField rank;
+    IntField block;
+    IntField blockColour;
+    LusgsSweepList lower;
+    LusgsSweepList upper;
+    LusgsSchedule lowerSchedule;
+    LusgsSchedule upperSchedule;
+public:
+    void Init( UnsGrid * grid );
+protected:
+    void CalcRank( UnsGrid * grid, int colourFlag );
+    void CalcBlockColour( UnsGrid * grid );
+    void CalcSweepList( UnsGrid * grid );
+    void CalcSchedule();
+    void CalcColourSchedule();
+    int GetRank( int cId ) { return cId < nCells ? rank[ cId ] : cId; }
+};
+
+class LusgsFactory
+{
+public:
+    LusgsFactory();
+    ~LusgsFactory();
+public:
+    static std::map< UnsGrid *, LusgsPlan * > data;
+public:
+    static LusgsPlan * GetLusgsPlan( UnsGrid * grid );
+};
+
+EndNameSpace
@@ -68,7 +68,8 @@ void RegisterImplicitTask()
 
 void LusgsInit( StringField & data )
 {
-    ;
+    LusgsSolver * lusgsSolver = LusgsState::GetLusgsSolver();
+    lusgsSolver->Initialize();
 }
 
 void LusgsLowerSweep( StringField & data )
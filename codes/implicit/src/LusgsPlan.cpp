@@ -0,0 +1,400 @@
+/*---------------------------------------------------------------------------*\
+    OneFLOW - LargeScale Multiphysics Scientific Simulation Environment
+    Copyright (C) 2017-2023 He Xin and the OneFLOW contributors.
+-------------------------------------------------------------------------------
+License
+    This file is part of OneFLOW.
+
+    OneFLOW is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OneFLOW is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "LusgsPlan.h"
+#include "UnsGrid.h"
+#include "FaceTopo.h"
+#include "FaceMesh.h"
+#include "CellMesh.h"
+#include "CellTopo.h"
+#include "UCom.h"
+#include "Com.h"
+#include "Ctrl.h"
+#include "HXMath.h"
+#include <algorithm>
+
+BeginNameSpace( ONEFLOW )
+
+LusgsSweepList::LusgsSweepList()
+{
+    ;
+}
+
+LusgsSweepList::~LusgsSweepList()
+{
+    ;
+}
+
+void LusgsSweepList::Add( FaceMesh * faceMesh, int fId, int rc, bool swapflag )
+{
+    Real sign = swapflag ? - 1.0 : 1.0;
+
+    face.push_back( fId );
+    nei.push_back( rc );
+    swap.push_back( swapflag );
+
+    //same sign flip as GCom::Reverse
+    xfn.push_back( sign * faceMesh->xfn[ fId ] );
+    yfn.push_back( sign * faceMesh->yfn[ fId ] );
+    zfn.push_back( sign * faceMesh->zfn[ fId ] );
+    vfn.push_back( sign * faceMesh->vfn[ fId ] );
+    farea.push_back( faceMesh->area[ fId ] );
+}
+
+void LusgsSweepList::SetGeometry( int i, UGeom & ug, GCom & gcom )
+{
+    ug.fId = face[ i ];
+    ug.lc  = ug.cId;
+    ug.rc  = nei[ i ];
+
+    gcom.xfn   = xfn  [ i ];
+    gcom.yfn   = yfn  [ i ];
+    gcom.zfn   = zfn  [ i ];
+    gcom.vfn   = vfn  [ i ];
+    gcom.farea = farea[ i ];
+
+    gcom.swapflag = ( swap[ i ] != 0 );
+
+    gcom.xcc2 = ( * ug.xcc )[ ug.rc ];
+    gcom.ycc2 = ( * ug.ycc )[ ug.rc ];
+    gcom.zcc2 = ( * ug.zcc )[ ug.rc ];
+
+    gcom.xcc1 = ( * ug.xcc )[ ug.lc ];
+    gcom.ycc1 = ( * ug.ycc )[ ug.lc ];
+    gcom.zcc1 = ( * ug.zcc )[ ug.lc ];
+}
+
+LusgsSchedule::LusgsSchedule()
+{
+    ;
+}
+
+LusgsSchedule::~LusgsSchedule()
+{
+    ;
+}
+
+void LusgsSchedule::Init( IntField & order, IntField & level, IntField & task, int nLevels )
+{
+    int nCells = order.size();
+
+    //Sort the cells by level, keeping the sweep order inside one level
+    IntField pos( nLevels + 1, 0 );
+    for ( int i = 0; i < nCells; ++ i )
+    {
+        ++ pos[ level[ order[ i ] ] + 1 ];
+    }
+
+    for ( int iLevel = 0; iLevel < nLevels; ++ iLevel )
+    {
+        pos[ iLevel + 1 ] += pos[ iLevel ];
+    }
+
+    cells.resize( nCells );
+    for ( int i = 0; i < nCells; ++ i )
+    {
+        int cId = order[ i ];
+        cells[ pos[ level[ cId ] ] ++ ] = cId;
+    }
+
+    //Consecutive cells of the same level and task form one task
+    start.resize( 0 );
+    taskStart.resize( 0 );
+
+    int currLevel = - 1;
+    int currTask  = - 1;
+    for ( int i = 0; i < nCells; ++ i )
+    {
+        int cId = cells[ i ];
+        while ( currLevel < level[ cId ] )
+        {
+            start.push_back( taskStart.size() );
+            ++ currLevel;
+            currTask = - 1;
+        }
+
+        if ( task[ cId ] != currTask )
+        {
+            taskStart.push_back( i );
+            currTask = task[ cId ];
+        }
+    }
+
+    while ( currLevel < nLevels )
+    {
+        start.push_back( taskStart.size() );
+        ++ currLevel;
+    }
+    taskStart.push_back( nCells );
+}
+
+int LusgsPlan::blockSize = 1024;
+
+LusgsPlan::LusgsPlan()
+{
+    this->nCells = 0;
+    this->nColors = 0;
+}
+
+LusgsPlan::~LusgsPlan()
+{
+    ;
+}
+
+void LusgsPlan::Init( UnsGrid * grid )
+{
+    FaceTopo * faceTopo = grid->faceTopo;
+    CellTopo * cellTopo = grid->cellMesh->cellTopo;
+    cellTopo->CalcC2f( faceTopo );
+
+    this->nCells = grid->nCells;
+
+    int colourFlag = ( ctrl.ilusgsthread == 2 );
+
+    this->CalcRank( grid, colourFlag );
+    this->CalcSweepList( grid );
+
+    if ( colourFlag )
+    {
+        this->CalcColourSchedule();
+    }
+    else
+    {
+        this->CalcSchedule();
+    }
+}
+
+void LusgsPlan::CalcRank( UnsGrid * grid, int colourFlag )
+{
+    rank.resize( nCells );
+
+    if ( ! colourFlag )
+    {
+        for ( int cId = 0; cId < nCells; ++ cId )
+        {
+            rank[ cId ] = cId;
+        }
+        return;
+    }
+
+    this->CalcBlockColour( grid );
+
+    //Cells are ranked colour by colour, in cell order inside one colour,
+    //so the cells of one block stay consecutive
+    IntField count( nColors + 1, 0 );
+    for ( int cId = 0; cId < nCells; ++ cId )
+    {
+        ++ count[ blockColour[ block[ cId ] ] + 1 ];
+    }
+
+    for ( int iColor = 0; iColor < nColors; ++ iColor )
+    {
+        count[ iColor + 1 ] += count[ iColor ];
+    }
+
+    for ( int cId = 0; cId < nCells; ++ cId )
+    {
+        rank[ cId ] = count[ blockColour[ block[ cId ] ] ] ++;
+    }
+}
+
+void LusgsPlan::CalcBlockColour( UnsGrid * grid )
+{
+    FaceTopo * faceTopo = grid->faceTopo;
+    IntField & lcf = faceTopo->lCells;
+    IntField & rcf = faceTopo->rCells;
+    LinkField & c2f = grid->cellMesh->cellTopo->c2f;
+
+    int nBlocks = ( nCells + blockSize - 1 ) / blockSize;
+
+    block.resize( nCells );
+    for ( int cId = 0; cId < nCells; ++ cId )
+    {
+        block[ cId ] = cId / blockSize;
+    }
+
+    //Greedy colouring: two blocks sharing an inner face never get the same colour
+    blockColour.resize( 0 );
+    blockColour.resize( nBlocks, - 1 );
+    IntField mark;
+    nColors = 0;
+
+    for ( int iBlock = 0; iBlock < nBlocks; ++ iBlock )
+    {
+        int cSt = iBlock * blockSize;
+        int cEd = MIN( cSt + blockSize, nCells );
+        for ( int cId = cSt; cId < cEd; ++ cId )
+        {
+            int fn = c2f[ cId ].size();
+            for ( int iFace = 0; iFace < fn; ++ iFace )
+            {
+                int fId = c2f[ cId ][ iFace ];
+                int nc = ( lcf[ fId ] == cId ) ? rcf[ fId ] : lcf[ fId ];
+                if ( nc >= nCells ) continue;
+                int iColor = blockColour[ block[ nc ] ];
+                if ( block[ nc ] == iBlock || iColor < 0 ) continue;
+                mark[ iColor ] = iBlock;
+            }
+        }
+
+        int iColor = 0;
+        while ( iColor < nColors && mark[ iColor ] == iBlock ) ++ iColor;
+
+        if ( iColor == nColors )
+        {
+            mark.push_back( - 1 );
+            ++ nColors;
+        }
+        blockColour[ iBlock ] = iColor;
+    }
+}
+
+void LusgsPlan::CalcSweepList( UnsGrid * grid )
+{
+    FaceTopo * faceTopo = grid->faceTopo;
+    FaceMesh * faceMesh = grid->faceMesh;
+    CellTopo * cellTopo = grid->cellMesh->cellTopo;
+
+    IntField & lcf = faceTopo->lCells;
+    IntField & rcf = faceTopo->rCells;
+    LinkField & c2f = cellTopo->c2f;
+
+    lower.start.resize( nCells + 1 );
+    upper.start.resize( nCells + 1 );
+
+    for ( int cId = 0; cId < nCells; ++ cId )
+    {
+        lower.start[ cId ] = lower.face.size();
+        upper.start[ cId ] = upper.face.size();
+
+        int fn = c2f[ cId ].size();
+        for ( int iFace = 0; iFace < fn; ++ iFace )
+        {
+            int fId = c2f[ cId ][ iFace ];
+            int lc = lcf[ fId ];
+            int rc = rcf[ fId ];
+
+            //One of lc and rc is the cell itself; the other one is stored as its neighbor.
+            bool swapflag = ( rc == cId );
+            int nc = swapflag ? lc : rc;
+
+            if ( this->GetRank( nc ) < rank[ cId ] )
+            {
+                lower.Add( faceMesh, fId, nc, swapflag );
+            }
+            else
+            {
+                upper.Add( faceMesh, fId, nc, swapflag );
+            }
+        }
+    }
+
+    lower.start[ nCells ] = lower.face.size();
+    upper.start[ nCells ] = upper.face.size();
+}
+
+void LusgsPlan::CalcSchedule()
+{
+    IntField order( nCells );
+    IntField task( nCells );
+    for ( int cId = 0; cId < nCells; ++ cId )
+    {
+        order[ cId ] = cId;
+        task [ cId ] = cId;
+    }
+
+    IntField level( nCells, 0 );
+    int nLevels = 0;
+
+    //A cell is solved one level after the last of its lower neighbors
+    for ( int cId = 0; cId < nCells; ++ cId )
+    {
+        for ( int j = lower.start[ cId ]; j < lower.start[ cId + 1 ]; ++ j )
+        {
+            level[ cId ] = MAX( level[ cId ], level[ lower.nei[ j ] ] + 1 );
+        }
+        nLevels = MAX( nLevels, level[ cId ] + 1 );
+    }
+    lowerSchedule.Init( order, level, task, nLevels );
+
+    //Same for the upper sweep, walking the cells backwards; ghost cells are never updated
+    level.assign( nCells, 0 );
+    nLevels = 0;
+    for ( int cId = nCells - 1; cId >= 0; -- cId )
+    {
+        for ( int j = upper.start[ cId ]; j < upper.start[ cId + 1 ]; ++ j )
+        {
+            int nc = upper.nei[ j ];
+            if ( nc >= nCells ) continue;
+            level[ cId ] = MAX( level[ cId ], level[ nc ] + 1 );
+        }
+        nLevels = MAX( nLevels, level[ cId ] + 1 );
+    }
+    std::reverse( order.begin(), order.end() );
+    upperSchedule.Init( order, level, task, nLevels );
+}
+
+//One level per colour and one task per block
+void LusgsPlan::CalcColourSchedule()
+{
+    IntField order( nCells );
+    IntField level( nCells );
+    for ( int cId = 0; cId < nCells; ++ cId )
+    {
+        order[ rank[ cId ] ] = cId;
+        level[ cId ] = blockColour[ block[ cId ] ];
+    }
+    lowerSchedule.Init( order, level, block, nColors );
+
+    for ( int cId = 0; cId < nCells; ++ cId )
+    {
+        level[ cId ] = nColors - 1 - level[ cId ];
+    }
+    std::reverse( order.begin(), order.end() );
+    upperSchedule.Init( order, level, block, nColors );
+}
+
+std::map< UnsGrid *, LusgsPlan * > LusgsFactory::data;
+
+LusgsFactory::LusgsFactory()
+{
+    ;
+}
+
+LusgsFactory::~LusgsFactory()
+{
+    ;
+}
+
+LusgsPlan * LusgsFactory::GetLusgsPlan( UnsGrid * grid )
+{
+    std::map< UnsGrid *, LusgsPlan * >::iterator iter = LusgsFactory::data.find( grid );
+    if ( iter != LusgsFactory::data.end() ) return iter->second;
+
+    LusgsPlan * lusgsPlan = new LusgsPlan();
+    lusgsPlan->Init( grid );
+    LusgsFactory::data[ grid ] = lusgsPlan;
+
+    return lusgsPlan;
+}
+
+EndNameSpace
@@ -23,6 +23,8 @@ License
 
 #pragma once
 #include "Lusgs.h"
+#include "NsLusgs.h"
+#include "Com.h"
 BeginNameSpace( ONEFLOW )
 
 class INsLusgs : public LusgsSolver
@@ -48,6 +50,11 @@ public:
     void CalcUpperChange();
     bool IsOversetCell  ();
     void ZeroOversetCell();
+public:
+    //Sweep state of this solver object. Inside the member functions it hides the
+    //global of the same name, so that every thread can sweep with its own solver object.
+    LusgsData nslu;
+    GCom gcom;
 };
 
 void CalcIDH( RealField & prim, Real & gama, RealField & dq, Real & dh, Real & totalEnthalpy );
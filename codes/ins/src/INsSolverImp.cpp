@@ -63,19 +63,7 @@ void INsInitFinal( StringField & data )
     INsCalcBc();
     INsCalcGamaT( F_GHOST );
     //ICalcLaminarViscosity( F_GHOST );
-
-    Grid * grid = Zone::GetGrid();
-
-    if ( Zone::GetCGrid( grid ) )
-    {
-        //RestrictAllQ( NS_SOLVER, FLOW_FIELD_INDEX );
-
-        GridState::gridLevel += 1;
-
-		INsCalcBc();
-
-        GridState::gridLevel -= 1;
-    }
+    //The coarse grid levels run INIT_FINAL themselves
 }
 
 void INsVisual( StringField & data )
@@ -39,8 +39,8 @@ void PrepareInterfaceFieldRecord( int sTid, int iFk, int iSr, FieldRecord * fiel
 void SetInterfaceFieldData( int iSr, FieldRecord * fieldRecord );
 
 void HXWriteSubData( DataBook * dataBook, MRField * field2D, IntField & idMap );
-void HXWriteSubData( DataBook * dataBook, RealField & field, IntField & idMap );
+void HXWriteSubData( DataBook * dataBook, MRFieldRow field, IntField & idMap );
 void HXReadSubData( DataBook * dataBook, MRField * field2D, IntField & idMap );
-void HXReadSubData( DataBook * dataBook, RealField & field, IntField & idMap );
+void HXReadSubData( DataBook * dataBook, MRFieldRow field, IntField & idMap );
 
 EndNameSpace
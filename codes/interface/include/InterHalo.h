@@ -0,0 +1,120 @@
+/*---------------------------------------------------------------------------*\
+    OneFLOW - LargeScale Multiphysics Scientific Simulation Environment
+    Copyright (C) 2017-2023 He Xin and the OneFLOW contributors.
+-------------------------------------------------------------------------------
+License
+    This file is part of OneFLOW.
+
+    OneFLOW is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OneFLOW is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+
+#pragma once
+#include "HXDefine.h"
+#include "HXArray.h"
+#include <map>
+#include <string>
+
+BeginNameSpace( ONEFLOW )
+
+class DataBook;
+class Grid;
+class InterFace;
+
+//One interface field, the cell field of the grid and its storage on every ghost level
+//are looked up by name on each exchange so that a reallocated field is always followed
+class HaloField
+{
+public:
+    HaloField();
+    ~HaloField();
+public:
+    std::string name;
+    int nEqu;
+};
+
+//Halo descriptor of one solver on one grid.
+//The gather/scatter cell lists are resolved once, and the fields of one
+//message are packed into a single contiguous buffer per neighbor.
+class HaloPlan
+{
+public:
+    HaloPlan();
+    ~HaloPlan();
+public:
+    Grid * grid;
+    InterFace * interFace;
+    int sTid;
+    HXVector< IntField > sendCells;
+    HXVector< IntField > recvCells;
+    HXVector< HaloField * > fields;
+    std::map< std::string, HaloField * > fieldMap;
+    std::map< int, HXVector< HaloField * > > messageFields;
+    HXVector< RealField > sendBuffer;
+    HXVector< RealField > recvBuffer;
+public:
+    void Init( Grid * grid, int sTid );
+    HaloField * GetHaloField( const std::string & name );
+    void Upload();
+    void Download();
+    void Upload( HaloField * haloField, MRField * field, int nEqu );
+    void Download( HaloField * haloField, MRField * field, int nEqu );
+    void Pack( int iFk, int neiId, DataBook * dataBook );
+    void Unpack( int iFk, int neiId, DataBook * dataBook );
+protected:
+    void InitCells();
+    MRField * GetField( HaloField * haloField );
+    MRField * GetSendField( HaloField * haloField, int ghostId );
+    MRField * GetRecvField( HaloField * haloField, int ghostId );
+    HXVector< HaloField * > & GetMessageFields( int iFk );
+    int GetMessageSize( HXVector< HaloField * > & haloFieldList, int nElem );
+};
+
+//Exchange of one interface message kind for several solvers together: every neighbor
+//gets a single message holding the fields of the solvers one after the other
+class HaloStage
+{
+public:
+    HaloStage();
+    ~HaloStage();
+public:
+    static int iFk;
+    static int startSid;
+    static int lastSid;
+public:
+    //Called by every solver at the end of an iteration, the first solver of the pass exchanges
+    static void PostExchange( int iFk );
+    //Exchanges the data of the solvers from startSid on
+    static void Exchange( int iFk, int startSid );
+protected:
+    static void Upload();
+    static void Download();
+    static void Pack();
+    static void Unpack();
+};
+
+class HaloFactory
+{
+public:
+    HaloFactory();
+    ~HaloFactory();
+public:
+    static std::map< std::pair< Grid *, int >, HaloPlan * > data;
+public:
+    static HaloPlan * GetHaloPlan( Grid * grid, int sTid );
+    static void Reset();
+};
+
+EndNameSpace
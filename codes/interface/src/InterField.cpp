@@ -139,7 +139,7 @@ void HXWriteSubData( DataBook * dataBook, MRField * field2D, IntField & idMap )
     }
 }
 
-void HXWriteSubData( DataBook * dataBook, RealField & field, IntField & idMap )
+void HXWriteSubData( DataBook * dataBook, MRFieldRow field, IntField & idMap )
 {
     int nElem = idMap.size();
     if ( nElem <= 0 ) return;
@@ -161,7 +161,7 @@ void HXReadSubData( DataBook * dataBook, MRField * field2D, IntField & idMap )
     }
 }
 
-void HXReadSubData( DataBook * dataBook, RealField & field, IntField & idMap )
+void HXReadSubData( DataBook * dataBook, MRFieldRow field, IntField & idMap )
 {
     int nElem = idMap.size();
     if ( nElem <= 0 ) return;
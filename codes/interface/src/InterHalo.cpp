@@ -0,0 +1,459 @@
+/*---------------------------------------------------------------------------*\
+    OneFLOW - LargeScale Multiphysics Scientific Simulation Environment
+    Copyright (C) 2017-2023 He Xin and the OneFLOW contributors.
+-------------------------------------------------------------------------------
+License
+    This file is part of OneFLOW.
+
+    OneFLOW is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OneFLOW is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "InterHalo.h"
+#include "InterFace.h"
+#include "Grid.h"
+#include "GridState.h"
+#include "UnsGrid.h"
+#include "FaceTopo.h"
+#include "FieldImp.h"
+#include "SolverDef.h"
+#include "RegisterUtil.h"
+#include "DataBase.h"
+#include "DataStorage.h"
+#include "DataBook.h"
+#include "DataBaseIO.h"
+#include "Zone.h"
+#include "ZoneState.h"
+#include "SolverState.h"
+#include "SolverMap.h"
+#include "ActionState.h"
+#include "InterfaceExchange.h"
+#include <climits>
+
+BeginNameSpace( ONEFLOW )
+
+HaloField::HaloField()
+{
+    this->nEqu = 0;
+}
+
+HaloField::~HaloField()
+{
+    ;
+}
+
+HaloPlan::HaloPlan()
+{
+    this->grid      = 0;
+    this->interFace = 0;
+    this->sTid      = 0;
+}
+
+HaloPlan::~HaloPlan()
+{
+    for ( HXSize_t iField = 0; iField < this->fields.size(); ++ iField )
+    {
+        delete this->fields[ iField ];
+    }
+}
+
+void HaloPlan::Init( Grid * grid, int sTid )
+{
+    this->grid      = grid;
+    this->interFace = grid->interFace;
+    this->sTid      = sTid;
+
+    FieldManager * fieldManager = FieldFactory::GetFieldManager( sTid );
+    std::map< std::string, int > & data = fieldManager->iFieldProperty->data;
+
+    for ( std::map< std::string, int >::iterator iter = data.begin(); iter != data.end(); ++ iter )
+    {
+        HaloField * haloField = new HaloField();
+        haloField->name = iter->first;
+        haloField->nEqu = iter->second;
+
+        this->fields.push_back( haloField );
+        this->fieldMap[ iter->first ] = haloField;
+    }
+
+    this->sendBuffer.resize( interFace->nNeighbor );
+    this->recvBuffer.resize( interFace->nNeighbor );
+
+    this->InitCells();
+}
+
+void HaloPlan::InitCells()
+{
+    if ( ! ONEFLOW::IsUnsGrid( this->grid->type ) ) return;
+
+    UnsGrid * unsGrid = ONEFLOW::UnsGridCast( this->grid );
+    FaceTopo * faceTopo = unsGrid->faceTopo;
+
+    int nIFaces = this->interFace->nIFaces;
+
+    this->sendCells.resize( MAX_GHOST_LEVELS );
+    this->recvCells.resize( MAX_GHOST_LEVELS );
+
+    for ( int ghostId = 0; ghostId < MAX_GHOST_LEVELS; ++ ghostId )
+    {
+        IntField & sendCell = this->sendCells[ ghostId ];
+        IntField & recvCell = this->recvCells[ ghostId ];
+        sendCell.resize( nIFaces );
+        recvCell.resize( nIFaces );
+
+        for ( int iFace = 0; iFace < nIFaces; ++ iFace )
+        {
+            faceTopo->GetSId( iFace, ghostId + 1, sendCell[ iFace ] );
+            faceTopo->GetTId( iFace, ghostId + 1, recvCell[ iFace ] );
+        }
+    }
+}
+
+MRField * HaloPlan::GetField( HaloField * haloField )
+{
+    return ONEFLOW::GetFieldPointer< MRField >( this->grid, haloField->name );
+}
+
+MRField * HaloPlan::GetSendField( HaloField * haloField, int ghostId )
+{
+    return ONEFLOW::GetFieldPointer< MRField >( this->interFace->dataSend[ ghostId ], haloField->name );
+}
+
+MRField * HaloPlan::GetRecvField( HaloField * haloField, int ghostId )
+{
+    return ONEFLOW::GetFieldPointer< MRField >( this->interFace->dataRecv[ ghostId ], haloField->name );
+}
+
+HaloField * HaloPlan::GetHaloField( const std::string & name )
+{
+    std::map< std::string, HaloField * >::iterator iter = this->fieldMap.find( name );
+    if ( iter == this->fieldMap.end() ) return 0;
+    return iter->second;
+}
+
+void HaloPlan::Upload()
+{
+    for ( HXSize_t iField = 0; iField < this->fields.size(); ++ iField )
+    {
+        HaloField * haloField = this->fields[ iField ];
+        this->Upload( haloField, this->GetField( haloField ), haloField->nEqu );
+    }
+}
+
+void HaloPlan::Download()
+{
+    for ( HXSize_t iField = 0; iField < this->fields.size(); ++ iField )
+    {
+        HaloField * haloField = this->fields[ iField ];
+        this->Download( haloField, this->GetField( haloField ), haloField->nEqu );
+    }
+}
+
+void HaloPlan::Upload( HaloField * haloField, MRField * field, int nEqu )
+{
+    if ( field == 0 ) return;
+
+    int nIFaces = this->interFace->nIFaces;
+
+    for ( int ghostId = MAX_GHOST_LEVELS - 1; ghostId >= 0; -- ghostId )
+    {
+        MRField * fieldStorage = this->GetSendField( haloField, ghostId );
+        IntField & sendCell = this->sendCells[ ghostId ];
+
+        for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
+        {
+            MRFieldRow storage = ( * fieldStorage )[ iEqu ];
+            MRFieldRow value   = ( * field )[ iEqu ];
+            for ( int iFace = 0; iFace < nIFaces; ++ iFace )
+            {
+                storage[ iFace ] = value[ sendCell[ iFace ] ];
+            }
+        }
+    }
+}
+
+void HaloPlan::Download( HaloField * haloField, MRField * field, int nEqu )
+{
+    if ( field == 0 ) return;
+
+    int nIFaces = this->interFace->nIFaces;
+
+    for ( int ghostId = MAX_GHOST_LEVELS - 1; ghostId >= 0; -- ghostId )
+    {
+        MRField * fieldStorage = this->GetRecvField( haloField, ghostId );
+        IntField & recvCell = this->recvCells[ ghostId ];
+
+        for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
+        {
+            MRFieldRow storage = ( * fieldStorage )[ iEqu ];
+            MRFieldRow value   = ( * field )[ iEqu ];
+            for ( int iFace = 0; iFace < nIFaces; ++ iFace )
+            {
+                value[ recvCell[ iFace ] ] = storage[ iFace ];
+            }
+        }
+    }
+}
+
+HXVector< HaloField * > & HaloPlan::GetMessageFields( int iFk )
+{
+    std::map< int, HXVector< HaloField * > >::iterator iter = this->messageFields.find( iFk );
+    if ( iter != this->messageFields.end() ) return iter->second;
+
+    HXVector< HaloField * > & haloFieldList = this->messageFields[ iFk ];
+
+    VarNameSolver * varNameSolver = VarNameFactory::GetVarNameSolver( this->sTid, iFk );
+    StringField & fieldNameList = varNameSolver->data;
+
+    for ( HXSize_t iField = 0; iField < fieldNameList.size(); ++ iField )
+    {
+        HaloField * haloField = this->GetHaloField( fieldNameList[ iField ] );
+        if ( haloField == 0 ) continue;
+        haloFieldList.push_back( haloField );
+    }
+
+    return haloFieldList;
+}
+
+int HaloPlan::GetMessageSize( HXVector< HaloField * > & haloFieldList, int nElem )
+{
+    int nTEqu = 0;
+    for ( HXSize_t iField = 0; iField < haloFieldList.size(); ++ iField )
+    {
+        nTEqu += haloFieldList[ iField ]->nEqu;
+    }
+    return MAX_GHOST_LEVELS * nTEqu * nElem;
+}
+
+void HaloPlan::Pack( int iFk, int neiId, DataBook * dataBook )
+{
+    IntField & idsend = this->interFace->GetInterfaceId( neiId, GREAT_SEND );
+    int nElem = idsend.size();
+    if ( nElem <= 0 ) return;
+
+    HXVector< HaloField * > & haloFieldList = this->GetMessageFields( iFk );
+
+    RealField & buffer = this->sendBuffer[ neiId ];
+    int nSize = this->GetMessageSize( haloFieldList, nElem );
+    if ( nSize <= 0 ) return;
+    buffer.resize( nSize );
+
+    int iCount = 0;
+    for ( int ghostId = MAX_GHOST_LEVELS - 1; ghostId >= 0; -- ghostId )
+    {
+        for ( HXSize_t iField = 0; iField < haloFieldList.size(); ++ iField )
+        {
+            HaloField * haloField = haloFieldList[ iField ];
+            MRField * fieldStorage = this->GetSendField( haloField, ghostId );
+            int nEqu = haloField->nEqu;
+            for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
+            {
+                MRFieldRow storage = ( * fieldStorage )[ iEqu ];
+                for ( int iElem = 0; iElem < nElem; ++ iElem )
+                {
+                    buffer[ iCount ++ ] = storage[ idsend[ iElem ] ];
+                }
+            }
+        }
+    }
+
+    ONEFLOW::HXWrite( dataBook, buffer );
+}
+
+void HaloPlan::Unpack( int iFk, int neiId, DataBook * dataBook )
+{
+    IntField & idrecv = this->interFace->GetInterfaceId( neiId, GREAT_RECV );
+    int nElem = idrecv.size();
+    if ( nElem <= 0 ) return;
+
+    HXVector< HaloField * > & haloFieldList = this->GetMessageFields( iFk );
+
+    RealField & buffer = this->recvBuffer[ neiId ];
+    int nSize = this->GetMessageSize( haloFieldList, nElem );
+    if ( nSize <= 0 ) return;
+    buffer.resize( nSize );
+
+    ONEFLOW::HXRead( dataBook, buffer );
+
+    int iCount = 0;
+    for ( int ghostId = MAX_GHOST_LEVELS - 1; ghostId >= 0; -- ghostId )
+    {
+        for ( HXSize_t iField = 0; iField < haloFieldList.size(); ++ iField )
+        {
+            HaloField * haloField = haloFieldList[ iField ];
+            MRField * fieldStorage = this->GetRecvField( haloField, ghostId );
+            int nEqu = haloField->nEqu;
+            for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
+            {
+                MRFieldRow storage = ( * fieldStorage )[ iEqu ];
+                for ( int iElem = 0; iElem < nElem; ++ iElem )
+                {
+                    storage[ idrecv[ iElem ] ] = buffer[ iCount ++ ];
+                }
+            }
+        }
+    }
+}
+
+int HaloStage::iFk      = INTERFACE_DATA;
+int HaloStage::startSid = 0;
+int HaloStage::lastSid  = INT_MAX;
+
+HaloStage::HaloStage()
+{
+    ;
+}
+
+HaloStage::~HaloStage()
+{
+    ;
+}
+
+void HaloStage::PostExchange( int iFk )
+{
+    //The solvers post their data in the order of their ids, so a solver whose id is not
+    //above the last caller starts a new pass and exchanges for itself and all the solvers after it
+    int sid = SolverState::id;
+    bool startFlag = ( sid <= HaloStage::lastSid );
+    HaloStage::lastSid = sid;
+
+    if ( ! startFlag ) return;
+
+    HaloStage::Exchange( iFk, sid );
+}
+
+void HaloStage::Exchange( int iFk, int startSid )
+{
+    HaloStage::iFk      = iFk;
+    HaloStage::startSid = startSid;
+
+    HaloStage::Upload();
+
+    ExchangeKey key( - 1 - startSid, iFk, GridState::gridLevel );
+    interfaceExchange.Exchange( & HaloStage::Pack, & HaloStage::Unpack, key );
+
+    HaloStage::Download();
+}
+
+void HaloStage::Upload()
+{
+    for ( int zId = 0; zId < ZoneState::nZones; ++ zId )
+    {
+        if ( ! ZoneState::IsValidZone( zId ) ) continue;
+
+        ZoneState::zid = zId;
+        Grid * grid = Zone::GetGrid();
+
+        if ( ! ONEFLOW::IsUnsGrid( grid->type ) ) continue;
+        if ( ! ONEFLOW::IsValid( grid->interFace ) ) continue;
+
+        for ( int sid = HaloStage::startSid; sid < SolverState::nSolver; ++ sid )
+        {
+            HaloPlan * haloPlan = HaloFactory::GetHaloPlan( grid, SolverMap::GetTid( sid ) );
+            haloPlan->Upload();
+        }
+    }
+}
+
+void HaloStage::Download()
+{
+    for ( int zId = 0; zId < ZoneState::nZones; ++ zId )
+    {
+        if ( ! ZoneState::IsValidZone( zId ) ) continue;
+
+        ZoneState::zid = zId;
+        Grid * grid = Zone::GetGrid();
+
+        if ( ! ONEFLOW::IsUnsGrid( grid->type ) ) continue;
+        if ( ! ONEFLOW::IsValid( grid->interFace ) ) continue;
+
+        for ( int sid = HaloStage::startSid; sid < SolverState::nSolver; ++ sid )
+        {
+            HaloPlan * haloPlan = HaloFactory::GetHaloPlan( grid, SolverMap::GetTid( sid ) );
+            haloPlan->Download();
+        }
+    }
+}
+
+//The messages of the solvers follow one another in the data book of the neighbor
+void HaloStage::Pack()
+{
+    Grid * grid = Zone::GetGrid();
+    InterFace * interFace = grid->interFace;
+    if ( ! ONEFLOW::IsValid( interFace ) ) return;
+
+    int neiId = interFace->z2n[ ZoneState::rzid ];
+
+    ActionState::dataBook->MoveToBegin();
+
+    for ( int sid = HaloStage::startSid; sid < SolverState::nSolver; ++ sid )
+    {
+        HaloPlan * haloPlan = HaloFactory::GetHaloPlan( grid, SolverMap::GetTid( sid ) );
+        haloPlan->Pack( HaloStage::iFk, neiId, ActionState::dataBook );
+    }
+}
+
+void HaloStage::Unpack()
+{
+    Grid * grid = Zone::GetGrid();
+    InterFace * interFace = grid->interFace;
+    if ( ! ONEFLOW::IsValid( interFace ) ) return;
+
+    int neiId = interFace->z2n[ ZoneState::szid ];
+
+    ActionState::dataBook->MoveToBegin();
+
+    for ( int sid = HaloStage::startSid; sid < SolverState::nSolver; ++ sid )
+    {
+        HaloPlan * haloPlan = HaloFactory::GetHaloPlan( grid, SolverMap::GetTid( sid ) );
+        haloPlan->Unpack( HaloStage::iFk, neiId, ActionState::dataBook );
+    }
+}
+
+std::map< std::pair< Grid *, int >, HaloPlan * > HaloFactory::data;
+
+HaloFactory::HaloFactory()
+{
+    ;
+}
+
+HaloFactory::~HaloFactory()
+{
+    ;
+}
+
+HaloPlan * HaloFactory::GetHaloPlan( Grid * grid, int sTid )
+{
+    std::pair< Grid *, int > key( grid, sTid );
+
+    std::map< std::pair< Grid *, int >, HaloPlan * >::iterator iter = HaloFactory::data.find( key );
+    if ( iter != HaloFactory::data.end() ) return iter->second;
+
+    HaloPlan * haloPlan = new HaloPlan();
+    haloPlan->Init( grid, sTid );
+    HaloFactory::data[ key ] = haloPlan;
+
+    return haloPlan;
+}
+
+void HaloFactory::Reset()
+{
+    for ( std::map< std::pair< Grid *, int >, HaloPlan * >::iterator iter = HaloFactory::data.begin(); iter != HaloFactory::data.end(); ++ iter )
+    {
+        delete iter->second;
+    }
+    HaloFactory::data.clear();
+}
+
+EndNameSpace
@@ -22,6 +22,7 @@ License
 
 #include "InterfaceTaskReg.h"
 #include "InterField.h"
+#include "InterHalo.h"
 #include "ActionState.h"
 #include "HXMath.h"
 #include "SolverDef.h"
@@ -41,6 +42,7 @@ License
 #include "FieldWrap.h"
 #include "SolverState.h"
 #include "Zone.h"
+#include "ZoneState.h"
 #include "Grid.h"
 #include "UnsGrid.h"
 #include "InterFace.h"
@@ -99,13 +101,22 @@ void PrepareInterfaceField( StringField & data )
     int iFk  = ( * interfaceMap )[ data[ 0 ] ];
     int iSr  = ( * sendRecvMap )[ data[ 1 ] ];
 
-    FieldRecord * fieldRecord = new FieldRecord();
+    //By design, the current zone is the jth neighbor of zone I.
+    int oppoSr = GetOppositeSendRecv( iSr );
+    int neiId = interFace->z2n[ ZoneState::GetZid( oppoSr ) ];
 
-    PrepareInterfaceFieldRecord( sTid, iFk, iSr, fieldRecord );
+    HaloPlan * haloPlan = HaloFactory::GetHaloPlan( grid, sTid );
 
-    SetInterfaceFieldData( iSr, fieldRecord );
+    ActionState::dataBook->MoveToBegin();
 
-    delete fieldRecord;
+    if ( iSr == GREAT_SEND )
+    {
+        haloPlan->Pack( iFk, neiId, ActionState::dataBook );
+    }
+    else
+    {
+        haloPlan->Unpack( iFk, neiId, ActionState::dataBook );
+    }
 }
 
 void PrepareOversetInterfaceField( StringField & data )
@@ -0,0 +1,97 @@
+/*---------------------------------------------------------------------------*\
+    OneFLOW - LargeScale Multiphysics Scientific Simulation Environment
+    Copyright (C) 2017-2023 He Xin and the OneFLOW contributors.
+-------------------------------------------------------------------------------
+License
+    This file is part of OneFLOW.
+
+    OneFLOW is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OneFLOW is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+
+#pragma once
+#include "Configure.h"
+#include "HXArray.h"
+#include <fstream>
+#include <string>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+BeginNameSpace( ONEFLOW )
+
+class DataBook;
+
+//A checkpoint staged in memory: the zones of one process and the offsets
+//of their records in the binary file, the layout of the parallel io path
+class AsyncRecord
+{
+public:
+    AsyncRecord();
+    ~AsyncRecord();
+public:
+    std::string fileName;
+    HXVector< DataBook * > dataBookList;
+    HXVector< HXLongLong_t > posList;
+    //The size of the whole file, the record of the file-id process cuts the file to it
+    HXLongLong_t totalSize;
+    bool resizeFlag;
+public:
+    //Empties the record for nBooks zones, the DataBooks are kept and reused
+    void Reset( int nBooks );
+    //Returns false if the file could not be opened or written
+    bool Write();
+};
+
+//The two buffers of one file: the record being written and the staged one
+class AsyncSlot
+{
+public:
+    AsyncSlot();
+public:
+    AsyncRecord * staged;
+    AsyncRecord * inFlight;
+    bool ready;
+};
+
+//Writes staged checkpoints from a background thread so the time loop never waits on the disk.
+//Each file has one record in flight and one staged record that the time loop fills,
+//a checkpoint staged again before the thread picked it up is overwritten and skipped.
+class AsyncFileWriter
+{
+public:
+    //The staged record of a file, taken back from the thread if it was not picked up yet
+    static AsyncRecord * Stage( const std::string & fileName );
+    static void Submit( AsyncRecord * record );
+    //Waits until every staged checkpoint is on disk
+    static void Flush();
+protected:
+    //Stops the program on the main thread if the background thread failed to write a file
+    static void CheckError();
+    static void Start();
+    static void Join();
+    static void Run();
+    static AsyncSlot * FindReadySlot();
+protected:
+    static std::thread * worker;
+    static std::mutex mtx;
+    static std::condition_variable cond;
+    static std::map< std::string, AsyncSlot > slotMap;
+    static bool stopFlag;
+    static std::string errorFile;
+};
+
+EndNameSpace
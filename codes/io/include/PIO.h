@@ -23,11 +23,15 @@ License
 
 #pragma once
 #include "Configure.h"
+#include "HXArray.h"
+#include "BasicParallel.h"
 #include <fstream>
 #include <string>
 
 BeginNameSpace( ONEFLOW )
 
+class DataBook;
+
 class PIO
 {
 public:
@@ -40,6 +44,11 @@ public:
 
     static void CloseFile( std::fstream & file );
     static void CloseFile();
+public:
+    //Binary files made of one record per zone: the record size followed by the record
+    static void CalcZoneRecordPos( PL_File file, HXLongLong_t start, HXVector< HXLongLong_t > & zonePos, HXVector< HXLongLong_t > & zoneSize );
+    static void ReadZoneRecord( PL_File file, HXLongLong_t pos, HXLongLong_t size, DataBook * dataBook );
+    static void WriteZoneRecord( PL_File file, HXLongLong_t pos, DataBook * dataBook );
 };
 
 
@@ -0,0 +1,245 @@
+/*---------------------------------------------------------------------------*\
+    OneFLOW - LargeScale Multiphysics Scientific Simulation Environment
+    Copyright (C) 2017-2023 He Xin and the OneFLOW contributors.
+-------------------------------------------------------------------------------
+License
+    This file is part of OneFLOW.
+
+    OneFLOW is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OneFLOW is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "AsyncFileWriter.h"
+#include "DataBook.h"
+#include "FileUtil.h"
+#include "Stop.h"
+#include <iostream>
+
+
+BeginNameSpace( ONEFLOW )
+
+AsyncRecord::AsyncRecord()
+{
+    this->totalSize = 0;
+    this->resizeFlag = false;
+}
+
+AsyncRecord::~AsyncRecord()
+{
+    for ( HXSize_t iBook = 0; iBook < this->dataBookList.size(); ++ iBook )
+    {
+        delete this->dataBookList[ iBook ];
+    }
+}
+
+void AsyncRecord::Reset( int nBooks )
+{
+    for ( HXSize_t iBook = nBooks; iBook < this->dataBookList.size(); ++ iBook )
+    {
+        delete this->dataBookList[ iBook ];
+    }
+    this->dataBookList.resize( nBooks, 0 );
+
+    for ( int iBook = 0; iBook < nBooks; ++ iBook )
+    {
+        if ( ! this->dataBookList[ iBook ] )
+        {
+            this->dataBookList[ iBook ] = new DataBook();
+        }
+        this->dataBookList[ iBook ]->MoveToBegin();
+        this->dataBookList[ iBook ]->ReSize( 0 );
+    }
+
+    this->posList.resize( 0 );
+    this->totalSize = 0;
+    this->resizeFlag = false;
+}
+
+bool AsyncRecord::Write()
+{
+    //The other processes write their zones into the same file, so it is
+    //created if needed and only the file-id process sets its size. The
+    //zones all lie below totalSize, so a record written before the size
+    //is set keeps its data, and the tail of a longer old file goes away
+    {
+        std::fstream create( this->fileName.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::app );
+    }
+
+    if ( this->resizeFlag && ! ONEFLOW::ResizeFile( this->fileName, this->totalSize ) ) return false;
+
+    std::fstream file( this->fileName.c_str(), std::ios_base::in | std::ios_base::out | std::ios_base::binary );
+    if ( ! file ) return false;
+
+    for ( HXSize_t iBook = 0; iBook < this->dataBookList.size(); ++ iBook )
+    {
+        file.seekp( this->posList[ iBook ] );
+        this->dataBookList[ iBook ]->WriteFile( file );
+    }
+
+    bool flag = file.good();
+    file.close();
+    return flag;
+}
+
+AsyncSlot::AsyncSlot()
+{
+    this->staged = 0;
+    this->inFlight = 0;
+    this->ready = false;
+}
+
+std::thread * AsyncFileWriter::worker = 0;
+std::mutex AsyncFileWriter::mtx;
+std::condition_variable AsyncFileWriter::cond;
+std::map< std::string, AsyncSlot > AsyncFileWriter::slotMap;
+bool AsyncFileWriter::stopFlag = false;
+std::string AsyncFileWriter::errorFile;
+
+AsyncRecord * AsyncFileWriter::Stage( const std::string & fileName )
+{
+    AsyncFileWriter::CheckError();
+    AsyncFileWriter::Start();
+
+    std::lock_guard< std::mutex > lock( mtx );
+
+    AsyncSlot & slot = slotMap[ fileName ];
+    if ( ! slot.staged )
+    {
+        slot.staged = new AsyncRecord();
+        slot.staged->fileName = fileName;
+    }
+    slot.ready = false;
+
+    return slot.staged;
+}
+
+void AsyncFileWriter::Submit( AsyncRecord * record )
+{
+    std::lock_guard< std::mutex > lock( mtx );
+
+    slotMap[ record->fileName ].ready = true;
+
+    cond.notify_all();
+}
+
+void AsyncFileWriter::Flush()
+{
+    if ( ! worker ) return;
+
+    AsyncFileWriter::Join();
+
+    std::map< std::string, AsyncSlot >::iterator iter;
+    for ( iter = slotMap.begin(); iter != slotMap.end(); ++ iter )
+    {
+        delete iter->second.staged;
+    }
+    slotMap.clear();
+
+    AsyncFileWriter::CheckError();
+}
+
+void AsyncFileWriter::CheckError()
+{
+    std::string fileName;
+    {
+        std::lock_guard< std::mutex > lock( mtx );
+        fileName = errorFile;
+    }
+
+    if ( fileName.empty() ) return;
+
+    //The thread is joined first, exit would otherwise destroy the mutex it waits on
+    AsyncFileWriter::Join();
+
+    std::cout << "could not write " << fileName << std::endl;
+    Stop( "" );
+}
+
+void AsyncFileWriter::Start()
+{
+    if ( worker ) return;
+
+    worker = new std::thread( & AsyncFileWriter::Run );
+}
+
+void AsyncFileWriter::Join()
+{
+    if ( ! worker ) return;
+
+    {
+        std::unique_lock< std::mutex > lock( mtx );
+        stopFlag = true;
+        cond.notify_all();
+    }
+
+    worker->join();
+    delete worker;
+    worker = 0;
+    stopFlag = false;
+}
+
+AsyncSlot * AsyncFileWriter::FindReadySlot()
+{
+    std::map< std::string, AsyncSlot >::iterator iter;
+    for ( iter = slotMap.begin(); iter != slotMap.end(); ++ iter )
+    {
+        if ( iter->second.ready ) return & iter->second;
+    }
+    return 0;
+}
+
+void AsyncFileWriter::Run()
+{
+    while ( true )
+    {
+        AsyncSlot * slot = 0;
+        {
+            std::unique_lock< std::mutex > lock( mtx );
+            while ( ! ( slot = AsyncFileWriter::FindReadySlot() ) && ! stopFlag )
+            {
+                cond.wait( lock );
+            }
+
+            if ( ! slot ) return;
+
+            slot->inFlight = slot->staged;
+            slot->staged = 0;
+            slot->ready = false;
+        }
+
+        bool flag = slot->inFlight->Write();
+
+        {
+            std::lock_guard< std::mutex > lock( mtx );
+
+            if ( ! flag && errorFile.empty() )
+            {
+                errorFile = slot->inFlight->fileName;
+            }
+
+            //The written record becomes the next staging buffer unless the time loop already holds one
+            if ( ! slot->staged )
+            {
+                slot->staged = slot->inFlight;
+            }
+            else
+            {
+                delete slot->inFlight;
+            }
+            slot->inFlight = 0;
+        }
+    }
+}
+
+EndNameSpace
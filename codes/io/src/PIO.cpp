@@ -30,7 +30,9 @@ License
 #include "ActionState.h"
 #include "Task.h"
 #include "TaskState.h"
+#include "DataBook.h"
 #include <iostream>
+#include <cstring>
 
 BeginNameSpace( ONEFLOW )
 
@@ -76,5 +78,62 @@ void PIO::CloseFile( std::fstream & file )
     Prj::CloseFile( file );
 }
 
+void PIO::CalcZoneRecordPos( PL_File file, HXLongLong_t start, HXVector< HXLongLong_t > & zonePos, HXVector< HXLongLong_t > & zoneSize )
+{
+    int nZones = zonePos.size();
+    if ( nZones <= 0 ) return;
+
+    int fid = Parallel::GetFid();
+
+    if ( Parallel::pid == fid )
+    {
+        HXLongLong_t pos = start;
+        for ( int iZone = 0; iZone < nZones; ++ iZone )
+        {
+            HXLongLong_t nLength = 0;
+            ONEFLOW::HXFileReadAt( file, pos, & nLength, sizeof( HXLongLong_t ) );
+            pos += sizeof( HXLongLong_t );
+
+            zonePos [ iZone ] = pos;
+            zoneSize[ iZone ] = ( nLength > 0 ) ? nLength : 0;
+
+            pos += zoneSize[ iZone ];
+        }
+    }
+
+    if ( Parallel::mode == 0 )
+    {
+        ONEFLOW::HXBcast( & zonePos [ 0 ], nZones, fid );
+        ONEFLOW::HXBcast( & zoneSize[ 0 ], nZones, fid );
+    }
+}
+
+void PIO::ReadZoneRecord( PL_File file, HXLongLong_t pos, HXLongLong_t size, DataBook * dataBook )
+{
+    dataBook->MoveToBegin();
+    dataBook->ReSize( 0 );
+
+    if ( size <= 0 ) return;
+
+    std::vector< char > buffer( size );
+    ONEFLOW::HXFileReadAt( file, pos, buffer.data(), size );
+
+    dataBook->Write( buffer.data(), size );
+    dataBook->MoveToBegin();
+}
+
+void PIO::WriteZoneRecord( PL_File file, HXLongLong_t pos, DataBook * dataBook )
+{
+    HXLongLong_t nLength = dataBook->GetSize();
+    HXLongLong_t nHead = sizeof( HXLongLong_t );
+
+    std::vector< char > buffer( nHead + nLength );
+    std::memcpy( buffer.data(), & nLength, nHead );
+
+    dataBook->MoveToBegin();
+    dataBook->Read( buffer.data() + nHead, nLength );
+
+    ONEFLOW::HXFileWriteAt( file, pos, buffer.data(), buffer.size() );
+}
 
 EndNameSpace
@@ -32,6 +32,7 @@ License
 #include "Test.h"
 #include "Theory.h"
 #include "PostProcess.h"
+#include "AsyncFileWriter.h"
 #include <iostream>
 
 
@@ -66,6 +67,7 @@ void SimuImp::MainProcess()
 
 void SimuImp::PostProcess()
 {
+    AsyncFileWriter::Flush();
     HXFinalize();
 }
 
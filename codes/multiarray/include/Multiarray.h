@@ -22,7 +22,8 @@ License
 #pragma once
 #include "Configure.h"
 #include "Range.h"
-#include "Memop.h"
+#include <cstddef>
+#include <new>
 
 BeginNameSpace( ONEFLOW )
 
@@ -30,95 +31,345 @@ template < typename T, int N >
 class Multiarray;
 
 template < typename T, int N >
-class Multiarray
+class MultiarrayView;
+
+//Shape shared by arrays and views: element ( i0, i1, ... ) lives at
+//origin[ i0 * stride[ 0 ] + i1 * stride[ 1 ] + ... ], i0 runs fastest.
+//Only the rank N is a template parameter. The strides are set at run time from the ranges,
+//which are grid sizes read from the grid files, so the offsets cannot be compile-time constants.
+template < typename T, int N >
+class MultiarrayShape
 {
+protected:
+    T * origin;
+    int first[ N ];
+    int length[ N ];
+    std::ptrdiff_t stride[ N ];
 public:
-    typedef Multiarray< T, N > TArray;
+    int First( int d ) const { return first[ d ]; }
+    int Last( int d ) const { return first[ d ] + length[ d ] - 1; }
+    int Length( int d ) const { return length[ d ]; }
+    std::ptrdiff_t Stride( int d ) const { return stride[ d ]; }
+
+    std::size_t Size() const
+    {
+        std::size_t nSize = 1;
+        for ( int d = 0; d < N; ++ d )
+        {
+            nSize *= length[ d ];
+        }
+        return nSize;
+    }
+
+    //Address of the first element, contiguous when IsContiguous() holds
+    T * Data()
+    {
+        return & this->origin[ this->Offset( first ) ];
+    }
+
+    bool IsContiguous() const
+    {
+        std::ptrdiff_t expected = 1;
+        for ( int d = 0; d < N; ++ d )
+        {
+            if ( stride[ d ] != expected ) return false;
+            expected *= length[ d ];
+        }
+        return true;
+    }
+protected:
+    std::ptrdiff_t Offset( const int * index ) const
+    {
+        std::ptrdiff_t offset = 0;
+        for ( int d = 0; d < N; ++ d )
+        {
+            offset += index[ d ] * stride[ d ];
+        }
+        return offset;
+    }
+};
+
+//N-dimensional array, owned aligned storage or built on shared memory that it never frees.
+//The arrays are dense with i0 running fastest, so stride[ 0 ] is 1 and operator() leaves it out,
+//the other strides are loaded from the object and hoisted out of i0 loops by the compiler.
+//Strided sub-blocks are MultiarrayView.
+template < typename T, int N >
+class Multiarray : public MultiarrayShape< T, N >
+{
 public:
-    ArrayPointer< T > arrayPointer;
+    typedef Multiarray< T, N > TArray;
+    typedef MultiarrayView< T, N > TView;
+    static const std::size_t ALIGNMENT = 64;
 public:
     ~Multiarray()
     {
+        this->Deallocate();
     }
 
     Multiarray( const Range & r0 )
     {
-        arrayPointer.Allocate( r0 );
+        static_assert( N == 1, "Multiarray: wrong number of ranges" );
+        Range r[] = { r0 };
+        this->Allocate( 0, r );
     }
 
     Multiarray( const Range & r0, const Range & r1 )
     {
-        arrayPointer.Allocate( r0, r1 );
+        static_assert( N == 2, "Multiarray: wrong number of ranges" );
+        Range r[] = { r0, r1 };
+        this->Allocate( 0, r );
     }
 
     Multiarray( const Range & r0, const Range & r1, const Range & r2 )
     {
-        arrayPointer.Allocate( r0, r1, r2 );
+        static_assert( N == 3, "Multiarray: wrong number of ranges" );
+        Range r[] = { r0, r1, r2 };
+        this->Allocate( 0, r );
     }
 
     Multiarray( const Range & r0, const Range & r1, const Range & r2, const Range & r3 )
     {
-        arrayPointer.Allocate( r0, r1, r2, r3 );
+        static_assert( N == 4, "Multiarray: wrong number of ranges" );
+        Range r[] = { r0, r1, r2, r3 };
+        this->Allocate( 0, r );
     }
 
     Multiarray( T * dataPointer, const Range & r0 )
     {
-        arrayPointer.Allocate( dataPointer, r0 );
+        static_assert( N == 1, "Multiarray: wrong number of ranges" );
+        Range r[] = { r0 };
+        this->Allocate( dataPointer, r );
     }
 
     Multiarray( T * dataPointer, const Range & r0, const Range & r1 )
     {
-        arrayPointer.Allocate( dataPointer, r0, r1 );
+        static_assert( N == 2, "Multiarray: wrong number of ranges" );
+        Range r[] = { r0, r1 };
+        this->Allocate( dataPointer, r );
     }
 
     Multiarray( T * dataPointer, const Range & r0, const Range & r1, const Range & r2 )
     {
-        arrayPointer.Allocate( dataPointer, r0, r1, r2 );
+        static_assert( N == 3, "Multiarray: wrong number of ranges" );
+        Range r[] = { r0, r1, r2 };
+        this->Allocate( dataPointer, r );
     }
 
     Multiarray( T * dataPointer, const Range & r0, const Range & r1, const Range & r2, const Range & r3 )
     {
-        arrayPointer.Allocate( dataPointer, r0, r1, r2, r3 );
+        static_assert( N == 4, "Multiarray: wrong number of ranges" );
+        Range r[] = { r0, r1, r2, r3 };
+        this->Allocate( dataPointer, r );
+    }
+
+    //Copying an array that owns its storage copies the values, copying one on shared memory shares them
+    Multiarray( const TArray & rhs )
+    {
+        this->memory = 0;
+        this->origin = rhs.origin;
+        for ( int d = 0; d < N; ++ d )
+        {
+            this->first [ d ] = rhs.first [ d ];
+            this->length[ d ] = rhs.length[ d ];
+            this->stride[ d ] = rhs.stride[ d ];
+        }
+
+        if ( ! rhs.memory ) return;
+
+        Range r[ N ];
+        for ( int d = 0; d < N; ++ d )
+        {
+            r[ d ].SetRange( this->first[ d ], this->first[ d ] + this->length[ d ] - 1 );
+        }
+        this->Allocate( 0, r );
+
+        std::size_t nSize = this->Size();
+        for ( std::size_t i = 0; i < nSize; ++ i )
+        {
+            this->memory[ i ] = rhs.memory[ i ];
+        }
+    }
+
+    TArray & operator = ( const TArray & rhs ) = delete;
+protected:
+    T * memory;
+public:
+    //Zero-copy view on a sub-block, view index first + n addresses r[ n ] of this array
+    TView View( const Range & r0 )
+    {
+        static_assert( N == 1, "Multiarray: wrong number of ranges" );
+        Range r[] = { r0 };
+        return this->MakeView( r );
+    }
+
+    TView View( const Range & r0, const Range & r1 )
+    {
+        static_assert( N == 2, "Multiarray: wrong number of ranges" );
+        Range r[] = { r0, r1 };
+        return this->MakeView( r );
+    }
+
+    TView View( const Range & r0, const Range & r1, const Range & r2 )
+    {
+        static_assert( N == 3, "Multiarray: wrong number of ranges" );
+        Range r[] = { r0, r1, r2 };
+        return this->MakeView( r );
+    }
+
+    TView View( const Range & r0, const Range & r1, const Range & r2, const Range & r3 )
+    {
+        static_assert( N == 4, "Multiarray: wrong number of ranges" );
+        Range r[] = { r0, r1, r2, r3 };
+        return this->MakeView( r );
     }
 public:
     const T & operator()( int i0 ) const
-    { 
-        return arrayPointer.datap1[ i0 ];
+    {
+        return this->origin[ i0 ];
     }
 
     T & operator()( int i0 )
     {
-        return arrayPointer.datap1[ i0 ];
+        return this->origin[ i0 ];
     }
-    
+
     const T & operator()( int i0, int i1 ) const
-    { 
-        return arrayPointer.datap2[ i1 ][ i0 ];
+    {
+        return this->origin[ i0 + i1 * this->stride[ 1 ] ];
+    }
+
+    T & operator()( int i0, int i1 )
+    {
+        return this->origin[ i0 + i1 * this->stride[ 1 ] ];
+    }
+
+    const T & operator()( int i0, int i1, int i2 ) const
+    {
+        return this->origin[ i0 + i1 * this->stride[ 1 ] + i2 * this->stride[ 2 ] ];
+    }
+
+    T & operator()( int i0, int i1, int i2 )
+    {
+        return this->origin[ i0 + i1 * this->stride[ 1 ] + i2 * this->stride[ 2 ] ];
+    }
+
+    const T & operator()( int i0, int i1, int i2, int i3 ) const
+    {
+        return this->origin[ i0 + i1 * this->stride[ 1 ] + i2 * this->stride[ 2 ] + i3 * this->stride[ 3 ] ];
+    }
+
+    T & operator()( int i0, int i1, int i2, int i3 )
+    {
+        return this->origin[ i0 + i1 * this->stride[ 1 ] + i2 * this->stride[ 2 ] + i3 * this->stride[ 3 ] ];
+    }
+protected:
+    void Allocate( T * dataPointer, const Range * r )
+    {
+        std::ptrdiff_t s = 1;
+        for ( int d = 0; d < N; ++ d )
+        {
+            this->first [ d ] = r[ d ].First();
+            this->length[ d ] = r[ d ].Length();
+            this->stride[ d ] = s;
+            s *= this->length[ d ];
+        }
+
+        std::size_t nSize = this->Size();
+
+        T * data = dataPointer;
+        this->memory = 0;
+        if ( ! dataPointer )
+        {
+            this->memory = static_cast< T * >( ::operator new( ( nSize > 0 ? nSize : 1 ) * sizeof( T ), std::align_val_t( ALIGNMENT ) ) );
+            for ( std::size_t i = 0; i < nSize; ++ i )
+            {
+                new ( this->memory + i ) T();
+            }
+            data = this->memory;
+        }
+
+        this->origin = data - this->Offset( this->first );
+    }
+
+    void Deallocate()
+    {
+        if ( ! this->memory ) return;
+
+        std::size_t nSize = this->Size();
+        for ( std::size_t i = 0; i < nSize; ++ i )
+        {
+            this->memory[ i ].~T();
+        }
+        ::operator delete( this->memory, std::align_val_t( ALIGNMENT ) );
+        this->memory = 0;
+    }
+
+    TView MakeView( const Range * r )
+    {
+        TView view;
+        std::ptrdiff_t shift = 0;
+        for ( int d = 0; d < N; ++ d )
+        {
+            view.first [ d ] = r[ d ].First();
+            view.length[ d ] = r[ d ].Length();
+            view.stride[ d ] = this->stride[ d ] * r[ d ].Stride();
+            shift += r[ d ].First() * ( this->stride[ d ] - view.stride[ d ] );
+        }
+        view.origin = this->origin + shift;
+        return view;
+    }
+};
+
+//Zero-copy view on a sub-block of a Multiarray, every index keeps its stride
+//because a strided range makes i0 strided too. Views never own their storage.
+template < typename T, int N >
+class MultiarrayView : public MultiarrayShape< T, N >
+{
+    friend class Multiarray< T, N >;
+protected:
+    MultiarrayView()
+    {
+        this->origin = 0;
+    }
+public:
+    const T & operator()( int i0 ) const
+    {
+        return this->origin[ i0 * this->stride[ 0 ] ];
+    }
+
+    T & operator()( int i0 )
+    {
+        return this->origin[ i0 * this->stride[ 0 ] ];
+    }
+
+    const T & operator()( int i0, int i1 ) const
+    {
+        return this->origin[ i0 * this->stride[ 0 ] + i1 * this->stride[ 1 ] ];
     }
 
     T & operator()( int i0, int i1 )
     {
-        return arrayPointer.datap2[ i1 ][ i0 ];
+        return this->origin[ i0 * this->stride[ 0 ] + i1 * this->stride[ 1 ] ];
     }
 
     const T & operator()( int i0, int i1, int i2 ) const
     {
-        return arrayPointer.datap3[ i2 ][ i1 ][ i0 ];
+        return this->origin[ i0 * this->stride[ 0 ] + i1 * this->stride[ 1 ] + i2 * this->stride[ 2 ] ];
     }
 
-    T & operator()( int i0, int i1, int i2 ) 
+    T & operator()( int i0, int i1, int i2 )
     {
-        return arrayPointer.datap3[ i2 ][ i1 ][ i0 ];
+        return this->origin[ i0 * this->stride[ 0 ] + i1 * this->stride[ 1 ] + i2 * this->stride[ 2 ] ];
     }
 
     const T & operator()( int i0, int i1, int i2, int i3 ) const
     {
-        return arrayPointer.datap4[ i3 ][ i2 ][ i1 ][ i0 ];
+        return this->origin[ i0 * this->stride[ 0 ] + i1 * this->stride[ 1 ] + i2 * this->stride[ 2 ] + i3 * this->stride[ 3 ] ];
     }
 
-    T & operator()( int i0, int i1, int i2, int i3 ) 
+    T & operator()( int i0, int i1, int i2, int i3 )
     {
-        return arrayPointer.datap4[ i3 ][ i2 ][ i1 ][ i0 ];
+        return this->origin[ i0 * this->stride[ 0 ] + i1 * this->stride[ 1 ] + i2 * this->stride[ 2 ] + i3 * this->stride[ 3 ] ];
     }
 };
 
@@ -20,7 +20,7 @@ License
 
 \*---------------------------------------------------------------------------*/
 
-#include "Memop.h"
+#include "Multiarray.h"
 
 
 BeginNameSpace( ONEFLOW )
@@ -0,0 +1,71 @@
+/*---------------------------------------------------------------------------*\
+    OneFLOW - LargeScale Multiphysics Scientific Simulation Environment
+    Copyright (C) 2017-2023 He Xin and the OneFLOW contributors.
+-------------------------------------------------------------------------------
+License
+    This file is part of OneFLOW.
+
+    OneFLOW is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OneFLOW is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+
+#pragma once
+#include "HXDefine.h"
+
+BeginNameSpace( ONEFLOW )
+
+class UnsGrid;
+
+//Volume agglomeration of an unstructured grid into the grid of the next multigrid level.
+//Cells are grouped by an advancing front that starts from the walls. A seed cell takes the
+//free neighbors it shares the largest face area with. Near walls, where the cells are stretched,
+//only the large faces of a cell may be crossed, so the boundary layer is coarsened normal to the wall.
+//Interface faces are never merged, so the coarse interfaces of two zones stay face to face.
+class Agglomeration
+{
+public:
+    Agglomeration();
+    ~Agglomeration();
+public:
+    //A cell whose largest face is aspectRatio times its smallest one is agglomerated directionally
+    static Real aspectRatio;
+public:
+    UnsGrid * fineGrid;
+    UnsGrid * coarseGrid;
+    int nFineCells;
+    int nCoarseCells;
+    int maxSize;
+    IntField f2c;
+    IntField isotropic;
+    RealField maxArea;
+public:
+    UnsGrid * Create( UnsGrid * fineGrid );
+protected:
+    void CalcCellAnisotropy();
+    void CalcSeedOrder( IntField & seeds );
+    void Agglomerate();
+    void MergeSingletons( IntField & size );
+    void Renumber();
+    void CreateFaces();
+    void CalcMetrics();
+    void CreateInterFace();
+    bool CanCross( int cId, int fId );
+};
+
+void CreateCoarseGrids( int nLevels );
+void InitCoarseInterfaceTopo();
+void CalcCoarseWallDist();
+
+EndNameSpace
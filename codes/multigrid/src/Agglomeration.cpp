@@ -0,0 +1,636 @@
+/*---------------------------------------------------------------------------*\
+    OneFLOW - LargeScale Multiphysics Scientific Simulation Environment
+    Copyright (C) 2017-2023 He Xin and the OneFLOW contributors.
+-------------------------------------------------------------------------------
+License
+    This file is part of OneFLOW.
+
+    OneFLOW is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OneFLOW is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "Agglomeration.h"
+#include "UnsGrid.h"
+#include "FaceTopo.h"
+#include "FaceMesh.h"
+#include "CellMesh.h"
+#include "CellTopo.h"
+#include "BcRecord.h"
+#include "Boundary.h"
+#include "InterFace.h"
+#include "Zone.h"
+#include "ZoneState.h"
+#include "GridState.h"
+#include "Dimension.h"
+#include "HXMath.h"
+#include "Constant.h"
+#include "LogFile.h"
+#include <map>
+#include <tuple>
+#include <iostream>
+
+
+BeginNameSpace( ONEFLOW )
+
+Real Agglomeration::aspectRatio = 4.0;
+
+Agglomeration::Agglomeration()
+{
+    this->fineGrid = 0;
+    this->coarseGrid = 0;
+    this->nFineCells = 0;
+    this->nCoarseCells = 0;
+    this->maxSize = 0;
+}
+
+Agglomeration::~Agglomeration()
+{
+    ;
+}
+
+UnsGrid * Agglomeration::Create( UnsGrid * fineGrid )
+{
+    this->fineGrid = fineGrid;
+    this->nFineCells = fineGrid->nCells;
+    this->maxSize = ONEFLOW::IsThreeD() ? 8 : 4;
+
+    ONEFLOW::CalcC2f( fineGrid );
+
+    this->coarseGrid = new UnsGrid();
+    this->coarseGrid->Init();
+    this->coarseGrid->name      = fineGrid->name;
+    this->coarseGrid->dimension = fineGrid->dimension;
+    this->coarseGrid->type      = fineGrid->type;
+    this->coarseGrid->level     = fineGrid->level + 1;
+    this->coarseGrid->id        = fineGrid->id;
+    this->coarseGrid->localId   = fineGrid->localId;
+    this->coarseGrid->volBcType = fineGrid->volBcType;
+    this->coarseGrid->nNodes    = 0;
+
+    this->CalcCellAnisotropy();
+    this->Agglomerate();
+    this->CreateFaces();
+    this->CalcMetrics();
+    this->CreateInterFace();
+
+    return this->coarseGrid;
+}
+
+void Agglomeration::CalcCellAnisotropy()
+{
+    LinkField & c2f = this->fineGrid->cellMesh->cellTopo->c2f;
+    RealField & area = this->fineGrid->faceMesh->area;
+
+    this->isotropic.resize( this->nFineCells );
+    this->maxArea.resize( this->nFineCells );
+
+    for ( int cId = 0; cId < this->nFineCells; ++ cId )
+    {
+        Real amax = 0.0;
+        Real amin = LARGE;
+        int nFaces = c2f[ cId ].size();
+        for ( int iFace = 0; iFace < nFaces; ++ iFace )
+        {
+            Real a = area[ c2f[ cId ][ iFace ] ];
+            amax = MAX( amax, a );
+            amin = MIN( amin, a );
+        }
+        this->maxArea[ cId ] = amax;
+        this->isotropic[ cId ] = ( amax < Agglomeration::aspectRatio * amin ) ? 1 : 0;
+    }
+}
+
+bool Agglomeration::CanCross( int cId, int fId )
+{
+    if ( this->isotropic[ cId ] ) return true;
+    return this->fineGrid->faceMesh->area[ fId ] >= half * this->maxArea[ cId ];
+}
+
+void Agglomeration::CalcSeedOrder( IntField & seeds )
+{
+    FaceTopo * faceTopo = this->fineGrid->faceTopo;
+    BcRecord * bcRecord = faceTopo->bcManager->bcRecord;
+    int nBFaces = this->fineGrid->nBFaces;
+
+    //The front starts from the walls, then from the other boundaries
+    for ( int fId = 0; fId < nBFaces; ++ fId )
+    {
+        if ( ! BC::IsWallBc( bcRecord->bcType[ fId ] ) ) continue;
+        seeds.push_back( faceTopo->lCells[ fId ] );
+    }
+
+    for ( int fId = 0; fId < nBFaces; ++ fId )
+    {
+        if ( BC::IsWallBc( bcRecord->bcType[ fId ] ) ) continue;
+        seeds.push_back( faceTopo->lCells[ fId ] );
+    }
+
+    for ( int cId = 0; cId < this->nFineCells; ++ cId )
+    {
+        seeds.push_back( cId );
+    }
+}
+
+void Agglomeration::Agglomerate()
+{
+    LinkField & c2f = this->fineGrid->cellMesh->cellTopo->c2f;
+    IntField & lCells = this->fineGrid->faceTopo->lCells;
+    IntField & rCells = this->fineGrid->faceTopo->rCells;
+    RealField & area = this->fineGrid->faceMesh->area;
+    int nBFaces = this->fineGrid->nBFaces;
+
+    IntField seeds;
+    this->CalcSeedOrder( seeds );
+
+    this->f2c.resize( this->nFineCells );
+    this->f2c = -1;
+    this->nCoarseCells = 0;
+
+    IntField front;
+    IntField group;
+    IntField size;
+    IntField candCell;
+    RealField candWeight;
+    int head = 0;
+    int iSeed = 0;
+
+    while ( true )
+    {
+        int seed = -1;
+        while ( seed < 0 && head < front.size() )
+        {
+            int cId = front[ head ++ ];
+            if ( this->f2c[ cId ] < 0 ) seed = cId;
+        }
+        while ( seed < 0 && iSeed < seeds.size() )
+        {
+            int cId = seeds[ iSeed ++ ];
+            if ( this->f2c[ cId ] < 0 ) seed = cId;
+        }
+        if ( seed < 0 ) break;
+
+        int cc = this->nCoarseCells ++;
+        group.resize( 0 );
+        group.push_back( seed );
+        this->f2c[ seed ] = cc;
+
+        while ( group.size() < this->maxSize )
+        {
+            candCell.resize( 0 );
+            candWeight.resize( 0 );
+            for ( int iCell = 0; iCell < group.size(); ++ iCell )
+            {
+                int cId = group[ iCell ];
+                int nFaces = c2f[ cId ].size();
+                for ( int iFace = 0; iFace < nFaces; ++ iFace )
+                {
+                    int fId = c2f[ cId ][ iFace ];
+                    if ( fId < nBFaces ) continue;
+                    int nc = ( lCells[ fId ] == cId ) ? rCells[ fId ] : lCells[ fId ];
+                    if ( this->f2c[ nc ] >= 0 ) continue;
+                    if ( ! this->CanCross( cId, fId ) || ! this->CanCross( nc, fId ) ) continue;
+
+                    int iCand = 0;
+                    while ( iCand < candCell.size() && candCell[ iCand ] != nc ) ++ iCand;
+                    if ( iCand == candCell.size() )
+                    {
+                        candCell.push_back( nc );
+                        candWeight.push_back( 0.0 );
+                    }
+                    candWeight[ iCand ] += area[ fId ];
+                }
+            }
+
+            if ( candCell.size() == 0 ) break;
+
+            int iBest = 0;
+            for ( int iCand = 1; iCand < candCell.size(); ++ iCand )
+            {
+                if ( candWeight[ iCand ] > candWeight[ iBest ] ) iBest = iCand;
+            }
+            group.push_back( candCell[ iBest ] );
+            this->f2c[ candCell[ iBest ] ] = cc;
+        }
+
+        size.push_back( group.size() );
+
+        for ( int iCell = 0; iCell < group.size(); ++ iCell )
+        {
+            int cId = group[ iCell ];
+            int nFaces = c2f[ cId ].size();
+            for ( int iFace = 0; iFace < nFaces; ++ iFace )
+            {
+                int fId = c2f[ cId ][ iFace ];
+                if ( fId < nBFaces ) continue;
+                int nc = ( lCells[ fId ] == cId ) ? rCells[ fId ] : lCells[ fId ];
+                if ( this->f2c[ nc ] < 0 ) front.push_back( nc );
+            }
+        }
+    }
+
+    this->MergeSingletons( size );
+    this->Renumber();
+}
+
+void Agglomeration::MergeSingletons( IntField & size )
+{
+    LinkField & c2f = this->fineGrid->cellMesh->cellTopo->c2f;
+    IntField & lCells = this->fineGrid->faceTopo->lCells;
+    IntField & rCells = this->fineGrid->faceTopo->rCells;
+    RealField & area = this->fineGrid->faceMesh->area;
+    int nBFaces = this->fineGrid->nBFaces;
+
+    //A cell left alone joins the neighboring coarse cell it shares the largest face with
+    for ( int cId = 0; cId < this->nFineCells; ++ cId )
+    {
+        int cc = this->f2c[ cId ];
+        if ( size[ cc ] != 1 ) continue;
+
+        int target = -1;
+        Real amax = 0.0;
+        int nFaces = c2f[ cId ].size();
+        for ( int iFace = 0; iFace < nFaces; ++ iFace )
+        {
+            int fId = c2f[ cId ][ iFace ];
+            if ( fId < nBFaces ) continue;
+            int nc = ( lCells[ fId ] == cId ) ? rCells[ fId ] : lCells[ fId ];
+            if ( this->f2c[ nc ] == cc ) continue;
+            if ( area[ fId ] > amax )
+            {
+                amax = area[ fId ];
+                target = this->f2c[ nc ];
+            }
+        }
+
+        if ( target < 0 ) continue;
+
+        this->f2c[ cId ] = target;
+        size[ cc ] = 0;
+        size[ target ] += 1;
+    }
+}
+
+void Agglomeration::Renumber()
+{
+    IntField newId( this->nCoarseCells, -1 );
+    int nCoarseCells = 0;
+
+    //Coarse cells are numbered in the order of their first fine cell
+    for ( int cId = 0; cId < this->nFineCells; ++ cId )
+    {
+        int cc = this->f2c[ cId ];
+        if ( newId[ cc ] < 0 ) newId[ cc ] = nCoarseCells ++;
+        this->f2c[ cId ] = newId[ cc ];
+    }
+
+    this->nCoarseCells = nCoarseCells;
+}
+
+void Agglomeration::CreateFaces()
+{
+    FaceTopo * faceTopo = this->fineGrid->faceTopo;
+    BcRecord * bcRecord = faceTopo->bcManager->bcRecord;
+    int nBFaces = this->fineGrid->nBFaces;
+    int nFaces = this->fineGrid->nFaces;
+
+    IntField & f2cFace = this->fineGrid->f2cFace;
+    f2cFace.resize( nFaces );
+    f2cFace = -1;
+
+    IntField lCells, rCells, fTypes, bcType, bcNameId;
+
+    //Boundary faces of one coarse cell with the same boundary condition are merged
+    std::map< std::tuple< int, int, int >, int > bcFaceMap;
+    for ( int fId = 0; fId < nBFaces; ++ fId )
+    {
+        int cc = this->f2c[ faceTopo->lCells[ fId ] ];
+        int bctype = bcRecord->bcType[ fId ];
+        int nameId = bcRecord->bcNameId[ fId ];
+
+        int cf = -1;
+        if ( ! BC::IsInterfaceBc( bctype ) )
+        {
+            std::tuple< int, int, int > key( cc, bctype, nameId );
+            std::map< std::tuple< int, int, int >, int >::iterator iter = bcFaceMap.find( key );
+            if ( iter != bcFaceMap.end() )
+            {
+                cf = iter->second;
+            }
+            else
+            {
+                bcFaceMap.insert( std::make_pair( key, static_cast< int >( lCells.size() ) ) );
+            }
+        }
+
+        if ( cf < 0 )
+        {
+            cf = lCells.size();
+            lCells.push_back( cc );
+            rCells.push_back( 0 );
+            fTypes.push_back( faceTopo->fTypes[ fId ] );
+            bcType.push_back( bctype );
+            bcNameId.push_back( nameId );
+        }
+        f2cFace[ fId ] = cf;
+    }
+
+    int nCBFaces = lCells.size();
+
+    std::map< std::pair< int, int >, int > faceMap;
+    for ( int fId = nBFaces; fId < nFaces; ++ fId )
+    {
+        int cl = this->f2c[ faceTopo->lCells[ fId ] ];
+        int cr = this->f2c[ faceTopo->rCells[ fId ] ];
+        if ( cl == cr ) continue;
+
+        std::pair< int, int > key( MIN( cl, cr ), MAX( cl, cr ) );
+        std::map< std::pair< int, int >, int >::iterator iter = faceMap.find( key );
+        if ( iter != faceMap.end() )
+        {
+            f2cFace[ fId ] = iter->second;
+            continue;
+        }
+
+        int cf = lCells.size();
+        faceMap.insert( std::make_pair( key, cf ) );
+        lCells.push_back( cl );
+        rCells.push_back( cr );
+        fTypes.push_back( faceTopo->fTypes[ fId ] );
+        f2cFace[ fId ] = cf;
+    }
+
+    UnsGrid * grid = this->coarseGrid;
+    grid->nCells = this->nCoarseCells;
+    grid->nFaces = lCells.size();
+    grid->nBFaces = nCBFaces;
+
+    grid->cellMesh->cellTopo->Alloc( grid->nCells );
+    grid->faceTopo->nCells = grid->nCells;
+    grid->faceTopo->faces.resize( grid->nFaces );
+    grid->faceTopo->lCells = lCells;
+    grid->faceTopo->rCells = rCells;
+    grid->faceTopo->fTypes = fTypes;
+    grid->faceTopo->SetNBFaces( nCBFaces );
+    grid->faceTopo->bcManager->bcRecord->bcType = bcType;
+    grid->faceTopo->bcManager->bcRecord->bcNameId = bcNameId;
+    grid->NormalizeBc();
+
+    IntField & f2cCell = this->fineGrid->f2cCell;
+    f2cCell.resize( this->nFineCells + nBFaces );
+    for ( int cId = 0; cId < this->nFineCells; ++ cId )
+    {
+        f2cCell[ cId ] = this->f2c[ cId ];
+    }
+    for ( int fId = 0; fId < nBFaces; ++ fId )
+    {
+        f2cCell[ this->nFineCells + fId ] = grid->nCells + f2cFace[ fId ];
+    }
+}
+
+void Agglomeration::CalcMetrics()
+{
+    UnsGrid * grid = this->coarseGrid;
+    grid->AllocMetrics();
+
+    FaceMesh * fFaceMesh = this->fineGrid->faceMesh;
+    CellMesh * fCellMesh = this->fineGrid->cellMesh;
+    FaceMesh * faceMesh = grid->faceMesh;
+    CellMesh * cellMesh = grid->cellMesh;
+    IntField & fLCells = this->fineGrid->faceTopo->lCells;
+    IntField & lCells = grid->faceTopo->lCells;
+    IntField & f2cFace = this->fineGrid->f2cFace;
+
+    int nFaces = grid->nFaces;
+    int nBFaces = grid->nBFaces;
+    int nCells = grid->nCells;
+
+    faceMesh->xfn = 0;
+    faceMesh->yfn = 0;
+    faceMesh->zfn = 0;
+    faceMesh->xfc = 0;
+    faceMesh->yfc = 0;
+    faceMesh->zfc = 0;
+    RealField asum( nFaces, 0.0 );
+
+    //The coarse face vector is the sum of the fine face vectors
+    for ( int fId = 0; fId < this->fineGrid->nFaces; ++ fId )
+    {
+        int cf = f2cFace[ fId ];
+        if ( cf < 0 ) continue;
+
+        Real a = fFaceMesh->area[ fId ];
+        Real sign = ( this->f2c[ fLCells[ fId ] ] == lCells[ cf ] ) ? 1.0 : - 1.0;
+
+        faceMesh->xfn[ cf ] += sign * fFaceMesh->xfn[ fId ] * a;
+        faceMesh->yfn[ cf ] += sign * fFaceMesh->yfn[ fId ] * a;
+        faceMesh->zfn[ cf ] += sign * fFaceMesh->zfn[ fId ] * a;
+        faceMesh->xfc[ cf ] += fFaceMesh->xfc[ fId ] * a;
+        faceMesh->yfc[ cf ] += fFaceMesh->yfc[ fId ] * a;
+        faceMesh->zfc[ cf ] += fFaceMesh->zfc[ fId ] * a;
+        asum[ cf ] += a;
+    }
+
+    for ( int cf = 0; cf < nFaces; ++ cf )
+    {
+        Real a = ONEFLOW::DIST( faceMesh->xfn[ cf ], faceMesh->yfn[ cf ], faceMesh->zfn[ cf ] );
+        Real ainv = 1.0 / ( a + SMALL );
+        Real sinv = 1.0 / ( asum[ cf ] + SMALL );
+        faceMesh->area[ cf ] = a;
+        faceMesh->xfn[ cf ] *= ainv;
+        faceMesh->yfn[ cf ] *= ainv;
+        faceMesh->zfn[ cf ] *= ainv;
+        faceMesh->xfc[ cf ] *= sinv;
+        faceMesh->yfc[ cf ] *= sinv;
+        faceMesh->zfc[ cf ] *= sinv;
+    }
+
+    RealField & xcc = cellMesh->xcc;
+    RealField & ycc = cellMesh->ycc;
+    RealField & zcc = cellMesh->zcc;
+    RealField & vol = cellMesh->vol;
+
+    xcc = 0;
+    ycc = 0;
+    zcc = 0;
+    vol = 0;
+
+    for ( int cId = 0; cId < this->nFineCells; ++ cId )
+    {
+        int cc = this->f2c[ cId ];
+        Real v = fCellMesh->vol[ cId ];
+        xcc[ cc ] += fCellMesh->xcc[ cId ] * v;
+        ycc[ cc ] += fCellMesh->ycc[ cId ] * v;
+        zcc[ cc ] += fCellMesh->zcc[ cId ] * v;
+        vol[ cc ] += v;
+    }
+
+    for ( int cc = 0; cc < nCells; ++ cc )
+    {
+        Real vinv = 1.0 / ( vol[ cc ] + SMALL );
+        xcc[ cc ] *= vinv;
+        ycc[ cc ] *= vinv;
+        zcc[ cc ] *= vinv;
+    }
+
+    // For ghost cells
+    RealField & xfn = faceMesh->xfn;
+    RealField & yfn = faceMesh->yfn;
+    RealField & zfn = faceMesh->zfn;
+    RealField & xfc = faceMesh->xfc;
+    RealField & yfc = faceMesh->yfc;
+    RealField & zfc = faceMesh->zfc;
+
+    for ( int fId = 0; fId < nBFaces; ++ fId )
+    {
+        int lc = lCells[ fId ];
+        int rc = fId + nCells;
+        if ( faceMesh->area[ fId ] > SMALL )
+        {
+            Real tmp = 2.0 * ( ( xcc[ lc ] - xfc[ fId ] ) * xfn[ fId ]
+                             + ( ycc[ lc ] - yfc[ fId ] ) * yfn[ fId ]
+                             + ( zcc[ lc ] - zfc[ fId ] ) * zfn[ fId ] );
+            xcc[ rc ] = xcc[ lc ] - xfn[ fId ] * tmp;
+            ycc[ rc ] = ycc[ lc ] - yfn[ fId ] * tmp;
+            zcc[ rc ] = zcc[ lc ] - zfn[ fId ] * tmp;
+        }
+        else
+        {
+            // Degenerated faces
+            xcc[ rc ] = - xcc[ lc ] + 2.0 * xfc[ fId ];
+            ycc[ rc ] = - ycc[ lc ] + 2.0 * yfc[ fId ];
+            zcc[ rc ] = - zcc[ lc ] + 2.0 * zfc[ fId ];
+        }
+        vol[ rc ] = vol[ lc ];
+    }
+}
+
+void Agglomeration::CreateInterFace()
+{
+    InterFace * fInterFace = this->fineGrid->interFace;
+    UnsGrid * grid = this->coarseGrid;
+
+    grid->nIFaces = fInterFace->nIFaces;
+    grid->interFace->Set( grid->nIFaces, grid );
+
+    //Interface faces are kept one to one, so the neighbor zone sees the same face numbers
+    for ( int iFace = 0; iFace < grid->nIFaces; ++ iFace )
+    {
+        grid->interFace->zoneId          [ iFace ] = fInterFace->zoneId          [ iFace ];
+        grid->interFace->localInterfaceId[ iFace ] = fInterFace->localInterfaceId[ iFace ];
+        grid->interFace->idir            [ iFace ] = fInterFace->idir            [ iFace ];
+        grid->interFace->i2b             [ iFace ] = this->fineGrid->f2cFace[ fInterFace->i2b[ iFace ] ];
+    }
+}
+
+void CreateCoarseGrids( int nLevels )
+{
+    if ( nLevels <= 1 ) return;
+
+    for ( int iZone = 0; iZone < ZoneState::nZones; ++ iZone )
+    {
+        if ( ! ZoneState::IsValidZone( iZone ) ) continue;
+
+        Grid * grid = Zone::GetGrid( iZone, 0 );
+        if ( ! ONEFLOW::IsUnsGrid( grid->type ) )
+        {
+            std::cout << " agglomeration multigrid needs unstructured zones\n";
+            exit( 0 );
+        }
+
+        for ( int gl = 1; gl < nLevels; ++ gl )
+        {
+            UnsGrid * fineGrid = ONEFLOW::UnsGridCast( Zone::GetGrid( iZone, gl - 1 ) );
+
+            Agglomeration * agglomeration = new Agglomeration();
+            UnsGrid * coarseGrid = agglomeration->Create( fineGrid );
+            delete agglomeration;
+
+            Zone::AddGrid( iZone, coarseGrid );
+
+            std::cout << " zone " << iZone << " grid level " << gl;
+            std::cout << " nCells = " << coarseGrid->nCells << " nFaces = " << coarseGrid->nFaces << std::endl;
+            logFile << " zone " << iZone << " grid level " << gl;
+            logFile << " nCells = " << coarseGrid->nCells << " nFaces = " << coarseGrid->nFaces << "\n";
+        }
+    }
+
+    GridState::nGrids = nLevels;
+}
+
+void CalcCoarseWallDist()
+{
+    for ( int iZone = 0; iZone < ZoneState::nZones; ++ iZone )
+    {
+        if ( ! ZoneState::IsValidZone( iZone ) ) continue;
+
+        for ( int gl = 1; gl < GridState::nGrids; ++ gl )
+        {
+            UnsGrid * fineGrid = ONEFLOW::UnsGridCast( Zone::GetGrid( iZone, gl - 1 ) );
+            UnsGrid * grid = ONEFLOW::UnsGridCast( Zone::GetGrid( iZone, gl ) );
+
+            RealField & fdist = fineGrid->cellMesh->dist;
+            RealField & fvol = fineGrid->cellMesh->vol;
+            RealField & dist = grid->cellMesh->dist;
+            RealField & vol = grid->cellMesh->vol;
+
+            grid->cellMesh->AllocDist();
+            dist = 0;
+
+            //Volume weighted mean of the fine cell distances
+            for ( int cId = 0; cId < fineGrid->nCells; ++ cId )
+            {
+                int cc = fineGrid->f2cCell[ cId ];
+                dist[ cc ] += fdist[ cId ] * fvol[ cId ];
+            }
+
+            for ( int cc = 0; cc < grid->nCells; ++ cc )
+            {
+                dist[ cc ] /= ( vol[ cc ] + SMALL );
+            }
+        }
+    }
+}
+
+void InitCoarseInterfaceTopo()
+{
+    for ( int iZone = 0; iZone < ZoneState::nZones; ++ iZone )
+    {
+        if ( ! ZoneState::IsValidZone( iZone ) ) continue;
+
+        InterFace * fInterFace = Zone::GetGrid( iZone, 0 )->interFace;
+        if ( ! ONEFLOW::IsValid( fInterFace ) ) continue;
+
+        for ( int gl = 1; gl < GridState::nGrids; ++ gl )
+        {
+            InterFace * interFace = Zone::GetGrid( iZone, gl )->interFace;
+
+            interFace->nNeighbor = fInterFace->nNeighbor;
+            interFace->z2n = fInterFace->z2n;
+            interFace->AllocateNeighbor();
+
+            for ( int iNei = 0; iNei < interFace->nNeighbor; ++ iNei )
+            {
+                InterfacePair * fPair = fInterFace->interFacePairs[ iNei ];
+                InterfacePair * pair = interFace->interFacePairs[ iNei ];
+                pair->zid     = fPair->zid;
+                pair->nzid    = fPair->nzid;
+                pair->nIFaces = fPair->nIFaces;
+                pair->idsend  = fPair->idsend;
+                pair->idrecv  = fPair->idrecv;
+            }
+        }
+    }
+}
+
+EndNameSpace
@@ -36,6 +36,7 @@ License
 #include "CmxTask.h"
 #include "BgField.h"
 #include "TimeSpan.h"
+#include "MonitorReduce.h"
 #include <iostream>
 
 
@@ -105,6 +106,7 @@ void MG::MultigridSolve()
 {
     this->Allocate();
     this->Run();
+    MonitorReduce::Complete();
     this->Deallocate();
 }
 
@@ -170,7 +172,16 @@ void MG::Run()
 
 void MG::InnerProcess()
 {
-    ONEFLOW::MsMgTask( "POST_PROCESS" );
+    //Residuals, forces and dumps belong to the finest grid
+    for ( int sid = 0; sid < SolverState::nSolver; ++ sid )
+    {
+        SolverState::SetTidById( sid );
+        GridState::SetGridLevel( 0 );
+        ONEFLOW::SsSgTask( "POST_PROCESS" );
+    }
+
+    //The monitoring sums of this iteration overlap with the next one
+    MonitorReduce::Start();
 }
 
 void MG::OuterProcess( TimeSpan * timeSpan )
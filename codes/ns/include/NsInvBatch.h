@@ -0,0 +1,72 @@
+/*---------------------------------------------------------------------------*\
+    OneFLOW - LargeScale Multiphysics Scientific Simulation Environment
+    Copyright (C) 2017-2023 He Xin and the OneFLOW contributors.
+-------------------------------------------------------------------------------
+License
+    This file is part of OneFLOW.
+
+    OneFLOW is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OneFLOW is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+
+#pragma once
+#include "HXDefine.h"
+#include "HXArray.h"
+BeginNameSpace( ONEFLOW )
+
+//Number of faces evaluated together by the batched flux kernels
+const int INV_BATCH = 16;
+
+//Inviscid flux of a block of faces. The face data are stored as structure of arrays,
+//one lane per face, so that the compiler can evaluate the lanes with vector instructions.
+//Every kernel gives the same result as the scalar scheme of NsInvFlux.
+class NsInvBatch
+{
+public:
+    NsInvBatch();
+    ~NsInvBatch();
+public:
+    typedef void ( NsInvBatch:: * BatchFluxPointer )( int nFaces );
+public:
+    static bool IsBatched( int schemeId );
+    void Init( int nEqu, int nBEqu, int schemeId );
+    void Solve( int nFaces );
+public:
+    void Roe    ( int nFaces );
+    void Hlle   ( int nFaces );
+    void AusmpUp( int nFaces );
+    void Slau2  ( int nFaces );
+public:
+    BatchFluxPointer batchFluxPointer;
+    int nEqu, nBEqu;
+    int ieigenfix;
+    Real centropy1, centropy2;
+    Real m2ref;
+public:
+    int  face [ INV_BATCH ];
+    Real xfn  [ INV_BATCH ];
+    Real yfn  [ INV_BATCH ];
+    Real zfn  [ INV_BATCH ];
+    Real vfn  [ INV_BATCH ];
+    Real farea[ INV_BATCH ];
+    Real gama1[ INV_BATCH ];
+    Real gama2[ INV_BATCH ];
+    //Lane values the kernels hand on to the equations beyond nBEqu
+    Real s1[ INV_BATCH ], s2[ INV_BATCH ], s3[ INV_BATCH ], s4[ INV_BATCH ];
+    //Left and right primitive variables and flux, entry iEqu * INV_BATCH + lane
+    RealField prim1, prim2, flux;
+};
+
+EndNameSpace
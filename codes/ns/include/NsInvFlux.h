@@ -24,6 +24,8 @@ License
 #pragma once
 #include "HXDefine.h"
 #include "HXArray.h"
+#include "Com.h"
+#include "NsCom.h"
 BeginNameSpace( ONEFLOW )
 
 const int ISCHEME_ROE            = 1;
@@ -106,6 +108,12 @@ public:
     void Slau2();
 public:
     void ModifyAbsoluteEigenvalue();
+public:
+    //Face state of this flux object. Inside the member functions it hides the
+    //global of the same name, so that every thread can evaluate faces with its own flux object.
+    NsInv inv;
+    GCom gcom;
+    NsCom nscom;
 };
 
 void CalcEnthalpy( RealField & prim, Real gama, Real & enthalpy );
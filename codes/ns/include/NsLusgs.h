@@ -23,6 +23,7 @@ License
 
 #pragma once
 #include "Lusgs.h"
+#include "Com.h"
 BeginNameSpace( ONEFLOW )
 
 class LusgsData
@@ -87,6 +88,11 @@ public:
     void CalcUpperChange();
     bool IsOversetCell  ();
     void ZeroOversetCell();
+public:
+    //Sweep state of this solver object. Inside the member functions it hides the
+    //global of the same name, so that every thread can sweep with its own solver object.
+    LusgsData nslu;
+    GCom gcom;
 };
 
 void CalcDH( RealField & prim, Real & gama, RealField & dq, Real & dh, Real & totalEnthalpy );
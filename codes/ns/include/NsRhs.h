@@ -33,6 +33,8 @@ public:
     ~NsRhs();
 public:
     void UpdateResiduals() override;
+    void UpdateResidualsInner() override;
+    void UpdateResidualsHalo() override;
 };
 
 void NsCalcBc();
@@ -40,6 +42,8 @@ void NsCalcBcDebug( const std::string & title );
 void NsCalcGamaT(int flag);
 void NsCalcRHS();
 void NsCalcInvFlux();
+void NsCalcInvFluxInner();
+void NsCalcInvFluxHalo();
 void NsCalcVisFlux();
 void NsCalcSrcFlux();
 void NsCalcChemSrc();
@@ -30,6 +30,8 @@ DEFINE_DATA_CLASS( NsInitFinal );
 DEFINE_DATA_CLASS( NsVisual );
 DEFINE_DATA_CLASS( NsCalcTimeStep );
 DEFINE_DATA_CLASS( NsUpdateResiduals );
+DEFINE_DATA_CLASS( NsUpdateResidualsInner );
+DEFINE_DATA_CLASS( NsUpdateResidualsHalo );
 DEFINE_DATA_CLASS( NsImplicitMethod );
 DEFINE_DATA_CLASS( NsPostprocess );
 DEFINE_DATA_CLASS( NsFinalPostprocess );
@@ -24,6 +24,8 @@ License
 #pragma once
 #include "HXDefine.h"
 #include "VisGrad.h"
+#include "Com.h"
+#include "NsCom.h"
 BeginNameSpace( ONEFLOW )
 
 class NsVis
@@ -74,6 +76,15 @@ public:
     void CalcNew1Method();
     void CalcNew2Method();
     void ModifyFaceGrad();
+public:
+    //Face state of this flux object. Inside the member functions it hides the
+    //global of the same name, so that every thread can evaluate faces with its own flux object.
+    NsVis vis;
+    VisGrad visQ;
+    VisGrad visT;
+    VisGradGeom vgg;
+    GCom gcom;
+    NsCom nscom;
 };
 
 extern VisGrad visQ;
@@ -0,0 +1,553 @@
+/*---------------------------------------------------------------------------*\
+    OneFLOW - LargeScale Multiphysics Scientific Simulation Environment
+    Copyright (C) 2017-2023 He Xin and the OneFLOW contributors.
+-------------------------------------------------------------------------------
+License
+    This file is part of OneFLOW.
+
+    OneFLOW is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OneFLOW is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "NsInvBatch.h"
+#include "NsInvFlux.h"
+#include "NsCom.h"
+#include "NsIdx.h"
+#include "HXMath.h"
+#include "Ctrl.h"
+
+BeginNameSpace( ONEFLOW )
+
+//Copies of the Mach and pressure splittings of NsInvFlux.cpp that can be inlined into
+//the lane loops. Both branches are evaluated and one of them is selected.
+inline Real BatchFMSplit1( Real mach, Real ipn )
+{
+    return half * ( mach + ipn * ABS( mach ) );
+}
+
+inline Real BatchFMSplit2( Real mach, Real ipn )
+{
+    return ipn * fourth * SQR( mach + ipn );
+}
+
+inline Real BatchFMSplit4( Real mach, Real beta, Real ipn )
+{
+    Real fm1 = BatchFMSplit1( mach, ipn );
+    Real fm4 = BatchFMSplit2( mach, ipn ) * ( one - ipn * sixteen * beta * BatchFMSplit2( mach, - ipn ) );
+    return ( ABS( mach ) >= one ) ? fm1 : fm4;
+}
+
+inline Real BatchFPSplit5( Real mach, Real alpha, Real ipn )
+{
+    Real macha = ABS( mach );
+    Real fp1 = half * ( one + ipn * mach / ( macha + SMALL ) );
+    Real fp5 = BatchFMSplit2( mach, ipn ) * ( ( two * ipn - mach ) - ipn * sixteen * alpha * mach * BatchFMSplit2( mach,-ipn ) );
+    return ( macha >= one ) ? fp1 : fp5;
+}
+
+NsInvBatch::NsInvBatch()
+{
+    nEqu  = 0;
+    nBEqu = 0;
+    batchFluxPointer = & NsInvBatch::Roe;
+}
+
+NsInvBatch::~NsInvBatch()
+{
+    ;
+}
+
+bool NsInvBatch::IsBatched( int schemeId )
+{
+    return schemeId == ISCHEME_ROE     ||
+           schemeId == ISCHEME_HLLE    ||
+           schemeId == ISCHEME_AUSMPUP ||
+           schemeId == ISCHEME_SLAU2;
+}
+
+void NsInvBatch::Init( int nEqu, int nBEqu, int schemeId )
+{
+    this->nEqu  = nEqu;
+    this->nBEqu = nBEqu;
+
+    prim1.resize( nEqu * INV_BATCH );
+    prim2.resize( nEqu * INV_BATCH );
+    flux .resize( nEqu * INV_BATCH );
+
+    ieigenfix = ctrl.ieigenfix;
+    centropy1 = ctrl.centropy1;
+    centropy2 = ctrl.centropy2;
+    m2ref     = SQR( nscom.mach_ref );
+
+    if ( schemeId == ISCHEME_HLLE )
+    {
+        batchFluxPointer = & NsInvBatch::Hlle;
+    }
+    else if ( schemeId == ISCHEME_AUSMPUP )
+    {
+        batchFluxPointer = & NsInvBatch::AusmpUp;
+    }
+    else if ( schemeId == ISCHEME_SLAU2 )
+    {
+        batchFluxPointer = & NsInvBatch::Slau2;
+    }
+    else
+    {
+        batchFluxPointer = & NsInvBatch::Roe;
+    }
+}
+
+void NsInvBatch::Solve( int nFaces )
+{
+    ( this->*batchFluxPointer )( nFaces );
+}
+
+void NsInvBatch::Roe( int nFaces )
+{
+    const Real * p1 = & prim1[ 0 ];
+    const Real * p2 = & prim2[ 0 ];
+    Real * f = & flux[ 0 ];
+
+    #pragma omp simd
+    for ( int i = 0; i < nFaces; ++ i )
+    {
+        Real rl = p1[ IDX::IR * INV_BATCH + i ];
+        Real ul = p1[ IDX::IU * INV_BATCH + i ];
+        Real vl = p1[ IDX::IV * INV_BATCH + i ];
+        Real wl = p1[ IDX::IW * INV_BATCH + i ];
+        Real pl = p1[ IDX::IP * INV_BATCH + i ];
+
+        Real rr = p2[ IDX::IR * INV_BATCH + i ];
+        Real ur = p2[ IDX::IU * INV_BATCH + i ];
+        Real vr = p2[ IDX::IV * INV_BATCH + i ];
+        Real wr = p2[ IDX::IW * INV_BATCH + i ];
+        Real pr = p2[ IDX::IP * INV_BATCH + i ];
+
+        Real v2l = SQR( ul, vl, wl );
+        Real v2r = SQR( ur, vr, wr );
+
+        Real hl = ( gama1[ i ] / ( gama1[ i ] - one ) ) * ( pl / rl ) + half * v2l;
+        Real hr = ( gama2[ i ] / ( gama2[ i ] - one ) ) * ( pr / rr ) + half * v2r;
+
+        Real vnl = xfn[ i ] * ul + yfn[ i ] * vl + zfn[ i ] * wl - vfn[ i ];
+        Real vnr = xfn[ i ] * ur + yfn[ i ] * vr + zfn[ i ] * wr - vfn[ i ];
+
+        Real rvnl = rl * vnl;
+        Real rvnr = rr * vnr;
+
+        Real ratio = sqrt( rr / rl );
+        Real coef  = 1.0 / ( 1.0 + ratio );
+
+        Real um = ( ul + ur * ratio ) * coef;
+        Real vm = ( vl + vr * ratio ) * coef;
+        Real wm = ( wl + wr * ratio ) * coef;
+        Real hm = ( hl + hr * ratio ) * coef;
+        Real gama = ( gama1[ i ] + gama2[ i ] * ratio ) * coef;
+
+        Real v2 = SQR( um, vm, wm );
+
+        Real vnflow = xfn[ i ] * um + yfn[ i ] * vm + zfn[ i ] * wm;
+        Real vnrel  = vnflow - vfn[ i ];
+
+        Real gamm1 = gama - one;
+
+        Real c2 = gamm1 * ( hm - half * v2 );
+        Real cm = sqrt( ABS( c2 ) );
+
+        //Entropy fix
+        Real meig1 = ABS( vnrel      );
+        Real meig2 = ABS( vnrel + cm );
+        Real meig3 = ABS( vnrel - cm );
+
+        if ( ieigenfix == 1 )
+        {
+            Real maxEigenvalue = MAX( meig2, meig3 );
+            Real m1 = maxEigenvalue * centropy1;
+            Real m2 = maxEigenvalue * centropy2;
+
+            meig1 = MAX( m1, meig1 );
+            meig2 = MAX( m2, meig2 );
+            meig3 = MAX( m2, meig3 );
+        }
+
+        Real eml = ( pl / rl ) / ( gama1[ i ] - one ) + half * v2l;
+        Real emr = ( pr / rr ) / ( gama2[ i ] - one ) + half * v2r;
+
+        Real dq0 = rr - rl;
+        Real dq1 = rr * ur  - rl * ul;
+        Real dq2 = rr * vr  - rl * vl;
+        Real dq3 = rr * wr  - rl * wl;
+        Real dq4 = rr * emr - rl * eml;
+
+        Real xi1 = ( two * meig1 - meig2 - meig3 ) / ( two * c2 );
+        Real xi2 = ( meig2 - meig3 ) / ( two * cm );
+
+        Real dc   = vnflow   * dq0 -
+                    xfn[ i ] * dq1 -
+                    yfn[ i ] * dq2 -
+                    zfn[ i ] * dq3;
+        Real c2dc = c2 * dc;
+
+        Real ae = gama - one;
+        Real af = half * ae * v2;
+        Real dh = - ae * ( um * dq1 + vm * dq2 + wm * dq3 - dq4 );
+        dh += af * dq0;
+
+        Real term1 = dh   * xi1 + dc * xi2;
+        Real term2 = c2dc * xi1 + dh * xi2;
+
+        f[ IDX::IR  * INV_BATCH + i ] = half * ( ( rvnl + rvnr ) - ( meig1 * dq0 - term1 ) );
+        f[ IDX::IRU * INV_BATCH + i ] = half * ( ( ( rvnl * ul + xfn[ i ] * pl ) + ( rvnr * ur + xfn[ i ] * pr ) ) - ( meig1 * dq1 - um * term1 + xfn[ i ] * term2 ) );
+        f[ IDX::IRV * INV_BATCH + i ] = half * ( ( ( rvnl * vl + yfn[ i ] * pl ) + ( rvnr * vr + yfn[ i ] * pr ) ) - ( meig1 * dq2 - vm * term1 + yfn[ i ] * term2 ) );
+        f[ IDX::IRW * INV_BATCH + i ] = half * ( ( ( rvnl * wl + zfn[ i ] * pl ) + ( rvnr * wr + zfn[ i ] * pr ) ) - ( meig1 * dq3 - wm * term1 + zfn[ i ] * term2 ) );
+        f[ IDX::IRE * INV_BATCH + i ] = half * ( ( ( rvnl * hl + vfn[ i ] * pl ) + ( rvnr * hr + vfn[ i ] * pr ) ) - ( meig1 * dq4 - hm * term1 + vnflow * term2 ) );
+
+        s1[ i ] = rvnl;
+        s2[ i ] = rvnr;
+        s3[ i ] = meig1;
+        s4[ i ] = term1;
+    }
+
+    for ( int iEqu = nBEqu; iEqu < nEqu; ++ iEqu )
+    {
+        const Real * q1 = & prim1[ iEqu * INV_BATCH ];
+        const Real * q2 = & prim2[ iEqu * INV_BATCH ];
+        Real * fq = & flux[ iEqu * INV_BATCH ];
+
+        #pragma omp simd
+        for ( int i = 0; i < nFaces; ++ i )
+        {
+            Real rl = p1[ IDX::IR * INV_BATCH + i ];
+            Real rr = p2[ IDX::IR * INV_BATCH + i ];
+            Real dq = rr * q2[ i ] - rl * q1[ i ];
+            Real qm = half * ( q1[ i ] + q2[ i ] );
+            fq[ i ] = half * ( ( q1[ i ] * s1[ i ] + q2[ i ] * s2[ i ] ) - ( s3[ i ] * dq - qm * s4[ i ] ) );
+        }
+    }
+}
+
+void NsInvBatch::Hlle( int nFaces )
+{
+    const Real * p1 = & prim1[ 0 ];
+    const Real * p2 = & prim2[ 0 ];
+    Real * f = & flux[ 0 ];
+
+    #pragma omp simd
+    for ( int i = 0; i < nFaces; ++ i )
+    {
+        Real rl = p1[ IDX::IR * INV_BATCH + i ];
+        Real ul = p1[ IDX::IU * INV_BATCH + i ];
+        Real vl = p1[ IDX::IV * INV_BATCH + i ];
+        Real wl = p1[ IDX::IW * INV_BATCH + i ];
+        Real pl = p1[ IDX::IP * INV_BATCH + i ];
+
+        Real rr = p2[ IDX::IR * INV_BATCH + i ];
+        Real ur = p2[ IDX::IU * INV_BATCH + i ];
+        Real vr = p2[ IDX::IV * INV_BATCH + i ];
+        Real wr = p2[ IDX::IW * INV_BATCH + i ];
+        Real pr = p2[ IDX::IP * INV_BATCH + i ];
+
+        Real v2l = SQR( ul, vl, wl );
+        Real v2r = SQR( ur, vr, wr );
+
+        Real hl = ( gama1[ i ] / ( gama1[ i ] - one ) ) * ( pl / rl ) + half * v2l;
+        Real hr = ( gama2[ i ] / ( gama2[ i ] - one ) ) * ( pr / rr ) + half * v2r;
+
+        Real ratio = sqrt( rr / rl );
+        Real coef  = 1.0 / ( 1.0 + ratio );
+
+        Real rm = sqrt( rl * rr );
+        Real um = ( ul + ur * ratio ) * coef;
+        Real vm = ( vl + vr * ratio ) * coef;
+        Real wm = ( wl + wr * ratio ) * coef;
+        Real pm = ( pl + pr * ratio ) * coef;
+        Real gama = ( gama1[ i ] + gama2[ i ] * ratio ) * coef;
+
+        Real vnl = xfn[ i ] * ul + yfn[ i ] * vl + zfn[ i ] * wl - vfn[ i ];
+        Real vnr = xfn[ i ] * ur + yfn[ i ] * vr + zfn[ i ] * wr - vfn[ i ];
+
+        Real rvnl = rl * vnl;
+        Real rvnr = rr * vnr;
+
+        Real vnflow = xfn[ i ] * um + yfn[ i ] * vm + zfn[ i ] * wm;
+        Real vnrel  = vnflow - vfn[ i ];
+
+        Real cl = sqrt( gama1[ i ] * pl / ( rl + SMALL ) );
+        Real cr = sqrt( gama2[ i ] * pr / ( rr + SMALL ) );
+        Real cm = sqrt( gama * pm / ( rm + SMALL ) );
+
+        Real eml = ( pl / rl ) / ( gama1[ i ] - one ) + half * v2l;
+        Real emr = ( pr / rr ) / ( gama2[ i ] - one ) + half * v2r;
+
+        Real bm = MIN( zero, MIN( vnrel - cm, vnl - cl ) );
+        Real bp = MAX( zero, MAX( vnrel + cm, vnr + cr ) );
+
+        Real c1 = bp * bm / ( bp - bm + SMALL );
+        Real c2 = - half * ( bp + bm ) / ( bp - bm + SMALL );
+
+        Real f1[ 5 ], f2[ 5 ], q1[ 5 ], q2[ 5 ];
+
+        f1[ IDX::IR  ] = rvnl;
+        f1[ IDX::IRU ] = rvnl * ul + xfn[ i ] * pl;
+        f1[ IDX::IRV ] = rvnl * vl + yfn[ i ] * pl;
+        f1[ IDX::IRW ] = rvnl * wl + zfn[ i ] * pl;
+        f1[ IDX::IRE ] = rvnl * hl + vfn[ i ] * pl;
+
+        f2[ IDX::IR  ] = rvnr;
+        f2[ IDX::IRU ] = rvnr * ur + xfn[ i ] * pr;
+        f2[ IDX::IRV ] = rvnr * vr + yfn[ i ] * pr;
+        f2[ IDX::IRW ] = rvnr * wr + zfn[ i ] * pr;
+        f2[ IDX::IRE ] = rvnr * hr + vfn[ i ] * pr;
+
+        q1[ IDX::IR  ] = rl;
+        q1[ IDX::IRU ] = rl * ul;
+        q1[ IDX::IRV ] = rl * vl;
+        q1[ IDX::IRW ] = rl * wl;
+        q1[ IDX::IRE ] = rl * eml;
+
+        q2[ IDX::IR  ] = rr;
+        q2[ IDX::IRU ] = rr * ur;
+        q2[ IDX::IRV ] = rr * vr;
+        q2[ IDX::IRW ] = rr * wr;
+        q2[ IDX::IRE ] = rr * emr;
+
+        for ( int m = 0; m < 5; ++ m )
+        {
+            f[ m * INV_BATCH + i ] = half * ( f1[ m ] + f2[ m ] )
+                                   + c1   * ( q2[ m ] - q1[ m ] )
+                                   + c2   * ( f2[ m ] - f1[ m ] );
+        }
+
+        s1[ i ] = rvnl;
+        s2[ i ] = rvnr;
+        s3[ i ] = c1;
+        s4[ i ] = c2;
+    }
+
+    for ( int iEqu = nBEqu; iEqu < nEqu; ++ iEqu )
+    {
+        const Real * q1 = & prim1[ iEqu * INV_BATCH ];
+        const Real * q2 = & prim2[ iEqu * INV_BATCH ];
+        Real * fq = & flux[ iEqu * INV_BATCH ];
+
+        #pragma omp simd
+        for ( int i = 0; i < nFaces; ++ i )
+        {
+            Real rl = p1[ IDX::IR * INV_BATCH + i ];
+            Real rr = p2[ IDX::IR * INV_BATCH + i ];
+            Real fl = q1[ i ] * s1[ i ];
+            Real fr = q2[ i ] * s2[ i ];
+            fq[ i ] = half  * ( fl + fr )
+                    + s3[ i ] * ( rr * q2[ i ] - rl * q1[ i ] )
+                    + s4[ i ] * ( fr - fl );
+        }
+    }
+}
+
+void NsInvBatch::AusmpUp( int nFaces )
+{
+    Real fkp    = 0.25;
+    Real fsigma = one;
+
+    const Real * p1 = & prim1[ 0 ];
+    const Real * p2 = & prim2[ 0 ];
+    Real * f = & flux[ 0 ];
+
+    #pragma omp simd
+    for ( int i = 0; i < nFaces; ++ i )
+    {
+        Real rl = p1[ IDX::IR * INV_BATCH + i ];
+        Real ul = p1[ IDX::IU * INV_BATCH + i ];
+        Real vl = p1[ IDX::IV * INV_BATCH + i ];
+        Real wl = p1[ IDX::IW * INV_BATCH + i ];
+        Real pl = p1[ IDX::IP * INV_BATCH + i ];
+
+        Real rr = p2[ IDX::IR * INV_BATCH + i ];
+        Real ur = p2[ IDX::IU * INV_BATCH + i ];
+        Real vr = p2[ IDX::IV * INV_BATCH + i ];
+        Real wr = p2[ IDX::IW * INV_BATCH + i ];
+        Real pr = p2[ IDX::IP * INV_BATCH + i ];
+
+        Real v2l = SQR( ul, vl, wl );
+        Real v2r = SQR( ur, vr, wr );
+
+        Real hl = ( gama1[ i ] / ( gama1[ i ] - one ) ) * ( pl / rl ) + half * v2l;
+        Real hr = ( gama2[ i ] / ( gama2[ i ] - one ) ) * ( pr / rr ) + half * v2r;
+
+        Real vnl = xfn[ i ] * ul + yfn[ i ] * vl + zfn[ i ] * wl - vfn[ i ];
+        Real vnr = xfn[ i ] * ur + yfn[ i ] * vr + zfn[ i ] * wr - vfn[ i ];
+
+        Real gama = half * ( gama1[ i ] + gama2[ i ] );
+
+        Real orl = 1.0 / ( rl + SMALL );
+        Real orr = 1.0 / ( rr + SMALL );
+
+        Real c2l = gama * pl * orl;
+        Real c2r = gama * pr * orr;
+
+        //fourth speed interface
+        Real cl = sqrt( c2l );
+        Real cr = sqrt( c2r );
+        Real cm = half * ( cl + cr );
+
+        Real cm2 = cm * cm;
+        Real ocm = one / ( cm + SMALL );
+
+        Real rm = half * ( rl + rr );
+
+        Real ml = vnl * ocm;
+        Real mr = vnr * ocm;
+
+        Real ma2 = ( v2l + v2r ) / ( two * cm2 );
+        Real m02 = MIN( one, MAX( ma2, m2ref ) );
+        Real m0  = sqrt( m02 );
+
+        Real fa  = m0 * ( two - m0 );
+
+        Real alphac = 3.0 / 16.0 * ( - four + five * fa * fa );
+        Real betac  = 0.125;
+
+        Real fm4ml = BatchFMSplit4( ml, betac,  one );
+        Real fm4mr = BatchFMSplit4( mr, betac, -one );
+
+        Real fp5ml = BatchFPSplit5( ml, alphac,  one );
+        Real fp5mr = BatchFPSplit5( mr, alphac, -one );
+
+        Real mp  = - fkp / fa * MAX( one - fsigma * ma2, zero ) * ( pr - pl ) / ( rm * cm2 );
+        Real pu  = zero;
+
+        Real mi  = fm4ml + fm4mr + mp;
+        Real p12 = fp5ml * pl + fp5mr * pr + pu;
+
+        Real rvn = ( mi > zero ) ? cm * mi * rl : cm * mi * rr;
+
+        bool upwindLeft = rvn > zero;
+
+        f[ IDX::IR  * INV_BATCH + i ] = rvn;
+        f[ IDX::IRU * INV_BATCH + i ] = rvn * ( upwindLeft ? ul : ur ) + xfn[ i ] * p12;
+        f[ IDX::IRV * INV_BATCH + i ] = rvn * ( upwindLeft ? vl : vr ) + yfn[ i ] * p12;
+        f[ IDX::IRW * INV_BATCH + i ] = rvn * ( upwindLeft ? wl : wr ) + zfn[ i ] * p12;
+        f[ IDX::IRE * INV_BATCH + i ] = rvn * ( upwindLeft ? hl : hr ) + vfn[ i ] * p12;
+
+        s1[ i ] = rvn;
+    }
+
+    for ( int iEqu = nBEqu; iEqu < nEqu; ++ iEqu )
+    {
+        const Real * q1 = & prim1[ iEqu * INV_BATCH ];
+        const Real * q2 = & prim2[ iEqu * INV_BATCH ];
+        Real * fq = & flux[ iEqu * INV_BATCH ];
+
+        #pragma omp simd
+        for ( int i = 0; i < nFaces; ++ i )
+        {
+            fq[ i ] = s1[ i ] * ( ( s1[ i ] > zero ) ? q1[ i ] : q2[ i ] );
+        }
+    }
+}
+
+void NsInvBatch::Slau2( int nFaces )
+{
+    const Real * p1 = & prim1[ 0 ];
+    const Real * p2 = & prim2[ 0 ];
+    Real * f = & flux[ 0 ];
+
+    #pragma omp simd
+    for ( int i = 0; i < nFaces; ++ i )
+    {
+        Real rl = p1[ IDX::IR * INV_BATCH + i ];
+        Real ul = p1[ IDX::IU * INV_BATCH + i ];
+        Real vl = p1[ IDX::IV * INV_BATCH + i ];
+        Real wl = p1[ IDX::IW * INV_BATCH + i ];
+        Real pl = p1[ IDX::IP * INV_BATCH + i ];
+
+        Real rr = p2[ IDX::IR * INV_BATCH + i ];
+        Real ur = p2[ IDX::IU * INV_BATCH + i ];
+        Real vr = p2[ IDX::IV * INV_BATCH + i ];
+        Real wr = p2[ IDX::IW * INV_BATCH + i ];
+        Real pr = p2[ IDX::IP * INV_BATCH + i ];
+
+        Real v2l = SQR( ul, vl, wl );
+        Real v2r = SQR( ur, vr, wr );
+
+        Real hl = ( gama1[ i ] / ( gama1[ i ] - one ) ) * ( pl / rl ) + half * v2l;
+        Real hr = ( gama2[ i ] / ( gama2[ i ] - one ) ) * ( pr / rr ) + half * v2r;
+
+        Real vnl = xfn[ i ] * ul + yfn[ i ] * vl + zfn[ i ] * wl - vfn[ i ];
+        Real vnr = xfn[ i ] * ur + yfn[ i ] * vr + zfn[ i ] * wr - vfn[ i ];
+
+        Real orl = 1.0 / ( rl + SMALL );
+        Real orr = 1.0 / ( rr + SMALL );
+
+        Real c2l = gama1[ i ] * pl * orl;
+        Real c2r = gama2[ i ] * pr * orr;
+
+        Real cl = sqrt( c2l );
+        Real cr = sqrt( c2r );
+
+        Real cm = half * ( cl + cr ); //middle sound speed
+
+        Real t = rr / rl;
+        Real vna = ( ABS( vnl ) + t * ABS( vnr ) ) / ( 1 + t );
+
+        Real ml = vnl / cm;
+        Real mr = vnr / cm;
+
+        Real g = - MAX( MIN( ml, 0.0), -1.0 ) * MIN( MAX( mr, 0.0), 1.0 );
+
+        Real vnp = ( 1 - g ) * vna + g * ABS( vnl );
+        Real vnn = ( 1 - g ) * vna + g * ABS( vnr );
+
+        Real va = sqrt( half * ( v2l + v2r ) );
+        Real m12 = MIN( 1.0, va / cm );
+        Real ka = SQR( 1 - m12 );
+
+        Real ms = half * ( rl * ( vnl + vnp ) + rr * ( vnr - vnn ) - ka * ( pr - pl ) / cm );
+
+        Real fp5ml = BatchFPSplit5( ml, zero,  one );
+        Real fp5mr = BatchFPSplit5( mr, zero, -one );
+
+        Real ps = 0;
+        ps += half * ( pl + pr );
+        ps += half * ( fp5ml - fp5mr ) * ( pl - pr );
+        ps += va *( fp5ml + fp5mr - 1 ) * sqrt( rl * rr ) * cm;
+
+        Real mp = half * ( ms + ABS( ms ) );
+        Real mn = half * ( ms - ABS( ms ) );
+
+        f[ IDX::IR  * INV_BATCH + i ] = ( mp      + mn      );
+        f[ IDX::IRU * INV_BATCH + i ] = ( mp * ul + mn * ur ) + xfn[ i ] * ps;
+        f[ IDX::IRV * INV_BATCH + i ] = ( mp * vl + mn * vr ) + yfn[ i ] * ps;
+        f[ IDX::IRW * INV_BATCH + i ] = ( mp * wl + mn * wr ) + zfn[ i ] * ps;
+        f[ IDX::IRE * INV_BATCH + i ] = ( mp * hl + mn * hr ) + vfn[ i ] * ps;
+
+        s1[ i ] = mp;
+        s2[ i ] = mn;
+    }
+
+    for ( int iEqu = nBEqu; iEqu < nEqu; ++ iEqu )
+    {
+        const Real * q1 = & prim1[ iEqu * INV_BATCH ];
+        const Real * q2 = & prim2[ iEqu * INV_BATCH ];
+        Real * fq = & flux[ iEqu * INV_BATCH ];
+
+        #pragma omp simd
+        for ( int i = 0; i < nFaces; ++ i )
+        {
+            fq[ i ] = ( s1[ i ] * q1[ i ] + s2[ i ] * q2[ i ] );
+        }
+    }
+}
+
+EndNameSpace
@@ -34,7 +34,22 @@ LusgsData nslu;
 
 LusgsData::LusgsData()
 {
-    ;
+    nEqu = 0;
+    nBEqu = 0;
+    numberOfSweeps = 0;
+    numberOfRealSweeps = 0;
+    keyPrim = false;
+    tol = 0.0;
+    norm0 = 0.0;
+    dqSweep = 0.0;
+    dmax = 0.0;
+    norm = 0.0;
+    gama = 0.0;
+    rad = 0.0;
+    lmdOnFace1 = 0.0;
+    lmdOnFace2 = 0.0;
+    lmdOnFace3 = 0.0;
+    visrad = 0.0;
 }
 
 LusgsData::~LusgsData()
@@ -56,6 +56,20 @@ void NsRhs::UpdateResiduals()
 	NsCalcRHS();
 }
 
+void NsRhs::UpdateResidualsInner()
+{
+	NsCalcInvFluxInner();
+}
+
+void NsRhs::UpdateResidualsHalo()
+{
+	NsCalcInvFluxHalo();
+
+	NsCalcVisFlux();
+
+	NsCalcSrcFlux();
+}
+
 void NsCalcBc()
 {
 	UNsBcSolver * uNsBcSolver = new UNsBcSolver();
@@ -120,6 +134,20 @@ void NsCalcInvFlux()
 	delete uNsInvFlux;
 }
 
+void NsCalcInvFluxInner()
+{
+	UNsInvFlux * uNsInvFlux = new UNsInvFlux();
+	uNsInvFlux->CalcFluxInner();
+	delete uNsInvFlux;
+}
+
+void NsCalcInvFluxHalo()
+{
+	UNsInvFlux * uNsInvFlux = new UNsInvFlux();
+	uNsInvFlux->CalcFluxHalo();
+	delete uNsInvFlux;
+}
+
 void NsCalcVisFlux()
 {
 	UNsVisFlux * uNsVisFlux = new UNsVisFlux();
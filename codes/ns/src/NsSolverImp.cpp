@@ -48,6 +48,8 @@ void RegisterNsFunc()
     REGISTER_DATA_CLASS( NsVisual );
     REGISTER_DATA_CLASS( NsCalcTimeStep );
     REGISTER_DATA_CLASS( NsUpdateResiduals );
+    REGISTER_DATA_CLASS( NsUpdateResidualsInner );
+    REGISTER_DATA_CLASS( NsUpdateResidualsHalo );
     REGISTER_DATA_CLASS( NsImplicitMethod );
     REGISTER_DATA_CLASS( NsPostprocess );
     REGISTER_DATA_CLASS( NsFinalPostprocess );
@@ -66,20 +68,8 @@ void NsInitFinal( StringField & data )
     //NsCalcGamaT( F_GHOST );
     //CalcLaminarViscosity( F_GHOST );
 
+    //The coarse grid levels run INIT_FINAL themselves
     NsCalcBoundary( data );
-
-    Grid * grid = Zone::GetGrid();
-
-    if ( Zone::GetCGrid( grid ) )
-    {
-        //RestrictAllQ( NS_SOLVER, FLOW_FIELD_INDEX );
-
-        GridState::gridLevel += 1;
-
-        NsCalcBoundary( data );
-
-        GridState::gridLevel -= 1;
-    }
 }
 
 void NsVisual( StringField & data )
@@ -110,6 +100,20 @@ void NsUpdateResiduals( StringField & data )
     delete rhs;
 }
 
+void NsUpdateResidualsInner( StringField & data )
+{
+    Rhs * rhs = new NsRhs();
+    rhs->UpdateResidualsInner();
+    delete rhs;
+}
+
+void NsUpdateResidualsHalo( StringField & data )
+{
+    Rhs * rhs = new NsRhs();
+    rhs->UpdateResidualsHalo();
+    delete rhs;
+}
+
 void NsImplicitMethod( StringField & data )
 {
     ;
@@ -118,7 +122,7 @@ void NsImplicitMethod( StringField & data )
 void NsPostprocess( StringField & data )
 {
     //After every Iter, the first thing to consider is communication.
-    CommInterfaceData();
+    PostCommInterfaceData();
 
     //The solution and output of residuals need to be judged logically.
     if ( Iteration::ResOk() )
@@ -165,6 +169,12 @@ void DumpHeatFluxCoeff( StringField & data )
 
 void NsFinalPostprocess( StringField & data )
 {
+    //In split mode the last exchange has been left to the next residual evaluation
+    if ( ctrl.icommsplit == 1 )
+    {
+        ONEFLOW::CommInterfaceData();
+    }
+
     ONEFLOW::AddCmdToList( "DUMP_RESTART"        );
     ONEFLOW::AddCmdToList( "DUMP_AERODYNAMIC"    );
     ONEFLOW::AddCmdToList( "DUMP_PRESSURE_COEFF" );
@@ -27,8 +27,10 @@ License
 #endif
 
 #include "Configure.h"
+#include "HXTypeBasic.h"
 #include <string>
 #include <vector>
+#include <fstream>
 
 
 BeginNameSpace( ONEFLOW )
@@ -37,6 +39,7 @@ BeginNameSpace( ONEFLOW )
     typedef  MPI_Request  PL_HXRequest;
     typedef  MPI_Op       PL_Op;
     typedef  MPI_Datatype PL_Datatype;
+    typedef  MPI_File     PL_File;
 
     #define PL_REQUEST_NULL    MPI_REQUEST_NULL
     #define PL_MAX             MPI_MAX
@@ -49,6 +52,7 @@ BeginNameSpace( ONEFLOW )
     typedef  int  PL_HXRequest;
     typedef  int  PL_Op;
     typedef  int  PL_Datatype;
+    typedef  std::fstream * PL_File;
 
     #define PL_REQUEST_NULL    0
     #define PL_MAX             0
@@ -74,6 +78,9 @@ void HXRecv( void * data, int size, PL_Datatype dataType, int pid, int tag = 0 )
 void HXSendChar( void * data, int size, int pid, int tag = 0 );
 void HXRecvChar( void * data, int size, int pid, int tag = 0 );
 
+void HXISendChar( void * data, int size, int pid, int tag, PL_HXRequest * request );
+void HXIRecvChar( void * data, int size, int pid, int tag, PL_HXRequest * request );
+
 int HXWait( PL_HXRequest * request );
 int HXWait( int count, PL_HXRequest * arrayOfRequests );
 
@@ -97,6 +104,18 @@ void HXSmartRecv( T * field, int nElement, int pid, int tag )
 
 void HXReduceInt( void * s, void * t, int nElem, PL_Op op );
 void HXReduceReal( void * s, void * t, int nElem, PL_Op op );
+void HXReduceLongLong( HXLongLong_t * s, HXLongLong_t * t, int nElem, PL_Op op );
+void HXIReduceReal( void * s, void * t, int nElem, PL_Op op, PL_HXRequest * request );
+
+//Every process sends nElem integers to every process, s and t hold nElem * nProc of them
+void HXAllToAllInt( int * s, int * t, int nElem );
+
+//Shared file opened by every process, each process reads and writes its own ranges
+void HXFileOpen( const std::string & fileName, bool writeFlag, PL_File * file );
+void HXFileClose( PL_File * file );
+void HXFileSetSize( PL_File file, HXLongLong_t size );
+void HXFileReadAt( PL_File file, HXLongLong_t offset, void * data, HXLongLong_t size );
+void HXFileWriteAt( PL_File file, HXLongLong_t offset, void * data, HXLongLong_t size );
 
 
 EndNameSpace
@@ -0,0 +1,103 @@
+/*---------------------------------------------------------------------------*\
+    OneFLOW - LargeScale Multiphysics Scientific Simulation Environment
+    Copyright (C) 2017-2023 He Xin and the OneFLOW contributors.
+-------------------------------------------------------------------------------
+License
+    This file is part of OneFLOW.
+
+    OneFLOW is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OneFLOW is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#pragma once
+#include "BasicParallel.h"
+#include "HXDefine.h"
+#include <vector>
+#include <map>
+#include <tuple>
+
+
+BeginNameSpace( ONEFLOW )
+
+class DataBook;
+
+//One directed interface message: zone sZone sends to its iNei-th neighbor rZone
+class ExchangePair
+{
+public:
+    ExchangePair();
+    ~ExchangePair();
+public:
+    int sZone, rZone;
+    int sPid, rPid;
+    int iNei;
+    int sizeTag, dataTag;
+    DataBook * dataBook;
+    std::vector< char > buffer;
+};
+
+//Message sizes are set by the interface topology, the solver, the task and the grid level
+typedef std::tuple< int, int, int > ExchangeKey;
+
+//Each kind of interface message has its own range of tags, the base of the kind plus the
+//sending zone. The ranges lie above the small fixed tags of the other point-to-point messages
+const int INTERFACE_TAG_OFFSET = 16;
+const int INTERFACE_SIZE_MSG = 0;
+const int INTERFACE_DATA_MSG = 1;
+
+//The payload lengths the receivers of one exchange kind post, swapped on its first exchange
+//and raised by the senders when a message outgrows them
+class ExchangeSize
+{
+public:
+    std::vector< int > recvSize;
+    std::vector< int > sendSize;
+};
+
+//Per-process interface exchange schedule built once from interFaceTopo.
+//All sends and receives of one batch are posted together and completed with a single wait,
+//pairs whose zones live on the same process are copied directly without MPI.
+class InterfaceExchange
+{
+public:
+    InterfaceExchange();
+    ~InterfaceExchange();
+public:
+    bool initFlag;
+    HXVector< ExchangePair * > sendList;
+    HXVector< ExchangePair * > recvList;
+    HXVector< ExchangePair * > localList;
+    std::map< ExchangeKey, ExchangeSize > sizeMap;
+    std::vector< PL_HXRequest > requests;
+    ExchangeSize * pendingSize;
+    bool pending;
+public:
+    void Init();
+    void Reset();
+    void Exchange( VoidFunc sendAction, VoidFunc recvAction, const ExchangeKey & key );
+    void Start( VoidFunc sendAction, const ExchangeKey & key );
+    void Finish( VoidFunc recvAction );
+    bool IsPending() { return pending; }
+protected:
+    void Pack( ExchangePair * exchangePair, VoidFunc sendAction );
+    void Unpack( ExchangePair * exchangePair, VoidFunc recvAction );
+    //Swaps the payload lengths on the first exchange of a key
+    ExchangeSize & GetExchangeSize( const ExchangeKey & key );
+    static int GetTag( int msgKind, int zoneId );
+    void Free();
+};
+
+extern InterfaceExchange interfaceExchange;
+
+EndNameSpace
@@ -20,9 +20,46 @@ License
 
 \*---------------------------------------------------------------------------*/
 
-#include "Memop.h"
+
+#pragma once
+#include "BasicParallel.h"
+#include "HXDefine.h"
 
 
 BeginNameSpace( ONEFLOW )
 
+//Local values of one monitoring output, Finish is called with their sums over all processors
+class MonitorClient
+{
+public:
+    MonitorClient();
+    virtual ~MonitorClient();
+public:
+    int start;
+public:
+    virtual void Finish( Real * sum ) = 0;
+};
+
+//Sums the values of all monitoring clients of one iteration with a single non-blocking reduction.
+//The clients are finished when the next batch starts or at Complete, so the output lags one
+//iteration behind the solver when there is more than one processor.
+class MonitorReduce
+{
+public:
+    MonitorReduce();
+    ~MonitorReduce();
+public:
+    static RealField values;
+    static HXVector< MonitorClient * > clients;
+    static RealField sendBuffer;
+    static RealField recvBuffer;
+    static HXVector< MonitorClient * > pending;
+    static PL_HXRequest request;
+public:
+    //The client is owned by MonitorReduce from now on
+    static void Add( MonitorClient * client, Real * value, int nValue );
+    static void Start();
+    static void Complete();
+};
+
 EndNameSpace
@@ -21,11 +21,20 @@ License
 \*---------------------------------------------------------------------------*/
 
 #include "BasicParallel.h"
+#include "Stop.h"
+#include "Profiler.h"
 #include <iostream>
+#include <map>
 
 
 BeginNameSpace( ONEFLOW )
 
+void CountSwapBytes( int nBytes )
+{
+    static int profileId = Profiler::GetId( "swap_bytes", PROFILE_COUNTER );
+    Profiler::AddCount( profileId, nBytes );
+}
+
 void HXFinalize()
 {
 #ifdef HX_PARALLEL
@@ -85,6 +94,9 @@ void HXSend( void * data, int size, PL_Datatype dataType, int pid, int tag )
 {
 #ifdef HX_PARALLEL
     if ( size <= 0 ) return;
+    int typeSize = 0;
+    MPI_Type_size( dataType, & typeSize );
+    ONEFLOW::CountSwapBytes( size * typeSize );
     MPI_Send( data, size, dataType, pid, tag, MPI_COMM_WORLD );
 #endif
 }
@@ -104,6 +116,7 @@ void HXSendChar( void * data, int size, int pid, int tag )
 #ifdef HX_PARALLEL
     //Prevent special circumstances
     if ( size <= 0 ) return;
+    ONEFLOW::CountSwapBytes( size );
     MPI_Send( data, size, MPI_CHAR, pid, tag, MPI_COMM_WORLD );
 #endif
 }
@@ -119,6 +132,25 @@ void HXRecvChar( void * data, int size, int pid, int tag )
 #endif
 }
 
+void HXISendChar( void * data, int size, int pid, int tag, PL_HXRequest * request )
+{
+    * request = PL_REQUEST_NULL;
+#ifdef HX_PARALLEL
+    if ( size <= 0 ) return;
+    ONEFLOW::CountSwapBytes( size );
+    MPI_Isend( data, size, MPI_CHAR, pid, tag, MPI_COMM_WORLD, request );
+#endif
+}
+
+void HXIRecvChar( void * data, int size, int pid, int tag, PL_HXRequest * request )
+{
+    * request = PL_REQUEST_NULL;
+#ifdef HX_PARALLEL
+    if ( size <= 0 ) return;
+    MPI_Irecv( data, size, MPI_CHAR, pid, tag, MPI_COMM_WORLD, request );
+#endif
+}
+
 int HXWait( PL_HXRequest * request )
 {
     int errorCode = 0;
@@ -194,4 +226,166 @@ void HXReduceReal( void * s, void * t, int nElem, PL_Op op )
 }
 
 
+void HXReduceLongLong( HXLongLong_t * s, HXLongLong_t * t, int nElem, PL_Op op )
+{
+#ifdef HX_PARALLEL
+    MPI_Allreduce( s, t, nElem, MPI_LONG_LONG_INT, op, MPI_COMM_WORLD );
+#else
+    for ( int i = 0; i < nElem; ++ i )
+    {
+        t[ i ] = s[ i ];
+    }
+#endif
+}
+
+void HXIReduceReal( void * s, void * t, int nElem, PL_Op op, PL_HXRequest * request )
+{
+    * request = PL_REQUEST_NULL;
+#ifdef HX_PARALLEL
+    MPI_Iallreduce( s, t, nElem, MPI_DOUBLE, op, MPI_COMM_WORLD, request );
+#else
+    Real * source = static_cast< Real * >( s );
+    Real * target = static_cast< Real * >( t );
+    for ( int i = 0; i < nElem; ++ i )
+    {
+        target[ i ] = source[ i ];
+    }
+#endif
+}
+
+void HXAllToAllInt( int * s, int * t, int nElem )
+{
+#ifdef HX_PARALLEL
+    MPI_Alltoall( s, nElem, MPI_INT, t, nElem, MPI_INT, MPI_COMM_WORLD );
+#else
+    for ( int i = 0; i < nElem; ++ i )
+    {
+        t[ i ] = s[ i ];
+    }
+#endif
+}
+
+//MPI counts are int, large ranges are moved in pieces
+const HXLongLong_t MAX_FILE_CHUNK = 1 << 30;
+
+//Names of the open shared files, for the messages of the failed calls
+static std::map< PL_File, std::string > fileNameMap;
+
+static void HXFileError( const std::string & action, PL_File file )
+{
+    std::cout << "could not " << action << " " << fileNameMap[ file ] << std::endl;
+    Stop( "" );
+}
+
+void HXFileOpen( const std::string & fileName, bool writeFlag, PL_File * file )
+{
+#ifdef HX_PARALLEL
+    int amode = writeFlag ? ( MPI_MODE_CREATE | MPI_MODE_WRONLY ) : MPI_MODE_RDONLY;
+    bool err = ( MPI_File_open( MPI_COMM_WORLD, const_cast< char * >( fileName.c_str() ), amode, MPI_INFO_NULL, file ) != MPI_SUCCESS );
+#else
+    std::ios_base::openmode openMode = std::ios_base::binary;
+    openMode |= writeFlag ? ( std::ios_base::out | std::ios_base::trunc ) : std::ios_base::in;
+    * file = new std::fstream( fileName.c_str(), openMode );
+    bool err = ! ( * * file );
+#endif
+    if ( err )
+    {
+        std::cout << "could not open " << fileName << std::endl;
+        Stop( "" );
+    }
+    fileNameMap[ * file ] = fileName;
+}
+
+void HXFileClose( PL_File * file )
+{
+#ifdef HX_PARALLEL
+    PL_File handle = * file;
+    if ( MPI_File_close( file ) != MPI_SUCCESS )
+    {
+        HXFileError( "close", handle );
+    }
+    fileNameMap.erase( handle );
+#else
+    ( * file )->close();
+    if ( ( * file )->fail() )
+    {
+        HXFileError( "close", * file );
+    }
+    fileNameMap.erase( * file );
+    delete * file;
+    * file = 0;
+#endif
+}
+
+void HXFileSetSize( PL_File file, HXLongLong_t size )
+{
+#ifdef HX_PARALLEL
+    if ( MPI_File_set_size( file, size ) != MPI_SUCCESS )
+    {
+        HXFileError( "resize", file );
+    }
+#endif
+}
+
+void HXFileReadAt( PL_File file, HXLongLong_t offset, void * data, HXLongLong_t size )
+{
+    char * buffer = static_cast< char * >( data );
+#ifdef HX_PARALLEL
+    while ( size > 0 )
+    {
+        int nChunk = static_cast< int >( size < MAX_FILE_CHUNK ? size : MAX_FILE_CHUNK );
+        MPI_Status status;
+        int nRead = 0;
+        int err = MPI_File_read_at( file, offset, buffer, nChunk, MPI_CHAR, & status );
+        if ( err == MPI_SUCCESS ) MPI_Get_count( & status, MPI_CHAR, & nRead );
+        //A short count means the file ends before the record
+        if ( err != MPI_SUCCESS || nRead != nChunk )
+        {
+            HXFileError( "read", file );
+        }
+        offset += nChunk;
+        buffer += nChunk;
+        size   -= nChunk;
+    }
+#else
+    if ( size <= 0 ) return;
+    file->seekg( offset );
+    file->read( buffer, size );
+    if ( ! ( * file ) )
+    {
+        HXFileError( "read", file );
+    }
+#endif
+}
+
+void HXFileWriteAt( PL_File file, HXLongLong_t offset, void * data, HXLongLong_t size )
+{
+    char * buffer = static_cast< char * >( data );
+#ifdef HX_PARALLEL
+    while ( size > 0 )
+    {
+        int nChunk = static_cast< int >( size < MAX_FILE_CHUNK ? size : MAX_FILE_CHUNK );
+        MPI_Status status;
+        int nWrite = 0;
+        int err = MPI_File_write_at( file, offset, buffer, nChunk, MPI_CHAR, & status );
+        if ( err == MPI_SUCCESS ) MPI_Get_count( & status, MPI_CHAR, & nWrite );
+        if ( err != MPI_SUCCESS || nWrite != nChunk )
+        {
+            HXFileError( "write", file );
+        }
+        offset += nChunk;
+        buffer += nChunk;
+        size   -= nChunk;
+    }
+#else
+    if ( size <= 0 ) return;
+    file->seekp( offset );
+    file->write( buffer, size );
+    if ( ! ( * file ) )
+    {
+        HXFileError( "write", file );
+    }
+#endif
+}
+
 EndNameSpace
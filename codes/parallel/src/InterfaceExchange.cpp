@@ -0,0 +1,327 @@
+/*---------------------------------------------------------------------------*\
+    OneFLOW - LargeScale Multiphysics Scientific Simulation Environment
+    Copyright (C) 2017-2023 He Xin and the OneFLOW contributors.
+-------------------------------------------------------------------------------
+License
+    This file is part of OneFLOW.
+
+    OneFLOW is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OneFLOW is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "InterfaceExchange.h"
+#include "Parallel.h"
+#include "DataBook.h"
+#include "Zone.h"
+#include "ZoneState.h"
+#include "ActionState.h"
+#include <cstring>
+
+
+BeginNameSpace( ONEFLOW )
+
+ExchangePair::ExchangePair()
+{
+    this->dataBook = new DataBook();
+}
+
+ExchangePair::~ExchangePair()
+{
+    delete this->dataBook;
+}
+
+InterfaceExchange interfaceExchange;
+
+InterfaceExchange::InterfaceExchange()
+{
+    this->initFlag = false;
+    this->pendingSize = 0;
+    this->pending = false;
+}
+
+InterfaceExchange::~InterfaceExchange()
+{
+    this->Free();
+}
+
+void InterfaceExchange::Free()
+{
+    for ( HXSize_t i = 0; i < this->sendList.size(); ++ i )
+    {
+        delete this->sendList[ i ];
+    }
+    for ( HXSize_t i = 0; i < this->recvList.size(); ++ i )
+    {
+        delete this->recvList[ i ];
+    }
+    for ( HXSize_t i = 0; i < this->localList.size(); ++ i )
+    {
+        delete this->localList[ i ];
+    }
+    this->sendList.resize( 0 );
+    this->recvList.resize( 0 );
+    this->localList.resize( 0 );
+}
+
+void InterfaceExchange::Reset()
+{
+    this->Free();
+    this->sizeMap.clear();
+    this->initFlag = false;
+    this->pendingSize = 0;
+    this->pending = false;
+}
+
+void InterfaceExchange::Init()
+{
+    this->Reset();
+
+    //Keep only the pairs this process takes part in, in the same global order on every process,
+    //so that messages between two processes are matched by posting order
+    for ( int iZone = 0; iZone < ZoneState::nZones; ++ iZone )
+    {
+        int nNei = Zone::GetNumberOfZoneNeighbors( iZone );
+
+        for ( int iNei = 0; iNei < nNei; ++ iNei )
+        {
+            int jZone = Zone::GetNeighborZoneId( iZone, iNei );
+
+            int sPid = ZoneState::pid[ iZone ];
+            int rPid = ZoneState::pid[ jZone ];
+
+            if ( Parallel::pid != sPid && Parallel::pid != rPid ) continue;
+
+            ExchangePair * exchangePair = new ExchangePair();
+            exchangePair->sZone = iZone;
+            exchangePair->rZone = jZone;
+            exchangePair->sPid  = sPid;
+            exchangePair->rPid  = rPid;
+            exchangePair->iNei  = iNei;
+            exchangePair->sizeTag = InterfaceExchange::GetTag( INTERFACE_SIZE_MSG, iZone );
+            exchangePair->dataTag = InterfaceExchange::GetTag( INTERFACE_DATA_MSG, iZone );
+
+            if ( sPid == rPid )
+            {
+                this->localList.push_back( exchangePair );
+            }
+            else if ( Parallel::pid == sPid )
+            {
+                this->sendList.push_back( exchangePair );
+            }
+            else
+            {
+                this->recvList.push_back( exchangePair );
+            }
+        }
+    }
+
+    this->initFlag = true;
+}
+
+void InterfaceExchange::Exchange( VoidFunc sendAction, VoidFunc recvAction, const ExchangeKey & key )
+{
+    this->Start( sendAction, key );
+    this->Finish( recvAction );
+}
+
+void InterfaceExchange::Start( VoidFunc sendAction, const ExchangeKey & key )
+{
+    if ( ! this->initFlag )
+    {
+        this->Init();
+    }
+
+    for ( HXSize_t i = 0; i < this->localList.size(); ++ i )
+    {
+        this->Pack( this->localList[ i ], sendAction );
+    }
+
+    //Every message starts with the length of its payload
+    int nHead = sizeof( int );
+
+    for ( HXSize_t i = 0; i < this->sendList.size(); ++ i )
+    {
+        ExchangePair * exchangePair = this->sendList[ i ];
+        this->Pack( exchangePair, sendAction );
+
+        DataBook * dataBook = exchangePair->dataBook;
+        int nLength = dataBook->GetSize();
+        exchangePair->buffer.resize( nHead + nLength );
+        std::memcpy( exchangePair->buffer.data(), & nLength, nHead );
+        dataBook->MoveToBegin();
+        dataBook->Read( exchangePair->buffer.data() + nHead, nLength );
+    }
+
+    ExchangeSize & exchangeSize = this->GetExchangeSize( key );
+    std::vector< int > & recvSize = exchangeSize.recvSize;
+    std::vector< int > & sendSize = exchangeSize.sendSize;
+
+    int nRecv = this->recvList.size();
+    int nSend = this->sendList.size();
+
+    this->requests.resize( nRecv + 2 * nSend );
+    int nRequests = 0;
+
+    for ( int i = 0; i < nRecv; ++ i )
+    {
+        ExchangePair * exchangePair = this->recvList[ i ];
+        int nCapacity = nHead + recvSize[ i ];
+        exchangePair->buffer.resize( nCapacity );
+        ONEFLOW::HXIRecvChar( exchangePair->buffer.data(), nCapacity, exchangePair->sPid, exchangePair->dataTag, & this->requests[ nRequests ++ ] );
+    }
+
+    //A message longer than the receiver posts is announced by its head alone, the receiver
+    //then takes the whole message, which follows on the same tag
+    for ( int i = 0; i < nSend; ++ i )
+    {
+        ExchangePair * exchangePair = this->sendList[ i ];
+        int nMessage = exchangePair->buffer.size();
+        int nLength = nMessage - nHead;
+        if ( nLength > sendSize[ i ] )
+        {
+            sendSize[ i ] = nLength;
+            ONEFLOW::HXISendChar( exchangePair->buffer.data(), nHead, exchangePair->rPid, exchangePair->dataTag, & this->requests[ nRequests ++ ] );
+        }
+        ONEFLOW::HXISendChar( exchangePair->buffer.data(), nMessage, exchangePair->rPid, exchangePair->dataTag, & this->requests[ nRequests ++ ] );
+    }
+
+    this->requests.resize( nRequests );
+    this->pendingSize = & exchangeSize;
+    this->pending = true;
+}
+
+void InterfaceExchange::Finish( VoidFunc recvAction )
+{
+    if ( ! this->pending ) return;
+
+    int nRequests = this->requests.size();
+    if ( nRequests > 0 )
+    {
+        ONEFLOW::HXWait( nRequests, this->requests.data() );
+    }
+
+    int nHead = sizeof( int );
+    std::vector< int > & recvSize = this->pendingSize->recvSize;
+
+    for ( HXSize_t i = 0; i < this->recvList.size(); ++ i )
+    {
+        ExchangePair * exchangePair = this->recvList[ i ];
+        int nLength = 0;
+        std::memcpy( & nLength, exchangePair->buffer.data(), nHead );
+
+        if ( nLength > recvSize[ i ] )
+        {
+            recvSize[ i ] = nLength;
+            exchangePair->buffer.resize( nHead + nLength );
+            ONEFLOW::HXRecvChar( exchangePair->buffer.data(), nHead + nLength, exchangePair->sPid, exchangePair->dataTag );
+        }
+
+        DataBook * dataBook = exchangePair->dataBook;
+        dataBook->MoveToBegin();
+        dataBook->ReSize( 0 );
+        dataBook->Write( exchangePair->buffer.data() + nHead, nLength );
+
+        this->Unpack( exchangePair, recvAction );
+    }
+
+    for ( HXSize_t i = 0; i < this->localList.size(); ++ i )
+    {
+        this->Unpack( this->localList[ i ], recvAction );
+    }
+
+    this->pendingSize = 0;
+    this->pending = false;
+}
+
+void InterfaceExchange::Pack( ExchangePair * exchangePair, VoidFunc sendAction )
+{
+    DataBook * dataBook = exchangePair->dataBook;
+    dataBook->MoveToBegin();
+    dataBook->ReSize( 0 );
+
+    ZoneState::zid  = exchangePair->sZone;
+    ZoneState::rzid = exchangePair->rZone;
+    ZoneState::inei = exchangePair->iNei;
+
+    ActionState::dataBook = dataBook;
+
+    sendAction();
+}
+
+void InterfaceExchange::Unpack( ExchangePair * exchangePair, VoidFunc recvAction )
+{
+    DataBook * dataBook = exchangePair->dataBook;
+    dataBook->MoveToBegin();
+
+    ZoneState::zid  = exchangePair->rZone;
+    ZoneState::szid = exchangePair->sZone;
+
+    ActionState::dataBook = dataBook;
+
+    recvAction();
+}
+
+ExchangeSize & InterfaceExchange::GetExchangeSize( const ExchangeKey & key )
+{
+    std::map< ExchangeKey, ExchangeSize >::iterator iter = this->sizeMap.find( key );
+    if ( iter != this->sizeMap.end() )
+    {
+        return iter->second;
+    }
+
+    //The first exchange of a message kind also swaps the payload lengths, later ones reuse them
+    int nHead = sizeof( int );
+    int nRecv = this->recvList.size();
+    int nSend = this->sendList.size();
+
+    ExchangeSize & exchangeSize = this->sizeMap[ key ];
+    std::vector< int > & recvSize = exchangeSize.recvSize;
+    recvSize.resize( nRecv, 0 );
+
+    std::vector< int > & sendSize = exchangeSize.sendSize;
+    sendSize.resize( nSend );
+    for ( int i = 0; i < nSend; ++ i )
+    {
+        sendSize[ i ] = this->sendList[ i ]->buffer.size() - nHead;
+    }
+
+    this->requests.resize( nRecv + nSend );
+
+    for ( int i = 0; i < nRecv; ++ i )
+    {
+        ExchangePair * exchangePair = this->recvList[ i ];
+        ONEFLOW::HXIRecvChar( & recvSize[ i ], sizeof( int ), exchangePair->sPid, exchangePair->sizeTag, & this->requests[ i ] );
+    }
+
+    for ( int i = 0; i < nSend; ++ i )
+    {
+        ExchangePair * exchangePair = this->sendList[ i ];
+        ONEFLOW::HXISendChar( & sendSize[ i ], sizeof( int ), exchangePair->rPid, exchangePair->sizeTag, & this->requests[ nRecv + i ] );
+    }
+
+    int nRequests = this->requests.size();
+    if ( nRequests > 0 )
+    {
+        ONEFLOW::HXWait( nRequests, this->requests.data() );
+    }
+
+    return exchangeSize;
+}
+
+int InterfaceExchange::GetTag( int msgKind, int zoneId )
+{
+    return INTERFACE_TAG_OFFSET + msgKind * ZoneState::nZones + zoneId;
+}
+
+EndNameSpace
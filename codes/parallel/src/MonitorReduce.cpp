@@ -0,0 +1,103 @@
+/*---------------------------------------------------------------------------*\
+    OneFLOW - LargeScale Multiphysics Scientific Simulation Environment
+    Copyright (C) 2017-2023 He Xin and the OneFLOW contributors.
+-------------------------------------------------------------------------------
+License
+    This file is part of OneFLOW.
+
+    OneFLOW is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OneFLOW is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "MonitorReduce.h"
+#include "Parallel.h"
+
+
+BeginNameSpace( ONEFLOW )
+
+MonitorClient::MonitorClient()
+{
+    this->start = 0;
+}
+
+MonitorClient::~MonitorClient()
+{
+    ;
+}
+
+RealField MonitorReduce::values;
+HXVector< MonitorClient * > MonitorReduce::clients;
+RealField MonitorReduce::sendBuffer;
+RealField MonitorReduce::recvBuffer;
+HXVector< MonitorClient * > MonitorReduce::pending;
+PL_HXRequest MonitorReduce::request = PL_REQUEST_NULL;
+
+MonitorReduce::MonitorReduce()
+{
+    ;
+}
+
+MonitorReduce::~MonitorReduce()
+{
+    ;
+}
+
+void MonitorReduce::Add( MonitorClient * client, Real * value, int nValue )
+{
+    client->start = MonitorReduce::values.size();
+    for ( int i = 0; i < nValue; ++ i )
+    {
+        MonitorReduce::values.push_back( value[ i ] );
+    }
+    MonitorReduce::clients.push_back( client );
+}
+
+void MonitorReduce::Start()
+{
+    MonitorReduce::Complete();
+
+    if ( MonitorReduce::clients.size() == 0 ) return;
+
+    MonitorReduce::sendBuffer.swap( MonitorReduce::values );
+    MonitorReduce::pending.swap( MonitorReduce::clients );
+    MonitorReduce::values.resize( 0 );
+    MonitorReduce::clients.resize( 0 );
+
+    int nValue = MonitorReduce::sendBuffer.size();
+    MonitorReduce::recvBuffer.resize( nValue );
+    HXIReduceReal( & MonitorReduce::sendBuffer[ 0 ], & MonitorReduce::recvBuffer[ 0 ], nValue, PL_SUM, & MonitorReduce::request );
+
+    //Nothing to overlap with a single processor
+    if ( Parallel::GetNProc() == 1 )
+    {
+        MonitorReduce::Complete();
+    }
+}
+
+void MonitorReduce::Complete()
+{
+    if ( MonitorReduce::pending.size() == 0 ) return;
+
+    HXWait( & MonitorReduce::request );
+
+    for ( int i = 0; i < MonitorReduce::pending.size(); ++ i )
+    {
+        MonitorClient * client = MonitorReduce::pending[ i ];
+        client->Finish( & MonitorReduce::recvBuffer[ client->start ] );
+        delete client;
+    }
+    MonitorReduce::pending.resize( 0 );
+}
+
+EndNameSpace
@@ -21,6 +21,7 @@ License
 \*---------------------------------------------------------------------------*/
 #pragma once
 #include "Configure.h"
+#include "HXTypeBasic.h"
 #include <fstream>
 #include <string>
 #include <iomanip>
@@ -33,6 +34,8 @@ BeginNameSpace( ONEFLOW )
 
 bool DirExist( const std::string & dirName );
 void MakeDir( const std::string & dirName );
+//Cuts or extends an existing file to size bytes, returns false if that failed
+bool ResizeFile( const std::string & fileName, HXLongLong_t size );
 
 std::string HX_GetExePath();
 std::string HX_GetCurrentDir();
@@ -27,11 +27,13 @@ License
 #include <windows.h>
 #include <direct.h>
 #include <io.h>
+#include <fcntl.h>
 #else
     #ifdef WIN_GNU
         #include <windows.h>
         #include <direct.h>
         #include <io.h>
+        #include <fcntl.h>
     #else
         #include <sys/stat.h>
         #include <unistd.h>
@@ -72,6 +74,19 @@ void MakeDir( const std::string & dirName )
     }
 }
 
+bool ResizeFile( const std::string & fileName, HXLongLong_t size )
+{
+#if defined( _WINDOWS ) || defined( WIN_GNU )
+    int fd = _open( fileName.c_str(), _O_RDWR | _O_BINARY );
+    if ( fd < 0 ) return false;
+    bool flag = ( _chsize_s( fd, size ) == 0 );
+    _close( fd );
+    return flag;
+#else
+    return ( truncate( fileName.c_str(), size ) == 0 );
+#endif
+}
+
 std::string HX_GetExePath()
 {
     char buffer[ FILENAME_MAX ] = { 0 };
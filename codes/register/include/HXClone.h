@@ -35,8 +35,7 @@ class HXClone;
 HXClone * Clone() const { return new TYPE( * this ); }
 
 #define REGISTER_CLASS( TYPE ) \
-    HXClone * TYPE ## _myClass = \
-        HXClone::Register( #TYPE, new TYPE() );
+    HXClone::Register( #TYPE, new TYPE() );
 
 #define C_CLASS( TYPE ) C##TYPE
 
@@ -40,7 +40,9 @@ public:
     void Init( int nEqu );
     ResAver & operator += ( const ResAver & rhs );
     void Zero();
-    void CalcAver( HXVector< ResData > & dataList );
+    //Local sums of the zones, averaged by CalcAver once they are summed over all processors
+    void CalcSum( HXVector< ResData > & dataList );
+    void CalcAver();
 };
 
 class ResMax
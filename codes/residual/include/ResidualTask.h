@@ -22,6 +22,7 @@ along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
 #pragma once
 #include "Task.h"
 #include "Residual.h"
+#include "MonitorReduce.h"
 
 BeginNameSpace( ONEFLOW )
 
@@ -35,11 +36,25 @@ public:
 public:
     void CalcRes( int sTid, ResData & data );
     void PostDumpResiduals();
-    void DumpScreen();
-    void DumpFile();
 public:
     ResData data;
     HXVector< ResData > dataList;
 };
 
+//Residuals of one iteration, written when their global sums arrive
+class ResidualReport : public MonitorClient
+{
+public:
+    ResidualReport();
+    ~ResidualReport() override;
+public:
+    int tid;
+    int outerSteps, innerSteps;
+    ResData data;
+public:
+    void Finish( Real * sum ) override;
+    void DumpScreen();
+    void DumpFile();
+};
+
 EndNameSpace
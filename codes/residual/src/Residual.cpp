@@ -49,7 +49,7 @@ void ResAver::Zero()
     this->nCells = 0;
 }
 
-void ResAver::CalcAver( HXVector< ResData > & dataList )
+void ResAver::CalcSum( HXVector< ResData > & dataList )
 {
     this->Zero();
     for ( int i = 0; i < dataList.size(); ++ i )
@@ -57,17 +57,14 @@ void ResAver::CalcAver( HXVector< ResData > & dataList )
         ResData & t = dataList[ i ];
         * this += t.resave;
     }
+}
 
+void ResAver::CalcAver()
+{
     int nEqu = this->res.size();
-    RealField resSum( nEqu );
-    int nCellSum = 0;
-    HXReduceInt( & this->nCells, & nCellSum, 1, PL_SUM );
-    HXReduceReal( & this->res[ 0 ], & resSum[ 0 ], nEqu, PL_SUM );
-
-    this->nCells = nCellSum;
     for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
     {
-        this->res[ iEqu ] = sqrt( resSum[ iEqu ] / nCellSum );
+        this->res[ iEqu ] = sqrt( this->res[ iEqu ] / this->nCells );
     }
 }
 
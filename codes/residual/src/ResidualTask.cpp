@@ -127,22 +127,58 @@ void ResidualTask::CalcRes( int sTid, ResData & data )
 
 void ResidualTask::PostDumpResiduals()
 {
-    size_t nEqu = this->data.resave.res.size();
-    this->data.resave.CalcAver( dataList );
+    this->data.resave.CalcSum( dataList );
     this->data.resmax.CalcMax( dataList );
 
+    ResidualReport * report = new ResidualReport();
+    report->tid = SolverState::tid;
+    report->outerSteps = Iteration::outerSteps;
+    report->innerSteps = Iteration::innerSteps;
+    report->data = this->data;
+
+    int nEqu = this->data.resave.res.size();
+    RealField local( nEqu + 1 );
+    local[ 0 ] = this->data.resave.nCells;
+    for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
+    {
+        local[ iEqu + 1 ] = this->data.resave.res[ iEqu ];
+    }
+
+    MonitorReduce::Add( report, & local[ 0 ], nEqu + 1 );
+}
+
+ResidualReport::ResidualReport()
+{
+    ;
+}
+
+ResidualReport::~ResidualReport()
+{
+    ;
+}
+
+void ResidualReport::Finish( Real * sum )
+{
+    int nEqu = this->data.resave.res.size();
+    this->data.resave.nCells = static_cast< int >( sum[ 0 ] );
+    for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
+    {
+        this->data.resave.res[ iEqu ] = sum[ iEqu + 1 ];
+    }
+    this->data.resave.CalcAver();
+
     if ( Parallel::pid != Parallel::serverid ) return;
 
     this->DumpScreen();
     this->DumpFile();
 }
 
-void ResidualTask::DumpFile()
+void ResidualReport::DumpFile()
 {
     std::ostringstream oss;
 
     std::fstream file;
-    SolverInfo * solverInfo = SolverInfoFactory::GetSolverInfo( SolverState::tid );
+    SolverInfo * solverInfo = SolverInfoFactory::GetSolverInfo( this->tid );
     std::string & fileName = solverInfo->resFileName;
     PIO::OpenPrjFile( file, fileName, std::ios_base::out | std::ios_base::app );
 
@@ -170,8 +206,8 @@ void ResidualTask::DumpFile()
     oss << std::setiosflags( std::ios::scientific );
     oss << std::setiosflags( std::ios::showpoint );
 
-    oss << Iteration::outerSteps << " ";
-    oss << Iteration::innerSteps << " ";
+    oss << this->outerSteps << " ";
+    oss << this->innerSteps << " ";
 
     size_t nVar = this->data.resave.res.size();
     for ( int iVar = 0; iVar < nVar; ++ iVar )
@@ -187,12 +223,12 @@ void ResidualTask::DumpFile()
 
 }
 
-void ResidualTask::DumpScreen()
+void ResidualReport::DumpScreen()
 {
     int maxId = this->data.resmax.CalcMaxId();
 
     std::ostringstream oss;
-    if ( ( Iteration::outerSteps - 1 ) % 100 == 0 )
+    if ( ( this->outerSteps - 1 ) % 100 == 0 )
     {
         oss << std::endl;
         oss << "iter initer ave  max zone cell vol  nv \n";
@@ -203,8 +239,8 @@ void ResidualTask::DumpScreen()
     oss << std::setiosflags( std::ios::scientific );
     oss << std::setiosflags( std::ios::showpoint );
 
-    oss << std::setw( 7  ) << Iteration::outerSteps;
-    oss << std::setw( 7  ) << Iteration::innerSteps;
+    oss << std::setw( 7  ) << this->outerSteps;
+    oss << std::setw( 7  ) << this->innerSteps;
     oss << std::setw( 13 ) << this->data.resave.res[ maxId ];
     oss << std::setw( 13 ) << this->data.resmax.resmax[ maxId ];
     oss << std::setw( 4  ) << this->data.resmax.zid[ maxId ] + 1;
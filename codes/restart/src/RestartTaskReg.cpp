@@ -40,6 +40,7 @@ License
 #include "FieldImp.h"
 #include "FieldWrap.h"
 #include "SolverState.h"
+#include "GridState.h"
 #include "Zone.h"
 #include "Grid.h"
 #include "UnsGrid.h"
@@ -142,6 +143,12 @@ void InitFlowField( StringField & data )
 
     int startStrategy = ONEFLOW::GetDataValue< int >( "startStrategy" );
 
+    //The coarse grid levels are not in the restart file, they start from the initial field
+    if ( GridState::gridLevel > 0 )
+    {
+        startStrategy = ( startStrategy <= 1 ) ? 0 : 2;
+    }
+
     if ( startStrategy == 0 )
     {
         ONEFLOW::AddCmdToList( "INIT_RESTART" );
@@ -32,9 +32,9 @@ BeginNameSpace( ONEFLOW )
 class DataBook;
 
 void HXWriteField( DataBook * dataBook, MRField * field2D, std::vector< int > & idMap );
-void HXWriteField( DataBook * dataBook, RealField & field, std::vector< int > & idMap );
+void HXWriteField( DataBook * dataBook, MRFieldRow field, std::vector< int > & idMap );
 void HXReadField( DataBook * dataBook, MRField * field2D, std::vector< int > & idMap );
-void HXReadField( DataBook * dataBook, RealField & field, std::vector< int > & idMap );
+void HXReadField( DataBook * dataBook, MRFieldRow field, std::vector< int > & idMap );
 
 
 EndNameSpace
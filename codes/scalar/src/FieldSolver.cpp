@@ -141,7 +141,7 @@ void FieldSolver::ZoneBoundary()
     ScalarGrid * grid = ScalarZone::GetGrid();
     int nBFaces = grid->GetNBFaces();
 
-    RealField  & q = GetFieldReference< MRField > ( grid, "q" ).AsOneD();
+    MRFieldRow q = GetFieldReference< MRField > ( grid, "q" ).AsOneD();
 
     int nTCells = grid->GetNTCells();
     for ( int iFace = 0; iFace < nBFaces; ++ iFace )
@@ -176,9 +176,9 @@ void FieldSolver::ZoneGetQLQR()
     ScalarGrid * grid = ScalarZone::GetGrid();
     int nFaces = grid->GetNFaces();
 
-    RealField & q   = GetFieldReference< MRField > ( grid, "q" ).AsOneD();
-    RealField & qf1 = GetFieldReference< MRField > ( grid, "qf1" ).AsOneD();
-    RealField & qf2 = GetFieldReference< MRField > ( grid, "qf2" ).AsOneD();
+    MRFieldRow q   = GetFieldReference< MRField > ( grid, "q" ).AsOneD();
+    MRFieldRow qf1 = GetFieldReference< MRField > ( grid, "qf1" ).AsOneD();
+    MRFieldRow qf2 = GetFieldReference< MRField > ( grid, "qf2" ).AsOneD();
 
     for ( int iFace = 0; iFace < nFaces; ++ iFace )
     {
@@ -204,9 +204,9 @@ void FieldSolver::ZoneCalcInvFlux()
 {
     ScalarGrid * grid = ScalarZone::GetGrid();
 
-    RealField & invflux = GetFieldReference< MRField > ( grid, "invflux" ).AsOneD();
-    RealField & qf1 = GetFieldReference< MRField > ( grid, "qf1" ).AsOneD();
-    RealField & qf2 = GetFieldReference< MRField > ( grid, "qf2" ).AsOneD();
+    MRFieldRow invflux = GetFieldReference< MRField > ( grid, "invflux" ).AsOneD();
+    MRFieldRow qf1 = GetFieldReference< MRField > ( grid, "qf1" ).AsOneD();
+    MRFieldRow qf2 = GetFieldReference< MRField > ( grid, "qf2" ).AsOneD();
 
     int nFaces = grid->GetNFaces();
     Real vxl = 1.0;
@@ -253,14 +253,14 @@ void FieldSolver::ZoneUpdateResidual()
 {
     ScalarGrid * grid = ScalarZone::GetGrid();
 
-    RealField & res = GetFieldReference< MRField > ( grid, "res" ).AsOneD();
-    RealField & invflux = GetFieldReference< MRField > ( grid, "invflux" ).AsOneD();
+    MRFieldRow res = GetFieldReference< MRField > ( grid, "res" ).AsOneD();
+    MRFieldRow invflux = GetFieldReference< MRField > ( grid, "invflux" ).AsOneD();
 
     res = 0;
     this->AddF2CField( grid, res, invflux );
 }
 
-void FieldSolver::AddF2CField( ScalarGrid * grid, RealField & cField, RealField & fField )
+void FieldSolver::AddF2CField( ScalarGrid * grid, MRFieldRow cField, MRFieldRow fField )
 {
     int nFaces = grid->GetNFaces();
     int nBFaces = grid->GetNBFaces();
@@ -294,7 +294,7 @@ void FieldSolver::TimeIntergral()
 void FieldSolver::ZoneTimeIntergral()
 {
     ScalarGrid * grid = ScalarZone::GetGrid();
-    RealField & res = GetFieldReference< MRField > ( grid, "res" ).AsOneD();
+    MRFieldRow res = GetFieldReference< MRField > ( grid, "res" ).AsOneD();
 
     int nCells = grid->GetNCells();
     for ( int iCell = 0; iCell < nCells; ++ iCell )
@@ -318,8 +318,8 @@ void FieldSolver::Update()
 void FieldSolver::ZoneUpdate()
 {
     ScalarGrid * grid = ScalarZone::GetGrid();
-    RealField & q = GetFieldReference< MRField > ( grid, "q" ).AsOneD();
-    RealField & res = GetFieldReference< MRField > ( grid, "res" ).AsOneD();
+    MRFieldRow q = GetFieldReference< MRField > ( grid, "q" ).AsOneD();
+    MRFieldRow res = GetFieldReference< MRField > ( grid, "res" ).AsOneD();
 
     int nCells = grid->GetNCells();
     for ( int iCell = 0; iCell < nCells; ++ iCell )
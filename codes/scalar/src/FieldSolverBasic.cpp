@@ -173,7 +173,7 @@ void FieldSolverBasic::InitFlowField_Basic()
 {
     ScalarGrid * grid = ScalarZone::GetGrid();
 
-    RealField & q   = GetFieldReference< MRField > ( grid, "q" ).AsOneD();
+    MRFieldRow q   = GetFieldReference< MRField > ( grid, "q" ).AsOneD();
 
     int nTCells = grid->GetNTCells();
 
@@ -368,7 +368,7 @@ void FieldSolverBasic::GetVisualData( DataBook * dataBook )
 {
     ScalarGrid * grid = ScalarZone::GetGrid();
 
-    RealField & q = GetFieldReference< MRField > ( grid, "q" ).AsOneD();
+    MRFieldRow q = GetFieldReference< MRField > ( grid, "q" ).AsOneD();
 
     int nCells = grid->GetNCells();
 
@@ -422,7 +422,7 @@ void FieldSolverBasic::AddVisualData( RealField & qList, RealField & theoryList,
 {
     ScalarGrid * grid = ScalarZone::GetGrid();
 
-    RealField & q = GetFieldReference< MRField > ( grid, "q" ).AsOneD();
+    MRFieldRow q = GetFieldReference< MRField > ( grid, "q" ).AsOneD();
 
     int nCells = grid->GetNCells();
 
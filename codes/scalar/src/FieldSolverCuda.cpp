@@ -120,7 +120,7 @@ void FieldSolverCuda::ZoneBoundary()
     ScalarGrid * grid = ScalarZone::GetGrid();
     int nBFaces = grid->GetNBFaces();
 
-    RealField  & q = GetFieldReference< MRField > ( grid, "q" ).AsOneD();
+    MRFieldRow q = GetFieldReference< MRField > ( grid, "q" ).AsOneD();
 
     int nTCells = grid->GetNTCells();
 
@@ -156,9 +156,9 @@ void FieldSolverCuda::ZoneGetQLQR()
     ScalarGrid * grid = ScalarZone::GetGrid();
     int nFaces = grid->GetNFaces();
 
-    RealField & q   = GetFieldReference< MRField > ( grid, "q" ).AsOneD();
-    RealField & qf1 = GetFieldReference< MRField > ( grid, "qf1" ).AsOneD();
-    RealField & qf2 = GetFieldReference< MRField > ( grid, "qf2" ).AsOneD();
+    MRFieldRow q   = GetFieldReference< MRField > ( grid, "q" ).AsOneD();
+    MRFieldRow qf1 = GetFieldReference< MRField > ( grid, "qf1" ).AsOneD();
+    MRFieldRow qf2 = GetFieldReference< MRField > ( grid, "qf2" ).AsOneD();
 
 #ifdef ENABLE_CUDA
     int nBFaces = grid->GetNBFaces();
@@ -184,9 +184,9 @@ void FieldSolverCuda::ZoneCalcInvFlux()
 {
     ScalarGrid * grid = ScalarZone::GetGrid();
 
-    RealField & invflux = GetFieldReference< MRField > ( grid, "invflux" ).AsOneD();
-    RealField & qf1 = GetFieldReference< MRField > ( grid, "qf1" ).AsOneD();
-    RealField & qf2 = GetFieldReference< MRField > ( grid, "qf2" ).AsOneD();
+    MRFieldRow invflux = GetFieldReference< MRField > ( grid, "invflux" ).AsOneD();
+    MRFieldRow qf1 = GetFieldReference< MRField > ( grid, "qf1" ).AsOneD();
+    MRFieldRow qf2 = GetFieldReference< MRField > ( grid, "qf2" ).AsOneD();
 
     int nFaces = grid->GetNFaces();
     Real vxl = 1.0;
@@ -224,9 +224,9 @@ void FieldSolverCuda::ZoneCalcInvFluxCuda()
 {
     ScalarGrid * grid = ScalarZone::GetGrid();
 
-    RealField & invflux = GetFieldReference< MRField > ( grid, "invflux" ).AsOneD();
-    RealField & qf1 = GetFieldReference< MRField > ( grid, "qf1" ).AsOneD();
-    RealField & qf2 = GetFieldReference< MRField > ( grid, "qf2" ).AsOneD();
+    MRFieldRow invflux = GetFieldReference< MRField > ( grid, "invflux" ).AsOneD();
+    MRFieldRow qf1 = GetFieldReference< MRField > ( grid, "qf1" ).AsOneD();
+    MRFieldRow qf2 = GetFieldReference< MRField > ( grid, "qf2" ).AsOneD();
 
     int nFaces = grid->GetNFaces();
     Real vxl = 1.0;
@@ -255,15 +255,15 @@ void FieldSolverCuda::ZoneUpdateResidual()
 {
     ScalarGrid * grid = ScalarZone::GetGrid();
 
-    RealField & res = GetFieldReference< MRField > ( grid, "res" ).AsOneD();
-    RealField & invflux = GetFieldReference< MRField > ( grid, "invflux" ).AsOneD();
+    MRFieldRow res = GetFieldReference< MRField > ( grid, "res" ).AsOneD();
+    MRFieldRow invflux = GetFieldReference< MRField > ( grid, "invflux" ).AsOneD();
 
     res = 0;
     this->AddF2CFieldCuda( grid, res, invflux );
     int kkk = 1;
 }
 
-void FieldSolverCuda::AddF2CField( ScalarGrid * grid, RealField & cField, RealField & fField )
+void FieldSolverCuda::AddF2CField( ScalarGrid * grid, MRFieldRow cField, MRFieldRow fField )
 {
     int nFaces = grid->GetNFaces();
     int nBFaces = grid->GetNBFaces();
@@ -284,7 +284,7 @@ void FieldSolverCuda::AddF2CField( ScalarGrid * grid, RealField & cField, RealFi
     }
 }
 
-void FieldSolverCuda::AddF2CFieldCuda( ScalarGrid * grid, RealField & cField, RealField & fField )
+void FieldSolverCuda::AddF2CFieldCuda( ScalarGrid * grid, MRFieldRow cField, MRFieldRow fField )
 {
     int nFaces = grid->GetNFaces();
     int nBFaces = grid->GetNBFaces();
@@ -308,7 +308,7 @@ void FieldSolverCuda::TimeIntergral()
 void FieldSolverCuda::ZoneTimeIntergral()
 {
     ScalarGrid * grid = ScalarZone::GetGrid();
-    RealField & res = GetFieldReference< MRField > ( grid, "res" ).AsOneD();
+    MRFieldRow res = GetFieldReference< MRField > ( grid, "res" ).AsOneD();
 
     int nCells = grid->GetNCells();
 
@@ -323,7 +323,7 @@ void FieldSolverCuda::ZoneTimeIntergral()
 void FieldSolverCuda::ZoneTimeIntergralCuda()
 {
     ScalarGrid * grid = ScalarZone::GetGrid();
-    RealField & res = GetFieldReference< MRField > ( grid, "res" ).AsOneD();
+    MRFieldRow res = GetFieldReference< MRField > ( grid, "res" ).AsOneD();
 
     int nCells = grid->GetNCells();
     int nBFaces = grid->GetNBFaces();
@@ -347,8 +347,8 @@ void FieldSolverCuda::Update()
 void FieldSolverCuda::ZoneUpdate()
 {
     ScalarGrid * grid = ScalarZone::GetGrid();
-    RealField & q = GetFieldReference< MRField > ( grid, "q" ).AsOneD();
-    RealField & res = GetFieldReference< MRField > ( grid, "res" ).AsOneD();
+    MRFieldRow q = GetFieldReference< MRField > ( grid, "q" ).AsOneD();
+    MRFieldRow res = GetFieldReference< MRField > ( grid, "res" ).AsOneD();
 
     int nCells = grid->GetNCells();
 
@@ -361,8 +361,8 @@ void FieldSolverCuda::ZoneUpdate()
 void FieldSolverCuda::ZoneUpdateCuda()
 {
     ScalarGrid * grid = ScalarZone::GetGrid();
-    RealField & q = GetFieldReference< MRField > ( grid, "q" ).AsOneD();
-    RealField & res = GetFieldReference< MRField > ( grid, "res" ).AsOneD();
+    MRFieldRow q = GetFieldReference< MRField > ( grid, "q" ).AsOneD();
+    MRFieldRow res = GetFieldReference< MRField > ( grid, "res" ).AsOneD();
 
     int nCells = grid->GetNCells();
 #ifdef ENABLE_CUDA
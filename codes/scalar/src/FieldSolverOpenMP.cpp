@@ -29,6 +29,7 @@ License
 #include "ZoneState.h"
 #include "ScalarZone.h"
 #include "HXMath.h"
+#include "FaceAssemble.h"
 
 BeginNameSpace( ONEFLOW )
 
@@ -116,7 +117,7 @@ void FieldSolverOpenMP::ZoneBoundaryOpenMP()
     ScalarGrid * grid = ScalarZone::GetGrid();
     int nBFaces = grid->GetNBFaces();
 
-    RealField  & q = GetFieldReference< MRField > ( grid, "q" ).AsOneD();
+    MRFieldRow q = GetFieldReference< MRField > ( grid, "q" ).AsOneD();
 
     int nTCells = grid->GetNTCells();
 #pragma omp parallel for
@@ -152,9 +153,9 @@ void FieldSolverOpenMP::ZoneGetQLQROpenMP()
     ScalarGrid * grid = ScalarZone::GetGrid();
     int nFaces = grid->GetNFaces();
 
-    RealField & q   = GetFieldReference< MRField > ( grid, "q" ).AsOneD();
-    RealField & qf1 = GetFieldReference< MRField > ( grid, "qf1" ).AsOneD();
-    RealField & qf2 = GetFieldReference< MRField > ( grid, "qf2" ).AsOneD();
+    MRFieldRow q   = GetFieldReference< MRField > ( grid, "q" ).AsOneD();
+    MRFieldRow qf1 = GetFieldReference< MRField > ( grid, "qf1" ).AsOneD();
+    MRFieldRow qf2 = GetFieldReference< MRField > ( grid, "qf2" ).AsOneD();
 
 #pragma omp parallel for
     for ( int iFace = 0; iFace < nFaces; ++ iFace )
@@ -181,9 +182,9 @@ void FieldSolverOpenMP::ZoneCalcInvFluxOpenMP()
 {
     ScalarGrid * grid = ScalarZone::GetGrid();
 
-    RealField & invflux = GetFieldReference< MRField > ( grid, "invflux" ).AsOneD();
-    RealField & qf1 = GetFieldReference< MRField > ( grid, "qf1" ).AsOneD();
-    RealField & qf2 = GetFieldReference< MRField > ( grid, "qf2" ).AsOneD();
+    MRFieldRow invflux = GetFieldReference< MRField > ( grid, "invflux" ).AsOneD();
+    MRFieldRow qf1 = GetFieldReference< MRField > ( grid, "qf1" ).AsOneD();
+    MRFieldRow qf2 = GetFieldReference< MRField > ( grid, "qf2" ).AsOneD();
 
     int nFaces = grid->GetNFaces();
     Real vxl = 1.0;
@@ -231,33 +232,34 @@ void FieldSolverOpenMP::ZoneUpdateResidualOpenMP()
 {
     ScalarGrid * grid = ScalarZone::GetGrid();
 
-    RealField & res = GetFieldReference< MRField > ( grid, "res" ).AsOneD();
-    RealField & invflux = GetFieldReference< MRField > ( grid, "invflux" ).AsOneD();
+    MRFieldRow res = GetFieldReference< MRField > ( grid, "res" ).AsOneD();
+    MRFieldRow invflux = GetFieldReference< MRField > ( grid, "invflux" ).AsOneD();
 
     res = 0;
     this->AddF2CFieldOpenMP( grid, res, invflux );
 }
 
-void FieldSolverOpenMP::AddF2CFieldOpenMP( ScalarGrid * grid, RealField & cField, RealField & fField )
+//Each cell gathers its own faces, so no two threads write to the same cell
+void FieldSolverOpenMP::AddF2CFieldOpenMP( ScalarGrid * grid, MRFieldRow cField, MRFieldRow fField )
 {
+    int nCells = grid->GetNCells();
     int nFaces = grid->GetNFaces();
     int nBFaces = grid->GetNBFaces();
 
-#pragma omp parallel for
-    for ( int iFace = 0; iFace < nBFaces; ++ iFace )
-    {
-        int lc = grid->lc[ iFace ];
-        cField[ lc ] -= fField[ iFace ];
-    }
+    FaceAssemble * faceAssemble = FaceAssembleFactory::GetFaceAssemble( grid, nCells, nBFaces, nFaces, & grid->lc.data[ 0 ], & grid->rc.data[ 0 ] );
+    IntField & cellStart = faceAssemble->cellStart;
+    IntField & cellFaces = faceAssemble->cellFaces;
+    IntField & cellSign  = faceAssemble->cellSign;
 
 #pragma omp parallel for
-    for ( int iFace = nBFaces; iFace < nFaces; ++ iFace )
+    for ( int iCell = 0; iCell < nCells; ++ iCell )
     {
-        int lc = grid->lc[ iFace ];
-        int rc = grid->rc[ iFace ];
-
-        cField[ lc ] -= fField[ iFace ];
-        cField[ rc ] += fField[ iFace ];
+        Real value = cField[ iCell ];
+        for ( int i = cellStart[ iCell ]; i < cellStart[ iCell + 1 ]; ++ i )
+        {
+            value += cellSign[ i ] * fField[ cellFaces[ i ] ];
+        }
+        cField[ iCell ] = value;
     }
 }
 
@@ -274,7 +276,7 @@ void FieldSolverOpenMP::TimeIntergralOpenMP()
 void FieldSolverOpenMP::ZoneTimeIntergralOpenMP()
 {
     ScalarGrid * grid = ScalarZone::GetGrid();
-    RealField & res = GetFieldReference< MRField > ( grid, "res" ).AsOneD();
+    MRFieldRow res = GetFieldReference< MRField > ( grid, "res" ).AsOneD();
 
     int nCells = grid->GetNCells();
 #pragma omp parallel for
@@ -299,8 +301,8 @@ void FieldSolverOpenMP::UpdateOpenMP()
 void FieldSolverOpenMP::ZoneUpdateOpenMP()
 {
     ScalarGrid * grid = ScalarZone::GetGrid();
-    RealField & q = GetFieldReference< MRField > ( grid, "q" ).AsOneD();
-    RealField & res = GetFieldReference< MRField > ( grid, "res" ).AsOneD();
+    MRFieldRow q = GetFieldReference< MRField > ( grid, "q" ).AsOneD();
+    MRFieldRow res = GetFieldReference< MRField > ( grid, "res" ).AsOneD();
 
     int nCells = grid->GetNCells();
 #pragma omp parallel for
@@ -36,7 +36,7 @@ void HXWriteField( DataBook * dataBook, MRField * field2D, std::vector< int > &
     }
 }
 
-void HXWriteField( DataBook * dataBook, RealField & field, std::vector< int > & idMap )
+void HXWriteField( DataBook * dataBook, MRFieldRow field, std::vector< int > & idMap )
 {
     int nElem = idMap.size();
     if ( nElem <= 0 ) return;
@@ -58,7 +58,7 @@ void HXReadField( DataBook * dataBook, MRField * field2D, std::vector< int > & i
     }
 }
 
-void HXReadField( DataBook * dataBook, RealField & field, std::vector< int > &  idMap )
+void HXReadField( DataBook * dataBook, MRFieldRow field, std::vector< int > &  idMap )
 {
     int nElem = idMap.size();
     if ( nElem <= 0 ) return;
@@ -69,6 +69,7 @@ public:
 void SetField( FieldWrap * fieldWrap, Real value );
 void SetField( MRField * field, Real value );
 void SetField( RealField & field, Real value );
+void SetField( MRFieldRow field, Real value );
 void SetField( MRField * field1, MRField * field2 );
 void NegField( MRField * field1, MRField * field2 );
 
@@ -33,6 +33,8 @@ public:
     ~Rhs();
 public:
     virtual void UpdateResiduals();
+    virtual void UpdateResidualsInner();
+    virtual void UpdateResidualsHalo();
 };
 
 EndNameSpace
@@ -27,5 +27,6 @@ License
 BeginNameSpace( ONEFLOW )
 
 void CommInterfaceData();
+void PostCommInterfaceData();
 
 EndNameSpace
@@ -28,6 +28,9 @@ BeginNameSpace( ONEFLOW )
 
 typedef void ( * TIME_INTEGRAL )( void );
 
+class TaskPlan;
+class TaskStep;
+
 const int MULTI_STAGE = 1;
 const int LUSGS = 2;
 const int SIMPLE = 3;
@@ -49,13 +52,19 @@ public:
     ~TimeIntegral();
 public:
     static TIME_INTEGRAL timeIntegral;
+    //Task sequence of every ( solver, grid level, time scheme ) recorded at its first cycle
+    static HXVector< TaskPlan * > plans;
+    static IntField planKeys;
 public:
     static void Init();
     static void Relaxation( int nCycles );
+    static TaskPlan * GetPlan();
+    static void SetStage( TaskStep * step );
 public:
     static void RungeKutta();
     static void Lusgs();
 	static void Simple();
+    static void CommAndUpdateResiduals();
 };
 
 EndNameSpace
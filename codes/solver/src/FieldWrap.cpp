@@ -198,6 +198,11 @@ void SetField( RealField & field, Real value )
     field = value;
 }
 
+void SetField( MRFieldRow field, Real value )
+{
+    field = value;
+}
+
 void SetField( MRField * field1, MRField * field2 )
 {
     int nTEqu = field1->GetNEqu();
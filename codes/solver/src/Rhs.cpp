@@ -55,4 +55,14 @@ void Rhs::UpdateResiduals()
 {
 }
 
+//Solvers without a split evaluation do all their work once the interface data has arrived
+void Rhs::UpdateResidualsInner()
+{
+}
+
+void Rhs::UpdateResidualsHalo()
+{
+    this->UpdateResiduals();
+}
+
 EndNameSpace
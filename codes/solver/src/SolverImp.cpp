@@ -22,6 +22,10 @@ License
 
 #include "SolverImp.h"
 #include "CmxTask.h"
+#include "Iteration.h"
+#include "Ctrl.h"
+#include "InterHalo.h"
+#include "SolverDef.h"
 
 BeginNameSpace( ONEFLOW )
 
@@ -32,4 +36,22 @@ void CommInterfaceData()
     ONEFLOW::AddCmdToList( "DOWNLOAD_INTERFACE_DATA");
 }
 
+void PostCommInterfaceData()
+{
+    //In split mode the exchange is done while the next residuals are evaluated,
+    //here it is only needed when the field is going to be written out
+    if ( ctrl.icommsplit == 1 )
+    {
+        if ( ! Iteration::InnerOk() ) return;
+
+        bool visualFlag = ( Iteration::outerSteps % Iteration::nVisualSave == 0 );
+        bool restartFlag = ( Iteration::outerSteps % Iteration::nFieldSave == 0 );
+
+        if ( ! visualFlag && ! restartFlag ) return;
+    }
+
+    //The interface data of the solvers go out in one message per neighbor
+    HaloStage::PostExchange( INTERFACE_DATA );
+}
+
 EndNameSpace
@@ -24,6 +24,8 @@ License
 #include "Multigrid.h"
 #include "CmxTask.h"
 #include "GridState.h"
+#include "SolverState.h"
+#include "TaskPlan.h"
 #include "Ctrl.h"
 
 BeginNameSpace( ONEFLOW )
@@ -41,6 +43,8 @@ SweepState::~SweepState()
 }
 
 TIME_INTEGRAL TimeIntegral::timeIntegral;
+HXVector< TaskPlan * > TimeIntegral::plans;
+IntField TimeIntegral::planKeys;
 
 TimeIntegral::TimeIntegral()
 {
@@ -72,9 +76,50 @@ void TimeIntegral::Init()
 void TimeIntegral::Relaxation( int nCycles )
 {
     TimeIntegral::Init();
+    TaskPlan * plan = TimeIntegral::GetPlan();
     for ( int iCycle = 0; iCycle < nCycles; ++ iCycle )
     {
-        TimeIntegral::timeIntegral();
+        plan->Run();
+    }
+}
+
+TaskPlan * TimeIntegral::GetPlan()
+{
+    int key[ 3 ] = { SolverState::tid, GridState::gridLevel, ctrl.time_integral };
+
+    int nPlans = TimeIntegral::plans.size();
+    for ( int iPlan = 0; iPlan < nPlans; ++ iPlan )
+    {
+        int * planKey = & TimeIntegral::planKeys[ 3 * iPlan ];
+        if ( planKey[ 0 ] == key[ 0 ] && planKey[ 1 ] == key[ 1 ] && planKey[ 2 ] == key[ 2 ] )
+        {
+            return TimeIntegral::plans[ iPlan ];
+        }
+    }
+
+    TaskPlan * plan = new TaskPlan();
+    TaskPlan::record = plan;
+    TimeIntegral::timeIntegral();
+    TaskPlan::record = 0;
+
+    TimeIntegral::plans.push_back( plan );
+    for ( int m = 0; m < 3; ++ m )
+    {
+        TimeIntegral::planKeys.push_back( key[ m ] );
+    }
+    return plan;
+}
+
+//arg is the Runge-Kutta stage, -1 for the single stage of the coarse grids
+void TimeIntegral::SetStage( TaskStep * step )
+{
+    if ( step->arg < 0 )
+    {
+        ctrl.lhscoef = 1.0;
+    }
+    else
+    {
+        ctrl.lhscoef = ctrl.rk_coef[ step->arg ];
     }
 }
 
@@ -83,15 +128,25 @@ void TimeIntegral::RungeKutta()
     if ( GridState::gridLevel == 0 )
     {
         ONEFLOW::SsSgTask( "LOAD_Q"        );
-        ONEFLOW::SsSgTask( "CALC_TIME_STEP" );
+        if ( ctrl.icommsplit == 0 )
+        {
+            ONEFLOW::SsSgTask( "CALC_TIME_STEP" );
+        }
 
         int nStages = ctrl.rk_coef.size();
         for ( int iStage = 0; iStage < nStages; ++ iStage )
         {
-            ctrl.lhscoef = ctrl.rk_coef[ iStage ];
+            TaskPlan::Call( & TimeIntegral::SetStage, iStage );
 
             ONEFLOW::SsSgTask( "LOAD_RESIDUALS"   );
-            ONEFLOW::SsSgTask( "UPDATE_RESIDUALS" );
+            if ( ctrl.icommsplit == 1 && iStage == 0 )
+            {
+                TimeIntegral::CommAndUpdateResiduals();
+            }
+            else
+            {
+                ONEFLOW::SsSgTask( "UPDATE_RESIDUALS" );
+            }
             ONEFLOW::SsSgTask( "CALC_LHS"          );
             ONEFLOW::SsSgTask( "UPDATE_FLOWFIELD" );
             ONEFLOW::SsSgTask( "CALC_BOUNDARY"     );
@@ -99,7 +154,7 @@ void TimeIntegral::RungeKutta()
     }
     else
     {
-        ctrl.lhscoef = 1.0;
+        TaskPlan::Call( & TimeIntegral::SetStage, -1 );
         ONEFLOW::SsSgTask( "LOAD_Q"           );
         ONEFLOW::SsSgTask( "CALC_TIME_STEP"    );
         ONEFLOW::SsSgTask( "LOAD_RESIDUALS"   );
@@ -113,9 +168,17 @@ void TimeIntegral::RungeKutta()
 void TimeIntegral::Lusgs()
 {
     ONEFLOW::SsSgTask( "ZERO_DQ_FIELD"    );
-    ONEFLOW::SsSgTask( "CALC_TIME_STEP"    );
-    ONEFLOW::SsSgTask( "LOAD_RESIDUALS"   );
-    ONEFLOW::SsSgTask( "UPDATE_RESIDUALS" );
+    if ( ctrl.icommsplit == 1 && GridState::gridLevel == 0 )
+    {
+        ONEFLOW::SsSgTask( "LOAD_RESIDUALS"   );
+        TimeIntegral::CommAndUpdateResiduals();
+    }
+    else
+    {
+        ONEFLOW::SsSgTask( "CALC_TIME_STEP"    );
+        ONEFLOW::SsSgTask( "LOAD_RESIDUALS"   );
+        ONEFLOW::SsSgTask( "UPDATE_RESIDUALS" );
+    }
     ONEFLOW::SsSgTask( "INIT_LUSGS"       );
 
     for ( int iSweep = 0; iSweep < SweepState::nSweeps; ++ iSweep )
@@ -129,6 +192,19 @@ void TimeIntegral::Lusgs()
     ONEFLOW::SsSgTask( "CALC_BOUNDARY"           );
 }
 
+//The interior faces are computed while the interface messages are in flight,
+//the time step reads the ghost cells and therefore waits for the exchange
+void TimeIntegral::CommAndUpdateResiduals()
+{
+    ONEFLOW::SsSgTask( "UPLOAD_INTERFACE_DATA"   );
+    ONEFLOW::SsSgTask( "START_INTERFACE_DATA"    );
+    ONEFLOW::SsSgTask( "UPDATE_RESIDUALS_INNER"  );
+    ONEFLOW::SsSgTask( "FINISH_INTERFACE_DATA"   );
+    ONEFLOW::SsSgTask( "DOWNLOAD_INTERFACE_DATA" );
+    ONEFLOW::SsSgTask( "CALC_TIME_STEP"          );
+    ONEFLOW::SsSgTask( "UPDATE_RESIDUALS_HALO"   );
+}
+
 void TimeIntegral::Simple()
 {
 	ONEFLOW::SsSgTask("UPDATE_RESIDUALS");
@@ -32,8 +32,25 @@ public:
     ~CUpdateInterface() override;
 public:
     void Run() override;
-protected:
-    void SwapInterfaceData( int iZone, int jZone );
+};
+
+//Posts the interface messages and returns, the data is unpacked by CFinishInterface
+class CStartInterface : public Task
+{
+public:
+    CStartInterface ();
+    ~CStartInterface() override;
+public:
+    void Run() override;
+};
+
+class CFinishInterface : public Task
+{
+public:
+    CFinishInterface ();
+    ~CFinishInterface() override;
+public:
+    void Run() override;
 };
 
 
@@ -39,6 +39,10 @@ public:
 public:
     void ServerRead();
     void ServerRead( VoidFunc mainAction );
+    void ParallelRead();
+public:
+    //true for binary zone records that every process may access directly
+    bool parallelFlag;
 };
 
 EndNameSpace
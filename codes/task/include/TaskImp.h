@@ -31,6 +31,8 @@ DEFINE_DATA_CLASS( WriteBinaryFileTask );
 DEFINE_DATA_CLASS( ServerUpdateInterfaceTask  );
 DEFINE_DATA_CLASS( WriteAsciiFileTask );
 DEFINE_DATA_CLASS( ServerUpdateOversetInterfaceTask );
+DEFINE_DATA_CLASS( ServerStartInterfaceTask );
+DEFINE_DATA_CLASS( ServerFinishInterfaceTask );
 
 void RegisterComTask();
 
@@ -0,0 +1,76 @@
+/*---------------------------------------------------------------------------*\
+    OneFLOW - LargeScale Multiphysics Scientific Simulation Environment
+    Copyright (C) 2017-2023 He Xin and the OneFLOW contributors.
+-------------------------------------------------------------------------------
+License
+    This file is part of OneFLOW.
+
+    OneFLOW is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OneFLOW is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+
+#pragma once
+#include "HXDefine.h"
+
+BeginNameSpace( ONEFLOW )
+
+class Task;
+class HXClone;
+class TaskStep;
+
+typedef void ( * StepFunction )( TaskStep * step );
+typedef void ( * TaskTimer )( TaskStep * step, double seconds );
+
+//One task of one solver, its classes are looked up at the first call only
+class TaskStep
+{
+public:
+    TaskStep();
+    ~TaskStep();
+public:
+    int msgId;
+    int tid;
+    int arg;
+    Task * task;
+    HXClone * action;
+    StepFunction run;
+};
+
+void RunSimpleStep( TaskStep * step );
+void RunGeneralStep( TaskStep * step );
+
+//Flat sequence of steps, recorded by running the task calls once with TaskPlan::record set
+class TaskPlan
+{
+public:
+    TaskPlan();
+    ~TaskPlan();
+public:
+    HXVector< TaskStep * > steps;
+public:
+    void Run();
+public:
+    static TaskPlan * record;
+    static TaskTimer timer;
+    static HXVector< HXVector< TaskStep * > > taskSteps;
+public:
+    static TaskStep * GetTaskStep( int msgId );
+    static void RunTask( int msgId );
+    static void RunStep( TaskStep * step );
+    //Steps which are not tasks, such as setting a stage coefficient
+    static void Call( StepFunction run, int arg );
+};
+
+EndNameSpace
@@ -36,6 +36,11 @@ public:
 public:
     void ServerWrite();
     void ServerWrite( VoidFunc mainAction );
+    void ParallelWrite();
+    void AsyncWrite();
+public:
+    //true for binary zone records that every process may access directly
+    bool parallelFlag;
 };
 
 EndNameSpace
@@ -38,6 +38,7 @@ License
 #include "Zone.h"
 #include "Grid.h"
 #include "LogFile.h"
+#include "TaskPlan.h"
 
 BeginNameSpace( ONEFLOW )
 
@@ -153,9 +154,7 @@ void SsSgTask( const std::string & taskName )
 {
     int taskCode = MessageMap::GetMsgId( taskName );
 
-    ONEFLOW::GenerateCmdList( taskCode );
-
-    CMD::ExecuteCmd();
+    TaskPlan::RunTask( taskCode );
 }
 
 void MsMgTask( const std::string & taskname )
@@ -28,6 +28,9 @@ License
 #include "ActionState.h"
 #include "DataBook.h"
 #include "InterFace.h"
+#include "InterfaceExchange.h"
+#include "SolverState.h"
+#include "GridState.h"
 
 BeginNameSpace( ONEFLOW )
 
@@ -44,44 +47,47 @@ CUpdateInterface::~CUpdateInterface()
 
 void CUpdateInterface::Run()
 {
-    ActionState::dataBook = this->dataBook;
-    for ( int zId = 0; zId < ZoneState::nZones; ++ zId )
-    {
-        ZoneState::zid = zId;
+    ExchangeKey key( SolverState::tid, this->taskId, GridState::gridLevel );
 
-        int nNei = Zone::GetNumberOfZoneNeighbors( zId );
+    interfaceExchange.Exchange( this->sendAction, this->recvAction, key );
 
-        for ( int iNei = 0; iNei < nNei; ++ iNei )
-        {
-            int jZone = Zone::GetNeighborZoneId( zId, iNei );
+    ActionState::dataBook = this->dataBook;
+}
+
+CStartInterface::CStartInterface()
+{
+    ;
+}
 
-            this->SwapInterfaceData( zId, jZone );
-        }
-    }
+CStartInterface::~CStartInterface()
+{
+    ;
 }
 
-void CUpdateInterface::SwapInterfaceData( int iZone, int jZone )
+void CStartInterface::Run()
 {
-    int sPid = ZoneState::pid[ iZone ];
-    int rPid = ZoneState::pid[ jZone ];
+    ExchangeKey key( SolverState::tid, this->taskId, GridState::gridLevel );
+
+    interfaceExchange.Start( this->sendAction, key );
 
-    if ( Parallel::pid == sPid )
-    {
-        ZoneState::zid  = iZone;
-        ZoneState::rzid = jZone;
+    ActionState::dataBook = this->dataBook;
+}
 
-        this->sendAction();
-    }
+CFinishInterface::CFinishInterface()
+{
+    ;
+}
 
-    HXSwapData( ActionState::dataBook, sPid, rPid );
+CFinishInterface::~CFinishInterface()
+{
+    ;
+}
 
-    if ( Parallel::pid == rPid )
-    {
-        ZoneState::zid  = jZone;
-        ZoneState::szid = iZone;
+void CFinishInterface::Run()
+{
+    interfaceExchange.Finish( this->recvAction );
 
-        this->recvAction();
-    }
+    ActionState::dataBook = this->dataBook;
 }
 
 EndNameSpace
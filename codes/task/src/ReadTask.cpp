@@ -28,11 +28,17 @@ License
 #include "ActionState.h"
 #include "DataBook.h"
 #include "InterFace.h"
+#include "TaskState.h"
+#include "FileInfo.h"
+#include "Prj.h"
+#include "Ctrl.h"
+#include "AsyncFileWriter.h"
 
 BeginNameSpace( ONEFLOW )
 
 CReadFile::CReadFile()
 {
+    this->parallelFlag = false;
 }
 
 CReadFile::~CReadFile()
@@ -42,7 +48,15 @@ CReadFile::~CReadFile()
 void CReadFile::Run()
 {
     ActionState::dataBook = this->dataBook;
-    if ( Parallel::mode == 0 )
+
+    //A checkpoint written in the background must be complete before it is read back
+    AsyncFileWriter::Flush();
+
+    if ( this->parallelFlag && ctrl.iparallelio == 1 )
+    {
+        this->ParallelRead();
+    }
+    else if ( Parallel::mode == 0 )
     {
         this->ServerRead();
     }
@@ -83,4 +97,31 @@ void CReadFile::ServerRead( VoidFunc mainAction )
     }
 }
 
+void CReadFile::ParallelRead()
+{
+    int nZones = ZoneState::nZones;
+
+    std::string prjFileName = Prj::GetPrjFileName( TaskState::task->fileInfo->fileName );
+
+    PL_File file;
+    ONEFLOW::HXFileOpen( prjFileName, false, & file );
+
+    HXVector< HXLongLong_t > zonePos( nZones, 0 );
+    HXVector< HXLongLong_t > zoneSize( nZones, 0 );
+    PIO::CalcZoneRecordPos( file, 0, zonePos, zoneSize );
+
+    for ( int zId = 0; zId < nZones; ++ zId )
+    {
+        if ( Parallel::pid != ZoneState::pid[ zId ] ) continue;
+
+        ZoneState::zid = zId;
+
+        PIO::ReadZoneRecord( file, zonePos[ zId ], zoneSize[ zId ], ActionState::dataBook );
+
+        this->action();
+    }
+
+    ONEFLOW::HXFileClose( & file );
+}
+
 EndNameSpace
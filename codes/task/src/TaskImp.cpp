@@ -40,12 +40,15 @@ void RegisterComTask()
     REGISTER_DATA_CLASS( ServerUpdateInterfaceTask  );
     REGISTER_DATA_CLASS( WriteAsciiFileTask );
     REGISTER_DATA_CLASS( ServerUpdateOversetInterfaceTask );
+    REGISTER_DATA_CLASS( ServerStartInterfaceTask );
+    REGISTER_DATA_CLASS( ServerFinishInterfaceTask );
 }
 
 void ReadBinaryFileTask( StringField & data )
 {
     CReadFile * task = new CReadFile();
     task->mainAction = & ReadBinaryFile;
+    task->parallelFlag = true;
     TaskState::task = task;
 }
 
@@ -53,6 +56,7 @@ void WriteBinaryFileTask( StringField & data )
 {
     CWriteFile * task = new CWriteFile();
     task->mainAction = & WriteBinaryFile;
+    task->parallelFlag = true;
     TaskState::task = task;
 }
 
@@ -75,4 +79,16 @@ void ServerUpdateOversetInterfaceTask( StringField & data )
     TaskState::task = task;
 }
 
+void ServerStartInterfaceTask( StringField & data )
+{
+    CStartInterface * task = new CStartInterface();
+    TaskState::task = task;
+}
+
+void ServerFinishInterfaceTask( StringField & data )
+{
+    CFinishInterface * task = new CFinishInterface();
+    TaskState::task = task;
+}
+
 EndNameSpace
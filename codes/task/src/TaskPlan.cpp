@@ -0,0 +1,204 @@
+/*---------------------------------------------------------------------------*\
+    OneFLOW - LargeScale Multiphysics Scientific Simulation Environment
+    Copyright (C) 2017-2023 He Xin and the OneFLOW contributors.
+-------------------------------------------------------------------------------
+License
+    This file is part of OneFLOW.
+
+    OneFLOW is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OneFLOW is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "TaskPlan.h"
+#include "CmxTask.h"
+#include "Command.h"
+#include "SimpleTask.h"
+#include "Message.h"
+#include "HXClone.h"
+#include "TaskState.h"
+#include "ActionState.h"
+#include "SolverState.h"
+#include "ZoneState.h"
+#include "DataBook.h"
+#include <chrono>
+
+BeginNameSpace( ONEFLOW )
+
+TaskStep::TaskStep()
+{
+    this->msgId = -1;
+    this->tid = 0;
+    this->arg = 0;
+    this->task = 0;
+    this->action = 0;
+    this->run = 0;
+}
+
+TaskStep::~TaskStep()
+{
+    delete this->task;
+}
+
+//The same work as SimpleTask::Run with CmdAction, on a task kept from call to call
+void RunSimpleStep( TaskStep * step )
+{
+    Task * task = step->task;
+    TaskState::task = task;
+    SolverState::tid = step->tid;
+
+    task->dataBook->ReSize( 0 );
+    task->dataBook->MoveToBegin();
+    ActionState::dataBook = task->dataBook;
+
+    if ( ! step->action ) return;
+
+    for ( int zId = 0; zId < ZoneState::nZones; ++ zId )
+    {
+        if ( ! ZoneState::IsValidZone( zId ) ) continue;
+
+        ZoneState::zid = zId;
+        SolverState::msgId = step->msgId;
+
+        step->action->Solve();
+    }
+}
+
+//Messages made of other tasks and tasks of their own type are created anew at every call
+void RunGeneralStep( TaskStep * step )
+{
+    SolverState::tid = step->tid;
+    ONEFLOW::GenerateCmdList( step->msgId );
+    CMD::ExecuteCmd();
+}
+
+TaskPlan * TaskPlan::record = 0;
+TaskTimer TaskPlan::timer = 0;
+HXVector< HXVector< TaskStep * > > TaskPlan::taskSteps;
+
+TaskPlan::TaskPlan()
+{
+    ;
+}
+
+TaskPlan::~TaskPlan()
+{
+    //Task steps belong to TaskPlan::taskSteps, only the other ones to the plan
+    for ( HXSize_t iStep = 0; iStep < this->steps.size(); ++ iStep )
+    {
+        if ( this->steps[ iStep ]->msgId < 0 )
+        {
+            delete this->steps[ iStep ];
+        }
+    }
+}
+
+void TaskPlan::Run()
+{
+    HXSize_t nSteps = this->steps.size();
+    for ( HXSize_t iStep = 0; iStep < nSteps; ++ iStep )
+    {
+        TaskPlan::RunStep( this->steps[ iStep ] );
+    }
+}
+
+TaskStep * TaskPlan::GetTaskStep( int msgId )
+{
+    int sTid = SolverState::tid;
+
+    if ( TaskPlan::taskSteps.size() <= sTid )
+    {
+        TaskPlan::taskSteps.resize( sTid + 1 );
+    }
+
+    HXVector< TaskStep * > & tidSteps = TaskPlan::taskSteps[ sTid ];
+    if ( tidSteps.size() <= msgId )
+    {
+        tidSteps.resize( msgId + 1, 0 );
+    }
+
+    if ( tidSteps[ msgId ] ) return tidSteps[ msgId ];
+
+    TaskStep * step = new TaskStep();
+    step->msgId = msgId;
+    step->tid = sTid;
+
+    bool simple = ! ONEFLOW::GetClass( msgId, sTid, MESG_FUNC ) &&
+                  ! ONEFLOW::GetClass( msgId, sTid, TASK_FUNC ) &&
+                  ! ONEFLOW::GetClass( msgId, sTid, FILE_FUNC );
+
+    if ( simple )
+    {
+        step->task = new SimpleTask();
+        step->task->taskId = msgId;
+        step->task->taskName = MessageMap::GetMsgName( msgId );
+        step->action = ONEFLOW::GetClass( msgId, sTid, COMM_FUNC );
+        step->run = & ONEFLOW::RunSimpleStep;
+    }
+    else
+    {
+        step->run = & ONEFLOW::RunGeneralStep;
+    }
+
+    tidSteps[ msgId ] = step;
+    return step;
+}
+
+void TaskPlan::RunTask( int msgId )
+{
+    //Unknown task names do nothing
+    if ( msgId < 0 ) return;
+
+    TaskStep * step = TaskPlan::GetTaskStep( msgId );
+
+    if ( TaskPlan::record )
+    {
+        TaskPlan::record->steps.push_back( step );
+        return;
+    }
+
+    TaskPlan::RunStep( step );
+}
+
+void TaskPlan::RunStep( TaskStep * step )
+{
+    if ( ! TaskPlan::timer )
+    {
+        step->run( step );
+        return;
+    }
+
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    step->run( step );
+    std::chrono::duration< double > span = std::chrono::steady_clock::now() - t0;
+    TaskPlan::timer( step, span.count() );
+}
+
+void TaskPlan::Call( StepFunction run, int arg )
+{
+    TaskStep * step = new TaskStep();
+    step->tid = SolverState::tid;
+    step->arg = arg;
+    step->run = run;
+
+    if ( TaskPlan::record )
+    {
+        TaskPlan::record->steps.push_back( step );
+        return;
+    }
+
+    TaskPlan::RunStep( step );
+    delete step;
+}
+
+EndNameSpace
@@ -29,6 +29,11 @@ License
 #include "DataBase.h"
 #include "DataBook.h"
 #include "InterFace.h"
+#include "TaskState.h"
+#include "FileInfo.h"
+#include "Prj.h"
+#include "Ctrl.h"
+#include "AsyncFileWriter.h"
 #include <iostream>
 
 
@@ -36,6 +41,7 @@ BeginNameSpace( ONEFLOW )
 
 CWriteFile::CWriteFile()
 {
+    this->parallelFlag = false;
 }
 
 CWriteFile::~CWriteFile()
@@ -45,7 +51,17 @@ CWriteFile::~CWriteFile()
 void CWriteFile::Run()
 {
 	ActionState::dataBook = this->dataBook;
-	if ( Parallel::mode == 0 )
+	//The background writer lays the zone records out like ParallelWrite, so it serves
+	//iparallelio = 0 and 1 and the file is read back by either read path
+	if ( this->parallelFlag && ctrl.iasyncdump == 1 )
+	{
+		this->AsyncWrite();
+	}
+	else if ( this->parallelFlag && ctrl.iparallelio == 1 )
+	{
+		this->ParallelWrite();
+	}
+	else if ( Parallel::mode == 0 )
 	{
 		this->ServerWrite();
 	}
@@ -86,5 +102,134 @@ void CWriteFile::ServerWrite( VoidFunc mainAction )
     }
 }
 
+void CWriteFile::ParallelWrite()
+{
+    int nZones = ZoneState::nZones;
+
+    //Every process serializes its own zones, then the record offsets follow from the sizes of all zones
+    HXVector< DataBook * > dataBookList( nZones );
+    HXVector< HXLongLong_t > localSize( nZones, 0 );
+    HXVector< HXLongLong_t > zoneSize( nZones, 0 );
+
+    for ( int zId = 0; zId < nZones; ++ zId )
+    {
+        if ( Parallel::pid != ZoneState::pid[ zId ] ) continue;
+
+        ZoneState::zid = zId;
+
+        dataBookList[ zId ] = new DataBook();
+        ActionState::dataBook = dataBookList[ zId ];
+
+        this->action();
+
+        localSize[ zId ] = dataBookList[ zId ]->GetSize();
+    }
+
+    std::string prjFileName = Prj::GetPrjFileName( TaskState::task->fileInfo->fileName );
+
+    if ( Parallel::pid == Parallel::GetFid() )
+    {
+        Prj::CreateDirIfNeeded( prjFileName );
+    }
+
+    ONEFLOW::HXReduceLongLong( & localSize[ 0 ], & zoneSize[ 0 ], nZones, PL_SUM );
+
+    HXLongLong_t nHead = sizeof( HXLongLong_t );
+    HXVector< HXLongLong_t > zonePos( nZones, 0 );
+    HXLongLong_t totalSize = 0;
+    for ( int zId = 0; zId < nZones; ++ zId )
+    {
+        zonePos[ zId ] = totalSize;
+        totalSize += nHead + zoneSize[ zId ];
+    }
+
+    PL_File file;
+    ONEFLOW::HXFileOpen( prjFileName, true, & file );
+    ONEFLOW::HXFileSetSize( file, totalSize );
+
+    for ( int zId = 0; zId < nZones; ++ zId )
+    {
+        if ( ! dataBookList[ zId ] ) continue;
+
+        PIO::WriteZoneRecord( file, zonePos[ zId ], dataBookList[ zId ] );
+
+        delete dataBookList[ zId ];
+    }
+
+    ONEFLOW::HXFileClose( & file );
+
+    ActionState::dataBook = this->dataBook;
+}
+
+void CWriteFile::AsyncWrite()
+{
+    int nZones = ZoneState::nZones;
+
+    std::string prjFileName = Prj::GetPrjFileName( TaskState::task->fileInfo->fileName );
+
+    HXVector< HXLongLong_t > localSize( nZones, 0 );
+    HXVector< HXLongLong_t > zoneSize( nZones, 0 );
+    HXVector< int > zoneList;
+
+    for ( int zId = 0; zId < nZones; ++ zId )
+    {
+        if ( Parallel::pid != ZoneState::pid[ zId ] ) continue;
+
+        zoneList.push_back( zId );
+    }
+
+    //Every process stages its own zones in the staging buffer of the file, only the zone sizes
+    //are reduced here, the records are written at their offsets by a background thread.
+    //The file-id process always stages a record, it sets the size of the file
+    bool fidFlag = ( Parallel::pid == Parallel::GetFid() );
+    AsyncRecord * record = 0;
+    if ( ! zoneList.empty() || fidFlag )
+    {
+        record = AsyncFileWriter::Stage( prjFileName );
+        record->Reset( zoneList.size() );
+    }
+
+    for ( HXSize_t iZone = 0; iZone < zoneList.size(); ++ iZone )
+    {
+        int zId = zoneList[ iZone ];
+        ZoneState::zid = zId;
+
+        DataBook * dataBook = record->dataBookList[ iZone ];
+        ActionState::dataBook = dataBook;
+
+        this->action();
+
+        localSize[ zId ] = dataBook->GetSize();
+    }
+
+    ActionState::dataBook = this->dataBook;
+
+    if ( fidFlag )
+    {
+        Prj::CreateDirIfNeeded( prjFileName );
+    }
+
+    ONEFLOW::HXReduceLongLong( & localSize[ 0 ], & zoneSize[ 0 ], nZones, PL_SUM );
+
+    HXLongLong_t nHead = sizeof( HXLongLong_t );
+    HXVector< HXLongLong_t > zonePos( nZones, 0 );
+    HXLongLong_t totalSize = 0;
+    for ( int zId = 0; zId < nZones; ++ zId )
+    {
+        zonePos[ zId ] = totalSize;
+        totalSize += nHead + zoneSize[ zId ];
+    }
+
+    if ( ! record ) return;
+
+    for ( HXSize_t iZone = 0; iZone < zoneList.size(); ++ iZone )
+    {
+        record->posList.push_back( zonePos[ zoneList[ iZone ] ] );
+    }
+    record->totalSize = totalSize;
+    record->resizeFlag = fidFlag;
+
+    AsyncFileWriter::Submit( record );
+}
 
 EndNameSpace
@@ -0,0 +1,104 @@
+/*---------------------------------------------------------------------------*\
+    OneFLOW - LargeScale Multiphysics Scientific Simulation Environment
+    Copyright (C) 2017-2023 He Xin and the OneFLOW contributors.
+-------------------------------------------------------------------------------
+License
+    This file is part of OneFLOW.
+
+    OneFLOW is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OneFLOW is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+
+#pragma once
+#include "HXDefine.h"
+#include <string>
+
+BeginNameSpace( ONEFLOW )
+
+class TaskStep;
+
+const int PROFILE_TASK    = 0;
+const int PROFILE_KERNEL  = 1;
+const int PROFILE_COUNTER = 2;
+
+class ProfileItem
+{
+public:
+    ProfileItem();
+    ~ProfileItem();
+public:
+    std::string name;
+    int kind;
+    int solver;
+    HXLongLong_t calls;
+    HXLongLong_t count;
+    double time;
+};
+
+class ProfileEvent
+{
+public:
+    int id;
+    double start;
+    double span;
+};
+
+//Timers and counters of the tasks and the kernels. Items are registered at any time,
+//but they are only filled when Profiler::active is set. Not for use inside threaded loops.
+class Profiler
+{
+public:
+    Profiler();
+    ~Profiler();
+public:
+    static int active;
+    static int maxEvents;
+    static HXVector< ProfileItem > items;
+    static HXVector< ProfileEvent > events;
+    static HXVector< IntField > taskIds;
+public:
+    static void Init( int iprofile );
+    static int GetId( const std::string & name, int kind, int solver = -1 );
+    static double GetTime();
+    static void AddTime( int id, double start, double span );
+    static void AddCount( int id, HXLongLong_t count );
+    static void TimeTask( TaskStep * step, double seconds );
+    //Gathers the items of every processor on the server, which writes them as json and chrome trace files
+    static void Dump();
+protected:
+    static void DumpItems( StringField & rankItems );
+    static void DumpTrace( StringField & rankEvents );
+};
+
+//Times its own scope
+class ProfileScope
+{
+public:
+    ProfileScope( int id )
+    {
+        this->id = id;
+        this->start = Profiler::active ? Profiler::GetTime() : 0.0;
+    }
+    ~ProfileScope()
+    {
+        if ( ! Profiler::active ) return;
+        Profiler::AddTime( this->id, this->start, Profiler::GetTime() - this->start );
+    }
+public:
+    int id;
+    double start;
+};
+
+EndNameSpace
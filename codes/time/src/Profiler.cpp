@@ -0,0 +1,327 @@
+/*---------------------------------------------------------------------------*\
+    OneFLOW - LargeScale Multiphysics Scientific Simulation Environment
+    Copyright (C) 2017-2023 He Xin and the OneFLOW contributors.
+-------------------------------------------------------------------------------
+License
+    This file is part of OneFLOW.
+
+    OneFLOW is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OneFLOW is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "Profiler.h"
+#include "TaskPlan.h"
+#include "Message.h"
+#include "Parallel.h"
+#include "BasicParallel.h"
+#include "Prj.h"
+#include <chrono>
+#include <map>
+#include <sstream>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+
+BeginNameSpace( ONEFLOW )
+
+ProfileItem::ProfileItem()
+{
+    this->kind   = PROFILE_KERNEL;
+    this->solver = -1;
+    this->calls  = 0;
+    this->count  = 0;
+    this->time   = 0.0;
+}
+
+ProfileItem::~ProfileItem()
+{
+    ;
+}
+
+//Statistics of one item over all processors
+class ProfileStat
+{
+public:
+    ProfileStat() { kind = PROFILE_KERNEL; solver = -1; calls = 0; }
+public:
+    std::string name;
+    int kind;
+    int solver;
+    HXLongLong_t calls;
+    RealField time;
+    RealField count;
+};
+
+std::chrono::steady_clock::time_point profileStartTime = std::chrono::steady_clock::now();
+
+int Profiler::active = 0;
+int Profiler::maxEvents = 200000;
+HXVector< ProfileItem > Profiler::items;
+HXVector< ProfileEvent > Profiler::events;
+HXVector< IntField > Profiler::taskIds;
+
+Profiler::Profiler()
+{
+    ;
+}
+
+Profiler::~Profiler()
+{
+    ;
+}
+
+void Profiler::Init( int iprofile )
+{
+    Profiler::active = iprofile;
+    if ( ! Profiler::active ) return;
+
+    profileStartTime = std::chrono::steady_clock::now();
+    Profiler::events.reserve( 4096 );
+    TaskPlan::timer = & Profiler::TimeTask;
+}
+
+int Profiler::GetId( const std::string & name, int kind, int solver )
+{
+    for ( int id = 0; id < Profiler::items.size(); ++ id )
+    {
+        ProfileItem & item = Profiler::items[ id ];
+        if ( item.kind == kind && item.solver == solver && item.name == name ) return id;
+    }
+
+    ProfileItem item;
+    item.name   = name;
+    item.kind   = kind;
+    item.solver = solver;
+    Profiler::items.push_back( item );
+    return Profiler::items.size() - 1;
+}
+
+double Profiler::GetTime()
+{
+    std::chrono::duration< double > span = std::chrono::steady_clock::now() - profileStartTime;
+    return span.count();
+}
+
+void Profiler::AddTime( int id, double start, double span )
+{
+    ProfileItem & item = Profiler::items[ id ];
+    item.time  += span;
+    item.calls += 1;
+
+    if ( Profiler::events.size() >= Profiler::maxEvents ) return;
+
+    ProfileEvent event;
+    event.id    = id;
+    event.start = start;
+    event.span  = span;
+    Profiler::events.push_back( event );
+}
+
+void Profiler::AddCount( int id, HXLongLong_t count )
+{
+    if ( ! Profiler::active ) return;
+    ProfileItem & item = Profiler::items[ id ];
+    item.count += count;
+    item.calls += 1;
+}
+
+void Profiler::TimeTask( TaskStep * step, double seconds )
+{
+    if ( step->msgId < 0 ) return;
+
+    if ( Profiler::taskIds.size() <= step->tid )
+    {
+        Profiler::taskIds.resize( step->tid + 1 );
+    }
+    IntField & ids = Profiler::taskIds[ step->tid ];
+    if ( ids.size() <= step->msgId )
+    {
+        ids.resize( step->msgId + 1, -1 );
+    }
+    if ( ids[ step->msgId ] < 0 )
+    {
+        ids[ step->msgId ] = Profiler::GetId( MessageMap::GetMsgName( step->msgId ), PROFILE_TASK, step->tid );
+    }
+
+    Profiler::AddTime( ids[ step->msgId ], Profiler::GetTime() - seconds, seconds );
+}
+
+void Profiler::Dump()
+{
+    if ( ! Profiler::active ) return;
+
+    std::ostringstream oss_item, oss_event;
+    oss_item << std::setprecision( 17 );
+    oss_event << std::setprecision( 17 );
+    for ( int id = 0; id < Profiler::items.size(); ++ id )
+    {
+        ProfileItem & item = Profiler::items[ id ];
+        oss_item << item.kind << " " << item.solver << " " << item.calls << " " << item.count << " " << item.time << " " << item.name << "\n";
+    }
+    for ( int iEvent = 0; iEvent < Profiler::events.size(); ++ iEvent )
+    {
+        ProfileEvent & event = Profiler::events[ iEvent ];
+        ProfileItem & item = Profiler::items[ event.id ];
+        oss_event << item.kind << " " << item.solver << " " << event.start << " " << event.span << " " << item.name << "\n";
+    }
+
+    int nProc = Parallel::GetNProc();
+    int pid = Parallel::GetPid();
+    int serverid = Parallel::GetServerid();
+    int tag = Parallel::GetDefaultTag();
+
+    StringField rankItems( nProc ), rankEvents( nProc );
+    rankItems[ pid ] = oss_item.str();
+    rankEvents[ pid ] = oss_event.str();
+
+    for ( int ip = 0; ip < nProc; ++ ip )
+    {
+        if ( ip == serverid ) continue;
+        if ( pid == ip )
+        {
+            ONEFLOW::HXSendString( rankItems[ ip ], serverid, tag );
+            ONEFLOW::HXSendString( rankEvents[ ip ], serverid, tag );
+        }
+        else if ( pid == serverid )
+        {
+            ONEFLOW::HXRecvString( rankItems[ ip ], ip, tag );
+            ONEFLOW::HXRecvString( rankEvents[ ip ], ip, tag );
+        }
+    }
+
+    if ( pid == serverid )
+    {
+        Profiler::DumpItems( rankItems );
+        Profiler::DumpTrace( rankEvents );
+    }
+
+    Profiler::events.resize( 0 );
+}
+
+std::string GetProfileKindName( int kind )
+{
+    if ( kind == PROFILE_TASK ) return "task";
+    if ( kind == PROFILE_COUNTER ) return "counter";
+    return "kernel";
+}
+
+void WriteProfileRange( std::fstream & file, const std::string & title, RealField & values )
+{
+    Real vmin = * std::min_element( values.begin(), values.end() );
+    Real vmax = * std::max_element( values.begin(), values.end() );
+    Real vsum = 0.0;
+    for ( int i = 0; i < values.size(); ++ i )
+    {
+        vsum += values[ i ];
+    }
+    file << "\"" << title << "\": { \"min\": " << vmin << ", \"max\": " << vmax << ", \"avg\": " << vsum / values.size() << " }";
+}
+
+void Profiler::DumpItems( StringField & rankItems )
+{
+    int nProc = rankItems.size();
+    std::map< std::string, int > keyMap;
+    HXVector< ProfileStat > stats;
+
+    for ( int ip = 0; ip < nProc; ++ ip )
+    {
+        std::istringstream iss( rankItems[ ip ] );
+        ProfileItem item;
+        while ( iss >> item.kind >> item.solver >> item.calls >> item.count >> item.time )
+        {
+            iss >> std::ws;
+            std::getline( iss, item.name );
+
+            std::ostringstream oss;
+            oss << item.kind << "|" << item.solver << "|" << item.name;
+            std::map< std::string, int >::iterator iter = keyMap.find( oss.str() );
+            int id;
+            if ( iter == keyMap.end() )
+            {
+                id = stats.size();
+                keyMap.insert( std::pair< std::string, int >( oss.str(), id ) );
+                ProfileStat stat;
+                stat.name   = item.name;
+                stat.kind   = item.kind;
+                stat.solver = item.solver;
+                stat.time.resize( nProc, 0.0 );
+                stat.count.resize( nProc, 0.0 );
+                stats.push_back( stat );
+            }
+            else
+            {
+                id = iter->second;
+            }
+
+            ProfileStat & stat = stats[ id ];
+            stat.calls += item.calls;
+            stat.time[ ip ] += item.time;
+            stat.count[ ip ] += item.count;
+        }
+    }
+
+    std::fstream file;
+    Prj::OpenPrjFile( file, "results/profile.json", std::ios_base::out );
+    file << std::setprecision( 9 );
+    file << "{\n";
+    file << "  \"nproc\": " << nProc << ",\n";
+    file << "  \"items\": [\n";
+    for ( int id = 0; id < stats.size(); ++ id )
+    {
+        ProfileStat & stat = stats[ id ];
+        file << "    { \"name\": \"" << stat.name << "\", \"kind\": \"" << GetProfileKindName( stat.kind ) << "\"";
+        file << ", \"solver\": " << stat.solver << ", \"calls\": " << stat.calls << ", ";
+        WriteProfileRange( file, "time", stat.time );
+        file << ", ";
+        WriteProfileRange( file, "count", stat.count );
+        file << " }";
+        if ( id != stats.size() - 1 ) file << ",";
+        file << "\n";
+    }
+    file << "  ]\n";
+    file << "}\n";
+    file.close();
+}
+
+void Profiler::DumpTrace( StringField & rankEvents )
+{
+    int nProc = rankEvents.size();
+
+    std::fstream file;
+    Prj::OpenPrjFile( file, "results/profile_trace.json", std::ios_base::out );
+    file << std::fixed << std::setprecision( 3 );
+    file << "{\"traceEvents\":[\n";
+    bool first = true;
+    for ( int ip = 0; ip < nProc; ++ ip )
+    {
+        std::istringstream iss( rankEvents[ ip ] );
+        int kind, solver;
+        double start, span;
+        std::string name;
+        while ( iss >> kind >> solver >> start >> span )
+        {
+            iss >> std::ws;
+            std::getline( iss, name );
+            if ( ! first ) file << ",\n";
+            first = false;
+            file << "{\"name\":\"" << name << "\",\"cat\":\"" << GetProfileKindName( kind ) << "\",\"ph\":\"X\"";
+            file << ",\"ts\":" << start * 1.0e6 << ",\"dur\":" << span * 1.0e6;
+            file << ",\"pid\":" << ip << ",\"tid\":" << std::max( solver, 0 ) << "}";
+        }
+    }
+    file << "\n]}\n";
+    file.close();
+}
+
+EndNameSpace
@@ -24,6 +24,7 @@ License
 #pragma once
 #include "HXDefine.h"
 #include "HXArray.h"
+#include "Com.h"
 BeginNameSpace( ONEFLOW )
 
 class TurbInv
@@ -52,6 +53,11 @@ public:
     ~TurbInvFlux();
 public:
     void RoeFlux();
+public:
+    //Face state of this flux object. Inside the member functions it hides the
+    //global of the same name, so that every thread can evaluate faces with its own flux object.
+    TurbInv turbInv;
+    GCom gcom;
 };
 
 EndNameSpace
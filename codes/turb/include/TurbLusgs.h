@@ -23,6 +23,7 @@ License
 
 #pragma once
 #include "Lusgs.h"
+#include "Com.h"
 BeginNameSpace( ONEFLOW )
 
 class TurbLusgsData
@@ -80,6 +81,11 @@ public:
     void CalcUpperChange();
     bool IsOversetCell  ();
     void ZeroOversetCell();
+public:
+    //Sweep state of this solver object. Inside the member functions it hides the
+    //global of the same name, so that every thread can sweep with its own solver object.
+    TurbLusgsData turblu;
+    GCom gcom;
 };
 
 
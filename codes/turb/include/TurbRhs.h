@@ -33,11 +33,17 @@ public:
     ~TurbRhs();
 public:
     void CalcRHS();
+    void CalcRHSInner();
+    void CalcRHSHalo();
 };
 
 void TurbCalcBc();
 void TurbCalcRHS();
+void TurbCalcRHSInner();
+void TurbCalcRHSHalo();
 void TurbCalcInvFlux();
+void TurbCalcInvFluxInner();
+void TurbCalcInvFluxHalo();
 void TurbCalcVisFlux();
 void TurbCalcSrcFlux();
 void TurbCalcSpectrum();
@@ -28,6 +28,8 @@ BeginNameSpace( ONEFLOW )
 
 DEFINE_DATA_CLASS( TurbInitFinal );
 DEFINE_DATA_CLASS( TurbUpdateResiduals );
+DEFINE_DATA_CLASS( TurbUpdateResidualsInner );
+DEFINE_DATA_CLASS( TurbUpdateResidualsHalo );
 DEFINE_DATA_CLASS( TurbImplicitMethod );
 DEFINE_DATA_CLASS( TurbPostprocess );
 DEFINE_DATA_CLASS( TurbFinalPostprocess );
@@ -36,7 +36,16 @@ TurbLusgsData turblu;
 
 TurbLusgsData::TurbLusgsData()
 {
-    ;
+    nEqu = 0;
+    nBEqu = 0;
+    numberOfSweeps = 0;
+    numberOfRealSweeps = 0;
+    keyPrim = false;
+    tol = 0.0;
+    norm0 = 0.0;
+    dqSweep = 0.0;
+    dmax = 0.0;
+    norm = 0.0;
 }
 
 TurbLusgsData::~TurbLusgsData()
@@ -46,6 +46,16 @@ void TurbRhs::CalcRHS()
     TurbCalcRHS();
 }
 
+void TurbRhs::CalcRHSInner()
+{
+    TurbCalcRHSInner();
+}
+
+void TurbRhs::CalcRHSHalo()
+{
+    TurbCalcRHSHalo();
+}
+
 void TurbCalcBc()
 {
     UTurbBcSolver * uTurbBcSolver = new UTurbBcSolver();
@@ -69,6 +79,27 @@ void TurbCalcRHS()
     TurbCalcDualTimeStepSrc();
 }
 
+//The boundary values and the inviscid flux of the faces away from the interfaces
+//do not need the interface data
+void TurbCalcRHSInner()
+{
+    TurbCalcBc();
+
+    TurbCalcInvFluxInner();
+}
+
+void TurbCalcRHSHalo()
+{
+    TurbCalcSpectrum();
+
+    TurbCalcSrcFlux();
+
+    TurbCalcInvFluxHalo();
+
+    TurbCalcVisFlux();
+
+    TurbCalcDualTimeStepSrc();
+}
 
 void TurbCalcInvFlux()
 {
@@ -77,6 +108,20 @@ void TurbCalcInvFlux()
     delete uTurbInvFlux;
 }
 
+void TurbCalcInvFluxInner()
+{
+    UTurbInvFlux * uTurbInvFlux = new UTurbInvFlux();
+    uTurbInvFlux->CalcFluxInner();
+    delete uTurbInvFlux;
+}
+
+void TurbCalcInvFluxHalo()
+{
+    UTurbInvFlux * uTurbInvFlux = new UTurbInvFlux();
+    uTurbInvFlux->CalcFluxHalo();
+    delete uTurbInvFlux;
+}
+
 void TurbCalcVisFlux()
 {
     UTurbVisFlux * uTurbVisFlux = new UTurbVisFlux();
@@ -26,6 +26,7 @@ License
 #include "TurbRhs.h"
 #include "CmxTask.h"
 #include "Iteration.h"
+#include "Ctrl.h"
 #include "SolverRegister.h"
 
 BeginNameSpace( ONEFLOW )
@@ -34,6 +35,8 @@ void SetTurbFunc()
 {
     REGISTER_DATA_CLASS( TurbInitFinal );
     REGISTER_DATA_CLASS( TurbUpdateResiduals );
+    REGISTER_DATA_CLASS( TurbUpdateResidualsInner );
+    REGISTER_DATA_CLASS( TurbUpdateResidualsHalo );
     REGISTER_DATA_CLASS( TurbImplicitMethod );
     REGISTER_DATA_CLASS( TurbPostprocess );
     REGISTER_DATA_CLASS( TurbFinalPostprocess );
@@ -62,6 +65,20 @@ void TurbUpdateResiduals( StringField & data )
     delete rhs;
 }
 
+void TurbUpdateResidualsInner( StringField & data )
+{
+    TurbRhs * rhs = new TurbRhs();
+    rhs->CalcRHSInner();
+    delete rhs;
+}
+
+void TurbUpdateResidualsHalo( StringField & data )
+{
+    TurbRhs * rhs = new TurbRhs();
+    rhs->CalcRHSHalo();
+    delete rhs;
+}
+
 void TurbImplicitMethod( StringField & data )
 {
     ;
@@ -69,7 +86,7 @@ void TurbImplicitMethod( StringField & data )
 
 void TurbPostprocess( StringField & data )
 {
-    CommInterfaceData();
+    PostCommInterfaceData();
 
     //The solution and output of residuals need logical judgment
     if ( Iteration::ResOk() )
@@ -89,6 +106,12 @@ void TurbPostprocess( StringField & data )
 
 void TurbFinalPostprocess( StringField & data )
 {
+    //In split mode the last exchange has been left to the next residual evaluation
+    if ( ctrl.icommsplit == 1 )
+    {
+        ONEFLOW::CommInterfaceData();
+    }
+
     ONEFLOW::AddCmdToList( "DUMP_RESTART" );
 }
 
@@ -0,0 +1,63 @@
+/*---------------------------------------------------------------------------*\
+    OneFLOW - LargeScale Multiphysics Scientific Simulation Environment
+    Copyright (C) 2017-2023 He Xin and the OneFLOW contributors.
+-------------------------------------------------------------------------------
+License
+    This file is part of OneFLOW.
+
+    OneFLOW is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OneFLOW is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#pragma once
+#include "HXDefine.h"
+#include <map>
+
+BeginNameSpace( ONEFLOW )
+
+class UnsGrid;
+
+//Sparsity pattern of the linear systems of the incompressible solver on one grid.
+//There is one row per cell, ghost cells included. A row lists the neighbours in c2f
+//order and then the diagonal, the order used when the momentum and pressure-correction
+//matrices are filled. The pattern depends on the grid only, so it is built once and each
+//solve only writes new values. lslot[ fId ] and rslot[ fId ] are the entries of face fId
+//in the rows of its left and right cells, -1 when the face is not in that row.
+class CsrPattern
+{
+public:
+    CsrPattern();
+    ~CsrPattern();
+public:
+    int nRow, nnz;
+    IntField ia, ja, diag;
+    IntField lslot, rslot;
+public:
+    void Init( UnsGrid * grid );
+};
+
+//The pattern of a grid is built on first use and kept for the whole run, like the
+//gradient weights of GradWeightFactory, since grids are never rebuilt or freed
+class CsrPatternFactory
+{
+public:
+    CsrPatternFactory();
+    ~CsrPatternFactory();
+public:
+    static std::map< UnsGrid *, CsrPattern * > data;
+public:
+    static CsrPattern * GetCsrPattern( UnsGrid * grid );
+};
+
+EndNameSpace
@@ -0,0 +1,117 @@
+/*---------------------------------------------------------------------------*\
+    OneFLOW - LargeScale Multiphysics Scientific Simulation Environment
+    Copyright (C) 2017-2023 He Xin and the OneFLOW contributors.
+-------------------------------------------------------------------------------
+License
+    This file is part of OneFLOW.
+
+    OneFLOW is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OneFLOW is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "CsrPattern.h"
+#include "UnsGrid.h"
+#include "FaceTopo.h"
+#include "CellMesh.h"
+#include "CellTopo.h"
+
+BeginNameSpace( ONEFLOW )
+
+CsrPattern::CsrPattern()
+{
+    this->nRow = 0;
+    this->nnz  = 0;
+}
+
+CsrPattern::~CsrPattern()
+{
+    ;
+}
+
+void CsrPattern::Init( UnsGrid * grid )
+{
+    FaceTopo * faceTopo = grid->faceTopo;
+    CellTopo * cellTopo = grid->cellMesh->cellTopo;
+    cellTopo->CalcC2f( faceTopo );
+
+    LinkField & c2f = cellTopo->c2f;
+    IntField & lcf = faceTopo->lCells;
+    IntField & rcf = faceTopo->rCells;
+
+    this->nRow = grid->nCells + grid->nBFaces;
+
+    this->ia.resize( this->nRow + 1 );
+    this->diag.resize( this->nRow );
+    this->ia[ 0 ] = 0;
+    for ( int cId = 0; cId < this->nRow; ++ cId )
+    {
+        int fn = c2f[ cId ].size();
+        this->ia[ cId + 1 ] = this->ia[ cId ] + fn + 1;
+    }
+    this->nnz = this->ia[ this->nRow ];
+
+    this->ja.resize( this->nnz );
+    this->lslot.resize( grid->nFaces, - 1 );
+    this->rslot.resize( grid->nFaces, - 1 );
+
+    for ( int cId = 0; cId < this->nRow; ++ cId )
+    {
+        int n  = this->ia[ cId ];
+        int fn = c2f[ cId ].size();
+        for ( int iFace = 0; iFace < fn; ++ iFace )
+        {
+            int fId = c2f[ cId ][ iFace ];
+            int lc  = lcf[ fId ];
+            int rc  = rcf[ fId ];
+            if ( cId == lc )
+            {
+                this->ja[ n + iFace ] = rc;
+                this->lslot[ fId ] = n + iFace;
+            }
+            else if ( cId == rc )
+            {
+                this->ja[ n + iFace ] = lc;
+                this->rslot[ fId ] = n + iFace;
+            }
+        }
+        this->ja[ n + fn ] = cId;
+        this->diag[ cId ] = n + fn;
+    }
+}
+
+std::map< UnsGrid *, CsrPattern * > CsrPatternFactory::data;
+
+CsrPatternFactory::CsrPatternFactory()
+{
+    ;
+}
+
+CsrPatternFactory::~CsrPatternFactory()
+{
+    ;
+}
+
+CsrPattern * CsrPatternFactory::GetCsrPattern( UnsGrid * grid )
+{
+    std::map< UnsGrid *, CsrPattern * >::iterator iter = CsrPatternFactory::data.find( grid );
+    if ( iter != CsrPatternFactory::data.end() ) return iter->second;
+
+    CsrPattern * csrPattern = new CsrPattern();
+    csrPattern->Init( grid );
+    CsrPatternFactory::data[ grid ] = csrPattern;
+
+    return csrPattern;
+}
+
+EndNameSpace
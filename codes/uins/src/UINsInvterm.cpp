@@ -44,6 +44,7 @@ License
 #include "TurbCom.h"
 #include "UTurbCom.h"
 #include "Ctrl.h"
+#include "CsrPattern.h"
 #include <iostream>
 #include <iomanip>
 
@@ -448,357 +449,253 @@ void UINsInvterm::MomPre()
 	}*/
 
 	//Bgmres solution
-	NonZero.Number = 0;
-	for (int cId = 0; cId < ug.nTCell; ++cId)
-	{                                          
-		int fn = (*ug.c2f)[cId].size();                             // Number of adjacent cells                             
-		NonZero.Number += fn;                                       // The number of nonzero elements on a non diagonal line
-	}
-	NonZero.Number = NonZero.Number + ug.nTCell;                     // The total number of nonzero elements     
-	Rank.RANKNUMBER = ug.nTCell;                                     // Row and column size of matrix
+	//The matrix is the same for u, v and w, it is assembled once and the
+	//three components are solved together as a block system with three
+	//right-hand sides, or one after the other with imomblock = 0.
+	//The sparsity pattern is that of the grid, built once, so only the
+	//values are written here, face by face through the slot map
+	CsrPattern * csr = CsrPatternFactory::GetCsrPattern(ug.grid);
+	NonZero.Number = csr->nnz;                                       // The total number of nonzero elements     
+	int nBlock = ctrl.imomblock == 1 ? 3 : 1;
+	Rank.RANKNUMBER = csr->nRow;                                     // Row and column size of matrix
 	Rank.NUMBER = NonZero.Number;                                    // The number of non-zero elements of matrix is transferred to the calculation program
-	Rank.COLNUMBER = 1;                                              // Number of right end items
-	Rank.Init();                                                     //Intermediate variable passed into GMRES calculation program
+	Rank.COLNUMBER = nBlock;                                         // Number of right end items
+	Rank.system = SYSTEM_MOMENTUM;                                   // Momentum equations, solved with BGMRES
+	Rank.grid = ug.grid;                                             // Grid of the system, the cached AMG hierarchies are kept per grid
+	Rank.Init(&csr->ia[0], &csr->ja[0]);                             //Intermediate variable passed into GMRES calculation program, only allocated when the sizes change
 	double residual_u, residual_v, residual_w;
-	for (int cId = 0; cId < ug.nTCell; ++cId)
-	{
-		Rank.TempIA[0] = 0;
-		int n = Rank.TempIA[cId];
-		int fn = (*ug.c2f)[cId].size();
-		Rank.TempIA[cId + 1] = Rank.TempIA[cId] + fn + 1;                                                  // The number of non-zero elements in the first n + 1 row
-		for (int iFace = 0; iFace < fn; ++iFace)
-		{
-			int fId = (*ug.c2f)[cId][iFace];                                                            // Number of adjacent faces
-			ug.lc = (*ug.lcf)[fId];                                                                     // Face left unit
-			ug.rc = (*ug.rcf)[fId];                                                                     // Face right unit
-			if (cId == ug.lc)
-			{
-				Rank.TempA[n + iFace] = -iinv.ai[fId][0];
-				Rank.TempJA[n + iFace] = ug.rc;
-			}
-			else if (cId == ug.rc)
-			{
-				Rank.TempA[n + iFace] = -iinv.ai[fId][1];
-				Rank.TempJA[n + iFace] = ug.lc;
-			}
-		}
-		Rank.TempA[n + fn] = iinv.spc[cId];                          //Primary diagonal element value
-		Rank.TempJA[n + fn] = cId;                                      //Principal diagonal ordinate
-
-	}
-	for (int cId = 0; cId < ug.nTCell; cId++)
-	{
-		Rank.TempB[cId][0] = iinv.buc[cId];
-	}
-	bgx.BGMRES();
-	for (int cId = 0; cId < ug.nTCell; cId++)
+	for (int fId = 0; fId < ug.nFaces; ++fId)
 	{
-		iinv.uc[cId] = Rank.TempX[cId][0];                       // Output of solution
+		if (csr->lslot[fId] != -1) Rank.TempA[csr->lslot[fId]] = -iinv.ai[fId][0];    // Entry of the right unit in the row of the left unit
+		if (csr->rslot[fId] != -1) Rank.TempA[csr->rslot[fId]] = -iinv.ai[fId][1];    // Entry of the left unit in the row of the right unit
 	}
-	residual_u = Rank.residual;
-	iinv.res_u = residual_u;
-
-	Rank.Deallocate();
-	//std::cout << "residual_u:" << residual_u << std::endl;
-
-
-
-
-	NonZero.Number = 0;
 	for (int cId = 0; cId < ug.nTCell; ++cId)
 	{
-		int fn = (*ug.c2f)[cId].size();                             //Number of adjacent cells                                    
-		NonZero.Number += fn;                                          //The number of nonzero elements on a non diagonal line
+		Rank.TempA[csr->diag[cId]] = iinv.spc[cId];                  //Primary diagonal element value
 	}
-	NonZero.Number = NonZero.Number + ug.nTCell;                     //The total number of nonzero elements         
-	Rank.RANKNUMBER = ug.nTCell;                                     // Row and column size of matrix
-	Rank.NUMBER = NonZero.Number;                                    // The number of non-zero elements of matrix is transferred to the calculation program
-	Rank.COLNUMBER = 1;                                              //Number of right end items
-	Rank.Init();                                                     //Intermediate variable passed into GMRES calculation program
-	//double residual_u, residual_v, residual_w;
-	for (int cId = 0; cId < ug.nTCell; ++cId)
+
+	RealField * bm[3] = { &iinv.buc, &iinv.bvc, &iinv.bwc };       // Right end items of u, v, w
+	RealField * xm[3] = { &iinv.uc, &iinv.vc, &iinv.wc };          // Solutions of u, v, w
+	double residual_m[3];
+	for (int iStart = 0; iStart < 3; iStart += nBlock)
 	{
-		Rank.TempIA[0] = 0;
-		int n = Rank.TempIA[cId];
-		int fn = (*ug.c2f)[cId].size();
-		Rank.TempIA[cId + 1] = Rank.TempIA[cId] + fn + 1;                                                  // The number of non-zero elements in the first n + 1 row
-		for (int iFace = 0; iFace < fn; ++iFace)
+		for (int iCol = 0; iCol < nBlock; ++iCol)
 		{
-			int fId = (*ug.c2f)[cId][iFace];                                                            // Number of adjacent faces
-			ug.lc = (*ug.lcf)[fId];                                                                     // Face left unit
-			ug.rc = (*ug.rcf)[fId];                                                                     // Face right unit
-			if (cId == ug.lc)
+			RealField & b = *bm[iStart + iCol];
+			for (int cId = 0; cId < ug.nTCell; cId++)
 			{
-				Rank.TempA[n + iFace] = -iinv.ai[fId][0];
-				Rank.TempJA[n + iFace] = ug.rc;
-			}
-			else if (cId == ug.rc)
-			{
-				Rank.TempA[n + iFace] = -iinv.ai[fId][1];
-				Rank.TempJA[n + iFace] = ug.lc;
+				Rank.TempB[cId][iCol] = b[cId];
 			}
 		}
-		Rank.TempA[n + fn] = iinv.spc[cId];                          //Primary diagonal element value
-		Rank.TempJA[n + fn] = cId;                                      //Principal diagonal ordinate
-
-	}
-
-
-	for (int cId = 0; cId < ug.nTCell; cId++)
-	{
-		Rank.TempB[cId][0] = iinv.bvc[cId];
-	}	
-	bgx.BGMRES();
-	for (int cId = 0; cId < ug.nTCell; cId++)
-	{
-		iinv.vc[cId] = Rank.TempX[cId][0];
-	}
-	residual_v = Rank.residual;
-	iinv.res_v = residual_v;
-
-	Rank.Deallocate();
-
-	//std::cout << "residual_v:" << residual_v << std::endl;
-
-
-	NonZero.Number = 0;
-	for (int cId = 0; cId < ug.nTCell; ++cId)
-	{
-		int fn = (*ug.c2f)[cId].size();                             //Number of adjacent cells                                    
-		NonZero.Number += fn;                                          //The number of nonzero elements on a non diagonal line
-	}
-	NonZero.Number = NonZero.Number + ug.nTCell;                     //The total number of nonzero elements         
-	Rank.RANKNUMBER = ug.nTCell;                                     // Row and column size of matrix
-	Rank.NUMBER = NonZero.Number;                                    // The number of non-zero elements of matrix is transferred to the calculation program
-	Rank.COLNUMBER = 1;                                              //Number of right end items
-	Rank.Init();                                                     //Intermediate variable passed into GMRES calculation program
-	//double residual_u, residual_v, residual_w;
-	for (int cId = 0; cId < ug.nTCell; ++cId)
-	{
-		Rank.TempIA[0] = 0;
-		int n = Rank.TempIA[cId];
-		int fn = (*ug.c2f)[cId].size();
-		Rank.TempIA[cId + 1] = Rank.TempIA[cId] + fn + 1;                                                  // The number of non-zero elements in the first n + 1 row
-		for (int iFace = 0; iFace < fn; ++iFace)
+		bgx.BGMRES();
+		for (int iCol = 0; iCol < nBlock; ++iCol)
 		{
-			int fId = (*ug.c2f)[cId][iFace];                                                            // Number of adjacent faces
-			ug.lc = (*ug.lcf)[fId];                                                                     // Face left unit
-			ug.rc = (*ug.rcf)[fId];                                                                     // Face right unit
-			if (cId == ug.lc)
+			RealField & x = *xm[iStart + iCol];
+			for (int cId = 0; cId < ug.nTCell; cId++)
 			{
-				Rank.TempA[n + iFace] = -iinv.ai[fId][0];
-				Rank.TempJA[n + iFace] = ug.rc;
-			}
-			else if (cId == ug.rc)
-			{
-				Rank.TempA[n + iFace] = -iinv.ai[fId][1];
-				Rank.TempJA[n + iFace] = ug.lc;
+				x[cId] = Rank.TempX[cId][iCol];                  // Output of solution
 			}
+			residual_m[iStart + iCol] = Rank.residuals[iCol];
 		}
-		Rank.TempA[n + fn] = iinv.spc[cId];                          //Primary diagonal element value
-		Rank.TempJA[n + fn] = cId;                                      //Principal diagonal ordinate
-
-	}
-
-	for (int cId = 0; cId < ug.nTCell; cId++)
-	{
-		Rank.TempB[cId][0] = iinv.bwc[cId];
 	}
-	bgx.BGMRES();
-	for (int cId = 0; cId < ug.nTCell; cId++)
-	{
-		iinv.wc[cId] = Rank.TempX[cId][0];
-	}
-	residual_w = Rank.residual;
+	residual_u = residual_m[0];
+	residual_v = residual_m[1];
+	residual_w = residual_m[2];
+	iinv.res_u = residual_u;
+	iinv.res_v = residual_v;
 	iinv.res_w = residual_w;
 
-	Rank.Deallocate();
-
+	//std::cout << "residual_u:" << residual_u << std::endl;
+	//std::cout << "residual_v:" << residual_v << std::endl;
 	//std::cout << "residual_w:" << residual_w << std::endl;
 
-	for (int fId = 0; fId < ug.nBFaces; ++fId)
+	BcInfo * bcInfo = ug.bcRecord->bcInfo;
+	ug.nRegion = bcInfo->bcType.size();
+	for (int ir = 0; ir < ug.nRegion; ++ir)
 	{
-		ug.fId = fId;
+		ug.ir = ir;
+		ug.bctype = bcInfo->bcType[ir];
+		ug.nRBFace = bcInfo->bcFace[ir].size();
+		for (int ibc = 0; ibc < ug.nRBFace; ++ibc)
+		{
+			ug.fId = bcInfo->bcFace[ ug.ir ][ ibc ];
+			ug.bcNameId = bcInfo->bcNameId[ ug.ir ][ ibc ];
 
-		BcInfo * bcInfo = ug.bcRecord->bcInfo;
+			ug.lc = ( * ug.lcf )[ ug.fId ];
+			ug.rc = ( * ug.rcf )[ ug.fId ];
 
-		ug.fId = bcInfo->bcFace[ ug.ir ][ fId ];
-		ug.bcNameId = bcInfo->bcNameId[ ug.ir ][ fId ];
+			if (ug.bctype < 0)
+			{
+				false;
+			}
 
-		ug.lc = ( * ug.lcf )[ ug.fId ];
-		ug.rc = ( * ug.rcf )[ ug.fId ];
+			else if (ug.bctype == BC::SOLID_SURFACE)
+			{
+				nscom.bcdtkey = 0;
+				if (ug.bcNameId == -1) return; //interface
+				int dd = ins_bc_data.r2d[ug.bcNameId];
+				if (dd != -1)
+				{
+					nscom.bcdtkey = 1;
+					nscom.bcflow = &ins_bc_data.dataList[dd];
+				}
 
-		if (ug.bctype < 0)
-		{
-			false;
-		}
+				if (nscom.bcdtkey == 0)
+				{
+					iinv.uc[ug.rc] = -iinv.uc[ug.lc] + 2 * gcom.vfx;
+					iinv.vc[ug.rc] = -iinv.vc[ug.lc] + 2 * gcom.vfy;
+					iinv.wc[ug.rc] = -iinv.wc[ug.lc] + 2 * gcom.vfz;
+				}
+				else
+				{
+					iinv.uc[ug.rc] = -iinv.uc[ug.lc] + 2 * (*nscom.bcflow)[IIDX::IIU];
+					iinv.vc[ug.rc] = -iinv.vc[ug.lc] + 2 * (*nscom.bcflow)[IIDX::IIV];
+					iinv.wc[ug.rc] = -iinv.wc[ug.lc] + 2 * (*nscom.bcflow)[IIDX::IIW];
+				}
 
-		else if (ug.bctype == BC::SOLID_SURFACE)
-		{
-			nscom.bcdtkey = 0;
-			if (ug.bcNameId == -1) return; //interface
-			int dd = ins_bc_data.r2d[ug.bcNameId];
-			if (dd != -1)
-			{
-				nscom.bcdtkey = 1;
-				nscom.bcflow = &ins_bc_data.dataList[dd];
 			}
 
-			if (nscom.bcdtkey == 0)
+			else if (ug.bctype == BC::INFLOW)
 			{
-				iinv.uc[ug.rc] = -iinv.uc[ug.lc] + 2 * gcom.vfx;
-				iinv.vc[ug.rc] = -iinv.vc[ug.lc] + 2 * gcom.vfy;
-				iinv.wc[ug.rc] = -iinv.wc[ug.lc] + 2 * gcom.vfz;
+				iinv.uc[ug.rc] = nscom.inflow[IIDX::IIU];
+				iinv.vc[ug.rc] = nscom.inflow[IIDX::IIV];
+				iinv.wc[ug.rc] = nscom.inflow[IIDX::IIW];
 			}
-			else
+
+			else if (ug.bctype == BC::OUTFLOW)
 			{
-				iinv.uc[ug.rc] = -iinv.uc[ug.lc] + 2 * (*nscom.bcflow)[IIDX::IIU];
-				iinv.vc[ug.rc] = -iinv.vc[ug.lc] + 2 * (*nscom.bcflow)[IIDX::IIV];
-				iinv.wc[ug.rc] = -iinv.wc[ug.lc] + 2 * (*nscom.bcflow)[IIDX::IIW];
+				iinv.uc[ug.rc] = iinv.uc[ug.lc];
+				iinv.vc[ug.rc] = iinv.vc[ug.lc];
+				iinv.wc[ug.rc] = iinv.wc[ug.lc];
 			}
 
-		}
-
-		else if (ug.bctype == BC::INFLOW)
-		{
-			iinv.uc[ug.rc] = nscom.inflow[IIDX::IIU];
-			iinv.vc[ug.rc] = nscom.inflow[IIDX::IIV];
-			iinv.wc[ug.rc] = nscom.inflow[IIDX::IIW];
-		}
-
-		else if (ug.bctype == BC::OUTFLOW)
-		{
-			iinv.uc[ug.rc] = iinv.uc[ug.lc];
-			iinv.vc[ug.rc] = iinv.vc[ug.lc];
-			iinv.wc[ug.rc] = iinv.wc[ug.lc];
-		}
-
-		else if (ug.bctype == BC::POLE || ug.bctype / 10 == BC::POLE)
-		{
-			iinv.uc[ug.rc] = iinv.uc[ug.lc];
-			iinv.vc[ug.rc] = iinv.vc[ug.lc];
-			iinv.wc[ug.rc] = iinv.wc[ug.lc];
-		}
+			else if (ug.bctype == BC::POLE || ug.bctype / 10 == BC::POLE)
+			{
+				iinv.uc[ug.rc] = iinv.uc[ug.lc];
+				iinv.vc[ug.rc] = iinv.vc[ug.lc];
+				iinv.wc[ug.rc] = iinv.wc[ug.lc];
+			}
 
-		else if (ug.bctype == BC::EXTRAPOLATION)
-		{
-			iinv.uc[ug.rc] = iinv.uc[ug.lc];
-			iinv.vc[ug.rc] = iinv.vc[ug.lc];
-			iinv.wc[ug.rc] = iinv.wc[ug.lc];
-		}
+			else if (ug.bctype == BC::EXTRAPOLATION)
+			{
+				iinv.uc[ug.rc] = iinv.uc[ug.lc];
+				iinv.vc[ug.rc] = iinv.vc[ug.lc];
+				iinv.wc[ug.rc] = iinv.wc[ug.lc];
+			}
 
-		else if (ug.bctype == BC::SYMMETRY)
-		{
-			Real vx1 = iinv.uc[ug.lc];
-			Real vy1 = iinv.vc[ug.lc];
-			Real vz1 = iinv.wc[ug.lc];
+			else if (ug.bctype == BC::SYMMETRY)
+			{
+				Real vx1 = iinv.uc[ug.lc];
+				Real vy1 = iinv.vc[ug.lc];
+				Real vz1 = iinv.wc[ug.lc];
 
-			Real vnRelative1 = (*ug.xfn)[ug.fId] * vx1 + (*ug.yfn)[ug.fId] * vy1 + (*ug.zfn)[ug.fId] * vz1 - (*ug.vfn)[ug.fId];
+				Real vnRelative1 = (*ug.xfn)[ug.fId] * vx1 + (*ug.yfn)[ug.fId] * vy1 + (*ug.zfn)[ug.fId] * vz1 - (*ug.vfn)[ug.fId];
 
-			iinv.uc[ug.rc] = iinv.uc[ug.lc]-two* (*ug.xfn)[ug.fId] * vnRelative1;
-			iinv.vc[ug.rc] = iinv.vc[ug.lc]- two * (*ug.yfn)[ug.fId] * vnRelative1;
-			iinv.wc[ug.rc] = iinv.wc[ug.lc]- two * (*ug.zfn)[ug.fId] * vnRelative1;
+				iinv.uc[ug.rc] = iinv.uc[ug.lc]-two* (*ug.xfn)[ug.fId] * vnRelative1;
+				iinv.vc[ug.rc] = iinv.vc[ug.lc]- two * (*ug.yfn)[ug.fId] * vnRelative1;
+				iinv.wc[ug.rc] = iinv.wc[ug.lc]- two * (*ug.zfn)[ug.fId] * vnRelative1;
 
-		}
+			}
 		
-		else if (ug.bctype == BC::FARFIELD)
-		{
-			Real rin = (*uinsf.q)[IIDX::IIR][ug.lc];
-			Real uin = iinv.uc[ug.lc];
-			Real vin = iinv.vc[ug.lc];
-			Real win = iinv.wc[ug.lc];
-			Real pin = (*uinsf.q)[IIDX::IIP][ug.lc];
+			else if (ug.bctype == BC::FARFIELD)
+			{
+				Real rin = (*uinsf.q)[IIDX::IIR][ug.lc];
+				Real uin = iinv.uc[ug.lc];
+				Real vin = iinv.vc[ug.lc];
+				Real win = iinv.wc[ug.lc];
+				Real pin = (*uinsf.q)[IIDX::IIP][ug.lc];
 
-			gcom.xfn *= nscom.faceOuterNormal;
-			gcom.yfn *= nscom.faceOuterNormal;
-			gcom.zfn *= nscom.faceOuterNormal;
+				gcom.xfn *= nscom.faceOuterNormal;
+				gcom.yfn *= nscom.faceOuterNormal;
+				gcom.zfn *= nscom.faceOuterNormal;
 
-			Real rref = nscom.inflow[IIDX::IIR];
-			Real uref = nscom.inflow[IIDX::IIU];
-			Real vref = nscom.inflow[IIDX::IIV];
-			Real wref = nscom.inflow[IIDX::IIW];
-			Real pref = nscom.inflow[IIDX::IIP];
+				Real rref = nscom.inflow[IIDX::IIR];
+				Real uref = nscom.inflow[IIDX::IIU];
+				Real vref = nscom.inflow[IIDX::IIV];
+				Real wref = nscom.inflow[IIDX::IIW];
+				Real pref = nscom.inflow[IIDX::IIP];
 
-			Real vnref = gcom.xfn * uref + gcom.yfn * vref + gcom.zfn * wref - gcom.vfn;
-			Real vnin = gcom.xfn * uin + gcom.yfn * vin + gcom.zfn * win - (*ug.vfn)[ug.fId];
+				Real vnref = gcom.xfn * uref + gcom.yfn * vref + gcom.zfn * wref - gcom.vfn;
+				Real vnin = gcom.xfn * uin + gcom.yfn * vin + gcom.zfn * win - (*ug.vfn)[ug.fId];
 
-			Real cref = sqrt(ABS(nscom.gama_ref * pref / rref));
-			Real cin = sqrt(ABS(nscom.gama * pin / rin));
+				Real cref = sqrt(ABS(nscom.gama_ref * pref / rref));
+				Real cin = sqrt(ABS(nscom.gama * pin / rin));
 
-			Real gamm1 = nscom.gama - one;
+				Real gamm1 = nscom.gama - one;
 
-			Real velin = DIST(uin, vin, win);
+				Real velin = DIST(uin, vin, win);
 
-			//Supersonic
-			if (velin > cin)
-			{
-				if (vnin >= 0.0)
+				//Supersonic
+				if (velin > cin)
 				{
-					iinv.uc[ug.rc] = iinv.uc[ug.lc];
-					iinv.vc[ug.rc] = iinv.vc[ug.lc];
-					iinv.wc[ug.rc] = iinv.wc[ug.lc];
+					if (vnin >= 0.0)
+					{
+						iinv.uc[ug.rc] = iinv.uc[ug.lc];
+						iinv.vc[ug.rc] = iinv.vc[ug.lc];
+						iinv.wc[ug.rc] = iinv.wc[ug.lc];
+					}
+					else
+					{
+						iinv.uc[ug.rc] = nscom.inflow[IIDX::IIU];
+						iinv.vc[ug.rc] = nscom.inflow[IIDX::IIV];
+						iinv.wc[ug.rc] = nscom.inflow[IIDX::IIW];
+					}
 				}
 				else
 				{
-					iinv.uc[ug.rc] = nscom.inflow[IIDX::IIU];
-					iinv.vc[ug.rc] = nscom.inflow[IIDX::IIV];
-					iinv.wc[ug.rc] = nscom.inflow[IIDX::IIW];
-				}
-			}
-			else
-			{
-				//subsonic
-				Real riemp = vnin + 2.0 * cin / gamm1;
-				Real riemm = vnref - 2.0 * cref / gamm1;
-				Real vnb = half * (riemp + riemm);
-				Real cb = fourth * (riemp - riemm) * gamm1;
-
-				Real vtx, vty, vtz, entr;
-				if (vnb >= 0.0)
-				{
-					// exit
-					entr = pin / pow(rin, nscom.gama);
-
-					vtx = uin - gcom.xfn * vnin;
-					vty = vin - gcom.yfn * vnin;
-					vtz = win - gcom.zfn * vnin;
-				}
-				else
-				{
-					//inlet
-					entr = pref / pow(rref, nscom.gama);
-					vtx = uref - gcom.xfn * vnref;
-					vty = vref - gcom.yfn * vnref;
-					vtz = wref - gcom.zfn * vnref;
-				}
-
-				Real rb = pow((cb * cb / (entr * nscom.gama)), one / gamm1);
-				Real ub = vtx + gcom.xfn * vnb;
-				Real vb = vty + gcom.yfn * vnb;
-				Real wb = vtz + gcom.zfn * vnb;
-				Real pb = cb * cb * rb / nscom.gama;
+					//subsonic
+					Real riemp = vnin + 2.0 * cin / gamm1;
+					Real riemm = vnref - 2.0 * cref / gamm1;
+					Real vnb = half * (riemp + riemm);
+					Real cb = fourth * (riemp - riemm) * gamm1;
+
+					Real vtx, vty, vtz, entr;
+					if (vnb >= 0.0)
+					{
+						// exit
+						entr = pin / pow(rin, nscom.gama);
+
+						vtx = uin - gcom.xfn * vnin;
+						vty = vin - gcom.yfn * vnin;
+						vtz = win - gcom.zfn * vnin;
+					}
+					else
+					{
+						//inlet
+						entr = pref / pow(rref, nscom.gama);
+						vtx = uref - gcom.xfn * vnref;
+						vty = vref - gcom.yfn * vnref;
+						vtz = wref - gcom.zfn * vnref;
+					}
+
+					Real rb = pow((cb * cb / (entr * nscom.gama)), one / gamm1);
+					Real ub = vtx + gcom.xfn * vnb;
+					Real vb = vty + gcom.yfn * vnb;
+					Real wb = vtz + gcom.zfn * vnb;
+					Real pb = cb * cb * rb / nscom.gama;
 
 				
-				iinv.uc[ug.rc] = ub;
-				iinv.vc[ug.rc] = vb;
-				iinv.wc[ug.rc] = wb;
+					iinv.uc[ug.rc] = ub;
+					iinv.vc[ug.rc] = vb;
+					iinv.wc[ug.rc] = wb;
 
+				}
 			}
-		}
 
-		else if (ug.bctype == BC::OVERSET)
-		{
-			;
-		}
+			else if (ug.bctype == BC::OVERSET)
+			{
+				;
+			}
 
-		else if (ug.bctype  == BC::GENERIC_2)
-		{
+			else if (ug.bctype  == BC::GENERIC_2)
+			{
 		
-			;
+				;
 			
-		}
+			}
 		
 
+		}
 	}
 
 /*for (int cId = 0; cId < ug.nCells; cId++)
@@ -1280,46 +1177,27 @@ void UINsInvterm::CalcPressCorrectEqu()
 	}*/
 
 		//Bgmres solution
-	NonZero.Number = 0;
-
-	for (int cId = 0; cId < ug.nTCell; ++cId)
-	{   
-		//ug.cId = cId;                                                                  // Main unit number
-		int fn = (*ug.c2f)[cId].size();                                                                 // Number of adjacent faces of element
-		NonZero.Number += fn;
-	}
-	NonZero.Number = NonZero.Number + ug.nTCell;                                                        // Count of non-zero elements
-	Rank.RANKNUMBER = ug.nTCell;                                                                        // Row and column of matrix
+	//The pattern is the one of the momentum equations, kept with the grid;
+	//the off-diagonal entries of a row come in c2f order as sjp does
+	CsrPattern * csr = CsrPatternFactory::GetCsrPattern(ug.grid);
+	NonZero.Number = csr->nnz;                                                                           // Count of non-zero elements
+	Rank.RANKNUMBER = csr->nRow;                                                                        // Row and column of matrix
 	Rank.COLNUMBER = 1;
 	Rank.NUMBER = NonZero.Number;                                                                      // The number of nonzero elements in matrix
-	Rank.Init();
+	Rank.system = SYSTEM_PRESSURE;                                                                     // Pressure correction, solved as set by ipsolver
+	Rank.grid = ug.grid;                                                                               // Grid of the system, the cached AMG hierarchies are kept per grid
+	Rank.Init(&csr->ia[0], &csr->ja[0]);
 	double residual_p;
 	for (int cId = 0; cId < ug.nTCell; ++cId)
 	{
 		iinv.ppd = iinv.pp[cId];
-		Rank.TempIA[0] = 0;
-		int n = Rank.TempIA[cId];
+		int n = csr->ia[cId];
 		int fn = (*ug.c2f)[cId].size();
-		Rank.TempIA[cId + 1] = Rank.TempIA[cId] + fn + 1;                  // The number of non-zero elements in the first n + 1 row
 		for (int iFace = 0; iFace < fn; ++iFace)
 		{
-			int fId = (*ug.c2f)[cId][iFace];                           // Number of adjacent faces
-			ug.fId = fId;
-			ug.lc = (*ug.lcf)[fId];                                    // Face left unit
-			ug.rc = (*ug.rcf)[fId];                                    // Face right unit
-			if (cId == ug.lc)
-			{
-				Rank.TempA[n + iFace] = iinv.sjp[cId][iFace];          //Non diagonal element value
-				Rank.TempJA[n + iFace] = ug.rc;                           //Vertical coordinates of non diagonal element
-			}
-			else if (cId == ug.rc)
-			{
-				Rank.TempA[n + iFace] = iinv.sjp[cId][iFace];          //Non diagonal element value
-				Rank.TempJA[n + iFace] = ug.lc;                           //Vertical coordinates of non diagonal element
-			}
+			Rank.TempA[n + iFace] = iinv.sjp[cId][iFace];              //Non diagonal element value
 		}
-		Rank.TempA[n + fn] = iinv.spp[cId];                            //Main diagonal element
-		Rank.TempJA[n + fn] = cId;                                        //Principal diagonal ordinate
+		Rank.TempA[csr->diag[cId]] = iinv.spp[cId];                    //Main diagonal element
 
 		Rank.TempB[cId][0] = iinv.bp[cId];                             //Right end item
 	}
@@ -1332,8 +1210,6 @@ void UINsInvterm::CalcPressCorrectEqu()
 		iinv.pp[cId] = Rank.TempX[cId][0]; //Of the current momentPressure correction value
 	}
 
-	Rank.Deallocate();
-
 	//iinv.res_p = 0;
 	//iinv.res_p = MAX(iinv.res_p, abs(iinv.ppd - iinv.pp[ug.cId]));
 
@@ -1626,197 +1502,201 @@ void UINsInvterm::UpdateSpeed()
 
 	}
 
-	for (int fId = 0; fId < ug.nBFaces; ++fId)
+	BcInfo * bcInfo = ug.bcRecord->bcInfo;
+	ug.nRegion = bcInfo->bcType.size();
+	for (int ir = 0; ir < ug.nRegion; ++ir)
 	{
-		ug.fId = fId;
+		ug.ir = ir;
+		ug.bctype = bcInfo->bcType[ir];
+		ug.nRBFace = bcInfo->bcFace[ir].size();
+		for (int ibc = 0; ibc < ug.nRBFace; ++ibc)
+		{
+			ug.fId = bcInfo->bcFace[ug.ir][ibc];
+			ug.bcNameId = bcInfo->bcNameId[ug.ir][ibc];
 
-		BcInfo * bcInfo = ug.bcRecord->bcInfo;
+			ug.lc = (*ug.lcf)[ug.fId];
+			ug.rc = (*ug.rcf)[ug.fId];
 
-		ug.fId = bcInfo->bcFace[ug.ir][fId];
-		ug.bcNameId = bcInfo->bcNameId[ug.ir][fId];
+			if (ug.bctype < 0)
+			{
+				false;
+			}
 
-		ug.lc = (*ug.lcf)[ug.fId];
-		ug.rc = (*ug.rcf)[ug.fId];
+			else if (ug.bctype == BC::SOLID_SURFACE)
+			{
+				nscom.bcdtkey = 0;
+				if (ug.bcNameId == -1) return; //interface
+				int dd = ins_bc_data.r2d[ug.bcNameId];
+				if (dd != -1)
+				{
+					nscom.bcdtkey = 1;
+					nscom.bcflow = &ins_bc_data.dataList[dd];
+				}
 
-		if (ug.bctype < 0)
-		{
-			false;
-		}
+				if (nscom.bcdtkey == 0)
+				{
+					iinv.up[ug.rc] = -iinv.up[ug.lc] + 2 * gcom.vfx;
+					iinv.vp[ug.rc] = -iinv.vp[ug.lc] + 2 * gcom.vfy;
+					iinv.wp[ug.rc] = -iinv.wp[ug.lc] + 2 * gcom.vfz;
+				}
+				else
+				{
+					iinv.up[ug.rc] = -iinv.up[ug.lc] + 2 * (*nscom.bcflow)[IIDX::IIU];
+					iinv.vp[ug.rc] = -iinv.vp[ug.lc] + 2 * (*nscom.bcflow)[IIDX::IIV];
+					iinv.wp[ug.rc] = -iinv.wp[ug.lc] + 2 * (*nscom.bcflow)[IIDX::IIW];
+				}
+			}
 
-		else if (ug.bctype == BC::SOLID_SURFACE)
-		{
-			nscom.bcdtkey = 0;
-			if (ug.bcNameId == -1) return; //interface
-			int dd = ins_bc_data.r2d[ug.bcNameId];
-			if (dd != -1)
+			else if (ug.bctype == BC::INFLOW)
 			{
-				nscom.bcdtkey = 1;
-				nscom.bcflow = &ins_bc_data.dataList[dd];
+				iinv.up[ug.rc] = nscom.inflow[IIDX::IIU];
+				iinv.vp[ug.rc] = nscom.inflow[IIDX::IIV];
+				iinv.wp[ug.rc] = nscom.inflow[IIDX::IIW];
 			}
 
-			if (nscom.bcdtkey == 0)
+			else if (ug.bctype == BC::OUTFLOW)
 			{
-				iinv.up[ug.rc] = -iinv.up[ug.lc] + 2 * gcom.vfx;
-				iinv.vp[ug.rc] = -iinv.vp[ug.lc] + 2 * gcom.vfy;
-				iinv.wp[ug.rc] = -iinv.wp[ug.lc] + 2 * gcom.vfz;
+				iinv.up[ug.rc] = iinv.up[ug.lc];
+				iinv.vp[ug.rc] = iinv.vp[ug.lc];
+				iinv.wp[ug.rc] = iinv.wp[ug.lc];
 			}
-			else
+
+			else if (ug.bctype == BC::POLE || ug.bctype / 10 == BC::POLE)
 			{
-				iinv.up[ug.rc] = -iinv.up[ug.lc] + 2 * (*nscom.bcflow)[IIDX::IIU];
-				iinv.vp[ug.rc] = -iinv.vp[ug.lc] + 2 * (*nscom.bcflow)[IIDX::IIV];
-				iinv.wp[ug.rc] = -iinv.wp[ug.lc] + 2 * (*nscom.bcflow)[IIDX::IIW];
+				iinv.up[ug.rc] = iinv.up[ug.lc];
+				iinv.vp[ug.rc] = iinv.vp[ug.lc];
+				iinv.wp[ug.rc] = iinv.wp[ug.lc];
 			}
-		}
-
-		else if (ug.bctype == BC::INFLOW)
-		{
-			iinv.up[ug.rc] = nscom.inflow[IIDX::IIU];
-			iinv.vp[ug.rc] = nscom.inflow[IIDX::IIV];
-			iinv.wp[ug.rc] = nscom.inflow[IIDX::IIW];
-		}
-
-		else if (ug.bctype == BC::OUTFLOW)
-		{
-			iinv.up[ug.rc] = iinv.up[ug.lc];
-			iinv.vp[ug.rc] = iinv.vp[ug.lc];
-			iinv.wp[ug.rc] = iinv.wp[ug.lc];
-		}
-
-		else if (ug.bctype == BC::POLE || ug.bctype / 10 == BC::POLE)
-		{
-			iinv.up[ug.rc] = iinv.up[ug.lc];
-			iinv.vp[ug.rc] = iinv.vp[ug.lc];
-			iinv.wp[ug.rc] = iinv.wp[ug.lc];
-		}
 
-		else if (ug.bctype == BC::EXTRAPOLATION)
-		{
-			iinv.up[ug.rc] = iinv.up[ug.lc];
-			iinv.vp[ug.rc] = iinv.vp[ug.lc];
-			iinv.wp[ug.rc] = iinv.wp[ug.lc];
-		}
+			else if (ug.bctype == BC::EXTRAPOLATION)
+			{
+				iinv.up[ug.rc] = iinv.up[ug.lc];
+				iinv.vp[ug.rc] = iinv.vp[ug.lc];
+				iinv.wp[ug.rc] = iinv.wp[ug.lc];
+			}
 
-		else if (ug.bctype == BC::SYMMETRY)
-		{
-			Real vx1 = iinv.up[ug.lc];
-			Real vy1 = iinv.vp[ug.lc];
-			Real vz1 = iinv.wp[ug.lc];
+			else if (ug.bctype == BC::SYMMETRY)
+			{
+				Real vx1 = iinv.up[ug.lc];
+				Real vy1 = iinv.vp[ug.lc];
+				Real vz1 = iinv.wp[ug.lc];
 
-			Real vnRelative1 = (*ug.xfn)[ug.fId] * vx1 + (*ug.yfn)[ug.fId] * vy1 + (*ug.zfn)[ug.fId] * vz1 - (*ug.vfn)[ug.fId];
+				Real vnRelative1 = (*ug.xfn)[ug.fId] * vx1 + (*ug.yfn)[ug.fId] * vy1 + (*ug.zfn)[ug.fId] * vz1 - (*ug.vfn)[ug.fId];
 
-			iinv.up[ug.rc] = iinv.up[ug.lc] - two * (*ug.xfn)[ug.fId] * vnRelative1;
-			iinv.vp[ug.rc] = iinv.vp[ug.lc] - two * (*ug.yfn)[ug.fId] * vnRelative1;
-			iinv.wp[ug.rc] = iinv.wp[ug.lc] - two * (*ug.zfn)[ug.fId] * vnRelative1;
+				iinv.up[ug.rc] = iinv.up[ug.lc] - two * (*ug.xfn)[ug.fId] * vnRelative1;
+				iinv.vp[ug.rc] = iinv.vp[ug.lc] - two * (*ug.yfn)[ug.fId] * vnRelative1;
+				iinv.wp[ug.rc] = iinv.wp[ug.lc] - two * (*ug.zfn)[ug.fId] * vnRelative1;
 
-		}
+			}
 
-		else if (ug.bctype == BC::SYMMETRY)
-		{
+			else if (ug.bctype == BC::SYMMETRY)
+			{
 
-		}
+			}
 
-		else if (ug.bctype == BC::FARFIELD)
-		{
-			Real rin = (*uinsf.q)[IIDX::IIR][ug.lc];
-			Real uin = iinv.up[ug.lc];
-			Real vin = iinv.vp[ug.lc];
-			Real win = iinv.wp[ug.lc];
-			Real pin = (*uinsf.q)[IIDX::IIP][ug.lc];
+			else if (ug.bctype == BC::FARFIELD)
+			{
+				Real rin = (*uinsf.q)[IIDX::IIR][ug.lc];
+				Real uin = iinv.up[ug.lc];
+				Real vin = iinv.vp[ug.lc];
+				Real win = iinv.wp[ug.lc];
+				Real pin = (*uinsf.q)[IIDX::IIP][ug.lc];
 
-			gcom.xfn *= nscom.faceOuterNormal;
-			gcom.yfn *= nscom.faceOuterNormal;
-			gcom.zfn *= nscom.faceOuterNormal;
+				gcom.xfn *= nscom.faceOuterNormal;
+				gcom.yfn *= nscom.faceOuterNormal;
+				gcom.zfn *= nscom.faceOuterNormal;
 
-			Real rref = nscom.inflow[IIDX::IIR];
-			Real uref = nscom.inflow[IIDX::IIU];
-			Real vref = nscom.inflow[IIDX::IIV];
-			Real wref = nscom.inflow[IIDX::IIW];
-			Real pref = nscom.inflow[IIDX::IIP];
+				Real rref = nscom.inflow[IIDX::IIR];
+				Real uref = nscom.inflow[IIDX::IIU];
+				Real vref = nscom.inflow[IIDX::IIV];
+				Real wref = nscom.inflow[IIDX::IIW];
+				Real pref = nscom.inflow[IIDX::IIP];
 
-			Real vnref = gcom.xfn * uref + gcom.yfn * vref + gcom.zfn * wref - gcom.vfn;
-			Real vnin = gcom.xfn * uin + gcom.yfn * vin + gcom.zfn * win - (*ug.vfn)[ug.fId];
+				Real vnref = gcom.xfn * uref + gcom.yfn * vref + gcom.zfn * wref - gcom.vfn;
+				Real vnin = gcom.xfn * uin + gcom.yfn * vin + gcom.zfn * win - (*ug.vfn)[ug.fId];
 
-			Real cref = sqrt(ABS(nscom.gama_ref * pref / rref));
-			Real cin = sqrt(ABS(nscom.gama * pin / rin));
+				Real cref = sqrt(ABS(nscom.gama_ref * pref / rref));
+				Real cin = sqrt(ABS(nscom.gama * pin / rin));
 
-			Real gamm1 = nscom.gama - one;
+				Real gamm1 = nscom.gama - one;
 
-			Real velin = DIST(uin, vin, win);
+				Real velin = DIST(uin, vin, win);
 
-			//Supersonic
-			if (velin > cin)
-			{
-				if (vnin >= 0.0)
+				//Supersonic
+				if (velin > cin)
 				{
-					iinv.up[ug.rc] = iinv.up[ug.lc];
-					iinv.vp[ug.rc] = iinv.vp[ug.lc];
-					iinv.wp[ug.rc] = iinv.wp[ug.lc];
+					if (vnin >= 0.0)
+					{
+						iinv.up[ug.rc] = iinv.up[ug.lc];
+						iinv.vp[ug.rc] = iinv.vp[ug.lc];
+						iinv.wp[ug.rc] = iinv.wp[ug.lc];
+					}
+					else
+					{
+						iinv.up[ug.rc] = nscom.inflow[IIDX::IIU];
+						iinv.vp[ug.rc] = nscom.inflow[IIDX::IIV];
+						iinv.wp[ug.rc] = nscom.inflow[IIDX::IIW];
+					}
 				}
 				else
 				{
-					iinv.up[ug.rc] = nscom.inflow[IIDX::IIU];
-					iinv.vp[ug.rc] = nscom.inflow[IIDX::IIV];
-					iinv.wp[ug.rc] = nscom.inflow[IIDX::IIW];
-				}
-			}
-			else
-			{
-				//subsonic
-				Real riemp = vnin + 2.0 * cin / gamm1;
-				Real riemm = vnref - 2.0 * cref / gamm1;
-				Real vnb = half * (riemp + riemm);
-				Real cb = fourth * (riemp - riemm) * gamm1;
-
-				Real vtx, vty, vtz, entr;
-				if (vnb >= 0.0)
-				{
-					// exit
-					entr = pin / pow(rin, nscom.gama);
+					//subsonic
+					Real riemp = vnin + 2.0 * cin / gamm1;
+					Real riemm = vnref - 2.0 * cref / gamm1;
+					Real vnb = half * (riemp + riemm);
+					Real cb = fourth * (riemp - riemm) * gamm1;
+
+					Real vtx, vty, vtz, entr;
+					if (vnb >= 0.0)
+					{
+						// exit
+						entr = pin / pow(rin, nscom.gama);
+
+						vtx = uin - gcom.xfn * vnin;
+						vty = vin - gcom.yfn * vnin;
+						vtz = win - gcom.zfn * vnin;
+					}
+					else
+					{
+						//inlet
+						entr = pref / pow(rref, nscom.gama);
+						vtx = uref - gcom.xfn * vnref;
+						vty = vref - gcom.yfn * vnref;
+						vtz = wref - gcom.zfn * vnref;
+					}
+
+					Real rb = pow((cb * cb / (entr * nscom.gama)), one / gamm1);
+					Real ub = vtx + gcom.xfn * vnb;
+					Real vb = vty + gcom.yfn * vnb;
+					Real wb = vtz + gcom.zfn * vnb;
+					Real pb = cb * cb * rb / nscom.gama;
+
+
+					iinv.up[ug.rc] = ub;
+					iinv.vp[ug.rc] = vb;
+					iinv.wp[ug.rc] = wb;
 
-					vtx = uin - gcom.xfn * vnin;
-					vty = vin - gcom.yfn * vnin;
-					vtz = win - gcom.zfn * vnin;
-				}
-				else
-				{
-					//inlet
-					entr = pref / pow(rref, nscom.gama);
-					vtx = uref - gcom.xfn * vnref;
-					vty = vref - gcom.yfn * vnref;
-					vtz = wref - gcom.zfn * vnref;
 				}
+			}
 
-				Real rb = pow((cb * cb / (entr * nscom.gama)), one / gamm1);
-				Real ub = vtx + gcom.xfn * vnb;
-				Real vb = vty + gcom.yfn * vnb;
-				Real wb = vtz + gcom.zfn * vnb;
-				Real pb = cb * cb * rb / nscom.gama;
+			else if (ug.bctype == BC::OVERSET)
+			{
+				;
+			}
 
+			else if (ug.bctype == BC::GENERIC_2)
+			{
 
-				iinv.up[ug.rc] = ub;
-				iinv.vp[ug.rc] = vb;
-				iinv.wp[ug.rc] = wb;
+				;
 
 			}
-		}
 
-		else if (ug.bctype == BC::OVERSET)
-		{
-			;
-		}
 
-		else if (ug.bctype == BC::GENERIC_2)
-		{
-
-			;
+			(*uinsf.q)[IIDX::IIU][ug.rc] = iinv.up[ug.rc];
+			(*uinsf.q)[IIDX::IIV][ug.rc] = iinv.vp[ug.rc];
+			(*uinsf.q)[IIDX::IIW][ug.rc] = iinv.wp[ug.rc];
 
 		}
-
-
-		(*uinsf.q)[IIDX::IIU][ug.rc] = iinv.up[ug.rc];
-		(*uinsf.q)[IIDX::IIV][ug.rc] = iinv.vp[ug.rc];
-		(*uinsf.q)[IIDX::IIW][ug.rc] = iinv.wp[ug.rc];
-
 	}
 
 
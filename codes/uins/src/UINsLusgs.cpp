@@ -26,6 +26,9 @@ License
 #include "UCom.h"
 #include "UINsCom.h"
 #include "Com.h"
+#include "LusgsPlan.h"
+#include "Ctrl.h"
+#include "NsCom.h"
 #include "UnsGrid.h"
 #include "CellMesh.h"
 #include "CellTopo.h"
@@ -35,17 +38,26 @@ License
 #include "HXMath.h"
 #include "Parallel.h"
 #include "Iteration.h"
+#include "Profiler.h"
 #include <iostream>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 BeginNameSpace( ONEFLOW )
 
 UINsLusgs::UINsLusgs()
 {
+    this->plan = 0;
 }
 
 UINsLusgs::~UINsLusgs()
 {
+    for ( HXSize_t i = 0; i < threadSolvers.size(); ++ i )
+    {
+        delete threadSolvers[ i ];
+    }
 }
 
 void UINsLusgs::SingleSweep()
@@ -54,16 +66,20 @@ void UINsLusgs::SingleSweep()
     this->UpperSweep();
 }
 
+void UINsLusgs::Initialize()
+{
+    this->Init();
+    this->CalcSpectrum();
+}
+
 void UINsLusgs::Init()
 {
-    UnsGrid * grid = Zone::GetUnsGrid();
-    FaceTopo * faceTopo = grid->faceTopo;
-    CellTopo * cellTopo = grid->cellMesh->cellTopo;
-    cellTopo->CalcC2f( faceTopo );
-    ug.Init();
+    ONEFLOW::ug.Init();
+    this->ug = ONEFLOW::ug;
+    this->nscom = ONEFLOW::nscom;
     nslu.Init();
     uinsf.Init();
-    this->CalcSpectrum();
+    this->plan = LusgsFactory::GetLusgsPlan( ug.grid );
 }
 
 void UINsLusgs::CalcSpectrum()
@@ -75,34 +91,20 @@ void UINsLusgs::CalcSpectrum()
 
 void UINsLusgs::LowerSweep()
 {
+    static int profileId = Profiler::GetId( "sweep", PROFILE_KERNEL );
+    ProfileScope profileScope( profileId );
+
     this->Init();
 
-    for ( int cId = 0; cId < ug.nCells; ++ cId )
+    if ( ctrl.ilusgsthread != 0 )
     {
-        ug.cId = cId;
-        if ( cId == 9 )
-        {
-            int kkk = 1;
-        }
-
-        gcom.blank = ( * ug.blankf )[ ug.cId ];
-
-        if ( this->IsOversetCell() )
-        {
-            this->ZeroOversetCell();
-        }
-        else
-        {
-            this->PrepareSweep();
-
-            this->ZeroFluxIncrement();
-        
-            this->SolveLowerCell();
-
-            this->CalcLowerChange();
-        }
+        this->WavefrontSweep( this->plan->lowerSchedule, true );
+        return;
+    }
 
-        this->Update();
+    for ( int cId = 0; cId < ug.nCells; ++ cId )
+    {
+        this->LowerSweepCell( cId );
     }
 
     //UploadInterfaceValue( grid, dqField, "dqField",  numberOfTotalEquations );
@@ -110,105 +112,159 @@ void UINsLusgs::LowerSweep()
 
 void UINsLusgs::UpperSweep()
 {
+    static int profileId = Profiler::GetId( "sweep", PROFILE_KERNEL );
+    ProfileScope profileScope( profileId );
+
     this->Init();
     //this->LusgsBoundary();
     //DownloadInterfaceValue( grid, dqField, "dqField",  numberOfTotalEquations );
-    
+
+    if ( ctrl.ilusgsthread != 0 )
+    {
+        this->WavefrontSweep( this->plan->upperSchedule, false );
+        return;
+    }
+
     for ( int cId = ug.nCells - 1; cId >= 0; -- cId )
     {
-        ug.cId = cId;
-        gcom.blank = ( * ug.blankf )[ ug.cId ];
+        this->UpperSweepCell( cId );
+    }
+}
 
-        if ( this->IsOversetCell() )
-        {
-            this->ZeroOversetCell();
-        }
-        else
-        {
-            this->PrepareSweep();
+void UINsLusgs::LowerSweepCell( int cId )
+{
+    ug.cId = cId;
+    gcom.blank = ( * ug.blankf )[ ug.cId ];
 
-            this->ZeroFluxIncrement();
+    if ( this->IsOversetCell() )
+    {
+        this->ZeroOversetCell();
+    }
+    else
+    {
+        this->PrepareSweep();
 
-            this->SolveUpperCell();
+        this->ZeroFluxIncrement();
 
-            this->CalcUpperChange();
-        }
+        this->SolveLowerCell();
 
-        this->Update();
+        this->CalcLowerChange();
     }
+
+    this->Update();
 }
 
-void UINsLusgs::SolveLowerCell()
+void UINsLusgs::UpperSweepCell( int cId )
 {
-    int fn = ( * ug.c2f )[ ug.cId ].size();
-    for ( int iFace = 0; iFace < fn; ++ iFace )
+    ug.cId = cId;
+    gcom.blank = ( * ug.blankf )[ ug.cId ];
+
+    if ( this->IsOversetCell() )
+    {
+        this->ZeroOversetCell();
+    }
+    else
     {
-        int fId = ( * ug.c2f )[ ug.cId ][ iFace ];
-        this->SolveLower( fId );
+        this->PrepareSweep();
+
+        this->ZeroFluxIncrement();
+
+        this->SolveUpperCell();
+
+        this->CalcUpperChange();
     }
+
+    this->Update();
 }
 
-void UINsLusgs::SolveUpperCell()
+//Tasks of one level only read dq of earlier levels, so each level is swept by all threads.
+//Thread 0 sweeps with this solver, every other thread with its own copy of it.
+void UINsLusgs::WavefrontSweep( LusgsSchedule & schedule, bool lowerFlag )
 {
-    int fn = ( * ug.c2f )[ ug.cId ].size();
-    for ( int iFace = 0; iFace < fn; ++ iFace )
+    int nThreads = 1;
+#ifdef _OPENMP
+    nThreads = omp_get_max_threads();
+#endif
+    while ( static_cast< int >( threadSolvers.size() ) < nThreads - 1 )
     {
-        int fId = ( * ug.c2f )[ ug.cId ][ iFace ];
-        this->SolveUpper( fId );
+        threadSolvers.push_back( new UINsLusgs() );
     }
-}
 
-void UINsLusgs::SolveLower( int fId )
-{
-    if ( this->CanNotLowerSolve( fId ) ) return;
+    #pragma omp parallel num_threads( nThreads )
+    {
+        int iThread = 0;
+#ifdef _OPENMP
+        iThread = omp_get_thread_num();
+#endif
+        UINsLusgs * solver = this;
+        if ( iThread != 0 )
+        {
+            solver = threadSolvers[ iThread - 1 ];
+            solver->CopySweepState( this );
+        }
+        Real norm0 = solver->nslu.norm;
 
-    this->Solve( fId, - 1 );
-}
+        #pragma omp barrier
 
-void UINsLusgs::SolveUpper( int fId )
-{
-    if ( this->CanNotUpperSolve( fId ) ) return;
+        int nLevels = schedule.GetNLevels();
+        for ( int iLevel = 0; iLevel < nLevels; ++ iLevel )
+        {
+            #pragma omp for schedule( dynamic )
+            for ( int iTask = schedule.start[ iLevel ]; iTask < schedule.start[ iLevel + 1 ]; ++ iTask )
+            {
+                for ( int i = schedule.taskStart[ iTask ]; i < schedule.taskStart[ iTask + 1 ]; ++ i )
+                {
+                    int cId = schedule.cells[ i ];
+                    if ( lowerFlag )
+                    {
+                        solver->LowerSweepCell( cId );
+                    }
+                    else
+                    {
+                        solver->UpperSweepCell( cId );
+                    }
+                }
+            }
+        }
 
-    this->Solve( fId, - 1 );
+        if ( iThread != 0 )
+        {
+            #pragma omp critical
+            this->nslu.norm += solver->nslu.norm - norm0;
+        }
+    }
 }
 
-bool UINsLusgs::CanNotLowerSolve( int fId )
+void UINsLusgs::CopySweepState( UINsLusgs * solver )
 {
-    ug.fId = fId;
-
-    ug.lc = ( * ug.lcf )[ ug.fId ];
-    ug.rc = ( * ug.rcf )[ ug.fId ];
-
-    // One of lc  and rc must be cell itself.
-    // Now its neighboring cell belongs to lower triangular
-    return ( ug.lc > ug.cId || ug.rc > ug.cId );
+    this->ug    = solver->ug;
+    this->gcom  = solver->gcom;
+    this->nscom = solver->nscom;
+    this->nslu  = solver->nslu;
+    this->plan  = solver->plan;
 }
 
-bool UINsLusgs::CanNotUpperSolve( int fId )
+void UINsLusgs::SolveLowerCell()
 {
-    ug.fId = fId;
-
-    ug.lc = ( * ug.lcf )[ ug.fId ];
-    ug.rc = ( * ug.rcf )[ ug.fId ];
-
-    // One of lc  and rc must be cell itself.
-    // Now its neighboring cell belongs to upper triangular
-    return ( ug.lc < ug.cId || ug.rc < ug.cId );
+    LusgsSweepList & lower = this->plan->lower;
+    for ( int i = lower.start[ ug.cId ]; i < lower.start[ ug.cId + 1 ]; ++ i )
+    {
+        this->Solve( lower, i, - 1 );
+    }
 }
 
-void UINsLusgs::Solve( int fId, int signValue )
+void UINsLusgs::SolveUpperCell()
 {
-    ug.fId = fId;
-
-    if ( fId == 147489 )
+    LusgsSweepList & upper = this->plan->upper;
+    for ( int i = upper.start[ ug.cId ]; i < upper.start[ ug.cId + 1 ]; ++ i )
     {
-        int kkk = 1;
+        this->Solve( upper, i, - 1 );
     }
+}
 
-    ug.lc = ( * ug.lcf )[ ug.fId ];
-    ug.rc = ( * ug.rcf )[ ug.fId ];
-
-    this->SetMeshGeometry();
+void UINsLusgs::Solve( LusgsSweepList & sweepList, int i, int signValue )
+{
+    sweepList.SetGeometry( i, ug, gcom );
 
     this->PrepareData();
 
@@ -219,11 +275,6 @@ void UINsLusgs::Solve( int fId, int signValue )
     this->AddFluxIncrement();
 }
 
-void UINsLusgs::SetMeshGeometry()
-{
-    gcom.SetGeometry();
-}
-
 void UINsLusgs::PrepareData()
 {
     for ( int iEqu = 0; iEqu < nslu.nEqu; ++ iEqu )
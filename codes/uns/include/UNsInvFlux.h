@@ -23,6 +23,8 @@ License
 
 #pragma once
 #include "NsInvFlux.h"
+#include "UCom.h"
+#include "NsInvBatch.h"
 
 BeginNameSpace( ONEFLOW )
 
@@ -36,13 +38,24 @@ public:
     UNsInvFlux ();
     ~UNsInvFlux();
 public:
+    void Init();
     void Alloc();
     void DeAlloc();
     void CalcFlux();
+    void CalcFluxInner();
+    void CalcFluxHalo();
     void CalcInvFlux();
+    void CalcInvFlux( IntField & faceList );
+    void CalcInvFlux( int nListFaces, IntField * faceList );
+    void CalcFaceInvFlux( int fId );
+    void CalcBatchInvFlux( int ist, int ied, IntField * faceList );
+    bool IsBatched();
+    void CopyFaceState( UNsInvFlux * flux );
     void CalcInvFace();
+    void CalcInvFace( IntField & faceList );
     void CalcLimiter();
     void AddInvFlux();
+    void AddInvFlux( IntField & faceList );
     void PrepareFaceValue();
     void UpdateFaceInvFlux();
     void ReadTmp();
@@ -54,6 +67,9 @@ public:
     Limiter * limiter;
     LimField * limf;
     MRField * invflux;
+    UGeom ug;
+    NsInvBatch batch;
+    HXVector< UNsInvFlux * > threadFluxes;
 };
 
 EndNameSpace
@@ -32,7 +32,8 @@ public:
     ~NsLimField() override;
 public:
     void Init() override;
-    void BcQlQrFix() override;
+protected:
+    void BcFaceQlQrFix( int fId, int lc, int rc ) override;
 };
 
 class NsLimiter : public Limiter
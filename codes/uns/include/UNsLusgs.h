@@ -23,30 +23,40 @@ License
 
 #pragma once
 #include "NsLusgs.h"
+#include "UCom.h"
+#include "NsCom.h"
 BeginNameSpace( ONEFLOW )
 
+class LusgsPlan;
+class LusgsSweepList;
+class LusgsSchedule;
+
 class UNsLusgs : public NsLusgs
 {
 public:
     UNsLusgs ();
     ~UNsLusgs();
+public:
+    LusgsPlan * plan;
+    UGeom ug;
+    NsCom nscom;
+    HXVector< UNsLusgs * > threadSolvers;
 public:
     void LowerSweep() override;
     void UpperSweep() override;
+    void Initialize() override;
     void SingleSweep();
+    void LowerSweepCell( int cId );
+    void UpperSweepCell( int cId );
+    void WavefrontSweep( LusgsSchedule & schedule, bool lowerFlag );
+    void CopySweepState( UNsLusgs * solver );
     void PrepareSweep();
     void Update();
 
     void SolveLowerCell();
     void SolveUpperCell();
 
-    void SolveLower( int fId );
-    void SolveUpper( int fId );
-
-    bool CanNotLowerSolve( int fId );
-    bool CanNotUpperSolve( int fId );
-    void Solve( int fId, int signValue );
-    void SetMeshGeometry();
+    void Solve( LusgsSweepList & sweepList, int i, int signValue );
     void PrepareData();
     void PrepareDataFacePrim();
     void CalcViscousTerm();
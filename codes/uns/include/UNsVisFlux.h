@@ -24,6 +24,7 @@ License
 #pragma once
 #include "NsVisFlux.h"
 #include "HXArray.h"
+#include "UCom.h"
 
 BeginNameSpace( ONEFLOW )
 
@@ -36,11 +37,17 @@ public:
     typedef void ( UNsVisFlux:: * VisPointer )();
     VisPointer visPointer;
     MRField * visflux;
+    RealField * heatFace;
+    UGeom ug;
+    HXVector< UNsVisFlux * > threadFluxes;
 public:
+    void Init();
     void SetVisPointer();
     void CalcFlux();
     void PrepareField();
     void CalcVisFlux();
+    void CalcFaceFlux( int fId );
+    void CopyFaceState( UNsVisFlux * flux );
     void AddVisFlux();
     void CalcFaceVisFlux();
     void UpdateFaceVisFlux();
@@ -52,6 +59,7 @@ public:
     void AddChemHeatFlux();
     void AddHeatFlux();
     void SaveHeatFlux();
+    void CollectHeatFlux();
 
     void Alloc();
     void DeAlloc();
@@ -38,8 +38,13 @@ License
 #include "Iteration.h"
 #include "TurbCom.h"
 #include "UTurbCom.h"
+#include "Profiler.h"
+#include "Ctrl.h"
 #include <iostream>
 #include <iomanip>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 BeginNameSpace( ONEFLOW )
@@ -53,6 +58,20 @@ UNsInvFlux::UNsInvFlux()
 UNsInvFlux::~UNsInvFlux()
 {
     delete limiter;
+    for ( int i = 0; i < threadFluxes.size(); ++ i )
+    {
+        delete threadFluxes[ i ];
+    }
+}
+
+void UNsInvFlux::Init()
+{
+    ONEFLOW::ug.Init();
+    this->ug = ONEFLOW::ug;
+    this->nscom = ONEFLOW::nscom;
+    inv.Init();
+    unsf.Init();
+    batch.Init( nscom.nEqu, nscom.nBEqu, nscom.ischeme );
 }
 
 void UNsInvFlux::CalcLimiter()
@@ -74,6 +93,13 @@ void UNsInvFlux::CalcInvFace()
     this->BoundaryQlQrFixField();
 }
 
+void UNsInvFlux::CalcInvFace( IntField & faceList )
+{
+    limf->GetQlQr( faceList );
+    limf->CalcFaceValue( faceList );
+    limf->BcQlQrFix( faceList );
+}
+
 void UNsInvFlux::GetQlQrField()
 {
     limf->GetQlQr();
@@ -122,10 +148,8 @@ void UNsInvFlux::BoundaryQlQrFixField()
 
 void UNsInvFlux::CalcFlux()
 {
-    if ( nscom.icmpInv == 0 ) return;
-    inv.Init();
-    ug.Init();
-    unsf.Init();
+    if ( ONEFLOW::nscom.icmpInv == 0 ) return;
+    this->Init();
     Alloc();
 
     this->SetPointer( nscom.ischeme );
@@ -138,28 +162,205 @@ void UNsInvFlux::CalcFlux()
     DeAlloc();
 }
 
+//Faces whose states do not depend on the interface ghost cells,
+//evaluated while the interface data is still in flight
+void UNsInvFlux::CalcFluxInner()
+{
+    if ( ONEFLOW::nscom.icmpInv == 0 ) return;
+    if ( ! limiter->IsLocal() ) return;
+
+    this->Init();
+    Alloc();
+
+    this->SetPointer( nscom.ischeme );
+
+    uns_grad.Init();
+    uns_grad.CalcGrad();
+
+    this->CalcLimiter();
+
+    this->CalcInvFace( * ug.innerFaces );
+    this->CalcInvFlux( * ug.innerFaces );
+    this->AddInvFlux( * ug.innerFaces );
+
+    DeAlloc();
+}
+
+//The remaining faces, once the interface ghost cells have been received
+void UNsInvFlux::CalcFluxHalo()
+{
+    if ( ONEFLOW::nscom.icmpInv == 0 ) return;
+
+    if ( ! limiter->IsLocal() )
+    {
+        this->CalcFlux();
+        return;
+    }
+
+    this->Init();
+    Alloc();
+
+    this->SetPointer( nscom.ischeme );
+
+    uns_grad.Init();
+    uns_grad.CalcGradHalo();
+
+    limiter->CalcHaloLimiter();
+
+    this->CalcInvFace( * ug.haloFaces );
+    this->CalcInvFlux( * ug.haloFaces );
+    this->AddInvFlux( * ug.haloFaces );
+
+    DeAlloc();
+}
+
 void UNsInvFlux::CalcInvFlux()
 {
-    for ( int fId = 0; fId < ug.nFaces; ++ fId )
+    static int profileId = Profiler::GetId( "inv_flux", PROFILE_KERNEL );
+    ProfileScope profileScope( profileId );
+
+    this->CalcInvFlux( ug.nFaces, 0 );
+}
+
+void UNsInvFlux::CalcInvFlux( IntField & faceList )
+{
+    static int profileId = Profiler::GetId( "inv_flux", PROFILE_KERNEL );
+    ProfileScope profileScope( profileId );
+
+    this->CalcInvFlux( faceList.size(), & faceList );
+}
+
+//Faces are independent of each other, so they are shared out over the threads.
+//Thread 0 evaluates its faces with this flux object, every other thread with its own copy of it.
+void UNsInvFlux::CalcInvFlux( int nListFaces, IntField * faceList )
+{
+    int nThreads = GetFaceThreads();
+    while ( threadFluxes.size() < nThreads - 1 )
     {
-        ug.fId = fId;
+        threadFluxes.push_back( new UNsInvFlux() );
+    }
 
-        if ( fId == 24 )
+    bool batched = this->IsBatched();
+    int nBlocks = ( nListFaces + INV_BATCH - 1 ) / INV_BATCH;
+
+    #pragma omp parallel num_threads( nThreads )
+    {
+        int iThread = 0;
+#ifdef _OPENMP
+        iThread = omp_get_thread_num();
+#endif
+        UNsInvFlux * flux = this;
+        if ( iThread != 0 )
         {
-            int kkk = 1;
+            flux = threadFluxes[ iThread - 1 ];
+            flux->CopyFaceState( this );
         }
 
-        ug.lc = ( * ug.lcf )[ ug.fId ];
-        ug.rc = ( * ug.rcf )[ ug.fId ];
+        #pragma omp barrier
+
+        if ( batched )
+        {
+            #pragma omp for
+            for ( int iBlock = 0; iBlock < nBlocks; ++ iBlock )
+            {
+                int ist = iBlock * INV_BATCH;
+                int ied = MIN( ist + INV_BATCH, nListFaces );
+
+                flux->CalcBatchInvFlux( ist, ied, faceList );
+            }
+        }
+        else
+        {
+            #pragma omp for
+            for ( int iFace = 0; iFace < nListFaces; ++ iFace )
+            {
+                int fId = iFace;
+                if ( faceList ) fId = ( * faceList )[ iFace ];
+
+                flux->CalcFaceInvFlux( fId );
+            }
+        }
+    }
+}
+
+bool UNsInvFlux::IsBatched()
+{
+    if ( ctrl.iinvbatch != 1 ) return false;
+    if ( nscom.chemModel != 0 ) return false;
+    return NsInvBatch::IsBatched( nscom.ischeme );
+}
+
+//Faces ist to ied - 1 of the list in one pass of the batched kernel:
+//gather the face states into the lanes, solve, scatter the fluxes back
+void UNsInvFlux::CalcBatchInvFlux( int ist, int ied, IntField * faceList )
+{
+    int nFaces = ied - ist;
+
+    for ( int i = 0; i < nFaces; ++ i )
+    {
+        int fId = ist + i;
+        if ( faceList ) fId = ( * faceList )[ ist + i ];
+
+        int lc = ( * ug.lcf )[ fId ];
+        int rc = ( * ug.rcf )[ fId ];
+
+        batch.face [ i ] = fId;
+        batch.xfn  [ i ] = ( * ug.xfn   )[ fId ];
+        batch.yfn  [ i ] = ( * ug.yfn   )[ fId ];
+        batch.zfn  [ i ] = ( * ug.zfn   )[ fId ];
+        batch.vfn  [ i ] = ( * ug.vfn   )[ fId ];
+        batch.farea[ i ] = ( * ug.farea )[ fId ];
+        batch.gama1[ i ] = ( * unsf.gama )[ 0 ][ lc ];
+        batch.gama2[ i ] = ( * unsf.gama )[ 0 ][ rc ];
+    }
 
-        this->PrepareFaceValue();
+    for ( int iEqu = 0; iEqu < nscom.nEqu; ++ iEqu )
+    {
+        Real * q1 = & batch.prim1[ iEqu * INV_BATCH ];
+        Real * q2 = & batch.prim2[ iEqu * INV_BATCH ];
+        for ( int i = 0; i < nFaces; ++ i )
+        {
+            q1[ i ] = ( * limf->qf1 )[ iEqu ][ batch.face[ i ] ];
+            q2[ i ] = ( * limf->qf2 )[ iEqu ][ batch.face[ i ] ];
+        }
+    }
 
-        ( this->*invFluxPointer )();
+    batch.Solve( nFaces );
 
-        this->UpdateFaceInvFlux();
+    for ( int iEqu = 0; iEqu < nscom.nTEqu; ++ iEqu )
+    {
+        Real * f = & batch.flux[ iEqu * INV_BATCH ];
+        for ( int i = 0; i < nFaces; ++ i )
+        {
+            ( * invflux )[ iEqu ][ batch.face[ i ] ] = batch.farea[ i ] * f[ i ];
+        }
     }
 }
 
+void UNsInvFlux::CalcFaceInvFlux( int fId )
+{
+    ug.fId = fId;
+    ug.lc = ( * ug.lcf )[ ug.fId ];
+    ug.rc = ( * ug.rcf )[ ug.fId ];
+
+    this->PrepareFaceValue();
+
+    ( this->*invFluxPointer )();
+
+    this->UpdateFaceInvFlux();
+}
+
+void UNsInvFlux::CopyFaceState( UNsInvFlux * flux )
+{
+    this->ug    = flux->ug;
+    this->inv   = flux->inv;
+    this->nscom = flux->nscom;
+    this->limf  = flux->limf;
+    this->invflux = flux->invflux;
+    this->invFluxPointer = flux->invFluxPointer;
+    this->batch = flux->batch;
+}
+
 void UNsInvFlux::PrepareFaceValue()
 {
     gcom.xfn   = ( * ug.xfn   )[ ug.fId ];
@@ -214,6 +415,14 @@ void UNsInvFlux::AddInvFlux()
     }
 }
 
+void UNsInvFlux::AddInvFlux( IntField & faceList )
+{
+    UnsGrid * grid = Zone::GetUnsGrid();
+    MRField * res = GetFieldPointer< MRField >( grid, "res" );
+
+    ONEFLOW::AddF2CField( res, invflux, faceList );
+}
+
 void UNsInvFlux::Alloc()
 {
     invflux = new MRField( nscom.nEqu, ug.nFaces );
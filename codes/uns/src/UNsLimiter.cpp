@@ -64,38 +64,24 @@ void NsLimField::Init()
     this->ckfun = & NsCheckFunction;
 }
 
-void NsLimField::BcQlQrFix()
+void NsLimField::BcFaceQlQrFix( int fId, int lc, int rc )
 {
-    for ( int fId = 0; fId < ug.nBFaces; ++ fId )
-    {
-        int bcType = ug.bcRecord->bcType[ fId ];
-        if ( bcType == BC::INTERFACE ) continue;
-        if ( bcType == BC::PERIODIC ) continue;
+    int bcType = ug.bcRecord->bcType[ fId ];
 
-        ug.fId = fId;
-        ug.lc = ( * ug.lcf )[ ug.fId ];
-        ug.rc = ( * ug.rcf )[ ug.fId ];
+    for ( int iEqu = 0; iEqu < this->nEqu; ++ iEqu )
+    {
+        Real tmp = half * ( ( * this->q )[ iEqu ][ lc ] + ( * this->q )[ iEqu ][ rc ] );
 
-        if ( ug.fId == 24 )
-        {
-            int kkk = 1;
-        }
+        ( * this->qf1 )[ iEqu ][ fId ] = tmp;
+        ( * this->qf2 )[ iEqu ][ fId ] = tmp;
+    }
 
+    if ( bcType == BC::SOLID_SURFACE )
+    {
         for ( int iEqu = 0; iEqu < this->nEqu; ++ iEqu )
         {
-            Real tmp = half * ( ( * this->q )[ iEqu ][ ug.lc ] + ( * this->q )[ iEqu ][ ug.rc ] );
-
-            ( * this->qf1 )[ iEqu ][ ug.fId ] = tmp;
-            ( * this->qf2 )[ iEqu ][ ug.fId ] = tmp;
-        }
-
-        if ( bcType == BC::SOLID_SURFACE )
-        {
-            for ( int iEqu = 0; iEqu < this->nEqu; ++ iEqu )
-            {
-                ( * this->qf1 )[ iEqu ][ ug.fId ] = ( * unsf.bc_q )[ iEqu ][ ug.fId ];
-                ( * this->qf2 )[ iEqu ][ ug.fId ] = ( * unsf.bc_q )[ iEqu ][ ug.fId ];
-            }
+            ( * this->qf1 )[ iEqu ][ fId ] = ( * unsf.bc_q )[ iEqu ][ fId ];
+            ( * this->qf2 )[ iEqu ][ fId ] = ( * unsf.bc_q )[ iEqu ][ fId ];
         }
     }
 }
@@ -40,8 +40,12 @@ License
 #include "ULimiter.h"
 #include "FieldImp.h"
 #include "Iteration.h"
+#include "Profiler.h"
 #include <iostream>
 #include <iomanip>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 
@@ -50,12 +54,29 @@ BeginNameSpace( ONEFLOW )
 
 UNsVisFlux::UNsVisFlux()
 {
-    ;
+    vgg.SetContext( & ug, & gcom );
+    visQ.SetContext( & vgg, & ug, & gcom );
+    visT.SetContext( & vgg, & ug, & gcom );
 }
 
 UNsVisFlux::~UNsVisFlux()
 {
-    ;
+    for ( int i = 0; i < threadFluxes.size(); ++ i )
+    {
+        delete threadFluxes[ i ];
+    }
+}
+
+void UNsVisFlux::Init()
+{
+    ONEFLOW::ug.Init();
+    this->ug = ONEFLOW::ug;
+    this->nscom = ONEFLOW::nscom;
+    this->vis = ONEFLOW::vis;
+    unsf.Init();
+    visQ.Init( nscom.nEqu );
+    visT.Init( nscom.nTModel );
+    vis.Init();
 }
 
 void UNsVisFlux::SetVisPointer()
@@ -90,11 +111,7 @@ void UNsVisFlux::SetVisPointer()
 void UNsVisFlux::CalcFlux()
 {
     if ( vis_model.vismodel == 0 ) return;
-    ug.Init();
-    unsf.Init();
-    visQ.Init( nscom.nEqu );
-    visT.Init( nscom.nTModel );
-    vis.Init();
+    this->Init();
     heat_flux.Init();
 
     Alloc();
@@ -111,11 +128,13 @@ void UNsVisFlux::CalcFlux()
 void UNsVisFlux::Alloc()
 {
     visflux = new MRField( nscom.nEqu, ug.nFaces );
+    heatFace = new RealField( ug.nBFaces );
 }
 
 void UNsVisFlux::DeAlloc()
 {
     delete visflux;
+    delete heatFace;
 }
 
 void UNsVisFlux::PrepareField()
@@ -124,21 +143,67 @@ void UNsVisFlux::PrepareField()
     ut_grad.CalcGrad();
 }
 
+//Thread 0 evaluates its faces with this flux object, every other thread with its own copy of it
 void UNsVisFlux::CalcVisFlux()
 {
-    for ( int fId = 0; fId < ug.nFaces; ++ fId )
+    static int profileId = Profiler::GetId( "vis_flux", PROFILE_KERNEL );
+    ProfileScope profileScope( profileId );
+
+    int nThreads = GetFaceThreads();
+    while ( threadFluxes.size() < nThreads - 1 )
+    {
+        threadFluxes.push_back( new UNsVisFlux() );
+    }
+
+    #pragma omp parallel num_threads( nThreads )
     {
-        ug.fId = fId;
+        int iThread = 0;
+#ifdef _OPENMP
+        iThread = omp_get_thread_num();
+#endif
+        UNsVisFlux * flux = this;
+        if ( iThread != 0 )
+        {
+            flux = threadFluxes[ iThread - 1 ];
+            flux->CopyFaceState( this );
+        }
+
+        #pragma omp barrier
+
+        #pragma omp for
+        for ( int fId = 0; fId < ug.nFaces; ++ fId )
+        {
+            flux->CalcFaceFlux( fId );
+        }
+    }
+
+    this->CollectHeatFlux();
+}
+
+void UNsVisFlux::CalcFaceFlux( int fId )
+{
+    ug.fId = fId;
 
-        ug.lc = ( * ug.lcf )[ ug.fId ];
-        ug.rc = ( * ug.rcf )[ ug.fId ];
+    ug.lc = ( * ug.lcf )[ ug.fId ];
+    ug.rc = ( * ug.rcf )[ ug.fId ];
 
-        this->PrepareFaceValue();
+    this->PrepareFaceValue();
 
-        this->CalcFaceVisFlux();
+    this->CalcFaceVisFlux();
 
-        this->UpdateFaceVisFlux();
-    }
+    this->UpdateFaceVisFlux();
+}
+
+void UNsVisFlux::CopyFaceState( UNsVisFlux * flux )
+{
+    this->ug    = flux->ug;
+    this->nscom = flux->nscom;
+    this->vis   = flux->vis;
+    this->visQ.Init( flux->visQ.nEqu );
+    this->visT.Init( flux->visT.nEqu );
+    this->visflux  = flux->visflux;
+    this->heatFace = flux->heatFace;
+    this->visPointer = flux->visPointer;
 }
 
 void UNsVisFlux::CalcFaceVisFlux()
@@ -165,9 +230,19 @@ void UNsVisFlux::SaveHeatFlux()
 {
     if ( ug.fId >= ug.nBFaces ) return;
     if ( ug.bcRecord->bcType[ ug.fId ] != BC::SOLID_SURFACE ) return;
-    SurfaceValue * heat_sur = heat_flux.heatflux[ ZoneState::zid ];
     Real non_dim_heatflux = - nscom.oreynolds * vis.qNormal;
-    heat_sur->var->push_back( non_dim_heatflux );
+    ( * heatFace )[ ug.fId ] = non_dim_heatflux;
+}
+
+//The wall heat flux is appended in face order, whichever thread evaluated the face
+void UNsVisFlux::CollectHeatFlux()
+{
+    for ( int fId = 0; fId < ug.nBFaces; ++ fId )
+    {
+        if ( ug.bcRecord->bcType[ fId ] != BC::SOLID_SURFACE ) continue;
+        SurfaceValue * heat_sur = heat_flux.heatflux[ ZoneState::zid ];
+        heat_sur->var->push_back( ( * heatFace )[ fId ] );
+    }
 }
 
 void UNsVisFlux::CalcStress()
@@ -0,0 +1,81 @@
+/*---------------------------------------------------------------------------*\
+    OneFLOW - LargeScale Multiphysics Scientific Simulation Environment
+    Copyright (C) 2017-2023 He Xin and the OneFLOW contributors.
+-------------------------------------------------------------------------------
+License
+    This file is part of OneFLOW.
+
+    OneFLOW is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OneFLOW is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+
+#pragma once
+#include "HXDefine.h"
+#include <map>
+#include <utility>
+
+BeginNameSpace( ONEFLOW )
+
+class UnsGrid;
+
+const int ASSEMBLE_SEQUENTIAL = 0;
+const int ASSEMBLE_COLOUR     = 1;
+const int ASSEMBLE_GATHER     = 2;
+
+//Race-free threaded assembly of face values into their left and right cells.
+//Face values are subtracted from the left cell and added to the right cell, the right cell
+//of a boundary face is a ghost cell and is left alone.
+//Colouring: the faces of one colour share no cell, colour iColour holds the faces
+//[ colourStart[ iColour ], colourStart[ iColour + 1 ] ) of colourFaces.
+//Gather: cell cId collects the faces [ cellStart[ cId ], cellStart[ cId + 1 ] ) of cellFaces in
+//increasing face order, with cellSign -1 when it is the left cell and +1 when it is the right cell,
+//so each cell is summed in the same order as the sequential face loop.
+class FaceAssemble
+{
+public:
+    FaceAssemble();
+    ~FaceAssemble();
+public:
+    int nCells, nBFaces;
+    int nColours;
+    IntField colourStart;
+    IntField colourFaces;
+    IntField cellStart;
+    IntField cellFaces;
+    IntField cellSign;
+    //Face work arrays of the gather kernels
+    RealField fx, fy, fz;
+public:
+    //All faces when faceList is null
+    void Init( int nCells, int nBFaces, int nFaces, int * lc, int * rc, IntField * faceList );
+protected:
+    void CalcColour( IntField & faces, int * lc, int * rc );
+    void CalcGather( IntField & faces, int * lc, int * rc );
+};
+
+class FaceAssembleFactory
+{
+public:
+    FaceAssembleFactory();
+    ~FaceAssembleFactory();
+public:
+    typedef std::pair< const void *, const void * > KeyType;
+    static std::map< KeyType, FaceAssemble * > data;
+public:
+    static FaceAssemble * GetFaceAssemble( UnsGrid * grid, IntField * faceList = 0 );
+    static FaceAssemble * GetFaceAssemble( const void * grid, int nCells, int nBFaces, int nFaces, int * lc, int * rc );
+};
+
+EndNameSpace
@@ -0,0 +1,74 @@
+/*---------------------------------------------------------------------------*\
+    OneFLOW - LargeScale Multiphysics Scientific Simulation Environment
+    Copyright (C) 2017-2023 He Xin and the OneFLOW contributors.
+-------------------------------------------------------------------------------
+License
+    This file is part of OneFLOW.
+
+    OneFLOW is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OneFLOW is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+
+#pragma once
+#include "HXDefine.h"
+#include <map>
+
+BeginNameSpace( ONEFLOW )
+
+class UnsGrid;
+
+const int GRAD_GG   = 0;
+const int GRAD_WLSQ = 1;
+
+//Geometric coefficients of the cell gradients of one grid. They depend on the grid only,
+//so they are computed once and shared by every field, equation and gradient call.
+//Green-Gauss: face value cl * q[ lc ] + cr * q[ rc ] with inverse distance weights,
+//face vector farea * ( xfn, yfn, zfn ) and 1 / cvol.
+//Weighted least squares: dr = centre of rc - centre of lc and w = 1 / |dr|^2 per face,
+//wdx = w * dr, and per cell the inverse of the symmetric matrix sum( w * dr * dr^T ),
+//stored as rxx, rxy, rxz, ryy, ryz, rzz. A boundary face uses its ghost cell as neighbour.
+class GradWeight
+{
+public:
+    GradWeight();
+    ~GradWeight();
+public:
+    int nCells, nBFaces, nFaces;
+    RealField cl, cr;
+    RealField fnxa, fnya, fnza;
+    RealField ovol;
+    bool lsqReady;
+    RealField wdx, wdy, wdz;
+    RealField rxx, rxy, rxz, ryy, ryz, rzz;
+public:
+    void Init( UnsGrid * grid );
+    void InitLsq( UnsGrid * grid );
+};
+
+//The weights of a grid are built on first use and kept for the whole run: grids are
+//read or agglomerated once into Zone::globalGrids and are never moved, rebuilt or freed
+class GradWeightFactory
+{
+public:
+    GradWeightFactory();
+    ~GradWeightFactory();
+public:
+    static std::map< UnsGrid *, GradWeight * > data;
+public:
+    static GradWeight * GetGradWeight( UnsGrid * grid );
+    static GradWeight * GetLsqWeight( UnsGrid * grid );
+};
+
+EndNameSpace
@@ -34,6 +34,7 @@ const int F_GHOST = 1;
 const int F_TOTAL = 2;
 
 class UnsGrid;
+class FaceAssemble;
 class UGeom
 {
 public:
@@ -64,6 +65,10 @@ public:
     IntField * blankf;
     LinkField * c2f;
 
+    IntField * haloFlag;
+    IntField * innerFaces;
+    IntField * haloFaces;
+
     RealField * xfn;
     RealField * yfn;
     RealField * zfn;
@@ -88,7 +93,10 @@ public:
 extern UGeom ug;
 
 void AddF2CField( MRField * cellField, MRField * faceField );
+void AddF2CField( MRField * cellField, MRField * faceField, IntField & faceList );
+void AddF2CFieldThread( MRField * cellField, MRField * faceField, FaceAssemble * faceAssemble );
 void AddF2CFieldDebug( MRField * cellField, MRField * faceField );
+int GetFaceThreads();
 
 class HXDebug
 {
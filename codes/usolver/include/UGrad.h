@@ -23,12 +23,28 @@ License
 
 #pragma once
 #include "HXDefine.h"
+#include "HXArray.h"
 
 BeginNameSpace( ONEFLOW )
 
+class FaceAssemble;
+class GradWeight;
+
 void CalcGrad( RealField & q, RealField & dqdx, RealField & dqdy, RealField & dqdz );
-void CalcGradGGCellWeight( RealField & q, RealField & dqdx, RealField & dqdy, RealField & dqdz );
-void CalcGradDebug( RealField & q, RealField & dqdx, RealField & dqdy, RealField & dqdz );
+void CalcGradGGCellWeight( MRFieldRow q, MRFieldRow dqdx, MRFieldRow dqdy, MRFieldRow dqdz );
+void CalcGradGGCellWeightHalo( MRFieldRow q, MRFieldRow dqdx, MRFieldRow dqdy, MRFieldRow dqdz );
+void CalcGradGGCellWeightThread( MRFieldRow q, MRFieldRow dqdx, MRFieldRow dqdy, MRFieldRow dqdz, FaceAssemble * faceAssemble, IntField * haloFlag );
+void CalcGradDebug( MRFieldRow q, MRFieldRow dqdx, MRFieldRow dqdy, MRFieldRow dqdz );
 void CalcGradGGCellWeightDebug( RealField & q, RealField & dqdx, RealField & dqdy, RealField & dqdz );
 
+void CalcGradGGCellWeight( MRField * q, MRField * dqdx, MRField * dqdy, MRField * dqdz, int nEqu );
+void CalcGradGGCellWeightHalo( MRField * q, MRField * dqdx, MRField * dqdy, MRField * dqdz, int nEqu );
+void CalcGradLsq( MRField * q, MRField * dqdx, MRField * dqdy, MRField * dqdz, int nEqu );
+void CalcGradLsqHalo( MRField * q, MRField * dqdx, MRField * dqdy, MRField * dqdz, int nEqu );
+void AddLsqFace( MRField * q, MRField * dqdx, MRField * dqdy, MRField * dqdz, int nEqu, GradWeight * gw, int fId, bool addl, bool addr );
+void SolveLsqGrad( MRField * dqdx, MRField * dqdy, MRField * dqdz, int nEqu, GradWeight * gw, IntField * haloFlag );
+void ZeroHaloGrad( MRField * dqdx, MRField * dqdy, MRField * dqdz, int nEqu );
+void ScaleCellGrad( MRField * dqdx, MRField * dqdy, MRField * dqdz, int nEqu, GradWeight * gw, IntField * haloFlag );
+void CopyGhostGrad( MRField * dqdx, MRField * dqdy, MRField * dqdz, int nEqu, IntField * haloFlag );
+
 EndNameSpace
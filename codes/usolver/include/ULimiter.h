@@ -44,8 +44,8 @@ public:
     Lim();
     ~Lim();
 public:
-    RealField *q, *dqdx, *dqdy, *dqdz;
-    RealField *limiter;
+    MRFieldRow q, dqdx, dqdy, dqdz;
+    MRFieldRow limiter;
     RealField * minvf, * maxvf;
     Real minv1, minv2, maxv1, maxv2;
     Real dqdx1, dqdy1, dqdz1;
@@ -65,9 +65,17 @@ public:
     virtual void Init(){};
     Real ModifyLimiter( Real phil, Real phir );
     void CalcFaceValue();
+    void CalcFaceValue( IntField & faceList );
     void CalcFaceValueWeighted();
     void GetQlQr();
+    void GetQlQr( IntField & faceList );
     virtual void BcQlQrFix();
+    void BcQlQrFix( IntField & faceList );
+protected:
+    //The face is passed explicitly, so that the face loops can be run by several threads
+    void GetFaceQlQr( int fId, int lc, int rc );
+    void CalcFaceValue( int fId, int lc, int rc, RealField & qTry );
+    virtual void BcFaceQlQrFix( int fId, int lc, int rc );
 public:
     int nEqu;
     MRField * q;
@@ -94,6 +102,8 @@ public:
     void SetInitValue();
     void CalcLimiter();
     void CalcLimiterScalar();
+    void CalcHaloLimiter();
+    bool IsLocal();
 
     void CalcZeroLimiter();
     void CalcNoLimiter();
@@ -103,6 +113,8 @@ public:
     void CalcLocalVencatLimiter();
     void PrepareData();
     void CalcMinMaxDiff();
+    void CalcHaloBarthLimiter();
+    void CalcHaloMinMaxDiff();
 };
 
 bool NoCheck( RealField & q );
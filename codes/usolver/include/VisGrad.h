@@ -31,12 +31,16 @@ const int VIS_TEST = 2;
 const int VIS_NEW1 = 3;
 const int VIS_NEW2 = 4;
 
+class UGeom;
+class GCom;
+
 class VisGradGeom
 {
 public:
     VisGradGeom();
     ~VisGradGeom();
 public:
+    void SetContext( UGeom * pug, GCom * pgcom );
     void CalcFaceWeight();
     void CalcAngle( Real dx, Real dy, Real dz, Real dist, Real & angle );
     void PrepareCellGeom();
@@ -56,6 +60,10 @@ public:
     Real skewAngle;
 
     Real dx, dy, dz, ods;
+public:
+    //Face geometry and face state the methods work on, the globals ug and gcom by default
+    UGeom * pug;
+    GCom * pgcom;
 };
 
 extern VisGradGeom vgg;
@@ -68,6 +76,7 @@ public:
 public:
     int nEqu;
     void Init( int nEqu );
+    void SetContext( VisGradGeom * pvgg, UGeom * pug, GCom * pgcom );
 public:
     void AverGrad();
     void ZeroNormalGrad();
@@ -94,6 +103,11 @@ public:
     RealField dqdx2, dqdy2, dqdz2;
     RealField dqdn1, dqdn2;
     RealField dqdt1, dqdt2;
+public:
+    //Face geometry and face state the methods work on, the globals vgg, ug and gcom by default
+    VisGradGeom * pvgg;
+    UGeom * pug;
+    GCom * pgcom;
 };
 
 void CorrectGrad( Real fl, Real fr, Real & dfdx, Real & dfdy, Real & dfdz, Real dx, Real dy, Real dz, Real ods );
@@ -0,0 +1,199 @@
+/*---------------------------------------------------------------------------*\
+    OneFLOW - LargeScale Multiphysics Scientific Simulation Environment
+    Copyright (C) 2017-2023 He Xin and the OneFLOW contributors.
+-------------------------------------------------------------------------------
+License
+    This file is part of OneFLOW.
+
+    OneFLOW is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OneFLOW is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "FaceAssemble.h"
+#include "UnsGrid.h"
+#include "FaceTopo.h"
+#include <algorithm>
+
+BeginNameSpace( ONEFLOW )
+
+FaceAssemble::FaceAssemble()
+{
+    this->nCells   = 0;
+    this->nBFaces  = 0;
+    this->nColours = 0;
+}
+
+FaceAssemble::~FaceAssemble()
+{
+    ;
+}
+
+void FaceAssemble::Init( int nCells, int nBFaces, int nFaces, int * lc, int * rc, IntField * faceList )
+{
+    this->nCells  = nCells;
+    this->nBFaces = nBFaces;
+
+    IntField faces;
+    if ( faceList )
+    {
+        faces = * faceList;
+        std::sort( faces.begin(), faces.end() );
+    }
+    else
+    {
+        faces.resize( nFaces );
+        for ( int fId = 0; fId < nFaces; ++ fId )
+        {
+            faces[ fId ] = fId;
+        }
+    }
+
+    this->CalcColour( faces, lc, rc );
+    this->CalcGather( faces, lc, rc );
+
+    this->fx.resize( nFaces );
+    this->fy.resize( nFaces );
+    this->fz.resize( nFaces );
+}
+
+void FaceAssemble::CalcColour( IntField & faces, int * lc, int * rc )
+{
+    //Greedy colouring, a face takes the lowest colour free on both of its cells
+    HXVector< IntField > cellColours( this->nCells );
+    int nListFaces = faces.size();
+    IntField faceColour( nListFaces );
+    IntField colourCount;
+    this->nColours = 0;
+    for ( int iFace = 0; iFace < nListFaces; ++ iFace )
+    {
+        int fId = faces[ iFace ];
+        IntField & lColours = cellColours[ lc[ fId ] ];
+        bool inner = fId >= this->nBFaces;
+
+        int iColour = 0;
+        while ( true )
+        {
+            bool used = std::find( lColours.begin(), lColours.end(), iColour ) != lColours.end();
+            if ( ! used && inner )
+            {
+                IntField & rColours = cellColours[ rc[ fId ] ];
+                used = std::find( rColours.begin(), rColours.end(), iColour ) != rColours.end();
+            }
+            if ( ! used ) break;
+            ++ iColour;
+        }
+
+        lColours.push_back( iColour );
+        if ( inner ) cellColours[ rc[ fId ] ].push_back( iColour );
+        faceColour[ iFace ] = iColour;
+
+        if ( iColour >= this->nColours )
+        {
+            this->nColours = iColour + 1;
+            colourCount.resize( this->nColours, 0 );
+        }
+        ++ colourCount[ iColour ];
+    }
+
+    this->colourStart.resize( this->nColours + 1 );
+    this->colourStart[ 0 ] = 0;
+    for ( int iColour = 0; iColour < this->nColours; ++ iColour )
+    {
+        this->colourStart[ iColour + 1 ] = this->colourStart[ iColour ] + colourCount[ iColour ];
+    }
+
+    IntField pos;
+    pos.assign( this->colourStart.begin(), this->colourStart.end() - 1 );
+    this->colourFaces.resize( nListFaces );
+    for ( int iFace = 0; iFace < nListFaces; ++ iFace )
+    {
+        this->colourFaces[ pos[ faceColour[ iFace ] ] ++ ] = faces[ iFace ];
+    }
+}
+
+void FaceAssemble::CalcGather( IntField & faces, int * lc, int * rc )
+{
+    int nListFaces = faces.size();
+    this->cellStart.resize( this->nCells + 1, 0 );
+    for ( int iFace = 0; iFace < nListFaces; ++ iFace )
+    {
+        int fId = faces[ iFace ];
+        ++ this->cellStart[ lc[ fId ] + 1 ];
+        if ( fId < this->nBFaces ) continue;
+        ++ this->cellStart[ rc[ fId ] + 1 ];
+    }
+
+    for ( int cId = 0; cId < this->nCells; ++ cId )
+    {
+        this->cellStart[ cId + 1 ] += this->cellStart[ cId ];
+    }
+
+    //Faces are visited in increasing order, so every cell lists its faces in increasing order
+    IntField pos;
+    pos.assign( this->cellStart.begin(), this->cellStart.end() - 1 );
+    this->cellFaces.resize( this->cellStart[ this->nCells ] );
+    this->cellSign.resize( this->cellStart[ this->nCells ] );
+    for ( int iFace = 0; iFace < nListFaces; ++ iFace )
+    {
+        int fId = faces[ iFace ];
+        int il = pos[ lc[ fId ] ] ++;
+        this->cellFaces[ il ] = fId;
+        this->cellSign [ il ] = - 1;
+        if ( fId < this->nBFaces ) continue;
+        int ir = pos[ rc[ fId ] ] ++;
+        this->cellFaces[ ir ] = fId;
+        this->cellSign [ ir ] = 1;
+    }
+}
+
+std::map< FaceAssembleFactory::KeyType, FaceAssemble * > FaceAssembleFactory::data;
+
+FaceAssembleFactory::FaceAssembleFactory()
+{
+    ;
+}
+
+FaceAssembleFactory::~FaceAssembleFactory()
+{
+    ;
+}
+
+FaceAssemble * FaceAssembleFactory::GetFaceAssemble( UnsGrid * grid, IntField * faceList )
+{
+    KeyType key( grid, faceList );
+    std::map< KeyType, FaceAssemble * >::iterator iter = FaceAssembleFactory::data.find( key );
+    if ( iter != FaceAssembleFactory::data.end() ) return iter->second;
+
+    FaceTopo * faceTopo = grid->faceTopo;
+    FaceAssemble * faceAssemble = new FaceAssemble();
+    faceAssemble->Init( grid->nCells, grid->nBFaces, grid->nFaces, & faceTopo->lCells[ 0 ], & faceTopo->rCells[ 0 ], faceList );
+    FaceAssembleFactory::data[ key ] = faceAssemble;
+
+    return faceAssemble;
+}
+
+FaceAssemble * FaceAssembleFactory::GetFaceAssemble( const void * grid, int nCells, int nBFaces, int nFaces, int * lc, int * rc )
+{
+    KeyType key( grid, static_cast< const void * >( 0 ) );
+    std::map< KeyType, FaceAssemble * >::iterator iter = FaceAssembleFactory::data.find( key );
+    if ( iter != FaceAssembleFactory::data.end() ) return iter->second;
+
+    FaceAssemble * faceAssemble = new FaceAssemble();
+    faceAssemble->Init( nCells, nBFaces, nFaces, lc, rc, 0 );
+    FaceAssembleFactory::data[ key ] = faceAssemble;
+
+    return faceAssemble;
+}
+
+EndNameSpace
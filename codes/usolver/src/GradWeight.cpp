@@ -0,0 +1,226 @@
+/*---------------------------------------------------------------------------*\
+    OneFLOW - LargeScale Multiphysics Scientific Simulation Environment
+    Copyright (C) 2017-2023 He Xin and the OneFLOW contributors.
+-------------------------------------------------------------------------------
+License
+    This file is part of OneFLOW.
+
+    OneFLOW is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OneFLOW is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "GradWeight.h"
+#include "UnsGrid.h"
+#include "FaceTopo.h"
+#include "FaceMesh.h"
+#include "CellMesh.h"
+#include "Dimension.h"
+#include "HXMath.h"
+
+BeginNameSpace( ONEFLOW )
+
+GradWeight::GradWeight()
+{
+    this->nCells   = 0;
+    this->nBFaces  = 0;
+    this->nFaces   = 0;
+    this->lsqReady = false;
+}
+
+GradWeight::~GradWeight()
+{
+    ;
+}
+
+void GradWeight::Init( UnsGrid * grid )
+{
+    this->nCells  = grid->nCells;
+    this->nBFaces = grid->nBFaces;
+    this->nFaces  = grid->nFaces;
+
+    IntField & lcf = grid->faceTopo->lCells;
+    IntField & rcf = grid->faceTopo->rCells;
+
+    FaceMesh * faceMesh = grid->faceMesh;
+    CellMesh * cellMesh = grid->cellMesh;
+
+    RealField & xfc = faceMesh->xfc;
+    RealField & yfc = faceMesh->yfc;
+    RealField & zfc = faceMesh->zfc;
+    RealField & xcc = cellMesh->xcc;
+    RealField & ycc = cellMesh->ycc;
+    RealField & zcc = cellMesh->zcc;
+
+    this->cl.resize( nFaces );
+    this->cr.resize( nFaces );
+    this->fnxa.resize( nFaces );
+    this->fnya.resize( nFaces );
+    this->fnza.resize( nFaces );
+
+    for ( int fId = 0; fId < nFaces; ++ fId )
+    {
+        int lc = lcf[ fId ];
+        int rc = rcf[ fId ];
+
+        Real dxl = xfc[ fId ] - xcc[ lc ];
+        Real dyl = yfc[ fId ] - ycc[ lc ];
+        Real dzl = zfc[ fId ] - zcc[ lc ];
+
+        Real dxr = xfc[ fId ] - xcc[ rc ];
+        Real dyr = yfc[ fId ] - ycc[ rc ];
+        Real dzr = zfc[ fId ] - zcc[ rc ];
+
+        Real delt1  = DIST( dxl, dyl, dzl );
+        Real delt2  = DIST( dxr, dyr, dzr );
+        Real delta  = 1.0 / ( delt1 + delt2 + SMALL );
+
+        this->cl[ fId ] = delt2 * delta;
+        this->cr[ fId ] = delt1 * delta;
+
+        this->fnxa[ fId ] = faceMesh->xfn[ fId ] * faceMesh->area[ fId ];
+        this->fnya[ fId ] = faceMesh->yfn[ fId ] * faceMesh->area[ fId ];
+        this->fnza[ fId ] = faceMesh->zfn[ fId ] * faceMesh->area[ fId ];
+    }
+
+    this->ovol.resize( nCells );
+    for ( int cId = 0; cId < nCells; ++ cId )
+    {
+        this->ovol[ cId ] = one / cellMesh->vol[ cId ];
+    }
+}
+
+void GradWeight::InitLsq( UnsGrid * grid )
+{
+    IntField & lcf = grid->faceTopo->lCells;
+    IntField & rcf = grid->faceTopo->rCells;
+
+    CellMesh * cellMesh = grid->cellMesh;
+    RealField & xcc = cellMesh->xcc;
+    RealField & ycc = cellMesh->ycc;
+    RealField & zcc = cellMesh->zcc;
+
+    this->wdx.resize( nFaces );
+    this->wdy.resize( nFaces );
+    this->wdz.resize( nFaces );
+
+    RealField axx( nCells, 0.0 ), axy( nCells, 0.0 ), axz( nCells, 0.0 );
+    RealField ayy( nCells, 0.0 ), ayz( nCells, 0.0 ), azz( nCells, 0.0 );
+
+    for ( int fId = 0; fId < nFaces; ++ fId )
+    {
+        int lc = lcf[ fId ];
+        int rc = rcf[ fId ];
+
+        Real dx = xcc[ rc ] - xcc[ lc ];
+        Real dy = ycc[ rc ] - ycc[ lc ];
+        Real dz = zcc[ rc ] - zcc[ lc ];
+
+        Real w = one / ( SQR( dx, dy, dz ) + SMALL );
+
+        this->wdx[ fId ] = w * dx;
+        this->wdy[ fId ] = w * dy;
+        this->wdz[ fId ] = w * dz;
+
+        axx[ lc ] += w * dx * dx;
+        axy[ lc ] += w * dx * dy;
+        axz[ lc ] += w * dx * dz;
+        ayy[ lc ] += w * dy * dy;
+        ayz[ lc ] += w * dy * dz;
+        azz[ lc ] += w * dz * dz;
+
+        //dr changes sign for the right cell, the products do not
+        if ( fId < nBFaces ) continue;
+        axx[ rc ] += w * dx * dx;
+        axy[ rc ] += w * dx * dy;
+        axz[ rc ] += w * dx * dz;
+        ayy[ rc ] += w * dy * dy;
+        ayz[ rc ] += w * dy * dz;
+        azz[ rc ] += w * dz * dz;
+    }
+
+    this->rxx.resize( nCells );
+    this->rxy.resize( nCells );
+    this->rxz.resize( nCells );
+    this->ryy.resize( nCells );
+    this->ryz.resize( nCells );
+    this->rzz.resize( nCells );
+
+    bool twoD = IsTwoD();
+
+    for ( int cId = 0; cId < nCells; ++ cId )
+    {
+        //A plane grid has no z extent, decouple z so that dqdz comes out zero
+        if ( twoD )
+        {
+            axz[ cId ] = 0.0;
+            ayz[ cId ] = 0.0;
+            azz[ cId ] = one;
+        }
+
+        Real cxx = ayy[ cId ] * azz[ cId ] - ayz[ cId ] * ayz[ cId ];
+        Real cxy = axz[ cId ] * ayz[ cId ] - axy[ cId ] * azz[ cId ];
+        Real cxz = axy[ cId ] * ayz[ cId ] - axz[ cId ] * ayy[ cId ];
+        Real cyy = axx[ cId ] * azz[ cId ] - axz[ cId ] * axz[ cId ];
+        Real cyz = axy[ cId ] * axz[ cId ] - axx[ cId ] * ayz[ cId ];
+        Real czz = axx[ cId ] * ayy[ cId ] - axy[ cId ] * axy[ cId ];
+
+        Real det  = axx[ cId ] * cxx + axy[ cId ] * cxy + axz[ cId ] * cxz;
+        Real odet = one / ( det + SMALL );
+
+        this->rxx[ cId ] = cxx * odet;
+        this->rxy[ cId ] = cxy * odet;
+        this->rxz[ cId ] = cxz * odet;
+        this->ryy[ cId ] = cyy * odet;
+        this->ryz[ cId ] = cyz * odet;
+        this->rzz[ cId ] = czz * odet;
+    }
+
+    this->lsqReady = true;
+}
+
+std::map< UnsGrid *, GradWeight * > GradWeightFactory::data;
+
+GradWeightFactory::GradWeightFactory()
+{
+    ;
+}
+
+GradWeightFactory::~GradWeightFactory()
+{
+    ;
+}
+
+GradWeight * GradWeightFactory::GetGradWeight( UnsGrid * grid )
+{
+    std::map< UnsGrid *, GradWeight * >::iterator iter = GradWeightFactory::data.find( grid );
+    if ( iter != GradWeightFactory::data.end() ) return iter->second;
+
+    GradWeight * gradWeight = new GradWeight();
+    gradWeight->Init( grid );
+    GradWeightFactory::data[ grid ] = gradWeight;
+
+    return gradWeight;
+}
+
+GradWeight * GradWeightFactory::GetLsqWeight( UnsGrid * grid )
+{
+    GradWeight * gradWeight = GradWeightFactory::GetGradWeight( grid );
+    if ( ! gradWeight->lsqReady )
+    {
+        gradWeight->InitLsq( grid );
+    }
+    return gradWeight;
+}
+
+EndNameSpace
@@ -34,7 +34,12 @@ License
 #include "OStream.h"
 #include "HXMath.h"
 #include "FileUtil.h"
+#include "FaceAssemble.h"
+#include "Ctrl.h"
 #include <iostream>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 BeginNameSpace( ONEFLOW )
 
@@ -99,6 +104,12 @@ void UGeom::Init()
 
     ug.c2f = & cellTopo->c2f;
 
+    faceTopo->CalcHaloPartition();
+
+    ug.haloFlag   = & faceTopo->haloFlag;
+    ug.innerFaces = & faceTopo->innerFaces;
+    ug.haloFaces  = & faceTopo->haloFaces;
+
     //ug.ireconface = 0;
     ug.ireconface = 1;
 }
@@ -143,6 +154,13 @@ void UGeom::DumpCellFace( int cId )
 
 void AddF2CField( MRField * cellField, MRField * faceField )
 {
+    if ( ctrl.iassemblethread != ASSEMBLE_SEQUENTIAL )
+    {
+        FaceAssemble * faceAssemble = FaceAssembleFactory::GetFaceAssemble( ug.grid );
+        ONEFLOW::AddF2CFieldThread( cellField, faceField, faceAssemble );
+        return;
+    }
+
     int nEqu = cellField->GetNEqu();
     for ( int fId = 0; fId < ug.nBFaces; ++ fId )
     {
@@ -170,6 +188,110 @@ void AddF2CField( MRField * cellField, MRField * faceField )
     }
 }
 
+void AddF2CField( MRField * cellField, MRField * faceField, IntField & faceList )
+{
+    if ( ctrl.iassemblethread != ASSEMBLE_SEQUENTIAL )
+    {
+        FaceAssemble * faceAssemble = FaceAssembleFactory::GetFaceAssemble( ug.grid, & faceList );
+        ONEFLOW::AddF2CFieldThread( cellField, faceField, faceAssemble );
+        return;
+    }
+
+    int nEqu = cellField->GetNEqu();
+    int nListFaces = faceList.size();
+    for ( int iFace = 0; iFace < nListFaces; ++ iFace )
+    {
+        ug.fId = faceList[ iFace ];
+        ug.lc = ( * ug.lcf )[ ug.fId ];
+        ug.rc = ( * ug.rcf )[ ug.fId ];
+
+        for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
+        {
+            ( * cellField )[ iEqu ][ ug.lc ] -= ( * faceField )[ iEqu ][ ug.fId ];
+        }
+
+        if ( ug.fId < ug.nBFaces ) continue;
+
+        for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
+        {
+            ( * cellField )[ iEqu ][ ug.rc ] += ( * faceField )[ iEqu ][ ug.fId ];
+        }
+    }
+}
+
+void AddF2CFieldThread( MRField * cellField, MRField * faceField, FaceAssemble * faceAssemble )
+{
+    int nEqu = cellField->GetNEqu();
+    int nBFaces = faceAssemble->nBFaces;
+    IntField & lcf = * ug.lcf;
+    IntField & rcf = * ug.rcf;
+
+    if ( ctrl.iassemblethread == ASSEMBLE_COLOUR )
+    {
+        for ( int iColour = 0; iColour < faceAssemble->nColours; ++ iColour )
+        {
+            int ist = faceAssemble->colourStart[ iColour ];
+            int ied = faceAssemble->colourStart[ iColour + 1 ];
+            #pragma omp parallel for
+            for ( int i = ist; i < ied; ++ i )
+            {
+                int fId = faceAssemble->colourFaces[ i ];
+                int lc = lcf[ fId ];
+                int rc = rcf[ fId ];
+                for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
+                {
+                    ( * cellField )[ iEqu ][ lc ] -= ( * faceField )[ iEqu ][ fId ];
+                }
+
+                if ( fId < nBFaces ) continue;
+
+                for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
+                {
+                    ( * cellField )[ iEqu ][ rc ] += ( * faceField )[ iEqu ][ fId ];
+                }
+            }
+        }
+        return;
+    }
+
+    IntField & cellStart = faceAssemble->cellStart;
+    IntField & cellFaces = faceAssemble->cellFaces;
+    IntField & cellSign  = faceAssemble->cellSign;
+    int nCells = faceAssemble->nCells;
+
+    #pragma omp parallel for
+    for ( int cId = 0; cId < nCells; ++ cId )
+    {
+        int ist = cellStart[ cId ];
+        int ied = cellStart[ cId + 1 ];
+        if ( ist == ied ) continue;
+        for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
+        {
+            MRFieldRow cRow = ( * cellField )[ iEqu ];
+            MRFieldRow fRow = ( * faceField )[ iEqu ];
+            Real value = cRow[ cId ];
+            for ( int i = ist; i < ied; ++ i )
+            {
+                value += cellSign[ i ] * fRow[ cellFaces[ i ] ];
+            }
+            cRow[ cId ] = value;
+        }
+    }
+}
+
+//Number of threads the face loops of the limiter and flux kernels are spread over
+int GetFaceThreads()
+{
+    int nThreads = 1;
+#ifdef _OPENMP
+    if ( ctrl.ifacethread == 1 )
+    {
+        nThreads = omp_get_max_threads();
+    }
+#endif
+    return nThreads;
+}
+
 void AddF2CFieldDebug( MRField * cellField, MRField * faceField )
 {
     int nEqu = cellField->GetNEqu();
@@ -336,8 +458,8 @@ void HXDebug::CompareFile( Real mindiff, int idump )
     int nEqu = field1->GetNEqu();
     for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
     {
-        HXVector< Real > & f1 = ( * field1 )[ iEqu ];
-        HXVector< Real > & f2 = ( * field2 )[ iEqu ];
+        MRFieldRow f1 = ( * field1 )[ iEqu ];
+        MRFieldRow f2 = ( * field2 )[ iEqu ];
         int nCells = f1.size();
         for ( int iCell = 0; iCell < nCells; ++ iCell )
         {
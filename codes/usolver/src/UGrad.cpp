@@ -31,6 +31,9 @@ License
 #include "CellTopo.h"
 #include "HXMath.h"
 #include "Zone.h"
+#include "FaceAssemble.h"
+#include "GradWeight.h"
+#include "Ctrl.h"
 #include <iostream>
 #include <iomanip>
 
@@ -85,8 +88,17 @@ void CalcGrad( RealField & q, RealField & dqdx, RealField & dqdy, RealField & dq
     }
 }
 
-void CalcGradGGCellWeight( RealField & q, RealField & dqdx, RealField & dqdy, RealField & dqdz )
+void CalcGradGGCellWeight( MRFieldRow q, MRFieldRow dqdx, MRFieldRow dqdy, MRFieldRow dqdz )
 {
+    if ( ctrl.iassemblethread != ASSEMBLE_SEQUENTIAL )
+    {
+        FaceAssemble * faceAssemble = FaceAssembleFactory::GetFaceAssemble( ug.grid );
+        ONEFLOW::CalcGradGGCellWeightThread( q, dqdx, dqdy, dqdz, faceAssemble, 0 );
+        return;
+    }
+
+    GradWeight * gw = GradWeightFactory::GetGradWeight( ug.grid );
+
     dqdx = 0;
     dqdy = 0;
     dqdz = 0;
@@ -97,32 +109,88 @@ void CalcGradGGCellWeight( RealField & q, RealField & dqdx, RealField & dqdy, Re
         ug.lc = ( * ug.lcf )[ ug.fId ];
         ug.rc = ( * ug.rcf )[ ug.fId ];
 
-        Real dxl = ( * ug.xfc )[ ug.fId ] - ( * ug.xcc )[ ug.lc ];
-        Real dyl = ( * ug.yfc )[ ug.fId ] - ( * ug.ycc )[ ug.lc ];
-        Real dzl = ( * ug.zfc )[ ug.fId ] - ( * ug.zcc )[ ug.lc ];
+        Real value = gw->cl[ ug.fId ] * q[ ug.lc ] + gw->cr[ ug.fId ] * q[ ug.rc ];
 
-        Real dxr = ( * ug.xfc )[ ug.fId ] - ( * ug.xcc )[ ug.rc ];
-        Real dyr = ( * ug.yfc )[ ug.fId ] - ( * ug.ycc )[ ug.rc ];
-        Real dzr = ( * ug.zfc )[ ug.fId ] - ( * ug.zcc )[ ug.rc ];
+        Real fnxa = gw->fnxa[ ug.fId ];
+        Real fnya = gw->fnya[ ug.fId ];
+        Real fnza = gw->fnza[ ug.fId ];
 
-        Real delt1  = DIST( dxl, dyl, dzl );
-        Real delt2  = DIST( dxr, dyr, dzr );
-        Real delta  = 1.0 / ( delt1 + delt2 + SMALL );
+        dqdx[ ug.lc ] += fnxa * value;
+        dqdy[ ug.lc ] += fnya * value;
+        dqdz[ ug.lc ] += fnza * value;
 
-        Real cl = delt2 * delta;
-        Real cr = delt1 * delta;
+        if ( ug.fId < ug.nBFaces ) continue;
+        dqdx[ ug.rc ] -= fnxa * value;
+        dqdy[ ug.rc ] -= fnya * value;
+        dqdz[ ug.rc ] -= fnza * value;
+    }
 
-        Real value = cl * q[ ug.lc ] + cr * q[ ug.rc ];
+    for ( int cId = 0; cId < ug.nCells; ++ cId )
+    {
+        Real ovol = gw->ovol[ cId ];
+        dqdx[ cId ] *= ovol;
+        dqdy[ cId ] *= ovol;
+        dqdz[ cId ] *= ovol;
+    }
 
-        Real fnxa = ( * ug.xfn )[ ug.fId ] * ( * ug.farea )[ ug.fId ];
-        Real fnya = ( * ug.yfn )[ ug.fId ] * ( * ug.farea )[ ug.fId ];
-        Real fnza = ( * ug.zfn )[ ug.fId ] * ( * ug.farea )[ ug.fId ];
+    for ( int fId = 0; fId < ug.nBFaces; ++ fId )
+    {
+        ug.fId = fId;
+        ug.lc = ( * ug.lcf )[ ug.fId ];
+        ug.rc = ( * ug.rcf )[ ug.fId ];
 
-        dqdx[ ug.lc ] += fnxa * value;
-        dqdy[ ug.lc ] += fnya * value;
-        dqdz[ ug.lc ] += fnza * value;
+        dqdx[ ug.rc ] = dqdx[ ug.lc ];
+        dqdy[ ug.rc ] = dqdy[ ug.lc ];
+        dqdz[ ug.rc ] = dqdz[ ug.lc ];
+    }
+}
+
+
+//Recompute the gradient of the halo cells only, the other cells are left as they are
+void CalcGradGGCellWeightHalo( MRFieldRow q, MRFieldRow dqdx, MRFieldRow dqdy, MRFieldRow dqdz )
+{
+    if ( ctrl.iassemblethread != ASSEMBLE_SEQUENTIAL )
+    {
+        FaceAssemble * faceAssemble = FaceAssembleFactory::GetFaceAssemble( ug.grid, ug.haloFaces );
+        ONEFLOW::CalcGradGGCellWeightThread( q, dqdx, dqdy, dqdz, faceAssemble, ug.haloFlag );
+        return;
+    }
+
+    GradWeight * gw = GradWeightFactory::GetGradWeight( ug.grid );
+
+    IntField & haloFlag  = * ug.haloFlag;
+    IntField & haloFaces = * ug.haloFaces;
+
+    for ( int cId = 0; cId < ug.nCells; ++ cId )
+    {
+        if ( haloFlag[ cId ] == 0 ) continue;
+        dqdx[ cId ] = 0;
+        dqdy[ cId ] = 0;
+        dqdz[ cId ] = 0;
+    }
+
+    int nHaloFaces = haloFaces.size();
+    for ( int iFace = 0; iFace < nHaloFaces; ++ iFace )
+    {
+        ug.fId = haloFaces[ iFace ];
+        ug.lc = ( * ug.lcf )[ ug.fId ];
+        ug.rc = ( * ug.rcf )[ ug.fId ];
+
+        Real value = gw->cl[ ug.fId ] * q[ ug.lc ] + gw->cr[ ug.fId ] * q[ ug.rc ];
+
+        Real fnxa = gw->fnxa[ ug.fId ];
+        Real fnya = gw->fnya[ ug.fId ];
+        Real fnza = gw->fnza[ ug.fId ];
+
+        if ( haloFlag[ ug.lc ] == 1 )
+        {
+            dqdx[ ug.lc ] += fnxa * value;
+            dqdy[ ug.lc ] += fnya * value;
+            dqdz[ ug.lc ] += fnza * value;
+        }
 
         if ( ug.fId < ug.nBFaces ) continue;
+        if ( haloFlag[ ug.rc ] == 0 ) continue;
         dqdx[ ug.rc ] -= fnxa * value;
         dqdy[ ug.rc ] -= fnya * value;
         dqdz[ ug.rc ] -= fnza * value;
@@ -130,7 +198,8 @@ void CalcGradGGCellWeight( RealField & q, RealField & dqdx, RealField & dqdy, Re
 
     for ( int cId = 0; cId < ug.nCells; ++ cId )
     {
-        Real ovol = one / ( * ug.cvol )[ cId ];
+        if ( haloFlag[ cId ] == 0 ) continue;
+        Real ovol = gw->ovol[ cId ];
         dqdx[ cId ] *= ovol;
         dqdy[ cId ] *= ovol;
         dqdz[ cId ] *= ovol;
@@ -142,12 +211,139 @@ void CalcGradGGCellWeight( RealField & q, RealField & dqdx, RealField & dqdy, Re
         ug.lc = ( * ug.lcf )[ ug.fId ];
         ug.rc = ( * ug.rcf )[ ug.fId ];
 
+        if ( haloFlag[ ug.lc ] == 0 ) continue;
+
         dqdx[ ug.rc ] = dqdx[ ug.lc ];
         dqdy[ ug.rc ] = dqdy[ ug.lc ];
         dqdz[ ug.rc ] = dqdz[ ug.lc ];
     }
 }
 
+//Threaded form of CalcGradGGCellWeight: the face values are formed face by face and then
+//summed into the cells colour by colour or cell by cell. With haloFlag only the flagged cells
+//are recomputed from the faces of the plan.
+void CalcGradGGCellWeightThread( MRFieldRow q, MRFieldRow dqdx, MRFieldRow dqdy, MRFieldRow dqdz, FaceAssemble * faceAssemble, IntField * haloFlag )
+{
+    IntField & lcf = * ug.lcf;
+    IntField & rcf = * ug.rcf;
+    RealField & fx = faceAssemble->fx;
+    RealField & fy = faceAssemble->fy;
+    RealField & fz = faceAssemble->fz;
+    IntField & faces = faceAssemble->colourFaces;
+    int nListFaces = faces.size();
+    int nCells = faceAssemble->nCells;
+    int nBFaces = faceAssemble->nBFaces;
+    GradWeight * gw = GradWeightFactory::GetGradWeight( ug.grid );
+
+    if ( haloFlag == 0 )
+    {
+        dqdx = 0;
+        dqdy = 0;
+        dqdz = 0;
+    }
+    else
+    {
+        #pragma omp parallel for
+        for ( int cId = 0; cId < nCells; ++ cId )
+        {
+            if ( ( * haloFlag )[ cId ] == 0 ) continue;
+            dqdx[ cId ] = 0;
+            dqdy[ cId ] = 0;
+            dqdz[ cId ] = 0;
+        }
+    }
+
+    #pragma omp parallel for
+    for ( int iFace = 0; iFace < nListFaces; ++ iFace )
+    {
+        int fId = faces[ iFace ];
+        int lc = lcf[ fId ];
+        int rc = rcf[ fId ];
+
+        Real value = gw->cl[ fId ] * q[ lc ] + gw->cr[ fId ] * q[ rc ];
+
+        fx[ fId ] = gw->fnxa[ fId ] * value;
+        fy[ fId ] = gw->fnya[ fId ] * value;
+        fz[ fId ] = gw->fnza[ fId ] * value;
+    }
+
+    if ( ctrl.iassemblethread == ASSEMBLE_COLOUR )
+    {
+        for ( int iColour = 0; iColour < faceAssemble->nColours; ++ iColour )
+        {
+            int ist = faceAssemble->colourStart[ iColour ];
+            int ied = faceAssemble->colourStart[ iColour + 1 ];
+            #pragma omp parallel for
+            for ( int i = ist; i < ied; ++ i )
+            {
+                int fId = faces[ i ];
+                int lc = lcf[ fId ];
+                int rc = rcf[ fId ];
+
+                if ( haloFlag == 0 || ( * haloFlag )[ lc ] == 1 )
+                {
+                    dqdx[ lc ] += fx[ fId ];
+                    dqdy[ lc ] += fy[ fId ];
+                    dqdz[ lc ] += fz[ fId ];
+                }
+
+                if ( fId < nBFaces ) continue;
+                if ( haloFlag != 0 && ( * haloFlag )[ rc ] == 0 ) continue;
+                dqdx[ rc ] -= fx[ fId ];
+                dqdy[ rc ] -= fy[ fId ];
+                dqdz[ rc ] -= fz[ fId ];
+            }
+        }
+    }
+    else
+    {
+        IntField & cellStart = faceAssemble->cellStart;
+        IntField & cellFaces = faceAssemble->cellFaces;
+        IntField & cellSign  = faceAssemble->cellSign;
+
+        #pragma omp parallel for
+        for ( int cId = 0; cId < nCells; ++ cId )
+        {
+            if ( haloFlag != 0 && ( * haloFlag )[ cId ] == 0 ) continue;
+            Real gx = dqdx[ cId ];
+            Real gy = dqdy[ cId ];
+            Real gz = dqdz[ cId ];
+            for ( int i = cellStart[ cId ]; i < cellStart[ cId + 1 ]; ++ i )
+            {
+                int fId = cellFaces[ i ];
+                gx -= cellSign[ i ] * fx[ fId ];
+                gy -= cellSign[ i ] * fy[ fId ];
+                gz -= cellSign[ i ] * fz[ fId ];
+            }
+            dqdx[ cId ] = gx;
+            dqdy[ cId ] = gy;
+            dqdz[ cId ] = gz;
+        }
+    }
+
+    #pragma omp parallel for
+    for ( int cId = 0; cId < nCells; ++ cId )
+    {
+        if ( haloFlag != 0 && ( * haloFlag )[ cId ] == 0 ) continue;
+        Real ovol = gw->ovol[ cId ];
+        dqdx[ cId ] *= ovol;
+        dqdy[ cId ] *= ovol;
+        dqdz[ cId ] *= ovol;
+    }
+
+    #pragma omp parallel for
+    for ( int fId = 0; fId < nBFaces; ++ fId )
+    {
+        int lc = lcf[ fId ];
+        int rc = rcf[ fId ];
+
+        if ( haloFlag != 0 && ( * haloFlag )[ lc ] == 0 ) continue;
+
+        dqdx[ rc ] = dqdx[ lc ];
+        dqdy[ rc ] = dqdy[ lc ];
+        dqdz[ rc ] = dqdz[ lc ];
+    }
+}
 
 void CalcGradGGCellWeightDebug( RealField & q, RealField & dqdx, RealField & dqdy, RealField & dqdz )
 {
@@ -213,7 +409,7 @@ void CalcGradGGCellWeightDebug( RealField & q, RealField & dqdx, RealField & dqd
 
 }
 
-void CalcGradDebug( RealField & q, RealField & dqdx, RealField & dqdy, RealField & dqdz )
+void CalcGradDebug( MRFieldRow q, MRFieldRow dqdx, MRFieldRow dqdy, MRFieldRow dqdz )
 {
     dqdx = 0;
     dqdy = 0;
@@ -275,4 +471,254 @@ void CalcGradDebug( RealField & q, RealField & dqdx, RealField & dqdy, RealField
     }
 }
 
+//All equations of a field in one face sweep, the geometric weights are read once per face
+//and every equation gives the same values as CalcGradGGCellWeight
+void CalcGradGGCellWeight( MRField * q, MRField * dqdx, MRField * dqdy, MRField * dqdz, int nEqu )
+{
+    if ( ctrl.iassemblethread != ASSEMBLE_SEQUENTIAL )
+    {
+        for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
+        {
+            ONEFLOW::CalcGradGGCellWeight( ( * q )[ iEqu ], ( * dqdx )[ iEqu ], ( * dqdy )[ iEqu ], ( * dqdz )[ iEqu ] );
+        }
+        return;
+    }
+
+    GradWeight * gw = GradWeightFactory::GetGradWeight( ug.grid );
+    IntField & lcf = * ug.lcf;
+    IntField & rcf = * ug.rcf;
+
+    for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
+    {
+        ( * dqdx )[ iEqu ] = 0;
+        ( * dqdy )[ iEqu ] = 0;
+        ( * dqdz )[ iEqu ] = 0;
+    }
+
+    for ( int fId = 0; fId < ug.nFaces; ++ fId )
+    {
+        int lc = lcf[ fId ];
+        int rc = rcf[ fId ];
+
+        Real cl = gw->cl[ fId ];
+        Real cr = gw->cr[ fId ];
+        Real fnxa = gw->fnxa[ fId ];
+        Real fnya = gw->fnya[ fId ];
+        Real fnza = gw->fnza[ fId ];
+        bool inner = fId >= ug.nBFaces;
+
+        for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
+        {
+            Real value = cl * ( * q )( iEqu, lc ) + cr * ( * q )( iEqu, rc );
+
+            ( * dqdx )( iEqu, lc ) += fnxa * value;
+            ( * dqdy )( iEqu, lc ) += fnya * value;
+            ( * dqdz )( iEqu, lc ) += fnza * value;
+
+            if ( ! inner ) continue;
+            ( * dqdx )( iEqu, rc ) -= fnxa * value;
+            ( * dqdy )( iEqu, rc ) -= fnya * value;
+            ( * dqdz )( iEqu, rc ) -= fnza * value;
+        }
+    }
+
+    ONEFLOW::ScaleCellGrad( dqdx, dqdy, dqdz, nEqu, gw, 0 );
+}
+
+void CalcGradGGCellWeightHalo( MRField * q, MRField * dqdx, MRField * dqdy, MRField * dqdz, int nEqu )
+{
+    if ( ctrl.iassemblethread != ASSEMBLE_SEQUENTIAL )
+    {
+        for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
+        {
+            ONEFLOW::CalcGradGGCellWeightHalo( ( * q )[ iEqu ], ( * dqdx )[ iEqu ], ( * dqdy )[ iEqu ], ( * dqdz )[ iEqu ] );
+        }
+        return;
+    }
+
+    GradWeight * gw = GradWeightFactory::GetGradWeight( ug.grid );
+    IntField & lcf = * ug.lcf;
+    IntField & rcf = * ug.rcf;
+    IntField & haloFlag  = * ug.haloFlag;
+    IntField & haloFaces = * ug.haloFaces;
+
+    ONEFLOW::ZeroHaloGrad( dqdx, dqdy, dqdz, nEqu );
+
+    int nHaloFaces = haloFaces.size();
+    for ( int iFace = 0; iFace < nHaloFaces; ++ iFace )
+    {
+        int fId = haloFaces[ iFace ];
+        int lc = lcf[ fId ];
+        int rc = rcf[ fId ];
+
+        Real cl = gw->cl[ fId ];
+        Real cr = gw->cr[ fId ];
+        Real fnxa = gw->fnxa[ fId ];
+        Real fnya = gw->fnya[ fId ];
+        Real fnza = gw->fnza[ fId ];
+        bool addl = haloFlag[ lc ] == 1;
+        bool addr = fId >= ug.nBFaces && haloFlag[ rc ] == 1;
+
+        for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
+        {
+            Real value = cl * ( * q )( iEqu, lc ) + cr * ( * q )( iEqu, rc );
+
+            if ( addl )
+            {
+                ( * dqdx )( iEqu, lc ) += fnxa * value;
+                ( * dqdy )( iEqu, lc ) += fnya * value;
+                ( * dqdz )( iEqu, lc ) += fnza * value;
+            }
+
+            if ( ! addr ) continue;
+            ( * dqdx )( iEqu, rc ) -= fnxa * value;
+            ( * dqdy )( iEqu, rc ) -= fnya * value;
+            ( * dqdz )( iEqu, rc ) -= fnza * value;
+        }
+    }
+
+    ONEFLOW::ScaleCellGrad( dqdx, dqdy, dqdz, nEqu, gw, ug.haloFlag );
+}
+
+//Weighted least squares: with dq = q[ rc ] - q[ lc ] every face adds w * dr * dq to both of
+//its cells, the gradient is the cached inverse matrix times that sum
+void CalcGradLsq( MRField * q, MRField * dqdx, MRField * dqdy, MRField * dqdz, int nEqu )
+{
+    GradWeight * gw = GradWeightFactory::GetLsqWeight( ug.grid );
+
+    for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
+    {
+        ( * dqdx )[ iEqu ] = 0;
+        ( * dqdy )[ iEqu ] = 0;
+        ( * dqdz )[ iEqu ] = 0;
+    }
+
+    for ( int fId = 0; fId < ug.nFaces; ++ fId )
+    {
+        ONEFLOW::AddLsqFace( q, dqdx, dqdy, dqdz, nEqu, gw, fId, true, fId >= ug.nBFaces );
+    }
+
+    ONEFLOW::SolveLsqGrad( dqdx, dqdy, dqdz, nEqu, gw, 0 );
+}
+
+void CalcGradLsqHalo( MRField * q, MRField * dqdx, MRField * dqdy, MRField * dqdz, int nEqu )
+{
+    GradWeight * gw = GradWeightFactory::GetLsqWeight( ug.grid );
+    IntField & lcf = * ug.lcf;
+    IntField & rcf = * ug.rcf;
+    IntField & haloFlag  = * ug.haloFlag;
+    IntField & haloFaces = * ug.haloFaces;
+
+    ONEFLOW::ZeroHaloGrad( dqdx, dqdy, dqdz, nEqu );
+
+    int nHaloFaces = haloFaces.size();
+    for ( int iFace = 0; iFace < nHaloFaces; ++ iFace )
+    {
+        int fId = haloFaces[ iFace ];
+        bool addl = haloFlag[ lcf[ fId ] ] == 1;
+        bool addr = fId >= ug.nBFaces && haloFlag[ rcf[ fId ] ] == 1;
+        ONEFLOW::AddLsqFace( q, dqdx, dqdy, dqdz, nEqu, gw, fId, addl, addr );
+    }
+
+    ONEFLOW::SolveLsqGrad( dqdx, dqdy, dqdz, nEqu, gw, ug.haloFlag );
+}
+
+void AddLsqFace( MRField * q, MRField * dqdx, MRField * dqdy, MRField * dqdz, int nEqu, GradWeight * gw, int fId, bool addl, bool addr )
+{
+    int lc = ( * ug.lcf )[ fId ];
+    int rc = ( * ug.rcf )[ fId ];
+
+    Real wdx = gw->wdx[ fId ];
+    Real wdy = gw->wdy[ fId ];
+    Real wdz = gw->wdz[ fId ];
+
+    for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
+    {
+        Real dq = ( * q )( iEqu, rc ) - ( * q )( iEqu, lc );
+
+        if ( addl )
+        {
+            ( * dqdx )( iEqu, lc ) += wdx * dq;
+            ( * dqdy )( iEqu, lc ) += wdy * dq;
+            ( * dqdz )( iEqu, lc ) += wdz * dq;
+        }
+
+        if ( ! addr ) continue;
+        ( * dqdx )( iEqu, rc ) += wdx * dq;
+        ( * dqdy )( iEqu, rc ) += wdy * dq;
+        ( * dqdz )( iEqu, rc ) += wdz * dq;
+    }
+}
+
+void SolveLsqGrad( MRField * dqdx, MRField * dqdy, MRField * dqdz, int nEqu, GradWeight * gw, IntField * haloFlag )
+{
+    for ( int cId = 0; cId < ug.nCells; ++ cId )
+    {
+        if ( haloFlag != 0 && ( * haloFlag )[ cId ] == 0 ) continue;
+        for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
+        {
+            Real bx = ( * dqdx )( iEqu, cId );
+            Real by = ( * dqdy )( iEqu, cId );
+            Real bz = ( * dqdz )( iEqu, cId );
+            ( * dqdx )( iEqu, cId ) = gw->rxx[ cId ] * bx + gw->rxy[ cId ] * by + gw->rxz[ cId ] * bz;
+            ( * dqdy )( iEqu, cId ) = gw->rxy[ cId ] * bx + gw->ryy[ cId ] * by + gw->ryz[ cId ] * bz;
+            ( * dqdz )( iEqu, cId ) = gw->rxz[ cId ] * bx + gw->ryz[ cId ] * by + gw->rzz[ cId ] * bz;
+        }
+    }
+
+    ONEFLOW::CopyGhostGrad( dqdx, dqdy, dqdz, nEqu, haloFlag );
+}
+
+void ZeroHaloGrad( MRField * dqdx, MRField * dqdy, MRField * dqdz, int nEqu )
+{
+    IntField & haloFlag = * ug.haloFlag;
+
+    for ( int cId = 0; cId < ug.nCells; ++ cId )
+    {
+        if ( haloFlag[ cId ] == 0 ) continue;
+        for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
+        {
+            ( * dqdx )( iEqu, cId ) = 0;
+            ( * dqdy )( iEqu, cId ) = 0;
+            ( * dqdz )( iEqu, cId ) = 0;
+        }
+    }
+}
+
+void ScaleCellGrad( MRField * dqdx, MRField * dqdy, MRField * dqdz, int nEqu, GradWeight * gw, IntField * haloFlag )
+{
+    for ( int cId = 0; cId < ug.nCells; ++ cId )
+    {
+        if ( haloFlag != 0 && ( * haloFlag )[ cId ] == 0 ) continue;
+        Real ovol = gw->ovol[ cId ];
+        for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
+        {
+            ( * dqdx )( iEqu, cId ) *= ovol;
+            ( * dqdy )( iEqu, cId ) *= ovol;
+            ( * dqdz )( iEqu, cId ) *= ovol;
+        }
+    }
+
+    ONEFLOW::CopyGhostGrad( dqdx, dqdy, dqdz, nEqu, haloFlag );
+}
+
+//The ghost cell of a boundary face takes the gradient of its inner cell
+void CopyGhostGrad( MRField * dqdx, MRField * dqdy, MRField * dqdz, int nEqu, IntField * haloFlag )
+{
+    for ( int fId = 0; fId < ug.nBFaces; ++ fId )
+    {
+        int lc = ( * ug.lcf )[ fId ];
+        int rc = ( * ug.rcf )[ fId ];
+
+        if ( haloFlag != 0 && ( * haloFlag )[ lc ] == 0 ) continue;
+
+        for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
+        {
+            ( * dqdx )( iEqu, rc ) = ( * dqdx )( iEqu, lc );
+            ( * dqdy )( iEqu, rc ) = ( * dqdy )( iEqu, lc );
+            ( * dqdz )( iEqu, rc ) = ( * dqdz )( iEqu, lc );
+        }
+    }
+}
+
 EndNameSpace
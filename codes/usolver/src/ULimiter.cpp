@@ -29,6 +29,7 @@ License
 #include "Boundary.h"
 #include "BcRecord.h"
 #include "Iteration.h"
+#include "Profiler.h"
 
 BeginNameSpace( ONEFLOW )
 
@@ -130,127 +131,193 @@ Real LimField::ModifyLimiter( Real phil, Real phir )
 
 void LimField::GetQlQr()
 {
+    int nThreads = GetFaceThreads();
+
+    #pragma omp parallel for num_threads( nThreads )
     for ( int fId = 0; fId < ug.nFaces; ++ fId )
     {
-        ug.fId = fId;
-        ug.lc = ( * ug.lcf )[ ug.fId ];
-        ug.rc = ( * ug.rcf )[ ug.fId ];
+        int lc = ( * ug.lcf )[ fId ];
+        int rc = ( * ug.rcf )[ fId ];
 
-        if ( fId == 24 )
-        {
-            std::vector< Real > tmp1, tmp2;
-            for ( int iEqu = 0; iEqu < this->nEqu; ++ iEqu )
-            {
-                tmp1.push_back( ( * this->q )[ iEqu ][ ug.lc ] );
-                tmp2.push_back( ( * this->q )[ iEqu ][ ug.rc ] );
-            }
-            int kkk = 1;
-        }
+        this->GetFaceQlQr( fId, lc, rc );
+    }
+}
 
-        for ( int iEqu = 0; iEqu < this->nEqu; ++ iEqu )
-        {
-            ( * this->qf1 )[ iEqu ][ ug.fId ] = ( * this->q )[ iEqu ][ ug.lc ];
-            ( * this->qf2 )[ iEqu ][ ug.fId ] = ( * this->q )[ iEqu ][ ug.rc ];
-        }
+void LimField::GetQlQr( IntField & faceList )
+{
+    int nThreads = GetFaceThreads();
+    int nListFaces = faceList.size();
+
+    #pragma omp parallel for num_threads( nThreads )
+    for ( int iFace = 0; iFace < nListFaces; ++ iFace )
+    {
+        int fId = faceList[ iFace ];
+        int lc = ( * ug.lcf )[ fId ];
+        int rc = ( * ug.rcf )[ fId ];
+
+        this->GetFaceQlQr( fId, lc, rc );
+    }
+}
+
+void LimField::GetFaceQlQr( int fId, int lc, int rc )
+{
+    for ( int iEqu = 0; iEqu < this->nEqu; ++ iEqu )
+    {
+        ( * this->qf1 )[ iEqu ][ fId ] = ( * this->q )[ iEqu ][ lc ];
+        ( * this->qf2 )[ iEqu ][ fId ] = ( * this->q )[ iEqu ][ rc ];
     }
 }
 
 void LimField::BcQlQrFix()
 {
+    int nThreads = GetFaceThreads();
+
+    #pragma omp parallel for num_threads( nThreads )
     for ( int fId = 0; fId < ug.nBFaces; ++ fId )
     {
         int bcType = ug.bcRecord->bcType[ fId ];
         if ( bcType == BC::INTERFACE ) continue;
         if ( bcType == BC::PERIODIC  ) continue;
 
-        ug.fId = fId;
-        ug.lc = ( * ug.lcf )[ ug.fId ];
-        ug.rc = ( * ug.rcf )[ ug.fId ];
+        int lc = ( * ug.lcf )[ fId ];
+        int rc = ( * ug.rcf )[ fId ];
 
-        for ( int iEqu = 0; iEqu < this->nEqu; ++ iEqu )
-        {
-            Real tmp = half * ( ( * this->q )[ iEqu ][ ug.lc ] + ( * this->q )[ iEqu ][ ug.rc ] );
+        this->BcFaceQlQrFix( fId, lc, rc );
+    }
+}
 
-            ( * this->qf1 )[ iEqu ][ ug.fId ] = tmp;
-            ( * this->qf2 )[ iEqu ][ ug.fId ] = tmp;
-        }
+void LimField::BcQlQrFix( IntField & faceList )
+{
+    int nThreads = GetFaceThreads();
+    int nListFaces = faceList.size();
+
+    #pragma omp parallel for num_threads( nThreads )
+    for ( int iFace = 0; iFace < nListFaces; ++ iFace )
+    {
+        int fId = faceList[ iFace ];
+        if ( fId >= ug.nBFaces ) continue;
+
+        int bcType = ug.bcRecord->bcType[ fId ];
+        if ( bcType == BC::INTERFACE ) continue;
+        if ( bcType == BC::PERIODIC  ) continue;
+
+        int lc = ( * ug.lcf )[ fId ];
+        int rc = ( * ug.rcf )[ fId ];
+
+        this->BcFaceQlQrFix( fId, lc, rc );
     }
 }
 
+void LimField::BcFaceQlQrFix( int fId, int lc, int rc )
+{
+    for ( int iEqu = 0; iEqu < this->nEqu; ++ iEqu )
+    {
+        Real tmp = half * ( ( * this->q )[ iEqu ][ lc ] + ( * this->q )[ iEqu ][ rc ] );
+
+        ( * this->qf1 )[ iEqu ][ fId ] = tmp;
+        ( * this->qf2 )[ iEqu ][ fId ] = tmp;
+    }
+}
 
 void LimField::CalcFaceValue()
 {
-    RealField qTry( this->nEqu );
+    int nThreads = GetFaceThreads();
 
-    for ( int fId = 0; fId < ug.nFaces; ++ fId )
+    #pragma omp parallel num_threads( nThreads )
     {
-        ug.fId = fId;
-        ug.lc = ( * ug.lcf )[ ug.fId ];
-        ug.rc = ( * ug.rcf )[ ug.fId ];
+        RealField qTry( this->nEqu );
 
-        if ( fId == 24 )
+        #pragma omp for
+        for ( int fId = 0; fId < ug.nFaces; ++ fId )
         {
-            int kkk = 1;
+            int lc = ( * ug.lcf )[ fId ];
+            int rc = ( * ug.rcf )[ fId ];
+
+            this->CalcFaceValue( fId, lc, rc, qTry );
         }
+    }
+}
 
-        Real dx = ( * ug.xfc )[ ug.fId ] - ( * ug.xcc )[ ug.lc ];
-        Real dy = ( * ug.yfc )[ ug.fId ] - ( * ug.ycc )[ ug.lc ];
-        Real dz = ( * ug.zfc )[ ug.fId ] - ( * ug.zcc )[ ug.lc ];
+void LimField::CalcFaceValue( IntField & faceList )
+{
+    int nThreads = GetFaceThreads();
+    int nListFaces = faceList.size();
 
-        for ( int iEqu = 0; iEqu < this->nEqu; ++ iEqu )
+    #pragma omp parallel num_threads( nThreads )
+    {
+        RealField qTry( this->nEqu );
+
+        #pragma omp for
+        for ( int iFace = 0; iFace < nListFaces; ++ iFace )
         {
-            qTry[ iEqu ] = ( * this->qf1 )[ iEqu ][ ug.fId ];
+            int fId = faceList[ iFace ];
+            int lc = ( * ug.lcf )[ fId ];
+            int rc = ( * ug.rcf )[ fId ];
+
+            this->CalcFaceValue( fId, lc, rc, qTry );
         }
+    }
+}
 
-        for ( int iEqu = 0; iEqu < this->nEqu; ++ iEqu )
-        {
-            Real dqdx = ( * this->dqdx )[ iEqu ][ ug.lc ];
-            Real dqdy = ( * this->dqdy )[ iEqu ][ ug.lc ];
-            Real dqdz = ( * this->dqdz )[ iEqu ][ ug.lc ];
+void LimField::CalcFaceValue( int fId, int lc, int rc, RealField & qTry )
+{
+    Real dx = ( * ug.xfc )[ fId ] - ( * ug.xcc )[ lc ];
+    Real dy = ( * ug.yfc )[ fId ] - ( * ug.ycc )[ lc ];
+    Real dz = ( * ug.zfc )[ fId ] - ( * ug.zcc )[ lc ];
 
-            Real phil  = ( * this->limiter )[ iEqu ][ ug.lc ];
-            Real phir  = ( * this->limiter )[ iEqu ][ ug.rc ];
-            Real phi = this->ModifyLimiter( phil, phir );
+    for ( int iEqu = 0; iEqu < this->nEqu; ++ iEqu )
+    {
+        qTry[ iEqu ] = ( * this->qf1 )[ iEqu ][ fId ];
+    }
 
-            qTry[ iEqu ] += phi * ( dqdx * dx + dqdy * dy + dqdz * dz );
-        }
+    for ( int iEqu = 0; iEqu < this->nEqu; ++ iEqu )
+    {
+        Real dqdx = ( * this->dqdx )[ iEqu ][ lc ];
+        Real dqdy = ( * this->dqdy )[ iEqu ][ lc ];
+        Real dqdz = ( * this->dqdz )[ iEqu ][ lc ];
 
-        if ( ( * this->ckfun )( qTry ) )
-        {
-            for ( int iEqu = 0; iEqu < this->nEqu; ++ iEqu )
-            {
-                ( * this->qf1 )[ iEqu ][ ug.fId ] = qTry[ iEqu ];
-            }
-        }
+        Real phil  = ( * this->limiter )[ iEqu ][ lc ];
+        Real phir  = ( * this->limiter )[ iEqu ][ rc ];
+        Real phi = this->ModifyLimiter( phil, phir );
 
-        dx = ( * ug.xfc )[ ug.fId ] - ( * ug.xcc )[ ug.rc ];
-        dy = ( * ug.yfc )[ ug.fId ] - ( * ug.ycc )[ ug.rc ];
-        dz = ( * ug.zfc )[ ug.fId ] - ( * ug.zcc )[ ug.rc ];
+        qTry[ iEqu ] += phi * ( dqdx * dx + dqdy * dy + dqdz * dz );
+    }
 
+    if ( ( * this->ckfun )( qTry ) )
+    {
         for ( int iEqu = 0; iEqu < this->nEqu; ++ iEqu )
         {
-            qTry[ iEqu ] = ( * this->qf2 )[ iEqu ][ ug.fId ];
+            ( * this->qf1 )[ iEqu ][ fId ] = qTry[ iEqu ];
         }
+    }
 
-        for ( int iEqu = 0; iEqu < this->nEqu; ++ iEqu )
-        {
-            Real dqdx = ( * this->dqdx )[ iEqu ][ ug.rc ];
-            Real dqdy = ( * this->dqdy )[ iEqu ][ ug.rc ];
-            Real dqdz = ( * this->dqdz )[ iEqu ][ ug.rc ];
+    dx = ( * ug.xfc )[ fId ] - ( * ug.xcc )[ rc ];
+    dy = ( * ug.yfc )[ fId ] - ( * ug.ycc )[ rc ];
+    dz = ( * ug.zfc )[ fId ] - ( * ug.zcc )[ rc ];
 
-            Real phil = ( * this->limiter )[ iEqu ][ ug.lc ];
-            Real phir = ( * this->limiter )[ iEqu ][ ug.rc ];
-            Real phi = this->ModifyLimiter( phir, phil );
+    for ( int iEqu = 0; iEqu < this->nEqu; ++ iEqu )
+    {
+        qTry[ iEqu ] = ( * this->qf2 )[ iEqu ][ fId ];
+    }
 
-            qTry[ iEqu ] += phi * ( dqdx * dx + dqdy * dy + dqdz * dz );
-        }
+    for ( int iEqu = 0; iEqu < this->nEqu; ++ iEqu )
+    {
+        Real dqdx = ( * this->dqdx )[ iEqu ][ rc ];
+        Real dqdy = ( * this->dqdy )[ iEqu ][ rc ];
+        Real dqdz = ( * this->dqdz )[ iEqu ][ rc ];
 
-        if ( ( * this->ckfun )( qTry ) )
+        Real phil = ( * this->limiter )[ iEqu ][ lc ];
+        Real phir = ( * this->limiter )[ iEqu ][ rc ];
+        Real phi = this->ModifyLimiter( phir, phil );
+
+        qTry[ iEqu ] += phi * ( dqdx * dx + dqdy * dy + dqdz * dz );
+    }
+
+    if ( ( * this->ckfun )( qTry ) )
+    {
+        for ( int iEqu = 0; iEqu < this->nEqu; ++ iEqu )
         {
-            for ( int iEqu = 0; iEqu < this->nEqu; ++ iEqu )
-            {
-                ( * this->qf2 )[ iEqu ][ ug.fId ] = qTry[ iEqu ];
-            }
+            ( * this->qf2 )[ iEqu ][ fId ] = qTry[ iEqu ];
         }
     }
 }
@@ -376,22 +443,56 @@ Limiter::~Limiter()
 
 void Limiter::CalcLimiter()
 {
+    static int profileId = Profiler::GetId( "limiter", PROFILE_KERNEL );
+    ProfileScope profileScope( profileId );
+
     ug.Init();
     limf->Init();
     Alloc();
     for ( int iEqu = 0; iEqu < limf->nEqu; ++ iEqu )
     {
-        lim->limiter = & ( * limf->limiter )[ iEqu ];
-        lim->q       = & ( * limf->q       )[ iEqu ];
-        lim->dqdx    = & ( * limf->dqdx    )[ iEqu ];
-        lim->dqdy    = & ( * limf->dqdy    )[ iEqu ];
-        lim->dqdz    = & ( * limf->dqdz    )[ iEqu ];
+        lim->limiter.Bind( ( * limf->limiter )[ iEqu ] );
+        lim->q.Bind(       ( * limf->q       )[ iEqu ] );
+        lim->dqdx.Bind(    ( * limf->dqdx    )[ iEqu ] );
+        lim->dqdy.Bind(    ( * limf->dqdy    )[ iEqu ] );
+        lim->dqdz.Bind(    ( * limf->dqdz    )[ iEqu ] );
         this->SetInitValue();
         this->CalcLimiterScalar();
     }
     DeAlloc();
 }
 
+//Venkatakrishnan's threshold is scaled with the range of the whole zone,
+//so that limiter can not be updated on the halo cells alone
+bool Limiter::IsLocal()
+{
+    return limflag != ILMT_VENCAT;
+}
+
+void Limiter::CalcHaloLimiter()
+{
+    static int profileId = Profiler::GetId( "limiter", PROFILE_KERNEL );
+    ProfileScope profileScope( profileId );
+
+    ug.Init();
+    limf->Init();
+
+    //The zero and first order limiters do not depend on the flow field
+    if ( limflag != ILMT_BARTH ) return;
+
+    Alloc();
+    for ( int iEqu = 0; iEqu < limf->nEqu; ++ iEqu )
+    {
+        lim->limiter.Bind( ( * limf->limiter )[ iEqu ] );
+        lim->q.Bind(       ( * limf->q       )[ iEqu ] );
+        lim->dqdx.Bind(    ( * limf->dqdx    )[ iEqu ] );
+        lim->dqdy.Bind(    ( * limf->dqdy    )[ iEqu ] );
+        lim->dqdz.Bind(    ( * limf->dqdz    )[ iEqu ] );
+        this->CalcHaloBarthLimiter();
+    }
+    DeAlloc();
+}
+
 void Limiter::Alloc()
 {
     lim->minvf = new RealField( ug.nTCell );
@@ -408,7 +509,7 @@ void Limiter::SetInitValue()
 {
     for ( int cId = 0; cId < ug.nTCell; ++ cId )
     {
-        ( * lim->limiter )[ cId ] = 1.0;
+        lim->limiter[ cId ] = 1.0;
     }
 }
 
@@ -443,8 +544,8 @@ void Limiter::CalcZeroLimiter()
         lim->lim1 = 0.0;
         lim->lim2 = 0.0;
 
-        ( * lim->limiter )[ ug.lc ] = lim->lim1;
-        ( * lim->limiter )[ ug.rc ] = lim->lim2;
+        lim->limiter[ ug.lc ] = lim->lim1;
+        lim->limiter[ ug.rc ] = lim->lim2;
     }
 }
 
@@ -459,8 +560,8 @@ void Limiter::CalcNoLimiter()
         lim->lim1 = 1.0;
         lim->lim2 = 1.0;
 
-        ( * lim->limiter )[ ug.lc ] = lim->lim1;
-        ( * lim->limiter )[ ug.rc ] = lim->lim2;
+        lim->limiter[ ug.lc ] = lim->lim1;
+        lim->limiter[ ug.rc ] = lim->lim2;
     }
 }
 
@@ -478,8 +579,8 @@ void Limiter::CalcBarthLimiter()
 
         this->CalcLocalBarthLimiter();
 
-        ( * lim->limiter )[ ug.lc ] = lim->lim1;
-        ( * lim->limiter )[ ug.rc ] = lim->lim2;
+        lim->limiter[ ug.lc ] = lim->lim1;
+        lim->limiter[ ug.rc ] = lim->lim2;
     }
 }
 
@@ -497,8 +598,8 @@ void Limiter::CalcVencatLimiter()
 
         this->CalcLocalVencatLimiter();
 
-        ( * lim->limiter )[ ug.lc ] = lim->lim1;
-        ( * lim->limiter )[ ug.rc ] = lim->lim2;
+        lim->limiter[ ug.lc ] = lim->lim1;
+        lim->limiter[ ug.rc ] = lim->lim2;
     }
 }
 
@@ -529,16 +630,16 @@ void Limiter::PrepareData()
     lim->maxv1 = ( * lim->maxvf )[ ug.lc ];
     lim->maxv2 = ( * lim->maxvf )[ ug.rc ];
 
-    lim->dqdx1 = ( * lim->dqdx )[ ug.lc ];
-    lim->dqdy1 = ( * lim->dqdy )[ ug.lc ];
-    lim->dqdz1 = ( * lim->dqdz )[ ug.lc ];
+    lim->dqdx1 = lim->dqdx[ ug.lc ];
+    lim->dqdy1 = lim->dqdy[ ug.lc ];
+    lim->dqdz1 = lim->dqdz[ ug.lc ];
 
-    lim->dqdx2 = ( * lim->dqdx )[ ug.rc ];
-    lim->dqdy2 = ( * lim->dqdy )[ ug.rc ];
-    lim->dqdz2 = ( * lim->dqdz )[ ug.rc ];
+    lim->dqdx2 = lim->dqdx[ ug.rc ];
+    lim->dqdy2 = lim->dqdy[ ug.rc ];
+    lim->dqdz2 = lim->dqdz[ ug.rc ];
 
-    lim->lim1 =  ( * lim->limiter )[ ug.lc ];
-    lim->lim2 =  ( * lim->limiter )[ ug.rc ];
+    lim->lim1 =  lim->limiter[ ug.lc ];
+    lim->lim2 =  lim->limiter[ ug.rc ];
 }
 
 void Limiter::CalcLocalBarthLimiter()
@@ -597,8 +698,8 @@ void Limiter::CalcMinMaxDiff()
     // Find the maximum and minimum in the neighbor of each cell
     for ( int cId = 0; cId < ug.nCells; ++ cId )
     {
-        ( * lim->minvf )[ cId ] = ( * lim->q )[ cId ];
-        ( * lim->maxvf )[ cId ] = ( * lim->q )[ cId ];
+        ( * lim->minvf )[ cId ] = lim->q[ cId ];
+        ( * lim->maxvf )[ cId ] = lim->q[ cId ];
     }
 
     for ( int fId = 0; fId < ug.nBFaces; ++ fId )
@@ -610,8 +711,8 @@ void Limiter::CalcMinMaxDiff()
         int bcType = ug.bcRecord->bcType[ fId ];
         if ( ! BC::IsInterfaceBc( bcType ) ) continue;
 
-        ( * lim->minvf )[ ug.lc ] = MIN( ( * lim->minvf )[ ug.lc ], ( * lim->q )[ ug.rc ] );
-        ( * lim->maxvf )[ ug.lc ] = MAX( ( * lim->maxvf )[ ug.lc ], ( * lim->q )[ ug.rc ] );
+        ( * lim->minvf )[ ug.lc ] = MIN( ( * lim->minvf )[ ug.lc ], lim->q[ ug.rc ] );
+        ( * lim->maxvf )[ ug.lc ] = MAX( ( * lim->maxvf )[ ug.lc ], lim->q[ ug.rc ] );
     }
 
     for ( int fId = ug.nBFaces; fId < ug.nFaces; ++ fId )
@@ -620,18 +721,18 @@ void Limiter::CalcMinMaxDiff()
         ug.lc = ( * ug.lcf )[ ug.fId ];
         ug.rc = ( * ug.rcf )[ ug.fId ];
 
-        ( * lim->minvf )[ ug.lc ] = MIN( ( * lim->minvf )[ ug.lc ], ( * lim->q )[ ug.rc ] );
-        ( * lim->maxvf )[ ug.lc ] = MAX( ( * lim->maxvf )[ ug.lc ], ( * lim->q )[ ug.rc ] );
+        ( * lim->minvf )[ ug.lc ] = MIN( ( * lim->minvf )[ ug.lc ], lim->q[ ug.rc ] );
+        ( * lim->maxvf )[ ug.lc ] = MAX( ( * lim->maxvf )[ ug.lc ], lim->q[ ug.rc ] );
 
-        ( * lim->minvf )[ ug.rc ] = MIN( ( * lim->minvf )[ ug.rc ], ( * lim->q )[ ug.lc ] );
-        ( * lim->maxvf )[ ug.rc ] = MAX( ( * lim->maxvf )[ ug.rc ], ( * lim->q )[ ug.lc ] );
+        ( * lim->minvf )[ ug.rc ] = MIN( ( * lim->minvf )[ ug.rc ], lim->q[ ug.lc ] );
+        ( * lim->maxvf )[ ug.rc ] = MAX( ( * lim->maxvf )[ ug.rc ], lim->q[ ug.lc ] );
     }
 
     // Get the maximum and the minimum difference
     for ( int cId = 0; cId < ug.nCells; ++ cId )
     {
-        ( * lim->minvf )[ cId ] -= ( * lim->q )[ cId ];
-        ( * lim->maxvf )[ cId ] -= ( * lim->q )[ cId ];
+        ( * lim->minvf )[ cId ] -= lim->q[ cId ];
+        ( * lim->maxvf )[ cId ] -= lim->q[ cId ];
     }
 
     lim->qmin =   LARGE;
@@ -643,6 +744,83 @@ void Limiter::CalcMinMaxDiff()
     }
 }
 
+void Limiter::CalcHaloBarthLimiter()
+{
+    IntField & haloFlag  = * ug.haloFlag;
+    IntField & haloFaces = * ug.haloFaces;
+
+    this->CalcHaloMinMaxDiff();
+
+    for ( int cId = 0; cId < ug.nTCell; ++ cId )
+    {
+        if ( haloFlag[ cId ] == 0 ) continue;
+        lim->limiter[ cId ] = 1.0;
+    }
+
+    int nHaloFaces = haloFaces.size();
+    for ( int iFace = 0; iFace < nHaloFaces; ++ iFace )
+    {
+        ug.fId = haloFaces[ iFace ];
+        ug.lc = ( * ug.lcf )[ ug.fId ];
+        ug.rc = ( * ug.rcf )[ ug.fId ];
+
+        this->PrepareData();
+
+        this->CalcLocalBarthLimiter();
+
+        if ( haloFlag[ ug.lc ] == 1 ) lim->limiter[ ug.lc ] = lim->lim1;
+        if ( haloFlag[ ug.rc ] == 1 ) lim->limiter[ ug.rc ] = lim->lim2;
+    }
+}
+
+void Limiter::CalcHaloMinMaxDiff()
+{
+    IntField & haloFlag  = * ug.haloFlag;
+    IntField & haloFaces = * ug.haloFaces;
+
+    for ( int cId = 0; cId < ug.nCells; ++ cId )
+    {
+        if ( haloFlag[ cId ] == 0 ) continue;
+        ( * lim->minvf )[ cId ] = lim->q[ cId ];
+        ( * lim->maxvf )[ cId ] = lim->q[ cId ];
+    }
+
+    int nHaloFaces = haloFaces.size();
+    for ( int iFace = 0; iFace < nHaloFaces; ++ iFace )
+    {
+        ug.fId = haloFaces[ iFace ];
+        ug.lc = ( * ug.lcf )[ ug.fId ];
+        ug.rc = ( * ug.rcf )[ ug.fId ];
+
+        if ( ug.fId < ug.nBFaces )
+        {
+            int bcType = ug.bcRecord->bcType[ ug.fId ];
+            if ( ! BC::IsInterfaceBc( bcType ) ) continue;
+        }
+
+        if ( haloFlag[ ug.lc ] == 1 )
+        {
+            ( * lim->minvf )[ ug.lc ] = MIN( ( * lim->minvf )[ ug.lc ], lim->q[ ug.rc ] );
+            ( * lim->maxvf )[ ug.lc ] = MAX( ( * lim->maxvf )[ ug.lc ], lim->q[ ug.rc ] );
+        }
+
+        if ( ug.fId < ug.nBFaces ) continue;
+
+        if ( haloFlag[ ug.rc ] == 1 )
+        {
+            ( * lim->minvf )[ ug.rc ] = MIN( ( * lim->minvf )[ ug.rc ], lim->q[ ug.lc ] );
+            ( * lim->maxvf )[ ug.rc ] = MAX( ( * lim->maxvf )[ ug.rc ], lim->q[ ug.lc ] );
+        }
+    }
+
+    for ( int cId = 0; cId < ug.nCells; ++ cId )
+    {
+        if ( haloFlag[ cId ] == 0 ) continue;
+        ( * lim->minvf )[ cId ] -= lim->q[ cId ];
+        ( * lim->maxvf )[ cId ] -= lim->q[ cId ];
+    }
+}
+
 bool NoCheck( RealField & q )
 {
     return true;
@@ -84,7 +84,7 @@ MRField * VisualTool::AddField( const std::string & varName )
     return fn;
 }
 
-MRField * VisualTool::AddField( RealField & qc, const std::string & varName )
+MRField * VisualTool::AddField( MRFieldRow qc, const std::string & varName )
 {
     this->AddTitle( varName );
     MRField * fn = CreateNodeVar( qc );
@@ -297,7 +297,7 @@ void BcVisual::Dump( std::ostringstream & oss, VisualTool * visualTool, std::str
     int nVar = visualTool->qNodeField.size();        
     for ( int iVar = 0; iVar < nVar; ++ iVar )
     {
-        RealField & q = ( * visualTool->qNodeField[ iVar ] )[ 0 ];
+        MRFieldRow q = ( * visualTool->qNodeField[ iVar ] )[ 0 ];
         Plot::DumpField( l2g, q );
     }
 
@@ -547,7 +547,7 @@ void UVisualize::ShowField( std::ostringstream & oss, VisualTool * visualTool )
     int nVar = visualTool->qNodeField.size();        
     for ( int iVar = 0; iVar < nVar; ++ iVar )
     {
-        RealField & q = ( * visualTool->qNodeField[ iVar ] )[ 0 ];
+        MRFieldRow q = ( * visualTool->qNodeField[ iVar ] )[ 0 ];
         Plot::DumpField( q );
     }
 
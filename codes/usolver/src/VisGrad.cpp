@@ -34,6 +34,8 @@ VisGradGeom vgg;
 VisGradGeom::VisGradGeom()
 {
     skewAngle = 20.0;
+    pug = & ug;
+    pgcom = & gcom;
 }
 
 VisGradGeom::~VisGradGeom()
@@ -41,8 +43,16 @@ VisGradGeom::~VisGradGeom()
     ;
 }
 
+void VisGradGeom::SetContext( UGeom * pug, GCom * pgcom )
+{
+    this->pug = pug;
+    this->pgcom = pgcom;
+}
+
 void VisGradGeom::CalcFaceWeight()
 {
+    UGeom & ug = * this->pug;
+
     dxl = ( * ug.xfc )[ ug.fId ] - ( * ug.xcc )[ ug.lc ];
     dyl = ( * ug.yfc )[ ug.fId ] - ( * ug.ycc )[ ug.lc ];
     dzl = ( * ug.zfc )[ ug.fId ] - ( * ug.zcc )[ ug.lc ];
@@ -69,6 +79,9 @@ void VisGradGeom::CalcAngle( Real dx, Real dy, Real dz, Real dist, Real & angle
 
 void VisGradGeom::PrepareCellGeom()
 {
+    UGeom & ug = * this->pug;
+    GCom & gcom = * this->pgcom;
+
     this->dxl = ( * ug.xcc )[ ug.lc ] - ( * ug.xfc )[ ug.fId ];
     this->dyl = ( * ug.ycc )[ ug.lc ] - ( * ug.yfc )[ ug.fId ];
     this->dzl = ( * ug.zcc )[ ug.lc ] - ( * ug.zfc )[ ug.fId ];
@@ -98,6 +111,8 @@ void VisGradGeom::PrepareCellGeom()
 
 void VisGradGeom::CalcGradCoef()
 {
+    UGeom & ug = * this->pug;
+
     this->dx  = ( * ug.xcc )[ ug.rc ] - ( * ug.xcc )[ ug.lc ];
     this->dy  = ( * ug.ycc )[ ug.rc ] - ( * ug.ycc )[ ug.lc ];
     this->dz  = ( * ug.zcc )[ ug.rc ] - ( * ug.zcc )[ ug.lc ];
@@ -112,7 +127,9 @@ void VisGradGeom::CalcGradCoef()
 
 VisGrad::VisGrad()
 {
-    ;
+    pvgg = & vgg;
+    pug = & ug;
+    pgcom = & gcom;
 }
 
 VisGrad::~VisGrad()
@@ -120,6 +137,13 @@ VisGrad::~VisGrad()
     ;
 }
 
+void VisGrad::SetContext( VisGradGeom * pvgg, UGeom * pug, GCom * pgcom )
+{
+    this->pvgg = pvgg;
+    this->pug = pug;
+    this->pgcom = pgcom;
+}
+
 void VisGrad::Init( int nEqu )
 {
     this->nEqu = nEqu;
@@ -178,6 +202,8 @@ void VisGrad::AverFaceValue()
 
 void VisGrad::CorrectFaceGrad()
 {
+    VisGradGeom & vgg = * this->pvgg;
+
     for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
     {
         CorrectGrad( q1[ iEqu ], q2[ iEqu ], dqdx[ iEqu ], dqdy[ iEqu ], dqdz[ iEqu ], vgg.dx, vgg.dy, vgg.dz, vgg.ods );
@@ -186,6 +212,8 @@ void VisGrad::CorrectFaceGrad()
 
 void VisGrad::CalcNormalGrad()
 {
+    GCom & gcom = * this->pgcom;
+
     for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
     {
         dqdn[ iEqu ] = gcom.xfn * dqdx[ iEqu ] + gcom.yfn * dqdy[ iEqu ] + gcom.zfn * dqdz[ iEqu ];
@@ -194,6 +222,8 @@ void VisGrad::CalcNormalGrad()
 
 bool VisGrad::FaceAngleIsValid()
 {
+    VisGradGeom & vgg = * this->pvgg;
+
     // Theoretically, more accurate to include the following terms
     bool result =  vgg.angle1 > vgg.skewAngle && vgg.angle2 > vgg.skewAngle;
     return result;
@@ -201,6 +231,8 @@ bool VisGrad::FaceAngleIsValid()
 
 bool VisGrad::TestSatisfied()
 {
+    VisGradGeom & vgg = * this->pvgg;
+
     bool result = vgg.angle1 > 0.0 && vgg.angle2 > 0.0 && ABS( vgg.d1 ) > SMALL && ABS( vgg.d2 ) > SMALL;
     if ( result )
     {
@@ -211,6 +243,8 @@ bool VisGrad::TestSatisfied()
 
 bool VisGrad::New1Satisfied()
 {
+    VisGradGeom & vgg = * this->pvgg;
+
     bool result =  vgg.d1 * vgg.d2 < 0.0 && ABS( vgg.d1 ) > SMALL && ABS( vgg.d2 ) > SMALL;
     if ( result )
     {
@@ -223,6 +257,8 @@ bool VisGrad::New1Satisfied()
 
 bool VisGrad::New2Satisfied()
 {
+    VisGradGeom & vgg = * this->pvgg;
+
     vgg.d = - two *  vgg.d1 *  vgg.d2 / ( SQR(  vgg.d1,  vgg.d2 ) + SMALL );
 
     bool result =  vgg.d > 0.1;
@@ -232,6 +268,9 @@ bool VisGrad::New2Satisfied()
 
 void VisGrad::CalcC1C2()
 {
+    VisGradGeom & vgg = * this->pvgg;
+    UGeom & ug = * this->pug;
+
     Real dtmp = SQR( vgg.d1, vgg.d2 );
     vgg.c1 = SQR( vgg.d1 ) / dtmp;
     vgg.c2 = 1.0 - vgg.c1;
@@ -250,6 +289,8 @@ void VisGrad::CalcC1C2()
 
 void VisGrad::AccurateSideValue()
 {
+    VisGradGeom & vgg = * this->pvgg;
+
     for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
     {
         q11[ iEqu ] += dqdx1[ iEqu ] * vgg.dxnl + dqdy1[ iEqu ] * vgg.dynl + dqdz1[ iEqu ] * vgg.dznl;
@@ -267,6 +308,9 @@ void VisGrad::AccurateFaceValue()
 
 void VisGrad::ModifyFaceGrad()
 {
+    VisGradGeom & vgg = * this->pvgg;
+    GCom & gcom = * this->pgcom;
+
     for ( int iEqu = 0; iEqu < nEqu; ++ iEqu )
     {
         dqdx[ iEqu ] = vgg.fw1 * dqdx1[ iEqu ] + vgg.fw2 * dqdx2[ iEqu ];
@@ -290,6 +334,8 @@ void VisGrad::ModifyFaceGrad()
 
 void VisGrad::CalcTestMethod()
 {
+    VisGradGeom & vgg = * this->pvgg;
+
     if ( this->FaceAngleIsValid() )
     {
         this->AccurateSideValue();
@@ -316,6 +362,8 @@ void VisGrad::CalcTestMethod()
 
 void VisGrad::CalcNew1Method()
 {
+    VisGradGeom & vgg = * this->pvgg;
+
     if ( ! this->New1Satisfied() ) return;
 
     this->AccurateSideValue();
@@ -328,6 +376,8 @@ void VisGrad::CalcNew1Method()
 
 void VisGrad::CalcNew2Method()
 {
+    VisGradGeom & vgg = * this->pvgg;
+
     if ( ! this->New2Satisfied() ) return;
 
     // Theoretically, more accurate to include the following terms
@@ -23,6 +23,7 @@ License
 
 #pragma once
 #include "TurbInvFlux.h"
+#include "UCom.h"
 
 BeginNameSpace( ONEFLOW )
 
@@ -37,16 +38,27 @@ public:
     ~UTurbInvFlux();
 public:
     Limiter * limiter, * nslimiter;
-    LimField * limf;
+    LimField * limf, * nslimf;
     MRField * invflux;
+    UGeom ug;
+    HXVector< UTurbInvFlux * > threadFluxes;
 public:
+    void Init();
     void Alloc();
     void DeAlloc();
     void CalcFlux();
+    void CalcFluxInner();
+    void CalcFluxHalo();
     void CalcInvFlux();
+    void CalcInvFlux( IntField & faceList );
+    void CalcInvFlux( int nListFaces, IntField * faceList );
+    void CalcFaceInvFlux( int fId );
+    void CopyFaceState( UTurbInvFlux * flux );
     void CalcInvFace();
+    void CalcInvFace( IntField & faceList );
     void CalcLimiter();
     void AddInvFlux();
+    void AddInvFlux( IntField & faceList );
     void PrepareFaceValue();
     void UpdateFaceInvFlux();
 public:
@@ -23,30 +23,37 @@ License
 
 #pragma once
 #include "TurbLusgs.h"
+#include "UCom.h"
 BeginNameSpace( ONEFLOW )
 
+class LusgsPlan;
+class LusgsSweepList;
+class LusgsSchedule;
+
 class UTurbLusgs : public TurbLusgs
 {
 public:
     UTurbLusgs ();
     ~UTurbLusgs();
+public:
+    LusgsPlan * plan;
+    UGeom ug;
+    HXVector< UTurbLusgs * > threadSolvers;
 public:
     void LowerSweep() override;
     void UpperSweep() override;
     void SingleSweep();
+    void LowerSweepCell( int cId );
+    void UpperSweepCell( int cId );
+    void WavefrontSweep( LusgsSchedule & schedule, bool lowerFlag );
+    void CopySweepState( UTurbLusgs * solver );
     void PrepareSweep();
     void Update();
 
     void SolveLowerCell();
     void SolveUpperCell();
 
-    void SolveLower( int fId );
-    void SolveUpper( int fId );
-
-    bool CanNotLowerSolve( int fId );
-    bool CanNotUpperSolve( int fId );
-    void Solve( int fId, int signValue );
-    void SetMeshGeometry();
+    void Solve( LusgsSweepList & sweepList, int i, int signValue );
     void PrepareData();
     void Init();
     void ReadTmp();
@@ -24,6 +24,9 @@ License
 #pragma once
 #include "TurbVisFlux.h"
 #include "VisGrad.h"
+#include "TurbCom.h"
+#include "Com.h"
+#include "UCom.h"
 
 BeginNameSpace( ONEFLOW )
 
@@ -37,6 +40,16 @@ public:
     VisPointer visPointer;
     MRField * visflux;
 public:
+    //Face state of this flux object. Inside the member functions it hides the
+    //global of the same name, so that every thread can evaluate faces with its own flux object.
+    UGeom ug;
+    GCom gcom;
+    TurbCom turbcom;
+    VisGrad visTurb;
+    VisGradGeom vgg;
+    HXVector< UTurbVisFlux * > threadFluxes;
+public:
+    void Init();
     void Alloc();
     void DeAlloc();
     void AddVisFlux();
@@ -44,6 +57,9 @@ public:
     void CalcVisFlux();
     void CalcVisFlux1Equ();
     void CalcVisFlux2Equ();
+    void CalcVisFlux( VisPointer faceVisPointer );
+    void CalcFaceFlux( int fId, VisPointer faceVisPointer );
+    void CopyFaceState( UTurbVisFlux * flux );
 
     void PrepareFaceValue();
     void CalcFaceVisFlux1Equ();
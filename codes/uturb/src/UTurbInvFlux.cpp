@@ -34,6 +34,10 @@ License
 #include "UCom.h"
 #include "UTurbCom.h"
 #include "UNsCom.h"
+#include "Profiler.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 BeginNameSpace( ONEFLOW )
 
@@ -43,6 +47,7 @@ UTurbInvFlux::UTurbInvFlux()
     nslimiter = new NsLimiter();
     nslimiter->limflag = turbcom.tns_ilim;
     limf = limiter->limf;
+    nslimf = nslimiter->limf;
     limiter->limflag = turbcom.turb_ilim;
 }
 
@@ -50,6 +55,19 @@ UTurbInvFlux::~UTurbInvFlux()
 {
     delete limiter;
     delete nslimiter;
+    for ( int i = 0; i < threadFluxes.size(); ++ i )
+    {
+        delete threadFluxes[ i ];
+    }
+}
+
+void UTurbInvFlux::Init()
+{
+    ONEFLOW::ug.Init();
+    this->ug = ONEFLOW::ug;
+    turbInv.Init();
+    unsf.Init();
+    uturbf.Init();
 }
 
 void UTurbInvFlux::CalcLimiter()
@@ -68,6 +86,18 @@ void UTurbInvFlux::CalcInvFace()
     this->BoundaryQlQrFixField();
 }
 
+void UTurbInvFlux::CalcInvFace( IntField & faceList )
+{
+    limf->GetQlQr( faceList );
+    nslimiter->limf->GetQlQr( faceList );
+
+    limf->CalcFaceValue( faceList );
+    nslimiter->limf->CalcFaceValue( faceList );
+
+    limf->BcQlQrFix( faceList );
+    nslimiter->limf->BcQlQrFix( faceList );
+}
+
 void UTurbInvFlux::GetQlQrField()
 {
     limf->GetQlQr();
@@ -117,6 +147,14 @@ void UTurbInvFlux::AddInvFlux()
     }
 }
 
+void UTurbInvFlux::AddInvFlux( IntField & faceList )
+{
+    UnsGrid * grid = Zone::GetUnsGrid();
+    MRField * res = GetFieldPointer< MRField >( grid, "turbres" );
+
+    ONEFLOW::AddF2CField( res, invflux, faceList );
+}
+
 void UTurbInvFlux::Alloc()
 {
     invflux = new MRField( limf->nEqu, ug.nFaces );
@@ -129,11 +167,7 @@ void UTurbInvFlux::DeAlloc()
 
 void UTurbInvFlux::CalcFlux()
 {
-    TurbInv & inv = turbInv;
-    inv.Init();
-    ug.Init();
-    unsf.Init();
-    uturbf.Init();
+    this->Init();
 
     Alloc();
 
@@ -144,26 +178,124 @@ void UTurbInvFlux::CalcFlux()
     DeAlloc();
 }
 
+void UTurbInvFlux::CalcFluxInner()
+{
+    if ( ! limiter->IsLocal() || ! nslimiter->IsLocal() ) return;
+
+    this->Init();
+
+    Alloc();
+
+    //The fused path takes the turbulence gradient from the source term evaluated before,
+    //it only enters the reconstruction above zero order
+    if ( limiter->limflag != ILMT_ZERO )
+    {
+        uturb_grad.Init();
+        uturb_grad.CalcGrad();
+    }
+
+    this->CalcLimiter();
+
+    this->CalcInvFace( * ug.innerFaces );
+    this->CalcInvFlux( * ug.innerFaces );
+    this->AddInvFlux( * ug.innerFaces );
+
+    DeAlloc();
+}
+
+void UTurbInvFlux::CalcFluxHalo()
+{
+    if ( ! limiter->IsLocal() || ! nslimiter->IsLocal() )
+    {
+        this->CalcFlux();
+        return;
+    }
+
+    this->Init();
+
+    Alloc();
+
+    limiter->CalcHaloLimiter();
+    nslimiter->CalcHaloLimiter();
+
+    this->CalcInvFace( * ug.haloFaces );
+    this->CalcInvFlux( * ug.haloFaces );
+    this->AddInvFlux( * ug.haloFaces );
+
+    DeAlloc();
+}
+
 void UTurbInvFlux::CalcInvFlux()
 {
-    for ( int fId = 0; fId < ug.nFaces; ++ fId )
+    static int profileId = Profiler::GetId( "turb_inv_flux", PROFILE_KERNEL );
+    ProfileScope profileScope( profileId );
+
+    this->CalcInvFlux( ug.nFaces, 0 );
+}
+
+void UTurbInvFlux::CalcInvFlux( IntField & faceList )
+{
+    static int profileId = Profiler::GetId( "turb_inv_flux", PROFILE_KERNEL );
+    ProfileScope profileScope( profileId );
+
+    this->CalcInvFlux( faceList.size(), & faceList );
+}
+
+//Thread 0 evaluates its faces with this flux object, every other thread with its own copy of it
+void UTurbInvFlux::CalcInvFlux( int nListFaces, IntField * faceList )
+{
+    int nThreads = GetFaceThreads();
+    while ( threadFluxes.size() < nThreads - 1 )
     {
-        ug.fId = fId;
+        threadFluxes.push_back( new UTurbInvFlux() );
+    }
 
-        if ( fId == 384 )
+    #pragma omp parallel num_threads( nThreads )
+    {
+        int iThread = 0;
+#ifdef _OPENMP
+        iThread = omp_get_thread_num();
+#endif
+        UTurbInvFlux * flux = this;
+        if ( iThread != 0 )
         {
-            int kkk = 1;
+            flux = threadFluxes[ iThread - 1 ];
+            flux->CopyFaceState( this );
         }
 
-        ug.lc = ( * ug.lcf )[ ug.fId ];
-        ug.rc = ( * ug.rcf )[ ug.fId ];
+        #pragma omp barrier
+
+        #pragma omp for
+        for ( int iFace = 0; iFace < nListFaces; ++ iFace )
+        {
+            int fId = iFace;
+            if ( faceList ) fId = ( * faceList )[ iFace ];
 
-        this->PrepareFaceValue();
-        this->RoeFlux();
-        this->UpdateFaceInvFlux();
+            flux->CalcFaceInvFlux( fId );
+        }
     }
 }
 
+void UTurbInvFlux::CalcFaceInvFlux( int fId )
+{
+    ug.fId = fId;
+    ug.lc = ( * ug.lcf )[ ug.fId ];
+    ug.rc = ( * ug.rcf )[ ug.fId ];
+
+    this->PrepareFaceValue();
+    this->RoeFlux();
+    this->UpdateFaceInvFlux();
+}
+
+void UTurbInvFlux::CopyFaceState( UTurbInvFlux * flux )
+{
+    this->ug      = flux->ug;
+    this->turbInv = flux->turbInv;
+    this->limf    = flux->limf;
+    this->nslimf  = flux->nslimf;
+    this->invflux = flux->invflux;
+}
+
 void UTurbInvFlux::PrepareFaceValue()
 {
     TurbInv & inv = turbInv;
@@ -180,15 +312,15 @@ void UTurbInvFlux::PrepareFaceValue()
         inv.prim2[ iEqu ] = ( * limf->qf2 )[ iEqu ][ ug.fId ];
     }
 
-    inv.rl = ( * nslimiter->limf->qf1 )[ IDX::IR ][ ug.fId ];
-    inv.ul = ( * nslimiter->limf->qf1 )[ IDX::IU ][ ug.fId ];
-    inv.vl = ( * nslimiter->limf->qf1 )[ IDX::IV ][ ug.fId ];
-    inv.wl = ( * nslimiter->limf->qf1 )[ IDX::IW ][ ug.fId ];
+    inv.rl = ( * nslimf->qf1 )[ IDX::IR ][ ug.fId ];
+    inv.ul = ( * nslimf->qf1 )[ IDX::IU ][ ug.fId ];
+    inv.vl = ( * nslimf->qf1 )[ IDX::IV ][ ug.fId ];
+    inv.wl = ( * nslimf->qf1 )[ IDX::IW ][ ug.fId ];
 
-    inv.rr = ( * nslimiter->limf->qf2 )[ IDX::IR ][ ug.fId ];
-    inv.ur = ( * nslimiter->limf->qf2 )[ IDX::IU ][ ug.fId ];
-    inv.vr = ( * nslimiter->limf->qf2 )[ IDX::IV ][ ug.fId ];
-    inv.wr = ( * nslimiter->limf->qf2 )[ IDX::IW ][ ug.fId ];
+    inv.rr = ( * nslimf->qf2 )[ IDX::IR ][ ug.fId ];
+    inv.ur = ( * nslimf->qf2 )[ IDX::IU ][ ug.fId ];
+    inv.vr = ( * nslimf->qf2 )[ IDX::IV ][ ug.fId ];
+    inv.wr = ( * nslimf->qf2 )[ IDX::IW ][ ug.fId ];
 }
 
 void UTurbInvFlux::UpdateFaceInvFlux()
@@ -29,6 +29,7 @@ License
 #include "TurbRhs.h"
 #include "UNsCom.h"
 #include "Com.h"
+#include "LusgsPlan.h"
 #include "UnsGrid.h"
 #include "CellMesh.h"
 #include "CellTopo.h"
@@ -38,17 +39,26 @@ License
 #include "HXMath.h"
 #include "Parallel.h"
 #include "Iteration.h"
+#include "Profiler.h"
 #include <iostream>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 BeginNameSpace( ONEFLOW )
 
 UTurbLusgs::UTurbLusgs()
 {
+    this->plan = 0;
 }
 
 UTurbLusgs::~UTurbLusgs()
 {
+    for ( HXSize_t i = 0; i < threadSolvers.size(); ++ i )
+    {
+        delete threadSolvers[ i ];
+    }
 }
 
 void UTurbLusgs::SingleSweep()
@@ -59,13 +69,11 @@ void UTurbLusgs::SingleSweep()
 
 void UTurbLusgs::Init()
 {
-    UnsGrid * grid = Zone::GetUnsGrid();
-    FaceTopo * faceTopo = grid->faceTopo;
-    CellTopo * cellTopo = grid->cellMesh->cellTopo;
-    cellTopo->CalcC2f( faceTopo );
-    ug.Init();
+    ONEFLOW::ug.Init();
+    this->ug = ONEFLOW::ug;
     turblu.Init();
     uturbf.Init();
+    this->plan = LusgsFactory::GetLusgsPlan( ug.grid );
 }
 
 void UTurbLusgs::ReadTmp()
@@ -89,135 +97,181 @@ void UTurbLusgs::ReadTmp()
 
 void UTurbLusgs::LowerSweep()
 {
+    static int profileId = Profiler::GetId( "sweep", PROFILE_KERNEL );
+    ProfileScope profileScope( profileId );
+
     this->Init();
 
-    //ReadTmp();
-    
-    for ( int cId = 0; cId < ug.nCells; ++ cId )
+    if ( ctrl.ilusgsthread != 0 )
     {
-        ug.cId = cId;
-
-        gcom.blank = ( * ug.blankf )[ ug.cId ];
-
-        if ( this->IsOversetCell() )
-        {
-            this->ZeroOversetCell();
-        }
-        else
-        {
-            this->PrepareSweep();
-
-            this->ZeroFluxIncrement();
-        
-            this->SolveLowerCell();
-
-            this->CalcLowerChange();
-        }
+        this->WavefrontSweep( this->plan->lowerSchedule, true );
+        return;
+    }
 
-        this->Update();
+    for ( int cId = 0; cId < ug.nCells; ++ cId )
+    {
+        this->LowerSweepCell( cId );
     }
-    
+
     //UploadInterfaceValue( grid, dqField, "dqField",  numberOfTotalEquations );
 }
 
 void UTurbLusgs::UpperSweep()
 {
+    static int profileId = Profiler::GetId( "sweep", PROFILE_KERNEL );
+    ProfileScope profileScope( profileId );
+
     this->Init();
     //this->LusgsBoundary();
     //DownloadInterfaceValue( grid, dqField, "dqField",  numberOfTotalEquations );
-    
+
+    if ( ctrl.ilusgsthread != 0 )
+    {
+        this->WavefrontSweep( this->plan->upperSchedule, false );
+        return;
+    }
+
     for ( int cId = ug.nCells - 1; cId >= 0; -- cId )
     {
-        ug.cId = cId;
-        gcom.blank = ( * ug.blankf )[ ug.cId ];
+        this->UpperSweepCell( cId );
+    }
 
-        if ( this->IsOversetCell() )
-        {
-            this->ZeroOversetCell();
-        }
-        else
-        {
-            this->PrepareSweep();
+    //CalcTurbulentViscosity();
+}
 
-            this->ZeroFluxIncrement();
+void UTurbLusgs::LowerSweepCell( int cId )
+{
+    ug.cId = cId;
+    gcom.blank = ( * ug.blankf )[ ug.cId ];
 
-            this->SolveUpperCell();
+    if ( this->IsOversetCell() )
+    {
+        this->ZeroOversetCell();
+    }
+    else
+    {
+        this->PrepareSweep();
 
-            this->CalcUpperChange();
-        }
+        this->ZeroFluxIncrement();
+
+        this->SolveLowerCell();
 
-        this->Update();
+        this->CalcLowerChange();
     }
 
-    //CalcTurbulentViscosity();
+    this->Update();
 }
 
-void UTurbLusgs::SolveLowerCell()
+void UTurbLusgs::UpperSweepCell( int cId )
 {
-    int fn = ( * ug.c2f )[ ug.cId ].size();
-    for ( int iFace = 0; iFace < fn; ++ iFace )
+    ug.cId = cId;
+    gcom.blank = ( * ug.blankf )[ ug.cId ];
+
+    if ( this->IsOversetCell() )
     {
-        int fId = ( * ug.c2f )[ ug.cId ][ iFace ];
-        this->SolveLower( fId );
+        this->ZeroOversetCell();
+    }
+    else
+    {
+        this->PrepareSweep();
+
+        this->ZeroFluxIncrement();
+
+        this->SolveUpperCell();
+
+        this->CalcUpperChange();
     }
+
+    this->Update();
 }
 
-void UTurbLusgs::SolveUpperCell()
+//Tasks of one level only read dq of earlier levels, so each level is swept by all threads.
+//Thread 0 sweeps with this solver, every other thread with its own copy of it.
+void UTurbLusgs::WavefrontSweep( LusgsSchedule & schedule, bool lowerFlag )
 {
-    int fn = ( * ug.c2f )[ ug.cId ].size();
-    for ( int iFace = 0; iFace < fn; ++ iFace )
+    int nThreads = 1;
+#ifdef _OPENMP
+    nThreads = omp_get_max_threads();
+#endif
+    while ( static_cast< int >( threadSolvers.size() ) < nThreads - 1 )
     {
-        int fId = ( * ug.c2f )[ ug.cId ][ iFace ];
-        this->SolveUpper( fId );
+        threadSolvers.push_back( new UTurbLusgs() );
     }
-}
 
-void UTurbLusgs::SolveLower( int fId )
-{
-    if ( this->CanNotLowerSolve( fId ) ) return;
+    #pragma omp parallel num_threads( nThreads )
+    {
+        int iThread = 0;
+#ifdef _OPENMP
+        iThread = omp_get_thread_num();
+#endif
+        UTurbLusgs * solver = this;
+        if ( iThread != 0 )
+        {
+            solver = threadSolvers[ iThread - 1 ];
+            solver->CopySweepState( this );
+        }
+        Real norm0 = solver->turblu.norm;
 
-    this->Solve( fId, - 1 );
-}
+        #pragma omp barrier
 
-void UTurbLusgs::SolveUpper( int fId )
-{
-    if ( this->CanNotUpperSolve( fId ) ) return;
+        int nLevels = schedule.GetNLevels();
+        for ( int iLevel = 0; iLevel < nLevels; ++ iLevel )
+        {
+            #pragma omp for schedule( dynamic )
+            for ( int iTask = schedule.start[ iLevel ]; iTask < schedule.start[ iLevel + 1 ]; ++ iTask )
+            {
+                for ( int i = schedule.taskStart[ iTask ]; i < schedule.taskStart[ iTask + 1 ]; ++ i )
+                {
+                    int cId = schedule.cells[ i ];
+                    if ( lowerFlag )
+                    {
+                        solver->LowerSweepCell( cId );
+                    }
+                    else
+                    {
+                        solver->UpperSweepCell( cId );
+                    }
+                }
+            }
+        }
 
-    this->Solve( fId, - 1 );
+        if ( iThread != 0 )
+        {
+            #pragma omp critical
+            this->turblu.norm += solver->turblu.norm - norm0;
+        }
+    }
 }
 
-bool UTurbLusgs::CanNotLowerSolve( int fId )
+void UTurbLusgs::CopySweepState( UTurbLusgs * solver )
 {
-    ug.fId = fId;
-
-    ug.lc = ( * ug.lcf )[ ug.fId ];
-    ug.rc = ( * ug.rcf )[ ug.fId ];
-
-    // One of lc  and rc must be cell itself.
-    // Now its neighboring cell belongs to lower triangular
-    return ( ug.lc > ug.cId || ug.rc > ug.cId );
+    this->ug     = solver->ug;
+    this->gcom   = solver->gcom;
+    this->turblu = solver->turblu;
+    this->plan   = solver->plan;
 }
 
-bool UTurbLusgs::CanNotUpperSolve( int fId )
+void UTurbLusgs::SolveLowerCell()
 {
-    ug.fId = fId;
-
-    ug.lc = ( * ug.lcf )[ ug.fId ];
-    ug.rc = ( * ug.rcf )[ ug.fId ];
-
-    // One of lc  and rc must be cell itself.
-    // Now its neighboring cell belongs to upper triangular
-    return ( ug.lc < ug.cId || ug.rc < ug.cId );
+    LusgsSweepList & lower = this->plan->lower;
+    for ( int i = lower.start[ ug.cId ]; i < lower.start[ ug.cId + 1 ]; ++ i )
+    {
+        this->Solve( lower, i, - 1 );
+    }
 }
 
-void UTurbLusgs::Solve( int fId, int signValue )
+void UTurbLusgs::SolveUpperCell()
 {
-    ug.fId = fId;
-
-    ug.lc = ( * ug.lcf )[ ug.fId ];
-    ug.rc = ( * ug.rcf )[ ug.fId ];
+    LusgsSweepList & upper = this->plan->upper;
+    for ( int i = upper.start[ ug.cId ]; i < upper.start[ ug.cId + 1 ]; ++ i )
+    {
+        this->Solve( upper, i, - 1 );
+    }
+}
 
-    this->SetMeshGeometry();
+void UTurbLusgs::Solve( LusgsSweepList & sweepList, int i, int signValue )
+{
+    sweepList.SetGeometry( i, ug, gcom );
 
     this->PrepareData();
 
@@ -226,11 +280,6 @@ void UTurbLusgs::Solve( int fId, int signValue )
     this->AddFluxIncrement();
 }
 
-void UTurbLusgs::SetMeshGeometry()
-{
-    gcom.SetGeometry();
-}
-
 void UTurbLusgs::PrepareData()
 {
     if ( gcom.swapflag )
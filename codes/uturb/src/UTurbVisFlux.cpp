@@ -35,6 +35,9 @@ License
 #include "VisGrad.h"
 #include "HXMath.h"
 #include <iostream>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 BeginNameSpace( ONEFLOW )
@@ -43,12 +46,25 @@ VisGrad visTurb;
 
 UTurbVisFlux::UTurbVisFlux()
 {
-
+    vgg.SetContext( & ug, & gcom );
+    visTurb.SetContext( & vgg, & ug, & gcom );
 }
 
 UTurbVisFlux::~UTurbVisFlux()
 {
+    for ( int i = 0; i < threadFluxes.size(); ++ i )
+    {
+        delete threadFluxes[ i ];
+    }
+}
 
+void UTurbVisFlux::Init()
+{
+    ONEFLOW::ug.Init();
+    this->ug = ONEFLOW::ug;
+    this->turbcom = ONEFLOW::turbcom;
+    uturbf.Init();
+    visTurb.Init( turbcom.nEqu );
 }
 
 void UTurbVisFlux::Alloc()
@@ -63,9 +79,7 @@ void UTurbVisFlux::DeAlloc()
 
 void UTurbVisFlux::CalcVisFlux()
 {
-    ug.Init();
-    uturbf.Init();
-    visTurb.Init( turbcom.nEqu );
+    this->Init();
     this->SetVisPointer();
     Alloc();
     if ( turbcom.nEqu == 1 )
@@ -246,43 +260,69 @@ void UTurbVisFlux::PrepareCellGeom()
 
 void UTurbVisFlux::CalcVisFlux1Equ()
 {
-    for ( int fId = 0; fId < ug.nFaces; ++ fId )
+    this->CalcVisFlux( & UTurbVisFlux::CalcFaceVisFlux1Equ );
+    this->AddVisFlux();
+}
+
+void UTurbVisFlux::CalcVisFlux2Equ()
+{
+    this->CalcVisFlux( & UTurbVisFlux::CalcFaceVisFlux2Equ );
+    this->AddVisFlux();
+}
+
+//Thread 0 evaluates its faces with this flux object, every other thread with its own copy of it
+void UTurbVisFlux::CalcVisFlux( VisPointer faceVisPointer )
+{
+    int nThreads = GetFaceThreads();
+    while ( threadFluxes.size() < nThreads - 1 )
     {
-        ug.fId = fId;
+        threadFluxes.push_back( new UTurbVisFlux() );
+    }
 
-        if ( fId == 866 )
+    #pragma omp parallel num_threads( nThreads )
+    {
+        int iThread = 0;
+#ifdef _OPENMP
+        iThread = omp_get_thread_num();
+#endif
+        UTurbVisFlux * flux = this;
+        if ( iThread != 0 )
         {
-            int kkk = 1;
+            flux = threadFluxes[ iThread - 1 ];
+            flux->CopyFaceState( this );
         }
 
-        ug.lc = ( * ug.lcf )[ ug.fId ];
-        ug.rc = ( * ug.rcf )[ ug.fId ];
+        #pragma omp barrier
 
-        this->PrepareFaceValue();
-
-        this->CalcFaceVisFlux1Equ();
-
-        this->UpdateFaceVisFlux();
+        #pragma omp for
+        for ( int fId = 0; fId < ug.nFaces; ++ fId )
+        {
+            flux->CalcFaceFlux( fId, faceVisPointer );
+        }
     }
-    this->AddVisFlux();
 }
 
-void UTurbVisFlux::CalcVisFlux2Equ()
+void UTurbVisFlux::CalcFaceFlux( int fId, VisPointer faceVisPointer )
 {
-    for ( int fId = 0; fId < ug.nFaces; ++ fId )
-    {
-        ug.fId = fId;
+    ug.fId = fId;
 
-        ug.lc = ( * ug.lcf )[ ug.fId ];
-        ug.rc = ( * ug.rcf )[ ug.fId ];
+    ug.lc = ( * ug.lcf )[ ug.fId ];
+    ug.rc = ( * ug.rcf )[ ug.fId ];
 
-        this->PrepareFaceValue();
+    this->PrepareFaceValue();
 
-        this->CalcFaceVisFlux2Equ();
+    ( this->* faceVisPointer )();
 
-        this->UpdateFaceVisFlux();
-    }
-    this->AddVisFlux();
+    this->UpdateFaceVisFlux();
+}
+
+void UTurbVisFlux::CopyFaceState( UTurbVisFlux * flux )
+{
+    this->ug      = flux->ug;
+    this->turbcom = flux->turbcom;
+    this->visTurb.Init( flux->visTurb.nEqu );
+    this->visflux = flux->visflux;
+    this->visPointer = flux->visPointer;
 }
 
 void UTurbVisFlux::AddVisFlux()
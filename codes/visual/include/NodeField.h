@@ -28,9 +28,9 @@ BeginNameSpace( ONEFLOW )
 
 MRField * AllocNodeVar( int nEqu = 1 );
 MRField * CreateNodeVar( const std::string & name );
-MRField * CreateNodeVar( RealField & qc );
-void CalcNodeVar( RealField & qNodeField, RealField & qField );
-void FixBcNodeVar( RealField & qNodeField, RealField & qField, RealField & nCount, int bcType, bool twoSide );
+MRField * CreateNodeVar( MRFieldRow qc );
+void CalcNodeVar( MRFieldRow qNodeField, MRFieldRow qField );
+void FixBcNodeVar( MRFieldRow qNodeField, MRFieldRow qField, RealField & nCount, int bcType, bool twoSide );
 
 template < typename T >
 void ReorderList( HXVector< T > & x, IntField & indexList )
@@ -48,6 +48,8 @@ public:
     static int nWords;
     static void DumpField( RealField & field );
     static void DumpField( IntField & l2g, RealField & x );
+    static void DumpField( MRFieldRow field );
+    static void DumpField( IntField & l2g, MRFieldRow x );
     static void DumpFaceNodeNumber( LinkField & f2n );
     static void DumpFaceNodeLink( LinkField & f2n );
     static void DumpFaceElementLink( IntField & elementId, int nElem );
@@ -53,7 +53,7 @@ MRField * CreateNodeVar( const std::string & name )
     return nf;
 }
 
-MRField * CreateNodeVar( RealField & qc )
+MRField * CreateNodeVar( MRFieldRow qc )
 {
     UnsGrid * grid = Zone::GetUnsGrid();
     MRField * fn = AllocNodeVar( 1 );
@@ -61,7 +61,7 @@ MRField * CreateNodeVar( RealField & qc )
     return fn;
 }
 
-void CalcNodeVar( RealField & qNodeField, RealField & qField )
+void CalcNodeVar( MRFieldRow qNodeField, MRFieldRow qField )
 {
     UnsGrid * grid = Zone::GetUnsGrid();
     FaceTopo * faceTopo = grid->faceTopo;
@@ -102,7 +102,7 @@ void CalcNodeVar( RealField & qNodeField, RealField & qField )
     }
 }
 
-void FixBcNodeVar( RealField & qNodeField, RealField & qField, RealField & nCount, int bcType, bool twoSide )
+void FixBcNodeVar( MRFieldRow qNodeField, MRFieldRow qField, RealField & nCount, int bcType, bool twoSide )
 {
     UnsGrid * grid = Zone::GetUnsGrid();
     FaceTopo * faceTopo = grid->faceTopo;
@@ -70,6 +70,29 @@ void Plot::DumpField( IntField & l2g, RealField & field )
     if ( nNodes % Plot::nWords != 0 ) ( * Plot::oss ) << std::endl;
 }
 
+void Plot::DumpField( MRFieldRow field )
+{
+    int nNodes = field.size();
+    for ( int iNode = 0; iNode < nNodes; ++ iNode )
+    {
+        ( * Plot::oss ) << field[ iNode ] << " ";
+        if ( ( iNode + 1 ) % Plot::nWords == 0 ) ( * Plot::oss ) << std::endl;
+    }
+    if ( nNodes % Plot::nWords != 0 ) ( * Plot::oss ) << std::endl;
+}
+
+void Plot::DumpField( IntField & l2g, MRFieldRow field )
+{
+    int nNodes = l2g.size();
+    for ( int iNode = 0; iNode < nNodes; ++ iNode )
+    {
+        int id = l2g[ iNode ];
+        ( * Plot::oss ) << field[ id ] << " ";
+        if ( ( iNode + 1 ) % Plot::nWords == 0 ) ( * Plot::oss ) << std::endl;
+    }
+    if ( nNodes % Plot::nWords != 0 ) ( * Plot::oss ) << std::endl;
+}
+
 void Plot::DumpFaceNodeLink( LinkField & f2n )
 {
     int nFaces = f2n.size();
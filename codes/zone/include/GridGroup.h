@@ -45,6 +45,7 @@ public:
     int zoneStart;
 protected:
     void ReadGrid( std::fstream & file, int iZone );
+    void ParallelReadGrid( std::fstream & file, const std::string & fileName );
     void CreateGrid( int zoneId );
     void CreateGridImp( int zoneId );
     void CreateGridTest( int zoneId );
@@ -37,6 +37,7 @@ License
 #include "HXMath.h"
 #include "DataBook.h"
 #include "Task.h"
+#include "Ctrl.h"
 #include <iostream>
 #include <string>
 
@@ -107,6 +108,12 @@ void GridGroup::ReadGrid( const std::string & fileName )
     this->InitZoneLayout( file );
     this->SetMultiZoneLayout();
 
+    if ( ctrl.iparallelio == 1 )
+    {
+        this->ParallelReadGrid( file, fileName );
+        return;
+    }
+
     for ( int iZone = 0; iZone < this->nZones; ++ iZone )
     {
         int zid = this->zoneStart + iZone;
@@ -116,6 +123,48 @@ void GridGroup::ReadGrid( const std::string & fileName )
     PIO::CloseFile( file );
 }
 
+void GridGroup::ParallelReadGrid( std::fstream & file, const std::string & fileName )
+{
+    int fid = Parallel::GetFid();
+
+    //The zone records start right after the zone layout
+    HXLongLong_t start = 0;
+    if ( Parallel::pid == fid )
+    {
+        start = file.tellg();
+    }
+
+    ONEFLOW::HXBcast( & start, 1, fid );
+
+    PIO::CloseFile( file );
+
+    PL_File plFile;
+    ONEFLOW::HXFileOpen( Prj::GetPrjFileName( fileName ), false, & plFile );
+
+    HXVector< HXLongLong_t > zonePos( this->nZones, 0 );
+    HXVector< HXLongLong_t > zoneSize( this->nZones, 0 );
+    PIO::CalcZoneRecordPos( plFile, start, zonePos, zoneSize );
+
+    for ( int iZone = 0; iZone < this->nZones; ++ iZone )
+    {
+        int zid = this->zoneStart + iZone;
+
+        if ( Parallel::pid != ZoneState::pid[ zid ] ) continue;
+
+        this->CreateGrid( zid );
+
+        DataBook * dataBook = new DataBook();
+
+        PIO::ReadZoneRecord( plFile, zonePos[ iZone ], zoneSize[ iZone ], dataBook );
+
+        ONEFLOW::DataToGrid( dataBook, zid );
+
+        delete dataBook;
+    }
+
+    ONEFLOW::HXFileClose( & plFile );
+}
+
 void GridGroup::ReadGrid( std::fstream & file, int zid )
 {
     int spid = 0;
@@ -30,6 +30,7 @@ along with OneFLOW.  If not, see <http://www.gnu.org/licenses/>.
 #include "CmxTask.h"
 #include "InterFace.h"
 #include "SlipFace.h"
+#include "Agglomeration.h"
 #include <iostream>
 
 
@@ -60,6 +61,9 @@ void MultiBlock::SetUpMultigrid()
 {
     SolverState::tid = GRID_SOLVER;
     SsSgTask( "CALC_METRICS" );
+
+    int nLevels = ONEFLOW::GetDataValue< int >( "nmg" );
+    ONEFLOW::CreateCoarseGrids( nLevels );
 }
 
 void MultiBlock::LoadGridAndBuildLink()
@@ -92,6 +96,8 @@ void MultiBlock::ProcessFlowWallDist()
     {
         LoadWallDist();
     }
+
+    ONEFLOW::CalcCoarseWallDist();
 }
 
 void MultiBlock::ProcessWallDist()
@@ -126,6 +132,7 @@ void MultiBlock::InitMultiZoneTopo()
     ONEFLOW::InitInterfaceTopo();
     ONEFLOW::InitSlipFaceTopo();
     MultiBlock::InitOversetTopo();
+    ONEFLOW::InitCoarseInterfaceTopo();
 }
 
 void MultiBlock::InitOversetTopo()